@@ -0,0 +1,104 @@
+// cmake/IonBenchmarkReporter.cpp
+// Catch2 reporter linked into every ion_add_benchmark() target.
+//
+// Writes one JSON document per run with a record per BENCHMARK, so results
+// can be collected and compared across commits:
+//
+//   {
+//     "context": {"executable": "...", "date": "...", "build": "release"},
+//     "benchmarks": [
+//       {"test_case": "...", "name": "...", "samples": 100, "iterations": 1,
+//        "mean_ns": 0.0, "mean_low_ns": 0.0, "mean_high_ns": 0.0, "stddev_ns": 0.0}
+//     ]
+//   }
+//
+// Select it with `--reporter ion-json::out=<file>`; run-<NAME> does.
+
+#include <catch2/benchmark/detail/catch_benchmark_stats.hpp>
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <catch2/reporters/catch_reporter_streaming_base.hpp>
+
+#include <chrono>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::string json_string(std::string_view text) {
+    std::string out = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+// BenchmarkStats dropped its Duration template parameter during Catch2 3.x;
+// take the type from the interface so either spelling compiles.
+template <typename> struct listener_argument;
+template <typename Listener, typename Arg>
+struct listener_argument<void (Listener::*)(Arg)> { using type = Arg; };
+using benchmark_stats = listener_argument<decltype(&Catch::IEventListener::benchmarkEnded)>::type;
+
+class ion_json_reporter final : public Catch::StreamingReporterBase {
+public:
+    using StreamingReporterBase::StreamingReporterBase;
+
+    static std::string getDescription() {
+        return "Benchmark results as one JSON document, for tracking over time";
+    }
+
+    void testRunStarting(Catch::TestRunInfo const& info) override {
+        StreamingReporterBase::testRunStarting(info);
+        executable_ = std::string(info.name);
+    }
+
+    void benchmarkEnded(benchmark_stats stats) override {
+        std::string test_case = currentTestCaseInfo ? currentTestCaseInfo->name : std::string();
+        records_.push_back(std::format(
+            "    {{\"test_case\": {}, \"name\": {}, \"samples\": {}, \"iterations\": {}, "
+            "\"mean_ns\": {}, \"mean_low_ns\": {}, \"mean_high_ns\": {}, \"stddev_ns\": {}}}",
+            json_string(test_case), json_string(stats.info.name), stats.info.samples, stats.info.iterations,
+            stats.mean.point.count(), stats.mean.lower_bound.count(), stats.mean.upper_bound.count(),
+            stats.standardDeviation.point.count()));
+    }
+
+    void testRunEnded(Catch::TestRunStats const& stats) override {
+        StreamingReporterBase::testRunEnded(stats);
+#if defined(NDEBUG)
+        constexpr std::string_view build = "release";
+#else
+        constexpr std::string_view build = "debug";
+#endif
+        auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+        m_stream << "{\n  \"context\": {\"executable\": " << json_string(executable_)
+                 << ", \"date\": " << json_string(std::format("{:%FT%TZ}", now))
+                 << ", \"build\": " << json_string(build) << "},\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < records_.size(); ++i) {
+            m_stream << records_[i] << (i + 1 < records_.size() ? ",\n" : "\n");
+        }
+        m_stream << "  ]\n}\n";
+        m_stream.flush();
+    }
+
+private:
+    std::string executable_;
+    std::vector<std::string> records_;
+};
+
+}  // namespace
+
+CATCH_REGISTER_REPORTER("ion-json", ion_json_reporter)
@@ -58,12 +58,114 @@ function(ion_setup_build_environment)
     set(BUILD_SHARED_LIBS OFF CACHE BOOL "Build shared libraries" FORCE)
 endfunction()
 
+# ──────────────────────────────────────────────────────────────────────────────
+# ion_setup_optimization
+#   Applies the whole-program optimization options to every Ion target
+#
+#   ION_ENABLE_LTO  IPO/LTO for Release builds, where the toolchain supports it
+#   ION_PGO         Profile-guided optimization phase:
+#                     GENERATE  instrument; running pgo-train (every run-<bench>
+#                               target) writes profiles to ION_PGO_DIR
+#                     USE       rebuild optimized with the collected profiles
+#
+#   Workflow, in one Release build directory:
+#     cmake -DION_PGO=GENERATE -DION_BUILD_BENCHMARKS=ON . && cmake --build . --target pgo-train
+#     cmake -DION_PGO=USE . && cmake --build .
+#   Delete ION_PGO_DIR before GENERATE to start from fresh profiles.
+#   Must be called AFTER ion_setup_build_interface.
+# ──────────────────────────────────────────────────────────────────────────────
+function(ion_setup_optimization)
+    if(ION_ENABLE_LTO)
+        include(CheckIPOSupported)
+        check_ipo_supported(RESULT _ipo_supported OUTPUT _ipo_output LANGUAGES CXX)
+        if(_ipo_supported)
+            set(CMAKE_INTERPROCEDURAL_OPTIMIZATION_RELEASE ON PARENT_SCOPE)
+        else()
+            message(WARNING "ION_ENABLE_LTO: not supported by this toolchain: ${_ipo_output}")
+        endif()
+    endif()
+
+    if(NOT ION_PGO OR ION_PGO STREQUAL "OFF")
+        return()
+    endif()
+    if(NOT ION_PGO MATCHES "^(GENERATE|USE)$")
+        message(FATAL_ERROR "ION_PGO must be OFF, GENERATE or USE, got '${ION_PGO}'")
+    endif()
+    if(NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang" OR MSVC)
+        message(FATAL_ERROR "ION_PGO is supported with GCC and Clang only")
+    endif()
+    if(NOT CMAKE_BUILD_TYPE STREQUAL "Release")
+        message(WARNING "ION_PGO is meant for Release builds, CMAKE_BUILD_TYPE is '${CMAKE_BUILD_TYPE}'")
+    endif()
+
+    set(_profile_dir "${ION_PGO_DIR}")
+    if(ION_PGO STREQUAL "GENERATE")
+        file(MAKE_DIRECTORY ${_profile_dir})
+        # Atomic counters keep profiles of the thread pool benchmarks consistent
+        set(_pgo_flags -fprofile-generate=${_profile_dir})
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            list(APPEND _pgo_flags -fprofile-update=atomic)
+        endif()
+        target_compile_options(ion_build INTERFACE ${_pgo_flags})
+        target_link_options(ion_build INTERFACE ${_pgo_flags})
+        return()
+    endif()
+
+    # USE: Clang reads one merged default.profdata, GCC reads the .gcda files in place
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        file(GLOB_RECURSE _profiles "${_profile_dir}/*.gcda")
+    else()
+        file(GLOB _profiles "${_profile_dir}/*.profraw")
+        if(_profiles)
+            string(REGEX MATCH "^[0-9]+" _clang_major ${CMAKE_CXX_COMPILER_VERSION})
+            get_filename_component(_compiler_dir ${CMAKE_CXX_COMPILER} DIRECTORY)
+            find_program(ION_LLVM_PROFDATA
+                NAMES llvm-profdata llvm-profdata-${_clang_major}
+                HINTS ${_compiler_dir}
+            )
+            if(NOT ION_LLVM_PROFDATA)
+                message(FATAL_ERROR "ION_PGO=USE: llvm-profdata not found, set ION_LLVM_PROFDATA")
+            endif()
+            execute_process(
+                COMMAND ${ION_LLVM_PROFDATA} merge -output=${_profile_dir}/default.profdata ${_profiles}
+                RESULT_VARIABLE _merge_result
+            )
+            if(NOT _merge_result EQUAL 0)
+                message(FATAL_ERROR "ION_PGO=USE: merging profiles in ${_profile_dir} failed")
+            endif()
+        endif()
+        file(GLOB _profiles "${_profile_dir}/default.profdata")
+    endif()
+    if(NOT _profiles)
+        message(FATAL_ERROR "ION_PGO=USE: no profiles in ${_profile_dir}; "
+            "build with ION_PGO=GENERATE and run the pgo-train target first")
+    endif()
+
+    # Code the benchmarks never reach is optimized as usual rather than for size
+    target_compile_options(ion_build INTERFACE -fprofile-use=${_profile_dir})
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        target_compile_options(ion_build INTERFACE -fprofile-partial-training -Wno-missing-profile)
+    else()
+        target_compile_options(ion_build INTERFACE
+            -Wno-profile-instr-unprofiled
+            -Wno-profile-instr-out-of-date
+        )
+    endif()
+    target_link_options(ion_build INTERFACE -fprofile-use=${_profile_dir})
+endfunction()
+
 # ──────────────────────────────────────────────────────────────────────────────
 # ion_add_library
 #   Creates a library target with standard Ion Vortex settings
 #   Automatically discovers sources based on standard layout:
 #     - src/**/*.cpp for sources
 #     - include/ion/${NAME}/**/*.h for public headers
+#
+#   The library type follows ION_LIBRARY_TYPE (SHARED by default). STATIC and
+#   OBJECT keep calls into the library out of the PLT, so with ION_ENABLE_LTO
+#   the linker can inline and devirtualize the final implementation classes.
+#   The type is global: the export header's ION_SHARED_LIBS switch covers
+#   every library at once.
 #   
 # Usage:
 #   ion_add_library(
@@ -96,9 +198,17 @@ function(ion_add_library)
         message(FATAL_ERROR "No sources found in ${CMAKE_CURRENT_SOURCE_DIR}/src/")
     endif()
 
+    set(_library_type SHARED)
+    if(ION_LIBRARY_TYPE)
+        set(_library_type ${ION_LIBRARY_TYPE})
+    endif()
+    if(NOT _library_type MATCHES "^(SHARED|STATIC|OBJECT)$")
+        message(FATAL_ERROR "ION_LIBRARY_TYPE must be SHARED, STATIC or OBJECT, got '${_library_type}'")
+    endif()
+
     # Create the library target
     set(_target_name "ion_${ARG_NAME}")
-    add_library(ion_${ARG_NAME} SHARED ${_sources} ${_public_headers})
+    add_library(ion_${ARG_NAME} ${_library_type} ${_sources} ${_public_headers})
     add_library(ion::${ARG_NAME} ALIAS ${_target_name})
     
     # Set shared library properties
@@ -131,8 +241,12 @@ function(ion_add_library)
     string(TOUPPER ${ARG_NAME} _name_upper)
     target_compile_definitions(ion_${ARG_NAME}
         PRIVATE "ION_${_name_upper}_EXPORTS"
-        PUBLIC "ION_SHARED_LIBS"
     )
+    if(_library_type STREQUAL "SHARED")
+        target_compile_definitions(ion_${ARG_NAME}
+            PUBLIC "ION_SHARED_LIBS"
+        )
+    endif()
     
     # Set up include directories
     target_include_directories(${_target_name}
@@ -179,7 +293,9 @@ function(ion_add_library)
     install(TARGETS ${_target_name}
         EXPORT IonTargets
         ARCHIVE DESTINATION lib
+        LIBRARY DESTINATION lib
         RUNTIME DESTINATION bin
+        OBJECTS DESTINATION lib/objects
     )
 
     install(DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/include/ion/${ARG_NAME}/
@@ -332,7 +448,7 @@ function(ion_add_application)
     endif()
 
     # Windows: Copy DLLs to executable directory if using lib/ layout
-    if(WIN32 AND CMAKE_LIBRARY_OUTPUT_DIRECTORY)
+    if(WIN32 AND CMAKE_LIBRARY_OUTPUT_DIRECTORY AND NOT ION_LIBRARY_TYPE MATCHES "STATIC|OBJECT")
         set(_ion_deps)
         foreach(_dep IN LISTS ARG_DEPENDENCIES)
             if(_dep MATCHES "^ion::")
@@ -434,7 +550,7 @@ function(ion_add_test)
         foreach(_dep IN LISTS ARG_DEPENDENCIES)
             if(_dep MATCHES "^ion::")
                 string(REPLACE "ion::" "ion_" _target ${_dep})
-                if(TARGET ${_target})
+                if(TARGET ${_target} AND NOT ION_LIBRARY_TYPE MATCHES "STATIC|OBJECT")
                     list(APPEND _dll_paths $<TARGET_FILE_DIR:${_target}>)
                 endif()
             endif()
@@ -451,7 +567,7 @@ function(ion_add_test)
         foreach(_dep IN LISTS ARG_DEPENDENCIES)
             if(_dep MATCHES "^ion::")
                 string(REPLACE "ion::" "ion_" _target ${_dep})
-                if(TARGET ${_target})
+                if(TARGET ${_target} AND NOT ION_LIBRARY_TYPE MATCHES "STATIC|OBJECT")
                     add_custom_command(TARGET ${ARG_NAME} POST_BUILD
                         COMMAND ${CMAKE_COMMAND} -E copy_if_different
                         $<TARGET_FILE:${_target}>
@@ -470,6 +586,118 @@ function(ion_add_test)
     endif()
 endfunction()
 
+# ──────────────────────────────────────────────────────────────────────────────
+# ion_add_benchmark
+#   Creates a Catch2 BENCHMARK executable and a run-<NAME> target for it
+#   Automatically discovers benchmark sources
+#
+#   Benchmarks are not registered with CTest. run-<NAME> runs every benchmark
+#   and writes the results as JSON to <build>/benchmarks/<NAME>.json through
+#   the ion-json reporter (IonBenchmarkReporter.cpp, linked into every target).
+#
+# Usage:
+#   ion_add_benchmark(
+#     NAME core-bench
+#     DEPENDENCIES ion::core
+#   )
+# ──────────────────────────────────────────────────────────────────────────────
+function(ion_add_benchmark)
+    cmake_parse_arguments(ARG
+        ""
+        "NAME"
+        "DEPENDENCIES"
+        ${ARGN}
+    )
+
+    if(NOT ARG_NAME)
+        message(FATAL_ERROR "ion_add_benchmark: NAME is required")
+    endif()
+
+    # Ensure Catch2 is available
+    find_package(Catch2 CONFIG REQUIRED)
+
+    # Automatically discover benchmark sources
+    file(GLOB_RECURSE _sources CONFIGURE_DEPENDS
+        "${CMAKE_CURRENT_SOURCE_DIR}/*.cpp"
+    )
+
+    if(NOT _sources)
+        message(FATAL_ERROR "No benchmark sources found in ${CMAKE_CURRENT_SOURCE_DIR}/")
+    endif()
+
+    add_executable(${ARG_NAME}
+        ${_sources}
+        ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/IonBenchmarkReporter.cpp
+    )
+
+    # Set output directories to avoid config subdirectories (MSVC)
+    set_target_properties(${ARG_NAME} PROPERTIES
+        RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+        RUNTIME_OUTPUT_DIRECTORY_DEBUG ${CMAKE_CURRENT_BINARY_DIR}
+        RUNTIME_OUTPUT_DIRECTORY_RELEASE ${CMAKE_CURRENT_BINARY_DIR}
+        PDB_OUTPUT_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+        PDB_OUTPUT_DIRECTORY_DEBUG ${CMAKE_CURRENT_BINARY_DIR}
+        PDB_OUTPUT_DIRECTORY_RELEASE ${CMAKE_CURRENT_BINARY_DIR}
+    )
+
+    # Ignore the STL dll-interface warnings MSVC generates.
+    if(MSVC)
+        target_compile_options(${ARG_NAME} PRIVATE
+            /wd4251  # 'type' needs to have dll-interface
+            /wd4275  # non dll-interface base class
+            /wd5030  # unrecognized attribute (gnu::...)
+        )
+    endif()
+
+    # Collect ALL transitive dependencies
+    ion_collect_all_dependencies(_all_deps ${ARG_DEPENDENCIES})
+
+    target_link_libraries(${ARG_NAME}
+        PRIVATE
+            ion::build
+            ${_all_deps}
+            Catch2::Catch2WithMain
+    )
+
+    # Machine-readable results next to a console summary
+    set(_results_dir "${CMAKE_BINARY_DIR}/benchmarks")
+    add_custom_target(run-${ARG_NAME}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${_results_dir}
+        COMMAND $<TARGET_FILE:${ARG_NAME}>
+            --reporter console
+            --reporter "ion-json::out=${_results_dir}/${ARG_NAME}.json"
+        DEPENDS ${ARG_NAME}
+        WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+        USES_TERMINAL
+        COMMENT "Running ${ARG_NAME}, results in ${_results_dir}/${ARG_NAME}.json"
+    )
+
+    # The benchmarks are the PGO training run (see ion_setup_optimization)
+    if(ION_PGO STREQUAL "GENERATE")
+        if(NOT TARGET pgo-train)
+            add_custom_target(pgo-train)
+        endif()
+        add_dependencies(pgo-train run-${ARG_NAME})
+    endif()
+
+    # On Windows, copy DLLs next to the executable so it runs from the build tree
+    if(WIN32)
+        foreach(_dep IN LISTS ARG_DEPENDENCIES)
+            if(_dep MATCHES "^ion::")
+                string(REPLACE "ion::" "ion_" _target ${_dep})
+                if(TARGET ${_target} AND NOT ION_LIBRARY_TYPE MATCHES "STATIC|OBJECT")
+                    add_custom_command(TARGET ${ARG_NAME} POST_BUILD
+                        COMMAND ${CMAKE_COMMAND} -E copy_if_different
+                        $<TARGET_FILE:${_target}>
+                        $<TARGET_FILE_DIR:${ARG_NAME}>
+                        COMMENT "Copying ${_target} DLL to benchmark directory"
+                    )
+                endif()
+            endif()
+        endforeach()
+    endif()
+endfunction()
+
 # ──────────────────────────────────────────────────────────────────────────────
 # ion_find_dependencies
 #   Wrapper to find common external dependencies with consistent error handling
@@ -0,0 +1,53 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <ion/core/buffer.h>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <span>
+
+using namespace ion::core;
+
+namespace {
+
+constexpr size_t k_fill_bytes = 64 * 1024;
+
+/**
+ * @brief Clears `buffer` and appends `chunk` until it holds k_fill_bytes.
+ */
+template <typename Buffer, size_t Chunk>
+size_t fill_buffer(Buffer& buffer, std::array<std::byte, Chunk> const& chunk) {
+    if (!buffer.clear()) return 0;
+    for (size_t written = 0; written + Chunk <= k_fill_bytes; written += Chunk) {
+        if (!buffer.append(std::span<std::byte const>(chunk))) return 0;
+    }
+    return buffer.size();
+}
+
+template <size_t Chunk>
+void bench_append() {
+    std::array<std::byte, Chunk> chunk{};
+    chunk.fill(std::byte{0x5a});
+
+    dynamic_buffer vector;
+    REQUIRE(vector.reserve(k_fill_bytes).has_value());
+    static_buffer<k_fill_bytes> fixed;
+    auto dispatched = std::move(*create_buffer(k_fill_bytes));
+
+    BENCHMARK(std::format("vector_buffer append, 64KB in {}B chunks", Chunk)) {
+        return fill_buffer(vector, chunk);
+    };
+    BENCHMARK(std::format("StaticBuffer append, 64KB in {}B chunks", Chunk)) {
+        return fill_buffer(fixed, chunk);
+    };
+    BENCHMARK(std::format("buffer_base append, 64KB in {}B chunks", Chunk)) {
+        return fill_buffer(*dispatched, chunk);
+    };
+}
+
+}  // namespace
+
+TEST_CASE("Buffer - Append throughput", "[benchmark][buffer]") {
+    bench_append<8>();
+    bench_append<256>();
+}
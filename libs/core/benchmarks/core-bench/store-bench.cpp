@@ -0,0 +1,249 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <ion/core/store.h>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ion::core;
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * @brief A JSON file of roughly `bytes`, removed again when the benchmark ends.
+ *
+ * The document is a flat object of small entity records, the shape a large
+ * settings or scene file has.
+ */
+class store_document {
+    fs::path path_;
+public:
+    store_document(std::string const& name, size_t bytes)
+        : path_(fs::temp_directory_path() / name) {
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        out << "{\n";
+        size_t written = 2;
+        for (size_t i = 0; written < bytes; ++i) {
+            auto record = std::format(
+                "{}  \"entity_{}\": {{\"name\": \"entity {}\", \"position\": [{}.5, {}.25, -3.0], \"visible\": true, \"layer\": {}}}",
+                i ? ",\n" : "", i, i, i, i, i % 16);
+            out << record;
+            written += record.size();
+        }
+        out << "\n}\n";
+    }
+
+    ~store_document() {
+        std::error_code ec;
+        fs::remove(path_, ec);
+        fs::remove(path_.string() + ".journal", ec);
+    }
+
+    fs::path const& path() const { return path_; }
+};
+
+void bench_open(std::string label, fs::path const& path, json_store_options const& opts) {
+    BENCHMARK_ADVANCED(std::move(label))(Catch::Benchmark::Chronometer meter) {
+        // Keep the stores alive until the sample is timed; closing is not part of open
+        std::vector<std::unique_ptr<store_base>> stores(meter.runs());
+        meter.measure([&](int i) {
+            stores[i] = std::move(*make_json_file_store(path, opts));
+            return stores[i]->open(path).has_value();
+        });
+    };
+}
+
+std::unique_ptr<store_base> open_memory_store() {
+    auto store = std::move(*make_in_memory_store());
+    REQUIRE(store->open({}).has_value());
+    return store;
+}
+
+/**
+ * @brief Fills a store with `count` integer keys `k0`, `k1`, ... under the root.
+ */
+void fill_keys(store_base& store, size_t count) {
+    auto txn = std::move(*store.begin_transaction());
+    auto root = *txn->root();
+    for (size_t i = 0; i < count; ++i) {
+        REQUIRE(txn->make_int(root, std::format("k{}", i), static_cast<int64_t>(i)).has_value());
+    }
+    REQUIRE(txn->commit().has_value());
+}
+
+}  // namespace
+
+TEST_CASE("Store - Open and parse", "[benchmark][storage][open]") {
+    json_store_options eager{};
+    json_store_options lazy{};
+    lazy.lazy_load = true;
+
+    for (auto [label, bytes] : {std::pair<char const*, size_t>{"1KB", 1u << 10}, {"1MB", 1u << 20}}) {
+        store_document doc(std::format("ion_bench_open_{}.json", label), bytes);
+        bench_open(std::format("JSON open, {}", label), doc.path(), eager);
+        bench_open(std::format("JSON open, {}, lazy", label), doc.path(), lazy);
+    }
+}
+
+TEST_CASE("Store - Open and parse 100MB", "[benchmark][storage][open][large]") {
+    json_store_options eager{};
+    json_store_options lazy{};
+    lazy.lazy_load = true;
+
+    store_document doc("ion_bench_open_100MB.json", size_t{100} << 20);
+    bench_open("JSON open, 100MB", doc.path(), eager);
+    bench_open("JSON open, 100MB, lazy", doc.path(), lazy);
+}
+
+TEST_CASE("Store - Transaction begin", "[benchmark][storage][transaction]") {
+    // Transactions share the committed tree, so beginning one should not
+    // depend on how much the store holds
+    for (size_t keys : {size_t{16}, size_t{16384}}) {
+        auto store = open_memory_store();
+        fill_keys(*store, keys);
+
+        BENCHMARK(std::format("begin_transaction, {} keys", keys)) {
+            return store->begin_transaction().has_value();
+        };
+        BENCHMARK(std::format("begin_read_transaction, {} keys", keys)) {
+            return store->begin_read_transaction().has_value();
+        };
+    }
+}
+
+TEST_CASE("Store - Navigate by depth", "[benchmark][storage][navigate]") {
+    // A chain of objects n0.n1...n15, each level with a few siblings to search past
+    auto store = open_memory_store();
+    {
+        auto txn = std::move(*store->begin_transaction());
+        auto parent = *txn->root();
+        for (int depth = 0; depth < 16; ++depth) {
+            for (char sibling : {'a', 'm', 'z'}) {
+                REQUIRE(txn->make_int(parent, std::format("{}{}", sibling, depth), depth).has_value());
+            }
+            parent = *txn->make_object(parent, std::format("n{}", depth));
+        }
+        REQUIRE(txn->commit().has_value());
+    }
+
+    auto view = std::move(*store->begin_read_transaction());
+    auto root = *view->root();
+    for (int depth : {1, 2, 4, 8, 16}) {
+        std::string text = "n0";
+        for (int i = 1; i < depth; ++i) text += std::format(".n{}", i);
+        auto compiled = *store_path::parse(text);
+
+        BENCHMARK(std::format("navigate string, depth {}", depth)) {
+            return view->navigate(root, text).has_value();
+        };
+        BENCHMARK(std::format("navigate store_path, depth {}", depth)) {
+            return view->navigate(root, compiled).has_value();
+        };
+    }
+}
+
+TEST_CASE("Store - Lookup by backend", "[benchmark][storage][lookup]") {
+    // The same entity records in both backends; the memory store packs them in its arena
+    constexpr size_t k_entities = 4096;
+    auto fill_entities = [](store_base& store) {
+        auto txn = std::move(*store.begin_transaction());
+        auto root = *txn->root();
+        for (size_t i = 0; i < k_entities; ++i) {
+            auto entity = *txn->make_object(root, std::format("entity_with_a_long_name_{}", i));
+            REQUIRE(txn->make_string(entity, "name", std::format("entity {}", i)).has_value());
+            REQUIRE(txn->make_bool(entity, "visible", true).has_value());
+            REQUIRE(txn->make_int(entity, "layer", static_cast<int64_t>(i % 16)).has_value());
+        }
+        REQUIRE(txn->commit().has_value());
+    };
+
+    auto memory = open_memory_store();
+    fill_entities(*memory);
+
+    store_document doc("ion_bench_lookup.json", 0);
+    auto json = std::move(*make_json_file_store(doc.path(), json_store_options{}));
+    REQUIRE(json->open(doc.path()).has_value());
+    fill_entities(*json);
+
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < k_entities; i += 61) keys.push_back(std::format("entity_with_a_long_name_{}", i));
+
+    auto lookup = [&](store_base& store) {
+        auto view = std::move(*store.begin_read_transaction());
+        auto root = *view->root();
+        int64_t sum = 0;
+        for (auto const& key : keys) {
+            auto entity = view->child(root, key);
+            if (!entity) return int64_t{-1};
+            sum += view->get_int(*view->child(*entity, "layer")).value_or(0);
+        }
+        return sum;
+    };
+
+    BENCHMARK("memory lookup") { return lookup(*memory); };
+    BENCHMARK("JSON lookup") { return lookup(*json); };
+}
+
+TEST_CASE("Store - Commit by size", "[benchmark][storage][commit]") {
+    constexpr size_t k_keys = 4096;
+    auto memory = open_memory_store();
+    fill_keys(*memory, k_keys);
+
+    store_document doc("ion_bench_commit.json", 0);
+    auto journaled = std::move(*make_json_file_store(doc.path(), json_store_options{}));
+    REQUIRE(journaled->open(doc.path()).has_value());
+    fill_keys(*journaled, k_keys);
+
+    auto commit_writes = [](store_base& store, size_t writes, int64_t value) {
+        auto txn = std::move(*store.begin_transaction());
+        auto root = *txn->root();
+        for (size_t i = 0; i < writes; ++i) {
+            if (!txn->set_int(*txn->child(root, std::format("k{}", i)), value)) return false;
+        }
+        return txn->commit().has_value();
+    };
+
+    for (size_t writes : {size_t{1}, size_t{16}, size_t{256}, size_t{4096}}) {
+        int64_t value = 0;
+        BENCHMARK(std::format("memory commit, {} writes", writes)) {
+            return commit_writes(*memory, writes, ++value);
+        };
+        BENCHMARK(std::format("JSON journal commit, {} writes", writes)) {
+            return commit_writes(*journaled, writes, ++value);
+        };
+    }
+}
+
+TEST_CASE("Store - Key validation against std::regex", "[benchmark][storage][keys]") {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 64; ++i) {
+        keys.push_back("window_" + std::to_string(i) + (i % 3 ? "_position_x" : ""));
+    }
+    keys.push_back("not-a-key");
+    std::regex const pattern("[A-Za-z_][A-Za-z0-9_]*");
+
+    BENCHMARK("std::regex_match") {
+        size_t valid = 0;
+        for (auto const& key : keys) valid += std::regex_match(key.begin(), key.end(), pattern);
+        return valid;
+    };
+
+    BENCHMARK("detail::is_valid_key") {
+        size_t valid = 0;
+        for (auto const& key : keys) valid += detail::is_valid_key(key);
+        return valid;
+    };
+
+    std::string_view path = "settings.display.windows[3].position_x";
+    BENCHMARK("detail::find_delimiter, 5-segment path") {
+        size_t segments = 0;
+        for (size_t i = 0; i < path.size(); i += detail::find_delimiter(path.substr(i)) + 1) ++segments;
+        return segments;
+    };
+}
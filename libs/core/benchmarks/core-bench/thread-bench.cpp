@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <ion/core/thread.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <format>
+#include <functional>
+
+using namespace ion::core;
+
+TEST_CASE("Executor - Task and pool round trips", "[benchmark][thread]") {
+    std::array<uint64_t, 5> payload{1, 2, 3, 4, 5};
+    uint64_t sink = 0;
+
+    BENCHMARK("std::function, 48-byte capture") {
+        std::function<void()> fn([payload, &sink] { sink += payload[4]; });
+        fn();
+        return sink;
+    };
+    BENCHMARK("Task, 48-byte capture") {
+        Task task([payload, &sink] { sink += payload[4]; });
+        task();
+        return sink;
+    };
+
+    for (uint32_t workers : {1u, 4u}) {
+        thread_pool_options opts{};
+        opts.worker_count = workers;
+        auto pool = std::move(*make_thread_pool(opts));
+
+        BENCHMARK(std::format("pool submit + wait_idle, 1000 tasks, {} workers", workers)) {
+            std::atomic<uint64_t> sum{0};
+            for (int i = 0; i < 1000; ++i) {
+                pool->submit([payload, &sum] { sum.fetch_add(payload[0], std::memory_order_relaxed); });
+            }
+            pool->wait_idle();
+            return sum.load();
+        };
+    }
+}
@@ -4,4 +4,9 @@
 
 #include "buffer/buffer_base.h"
 #include "buffer/static_buffer.h"
-#include "buffer/buffer_factory.h"
\ No newline at end of file
+#include "buffer/vector_buffer.h"
+#include "buffer/byte_sink.h"
+#include "buffer/buffer_factory.h"
+#include "buffer/buffer_pool.h"
+#include "buffer/chained_buffer.h"
+#include "buffer/ring_buffer.h"
\ No newline at end of file
@@ -14,6 +14,16 @@ public:
     [[ION_NODISCARD("Handle resize result")]]
     virtual std::expected<void, std::error_code> resize(std::size_t bytes) = 0;
 
+    /**
+     * @brief Resizes like resize(), but leaves bytes past the old size
+     *        indeterminate instead of zeroing them.
+     *
+     * For callers about to overwrite the whole range anyway, e.g. before
+     * reading a message into mutate().
+     */
+    [[ION_NODISCARD("Handle resize result")]]
+    virtual std::expected<void, std::error_code> resize_uninitialized(std::size_t bytes) = 0;
+
     [[ION_NODISCARD("Handle reserve result")]]
     virtual std::expected<void, std::error_code> reserve(std::size_t bytes) = 0;
 
@@ -24,7 +34,18 @@ public:
     virtual std::expected<void, std::error_code> shrink_to_fit() = 0;
 
     [[ION_NODISCARD("Handle append result")]]
-    virtual std::expected<void, std::error_code> append(std::span<const std::byte> src) = 0;
+    std::expected<void, std::error_code> append(std::span<const std::byte> src) {
+        return to_error_code(try_append(src));
+    }
+
+    /**
+     * @brief append() with a one-byte core_errc error, for tight loops.
+     *
+     * The result fits in a register and carries no error category; use
+     * to_error_code() where a failure has to leave as a std::error_code.
+     */
+    [[ION_NODISCARD("Handle append result")]]
+    virtual std::expected<void, core_errc> try_append(std::span<const std::byte> src) = 0;
 
     [[ION_NODISCARD("Handle view result")]]
     virtual std::span<const std::byte> view() const noexcept = 0;
@@ -4,9 +4,15 @@
 
 #include "buffer_base.h"
 #include "static_buffer.h"
+#include "vector_buffer.h"
 
 namespace ion::core {
 
+// Concrete buffer types, for code that writes through byte_sink without virtual dispatch
+using dynamic_buffer = detail::vector_buffer;
+template <std::size_t N>
+using static_buffer = detail::StaticBuffer<N>;
+
 // Factory function to create a dynamic buffer with an optional initial capacity
 [[ION_NODISCARD("Handle buffer creation result")]]
 ION_CORE_API std::expected<std::unique_ptr<buffer_base>, std::error_code>
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <system_error>
+
+#include "buffer_base.h"
+
+namespace ion::core {
+
+/**
+ * @brief Options for create_buffer_pool().
+ */
+struct ION_CORE_API buffer_pool_options {
+    std::size_t min_block = 64;             ///< Smallest capacity class in bytes; a power of two.
+    std::size_t max_block = 1 << 20;        ///< Largest pooled class; bigger buffers use the heap directly.
+    std::size_t max_cached_per_class = 64;  ///< Free blocks each shard keeps per class before freeing them.
+    uint32_t shard_count = 0;               ///< Free-list shards; 0 means one per available CPU.
+};
+
+/**
+ * @brief Hands out buffers whose storage is recycled instead of freed.
+ *
+ * Buffer capacities are rounded up to power-of-two classes between
+ * min_block and max_block, and a released buffer's block and the buffer
+ * object itself go back to a free list for the next acquire(). Free lists
+ * are sharded, and each thread keeps to one shard, so threads that acquire
+ * and release buffers at a high rate rarely meet on a lock. Once the free
+ * lists hold the working set, acquiring, growing within a class and
+ * releasing a buffer allocate nothing.
+ *
+ * @note The pool must outlive every buffer it hands out.
+ */
+class ION_CORE_API buffer_pool_base {
+public:
+    virtual ~buffer_pool_base() = default;
+
+    /**
+     * @brief Takes a buffer from the pool.
+     * @param initial_capacity Bytes to reserve up front; rounded up to a class.
+     * @return An empty buffer that returns its storage to this pool when destroyed.
+     */
+    [[ION_NODISCARD("Handle buffer acquisition result")]]
+    virtual std::expected<std::unique_ptr<buffer_base>, std::error_code>
+    acquire(std::size_t initial_capacity = 0) = 0;
+};
+
+/**
+ * @brief Creates a buffer pool.
+ * @param options Capacity classes, cache depth and sharding.
+ * @return Unique pointer to buffer_pool_base or error (InvalidArgument if
+ *         min_block or max_block is not a power of two or min_block > max_block).
+ */
+[[ION_NODISCARD("Handle buffer pool creation result")]]
+ION_CORE_API std::expected<std::unique_ptr<buffer_pool_base>, std::error_code>
+create_buffer_pool(buffer_pool_options options = {});
+
+} // namespace ion::core
@@ -0,0 +1,171 @@
+#pragma once
+#include "buffer_base.h"
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <ion/core/export.h>
+
+namespace ion::core {
+
+/**
+ * @brief A buffer that byte_writer can fill.
+ *
+ * Every buffer_base satisfies it, so a writer over `buffer_base&` goes
+ * through the vtable as before. The concrete `final` buffers (dynamic_buffer,
+ * static_buffer<N>) satisfy it directly: a writer over one of them calls
+ * their members statically, and the compiler can inline them.
+ */
+template <typename T>
+concept byte_sink = requires(T& sink, T const& csink, std::span<const std::byte> src, std::size_t n) {
+    { sink.append(src) } -> std::same_as<std::expected<void, std::error_code>>;
+    { sink.resize_uninitialized(n) } -> std::same_as<std::expected<void, std::error_code>>;
+    { sink.mutate() } noexcept -> std::same_as<std::span<std::byte>>;
+    { csink.size() } noexcept -> std::same_as<std::size_t>;
+    { csink.capacity() } noexcept -> std::same_as<std::size_t>;
+};
+
+/**
+ * @brief Appends fields to a byte_sink with one fallible call per batch
+ *        instead of one per field.
+ *
+ * reserve() grows the sink once for a run of fields; put() and put_le()
+ * then copy into the reserved room without checks or error results, and
+ * finish() trims the sink to what was written. write() is the checked
+ * variant that grows on demand, for fields whose total size is not known.
+ *
+ * @code
+ * byte_writer out(buffer);
+ * if (!out.reserve(k_header_size)) return ...;
+ * out.put_le<uint32_t>(magic);
+ * out.put_le<uint16_t>(version);
+ * if (auto e = out.write(payload); !e) return e;
+ * return out.finish();
+ * @endcode
+ *
+ * @note Until finish(), the sink's size includes reserved room that holds
+ *       indeterminate bytes.
+ */
+template <byte_sink Sink>
+class byte_writer {
+public:
+    explicit byte_writer(Sink& sink) noexcept
+        : sink_(sink), pos_(sink.size()), end_(pos_) {}
+
+    byte_writer(byte_writer const&) = delete;
+    byte_writer& operator=(byte_writer const&) = delete;
+
+    /**
+     * @brief Makes room for at least `bytes` more bytes past what was written.
+     * @return Success or the sink's error (e.g. MessageTooLong for a static buffer).
+     */
+    [[ION_NODISCARD("Handle reserve result")]]
+    std::expected<void, std::error_code> reserve(std::size_t bytes) {
+        if (end_ - pos_ >= bytes) return {};
+        if (bytes > max_size() - pos_) {
+            return std::unexpected(make_error_code(core_errc::message_too_long));
+        }
+        // Take all the room the sink already has; beyond that, grow by half
+        // so repeated write()s stay amortized
+        std::size_t need = pos_ + bytes;
+        std::size_t capacity = sink_.capacity();
+        std::size_t want = capacity >= need ? capacity : need + (need / 2 < max_size() - need ? need / 2 : max_size() - need);
+        if (auto grown = sink_.resize_uninitialized(want); !grown) return grown;
+        end_ = sink_.size();
+        data_ = sink_.mutate().data();
+        return {};
+    }
+
+    /**
+     * @brief Copies `bytes` into reserved room.
+     * @pre reserve() made room for them.
+     */
+    void put(std::span<const std::byte> bytes) noexcept {
+        if (!bytes.empty()) std::memcpy(data_ + pos_, bytes.data(), bytes.size());
+        pos_ += bytes.size();
+    }
+
+    /**
+     * @brief Copies the object representation of `value` into reserved room.
+     * @pre reserve() made room for sizeof(T) bytes.
+     */
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void put(T const& value) noexcept {
+        std::memcpy(data_ + pos_, &value, sizeof(T));
+        pos_ += sizeof(T);
+    }
+
+    /**
+     * @brief Copies an integer into reserved room in little-endian order.
+     * @pre reserve() made room for sizeof(T) bytes.
+     */
+    template <std::integral T>
+    void put_le(T value) noexcept {
+        if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) value = std::byteswap(value);
+        put(value);
+    }
+
+    /**
+     * @brief Reserves room for `bytes` if needed, then copies them.
+     */
+    [[ION_NODISCARD("Handle write result")]]
+    std::expected<void, std::error_code> write(std::span<const std::byte> bytes) {
+        if (end_ - pos_ < bytes.size()) {
+            if (auto e = reserve(bytes.size()); !e) return e;
+        }
+        put(bytes);
+        return {};
+    }
+
+    /**
+     * @brief Bytes written so far, counting what the sink held before.
+     */
+    [[ION_NODISCARD("Use the written size")]]
+    std::size_t position() const noexcept { return pos_; }
+
+    /**
+     * @brief Shrinks the sink to the bytes actually written.
+     */
+    [[ION_NODISCARD("Handle finish result")]]
+    std::expected<void, std::error_code> finish() {
+        if (end_ == pos_) return {};
+        auto trimmed = sink_.resize_uninitialized(pos_);
+        if (trimmed) end_ = pos_;
+        return trimmed;
+    }
+
+private:
+    static constexpr std::size_t max_size() noexcept { return static_cast<std::size_t>(PTRDIFF_MAX); }
+
+    Sink& sink_;
+    std::byte* data_ = nullptr;
+    std::size_t pos_;
+    std::size_t end_;
+};
+
+/**
+ * @brief Appends `bytes` to `sink` through its static type.
+ */
+template <byte_sink Sink>
+[[ION_NODISCARD("Handle append result")]]
+std::expected<void, std::error_code> write_bytes(Sink& sink, std::span<const std::byte> bytes) {
+    return sink.append(bytes);
+}
+
+/**
+ * @brief Appends an integer to `sink` in little-endian order.
+ */
+template <std::integral T, byte_sink Sink>
+[[ION_NODISCARD("Handle append result")]]
+std::expected<void, std::error_code> write_le(Sink& sink, T value) {
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) value = std::byteswap(value);
+    return sink.append(std::as_bytes(std::span{&value, 1}));
+}
+
+} // namespace ion::core
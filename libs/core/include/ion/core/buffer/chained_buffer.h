@@ -0,0 +1,106 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <span>
+#include <system_error>
+
+#include "buffer_base.h"
+
+namespace ion::core {
+
+/**
+ * @brief Deleter for a segment_owner: calls `release` once with the owner
+ *        pointer when the buffer drops the segment.
+ */
+struct segment_release {
+    void (*release)(void const* owner) noexcept = nullptr;
+
+    void operator()(void const* owner) const noexcept {
+        if (release) release(owner);
+    }
+};
+
+/**
+ * @brief Move-only handle that keeps memory linked by append_ref() alive.
+ */
+using segment_owner = std::unique_ptr<void const, segment_release>;
+
+/**
+ * @brief Wraps `owner` so the buffer deletes it once no segment needs it.
+ */
+template <typename T>
+segment_owner make_segment_owner(std::unique_ptr<T> owner) noexcept {
+    return segment_owner(owner.release(), segment_release{[](void const* p) noexcept { delete static_cast<T const*>(p); }});
+}
+
+/**
+ * @brief A buffer held as a chain of segments instead of one region.
+ *
+ * append() copies into spare room at the end of the chain, as for any
+ * buffer, but append_ref() links caller-owned memory as a segment of its
+ * own without copying it. A message built from a header, a payload the
+ * caller already holds and a trailer thus costs two small copies and no
+ * copy of the payload. segments() lists the pieces in order for a
+ * scatter/gather write; on POSIX each span maps onto one `iovec`.
+ *
+ * view() and mutate() never copy: view() returns the contents only while
+ * they form a single segment, and mutate() only while that segment is
+ * owned by the buffer rather than linked; otherwise both return an empty
+ * span. flatten() makes either hold by copying the chain into one owned
+ * segment. Code that only writes the chain out should stick to segments().
+ */
+class ION_CORE_API chained_buffer_base : public buffer_base {
+public:
+    /**
+     * @brief Appends `bytes` as a segment that refers to the caller's memory.
+     * @param bytes Memory to link; must stay unchanged while the buffer refers to it.
+     * @param owner Released once the buffer no longer refers to `bytes`; may
+     *              be empty when the caller guarantees their lifetime itself.
+     *              On error it is released before returning.
+     * @return Success or MessageTooLong if the total size would overflow.
+     */
+    [[ION_NODISCARD("Handle append result")]]
+    virtual std::expected<void, std::error_code>
+    append_ref(std::span<const std::byte> bytes, segment_owner owner = {}) = 0;
+
+    /**
+     * @brief The segments in order. Valid until the buffer is next modified
+     *        or flattened.
+     */
+    [[ION_NODISCARD("Use the segments")]]
+    virtual std::span<const std::span<const std::byte>> segments() const noexcept = 0;
+
+    /**
+     * @brief The contents as one span, without copying.
+     * @return The bytes, or InvalidState if they span more than one segment.
+     */
+    [[ION_NODISCARD("Handle view result")]]
+    virtual std::expected<std::span<const std::byte>, std::error_code> contiguous_view() const noexcept = 0;
+
+    /**
+     * @brief Copies the chain into a single owned segment, so view() and
+     *        mutate() return the whole contents.
+     *
+     * Allocates and copies unless the contents already are one owned segment.
+     * Spans previously returned by segments() are invalidated.
+     * @return The now contiguous bytes, or Unknown if allocation fails (the
+     *         chain is left as it was).
+     */
+    [[ION_NODISCARD("Handle flatten result")]]
+    virtual std::expected<std::span<std::byte>, std::error_code> flatten() = 0;
+};
+
+/**
+ * @brief Creates an empty chained buffer.
+ * @param segment_capacity Segments to make room for up front.
+ * @return Unique pointer to chained_buffer_base or error.
+ */
+[[ION_NODISCARD("Handle chained buffer creation result")]]
+ION_CORE_API std::expected<std::unique_ptr<chained_buffer_base>, std::error_code>
+create_chained_buffer(std::size_t segment_capacity = 0);
+
+} // namespace ion::core
@@ -0,0 +1,206 @@
+#pragma once
+#include "buffer_base.h"
+#include "static_buffer.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ion/core/export.h>
+
+namespace ion::core {
+
+/**
+ * @brief Which threads may produce into a ring_buffer.
+ */
+enum class ring_producers : uint8_t {
+    single,     ///< One producer thread; claiming slots is a plain store.
+    multiple,   ///< Any number of producer threads; claiming slots is a CAS.
+};
+
+/**
+ * @brief Bounded lock-free queue of byte messages between threads.
+ *
+ * The ring holds `SlotCount` slots of `SlotSize` bytes each, inline and
+ * allocation-free; every slot is a StaticBuffer, so a claimed slot is written
+ * through the ordinary buffer_base interface. Producers claim a run of free
+ * slots with try_reserve(), fill them and publish them with commit(). The one
+ * consumer takes a run of published slots with try_consume() and hands them
+ * back with release().
+ *
+ * Each slot carries a sequence number that commit() bumps, so producers in
+ * `multiple` mode may commit out of order; the consumer stops at the first
+ * slot not yet committed. Producer and consumer indices and every slot sit on
+ * cache lines of their own.
+ *
+ * @code
+ * ring_buffer<256, 1024, ring_producers::multiple> ring;
+ * // Producer
+ * if (auto batch = ring.try_reserve(); !batch.empty()) {
+ *     auto written = batch[0].append(message);   // MessageTooLong leaves the slot empty
+ *     ring.commit(batch);
+ * }
+ * // Consumer
+ * auto batch = ring.try_consume(32);
+ * for (size_t i = 0; i < batch.size(); ++i) handle(batch[i].view());
+ * ring.release(batch);
+ * @endcode
+ *
+ * @note A claimed slot must be committed even if it is left empty, and the
+ *       consumer must release batches in the order it consumed them.
+ */
+template <std::size_t SlotSize, std::size_t SlotCount, ring_producers Producers = ring_producers::single>
+class ring_buffer {
+    static_assert(SlotCount > 0 && std::has_single_bit(SlotCount), "ring_buffer slot count must be a power of two");
+
+    static constexpr std::size_t k_mask = SlotCount - 1;
+
+    struct alignas(64) slot {
+        std::atomic<uint64_t> sequence{0};   // Position + 1 once committed
+        detail::StaticBuffer<SlotSize> data;
+    };
+
+public:
+    /**
+     * @brief A run of consecutive slots claimed by try_reserve() or try_consume().
+     */
+    class batch {
+    public:
+        batch() = default;
+
+        [[ION_NODISCARD("Use the batch size")]]
+        std::size_t size() const noexcept { return count_; }
+
+        [[ION_NODISCARD("Use the batch state")]]
+        bool empty() const noexcept { return count_ == 0; }
+
+        /**
+         * @brief The i-th slot of the batch. Its static type is final, so
+         *        calls through it need no virtual dispatch.
+         */
+        detail::StaticBuffer<SlotSize>& operator[](std::size_t i) const noexcept {
+            return ring_->slots_[(first_ + i) & k_mask].data;
+        }
+
+    private:
+        friend class ring_buffer;
+
+        batch(ring_buffer* ring, uint64_t first, std::size_t count) noexcept
+            : ring_(ring), first_(first), count_(count) {}
+
+        ring_buffer* ring_ = nullptr;
+        uint64_t first_ = 0;
+        std::size_t count_ = 0;
+    };
+
+    ring_buffer() = default;
+    ring_buffer(ring_buffer const&) = delete;
+    ring_buffer& operator=(ring_buffer const&) = delete;
+
+    /**
+     * @brief Bytes each slot can hold.
+     */
+    static constexpr std::size_t slot_size() noexcept { return SlotSize; }
+
+    /**
+     * @brief Number of slots in the ring.
+     */
+    static constexpr std::size_t capacity() noexcept { return SlotCount; }
+
+    /**
+     * @brief Producer: claims up to `max_count` free slots, each cleared.
+     * @return The claimed run; empty if the ring is full.
+     */
+    [[ION_NODISCARD("Commit the reserved slots")]]
+    batch try_reserve(std::size_t max_count = 1) noexcept {
+        std::size_t count = 0;
+        uint64_t head = 0;
+        if constexpr (Producers == ring_producers::single) {
+            head = head_.load(std::memory_order_relaxed);
+            if (SlotCount - (head - cached_tail_) < max_count) {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+            }
+            count = std::min<std::size_t>(max_count, SlotCount - (head - cached_tail_));
+            if (count == 0) return {};
+            head_.store(head + count, std::memory_order_relaxed);
+        } else {
+            // Tail first: a newer head against an older tail only underestimates the room
+            uint64_t tail = tail_.load(std::memory_order_acquire);
+            head = head_.load(std::memory_order_relaxed);
+            for (;;) {
+                uint64_t used = head - tail;
+                if (used >= SlotCount) {
+                    uint64_t fresh = tail_.load(std::memory_order_acquire);
+                    if (fresh == tail) return {};
+                    tail = fresh;
+                    continue;
+                }
+                count = std::min<std::size_t>(max_count, SlotCount - used);
+                if (count == 0) return {};
+                if (head_.compare_exchange_weak(head, head + count, std::memory_order_relaxed)) break;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            (void)slots_[(head + i) & k_mask].data.clear();
+        }
+        return batch(this, head, count);
+    }
+
+    /**
+     * @brief Producer: publishes a batch from try_reserve() to the consumer.
+     */
+    void commit(batch const& claimed) noexcept {
+        for (std::size_t i = 0; i < claimed.count_; ++i) {
+            uint64_t pos = claimed.first_ + i;
+            slots_[pos & k_mask].sequence.store(pos + 1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Consumer: takes up to `max_count` committed slots, oldest first.
+     * @return The run; empty if nothing is committed yet.
+     */
+    [[ION_NODISCARD("Release the consumed slots")]]
+    batch try_consume(std::size_t max_count = 1) noexcept {
+        std::size_t count = 0;
+        while (count < max_count &&
+               slots_[(read_ + count) & k_mask].sequence.load(std::memory_order_acquire) == read_ + count + 1) {
+            ++count;
+        }
+        batch taken(this, read_, count);
+        read_ += count;
+        return taken;
+    }
+
+    /**
+     * @brief Consumer: returns a batch from try_consume() to the producers.
+     */
+    void release(batch const& taken) noexcept {
+        if (taken.count_ == 0) return;
+        tail_.store(taken.first_ + taken.count_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Slots claimed and not yet released; exact only when no other
+     *        thread is using the ring.
+     */
+    [[ION_NODISCARD("Use the size")]]
+    std::size_t size_approx() const noexcept {
+        return static_cast<std::size_t>(head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed));
+    }
+
+private:
+    // Producer side
+    alignas(64) std::atomic<uint64_t> head_{0};   // Next position to claim
+    uint64_t cached_tail_ = 0;                     // Single producer only: last tail seen
+
+    // Consumer side
+    alignas(64) std::atomic<uint64_t> tail_{0};   // Everything before it is free again
+    uint64_t read_ = 0;                            // Next position to consume
+
+    std::array<slot, SlotCount> slots_{};
+};
+
+} // namespace ion::core
@@ -19,6 +19,10 @@ public:
         return {};
     }
 
+    std::expected<void, std::error_code> resize_uninitialized(std::size_t bytes) override {
+        return resize(bytes);
+    }
+
     std::expected<void, std::error_code> reserve(std::size_t bytes) override {
         if (bytes > N) {
             return std::unexpected(make_error_code(core_errc::message_too_long));
@@ -36,9 +40,9 @@ public:
         return {};
     }
 
-    std::expected<void, std::error_code> append(std::span<const std::byte> src) override {
+    std::expected<void, core_errc> try_append(std::span<const std::byte> src) override {
         if (size_ + src.size() > N) {
-            return std::unexpected(make_error_code(core_errc::message_too_long));
+            return std::unexpected(core_errc::message_too_long);
         }
         std::memcpy(data_.data() + size_, src.data(), src.size());
         size_ += src.size();
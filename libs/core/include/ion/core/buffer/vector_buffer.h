@@ -0,0 +1,113 @@
+#pragma once
+#include "buffer_base.h"
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <ion/core/export.h>
+
+namespace ion::core::detail {
+
+/**
+ * @brief std::allocator that default-initializes instead of value-initializing,
+ *        so growing a vector of bytes leaves the new bytes untouched.
+ */
+template <typename T>
+struct default_init_allocator : std::allocator<T> {
+    template <typename U>
+    struct rebind { using other = default_init_allocator<U>; };
+
+    using std::allocator<T>::allocator;
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+/**
+ * @brief Growable buffer backed by a std::vector; what create_buffer() returns.
+ *
+ * Defined inline so that code holding the concrete type (see byte_sink)
+ * calls its members directly instead of through the vtable.
+ */
+class vector_buffer final : public buffer_base {
+    std::vector<std::byte, default_init_allocator<std::byte>> data_;
+public:
+    [[ION_NODISCARD("Handle resize result")]]
+    std::expected<void, std::error_code> resize(std::size_t bytes) override {
+        if (bytes > data_.max_size()) {
+            return std::unexpected(make_error_code(core_errc::message_too_long));
+        }
+        std::size_t old_size = data_.size();
+        data_.resize(bytes);
+        if (bytes > old_size) {
+            std::memset(data_.data() + old_size, 0, bytes - old_size);
+        }
+        return {};
+    }
+
+    [[ION_NODISCARD("Handle resize result")]]
+    std::expected<void, std::error_code> resize_uninitialized(std::size_t bytes) override {
+        if (bytes > data_.max_size()) {
+            return std::unexpected(make_error_code(core_errc::message_too_long));
+        }
+        data_.resize(bytes);
+        return {};
+    }
+
+    [[ION_NODISCARD("Handle reserve result")]]
+    std::expected<void, std::error_code> reserve(std::size_t bytes) override {
+        if (bytes > data_.max_size()) {
+            return std::unexpected(make_error_code(core_errc::message_too_long));
+        }
+        data_.reserve(bytes);
+        return {};
+    }
+
+    [[ION_NODISCARD("Handle clear result")]]
+    std::expected<void, std::error_code> clear() override {
+        data_.clear();
+        return {};
+    }
+
+    [[ION_NODISCARD("Handle shrinkToFit result")]]
+    std::expected<void, std::error_code> shrink_to_fit() override {
+        data_.shrink_to_fit();
+        return {};
+    }
+
+    [[ION_NODISCARD("Handle append result")]]
+    std::expected<void, core_errc> try_append(std::span<const std::byte> src) override {
+        if (data_.size() + src.size() > data_.max_size()) {
+            return std::unexpected(core_errc::message_too_long);
+        }
+        data_.insert(data_.end(), src.begin(), src.end());
+        return {};
+    }
+
+    std::span<const std::byte> view() const noexcept override {
+        return std::span<const std::byte>(data_.data(), data_.size());
+    }
+
+    std::span<std::byte> mutate() noexcept override {
+        return std::span<std::byte>(data_.data(), data_.size());
+    }
+
+    std::size_t size() const noexcept override {
+        return data_.size();
+    }
+
+    std::size_t capacity() const noexcept override {
+        return data_.capacity();
+    }
+};
+
+} // namespace ion::core::detail
@@ -3,11 +3,16 @@
 #include <string_view>
 #include <cstdint>
 #include <exception>
+#include <expected>
+#include <system_error>
+#include <type_traits>
+#include <utility>
 #include <ion/core/export.h>
 
 namespace ion::core {
 
-enum class ION_CORE_API core_errc
+// One byte, so std::expected<T, core_errc> stays as small as T allows
+enum class ION_CORE_API core_errc : std::uint8_t
 {
     invalid_handle   = 1, // raw==0 or generation mismatch
     path_syntax,          // malformed "[", non-digit index, etc.
@@ -20,7 +25,10 @@ enum class ION_CORE_API core_errc
     invalid_state,        // operation not valid in current state
     message_too_long,     // message exceeds max length,
     invalid_argument,     // invalid argument passed to function
-    unknown,              // unknown error
+    unknown          = 12, // unknown error
+    conflict         = 13, // concurrent commit changed data the transaction read
+    journal_mismatch = 14, // journal kept: it applies to neither the base file nor one it was folded into
+    // Values are persisted and compared: append new codes, never renumber
 };
 
 // core error category for std::error_code
@@ -44,6 +52,8 @@ public:
             case E::message_too_long:    return "Message too long";
             case E::invalid_argument:    return "Invalid argument";
             case E::unknown:             return "Unknown error";
+            case E::conflict:            return "Transaction conflict";
+            case E::journal_mismatch:    return "Journal does not match its base file";
             default:                     return "Unrecognised error";
         }
     }
@@ -55,6 +65,22 @@ inline std::error_code make_error_code(core_errc e) noexcept {
     return {static_cast<int>(e), k_core_category};
 }
 
+/**
+ * @brief Widens a core_errc result from a fast-path call (try_get_int(),
+ *        try_append(), ...) to the std::error_code form of the rest of the API.
+ *
+ * Only a failed result touches the error category.
+ */
+template <typename T>
+std::expected<T, std::error_code> to_error_code(std::expected<T, core_errc>&& result) {
+    if (!result) [[unlikely]] return std::unexpected(make_error_code(result.error()));
+    if constexpr (std::is_void_v<T>) {
+        return {};
+    } else {
+        return std::move(*result);
+    }
+}
+
 } // namespace ion::core
 
 template<> struct std::is_error_code_enum<ion::core::core_errc> : std::true_type {};
\ No newline at end of file
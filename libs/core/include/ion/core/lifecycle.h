@@ -0,0 +1,6 @@
+#pragma once
+
+#include <ion/core/types.h>
+
+#include "lifecycle/service.h"
+#include "lifecycle/service_host.h"
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <ion/core/metrics/metrics_registry.h>
+#include <ion/core/thread/executor.h>
+#include <ion/core/time/cached_clock.h>
+#include <ion/core/time/clock.h>
+
+#include "service.h"
+
+namespace ion::core {
+
+/**
+ * @brief Handle to a service added to a service_host_base.
+ */
+struct ION_CORE_API service_id {
+    uint32_t index = 0;
+};
+
+/**
+ * @brief How a service_host_base schedules one service.
+ */
+struct ION_CORE_API service_options {
+    std::string_view name{};          ///< Shown in stats and metric names; copied.
+    std::vector<service_id> after{};  ///< Services whose tick must finish before this one's starts.
+    uint64_t interval_ns = 0;         ///< Tick at most this often, at a fixed rate; 0 ticks every frame. Needs a clock.
+    uint64_t budget_ns = 0;           ///< Ticks longer than this count as overruns; 0 means no budget. Needs a clock.
+    bool skippable = false;           ///< May be skipped in a frame that has used up frame_budget_ns.
+};
+
+/**
+ * @brief Options for make_service_host().
+ */
+struct ION_CORE_API service_host_options {
+    executor_base* executor = nullptr;           ///< Runs a phase's services in parallel (e.g. a thread pool); null ticks them in turn.
+    clock_base const* clock = nullptr;           ///< Times ticks and paces intervals; without one, no latency is measured.
+    cached_clock* frame_clock = nullptr;         ///< Updated at the start of every frame, before any service ticks.
+    metrics_registry_base* metrics = nullptr;    ///< Receives each service's tick latency as histogram `service.<name>.tick_ns`.
+    uint64_t frame_interval_ns = 0;              ///< Frame period for run(); 0 runs frames back to back. Needs a clock.
+    uint64_t frame_budget_ns = 0;                ///< Past this much of a frame, skippable services wait for the next; 0 disables. Needs a clock.
+};
+
+/**
+ * @brief Tick counts and latency of one service.
+ */
+struct ION_CORE_API service_stats {
+    uint64_t ticks = 0;           ///< Ticks run.
+    uint64_t skipped = 0;         ///< Frames it was due in but skipped for the frame budget.
+    uint64_t overruns = 0;        ///< Ticks that took longer than its budget_ns.
+    uint64_t last_tick_ns = 0;    ///< Duration of the latest tick.
+    uint64_t max_tick_ns = 0;     ///< Longest tick so far.
+    uint64_t total_tick_ns = 0;   ///< Sum of every tick's duration.
+};
+
+/**
+ * @brief Runs a set of services frame by frame, in dependency order.
+ *
+ * Each service lands in the phase after the last of the services it runs
+ * `after`, so a frame runs phase 0, then phase 1, and so on. Services of
+ * one phase do not depend on each other: with an executor, the host hands
+ * all but one of them to it, ticks that one on the calling thread and
+ * waits for the phase to finish. Nothing is allocated per frame.
+ *
+ * init() and shutdown() run on the calling thread, in phase order and in
+ * reverse. Services are added before init().
+ *
+ * @note With an executor, a frame must not run on one of the executor's own
+ *       workers if the executor could then be left without a free worker.
+ */
+class ION_CORE_API service_host_base {
+public:
+    virtual ~service_host_base() = default;
+
+    /**
+     * @brief Adds a service. It must outlive the host.
+     * @return Its handle, or error (InvalidState after init(), InvalidArgument
+     *         for an unknown `after` handle or an interval without a clock).
+     */
+    [[ION_NODISCARD("Keep the service handle")]]
+    virtual std::expected<service_id, std::error_code> add(service_base& service, service_options const& options) = 0;
+
+    /**
+     * @brief Initializes every service in phase order.
+     * @return Success or error (InvalidState if already initialized).
+     */
+    [[ION_NODISCARD("Check for error on init")]]
+    virtual std::expected<void, std::error_code> init() = 0;
+
+    /**
+     * @brief Runs one frame: every phase in order, each service that is due.
+     * @return Success or error (InvalidState unless initialized and not shut down).
+     */
+    [[ION_NODISCARD("Check for error on tick")]]
+    virtual std::expected<void, std::error_code> tick() = 0;
+
+    /**
+     * @brief Runs frames until `stop` is set, one per frame_interval_ns.
+     *
+     * Sleeps on the calling thread between frames that finish early; a
+     * late frame starts the next one at once.
+     * @return Success once stopped, or what tick() reports.
+     */
+    [[ION_NODISCARD("Check for error on run")]]
+    virtual std::expected<void, std::error_code> run(std::atomic<bool> const& stop) = 0;
+
+    /**
+     * @brief Shuts every service down in reverse phase order.
+     * @return Success or error (InvalidState unless initialized).
+     */
+    [[ION_NODISCARD("Check for error on shutdown")]]
+    virtual std::expected<void, std::error_code> shutdown() = 0;
+
+    /**
+     * @brief Counts and latency of a service; may be read while a frame runs.
+     */
+    [[ION_NODISCARD("Use the stats")]]
+    virtual service_stats stats(service_id id) const noexcept = 0;
+
+    /**
+     * @brief The phase a service runs in.
+     */
+    [[ION_NODISCARD("Use the phase")]]
+    virtual std::size_t phase_of(service_id id) const noexcept = 0;
+
+    /**
+     * @brief Frames run so far.
+     */
+    [[ION_NODISCARD("Use the frame count")]]
+    virtual uint64_t frames() const noexcept = 0;
+};
+
+/**
+ * @brief Creates a service host.
+ * @param options Executor, clock, metrics and frame pacing.
+ * @return Unique pointer to service_host_base or error (InvalidArgument
+ *         for a frame interval or budget without a clock).
+ */
+[[ION_NODISCARD("Check for error or valid service host")]]
+ION_CORE_API std::expected<std::unique_ptr<service_host_base>, std::error_code>
+make_service_host(service_host_options options = {});
+
+} // namespace ion::core
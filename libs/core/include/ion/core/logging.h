@@ -0,0 +1,6 @@
+#pragma once
+
+#include <ion/core/types.h>
+
+#include "logging/logger.h"
+#include "logging/async_logger.h"
\ No newline at end of file
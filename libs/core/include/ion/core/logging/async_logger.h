@@ -0,0 +1,111 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include <ion/core/thread/executor.h>
+#include <ion/core/time/clock.h>
+
+#include "logger.h"
+
+namespace ion::core {
+
+/**
+ * @brief One formatted log line handed to a log_writer_base.
+ */
+struct ION_CORE_API log_entry {
+    log_level level;
+    uint64_t timestamp_ns;     ///< From the logger's clock; 0 without one.
+    std::string_view message;  ///< Valid for the duration of the write() call.
+};
+
+/**
+ * @brief Destination for the lines an asynchronous logger formats.
+ */
+class ION_CORE_API log_writer_base {
+public:
+    virtual ~log_writer_base() = default;
+
+    /**
+     * @brief Writes a batch of entries, oldest first per logging thread.
+     *        Called by one draining thread at a time.
+     */
+    virtual void write(std::span<const log_entry> batch) = 0;
+};
+
+/**
+ * @brief Creates a writer that prints each batch to stderr with one write.
+ * @return Unique pointer to log_writer_base or error.
+ */
+[[ION_NODISCARD("Check for error or valid log writer")]]
+ION_CORE_API std::expected<std::unique_ptr<log_writer_base>, std::error_code>
+make_stderr_log_writer();
+
+/**
+ * @brief Options for make_async_logger().
+ */
+struct ION_CORE_API async_logger_options {
+    log_level level = log_level::info;     ///< Least severe level that is recorded.
+    log_writer_base* writer = nullptr;     ///< Where lines go; required, must outlive the logger.
+    executor_base* executor = nullptr;     ///< Runs the drain; without one, call flush().
+    clock_base const* clock = nullptr;     ///< Timestamps records when set; must outlive the logger.
+    uint32_t shard_count = 0;              ///< Record rings; 0 means one per available CPU, up to 16.
+    uint32_t drain_threshold = 64;         ///< Records queued in a ring before a drain is scheduled.
+};
+
+/**
+ * @brief A logger that formats and writes on a drain thread, not the caller's.
+ *
+ * log() checks the level with one relaxed atomic load, then copies the
+ * arguments unformatted into a lock-free ring and returns. Threads are
+ * spread over `shard_count` rings and each thread always uses the same
+ * one, so records from one thread stay in order. A drain formats the
+ * records of every ring in batches and passes them to the writer.
+ *
+ * With an executor, a drain is scheduled on it once a ring holds
+ * `drain_threshold` records, or at once for warnings and more severe
+ * levels. Anything below the threshold waits for the next drain or
+ * flush(); a service would typically flush() from its tick(). When a ring
+ * is full, records are dropped and counted rather than blocking the
+ * caller. A preformatted message too long for a ring slot is copied to
+ * the heap and written whole. Destroying the logger waits for a scheduled drain and then
+ * flushes.
+ */
+class ION_CORE_API async_logger_base : public logger_base {
+public:
+    virtual ~async_logger_base() = default;
+
+    /**
+     * @brief Sets the least severe level that is recorded.
+     */
+    virtual void set_level(log_level level) noexcept = 0;
+
+    /**
+     * @brief Formats and writes every record logged so far on the calling thread.
+     */
+    virtual void flush() = 0;
+
+    /**
+     * @brief Records dropped because their ring was full, or because a
+     *        message too long for a ring slot could not be copied to the heap.
+     */
+    [[ION_NODISCARD("Use the dropped count")]]
+    virtual uint64_t dropped() const noexcept = 0;
+};
+
+/**
+ * @brief Creates an asynchronous logger.
+ * @param options Level, writer, drain executor and ring layout.
+ * @return Unique pointer to async_logger_base or error (InvalidArgument without a writer).
+ */
+[[ION_NODISCARD("Check for error or valid logger")]]
+ION_CORE_API std::expected<std::unique_ptr<async_logger_base>, std::error_code>
+make_async_logger(async_logger_options options);
+
+} // namespace ion::core
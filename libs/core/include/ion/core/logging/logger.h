@@ -1,7 +1,15 @@
 #pragma once
 
-#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <format>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 
 #include <ion/core/export.h>
 
@@ -16,20 +24,149 @@ enum class ION_CORE_API log_level {
     critical // about to crash / abort
 };
 
+namespace detail {
+
+/**
+ * @brief Formats captured arguments; see log_args.
+ */
+using log_format_fn = void (*)(std::string_view fmt, std::span<const std::byte> args, std::string& out);
+
+/**
+ * @brief The arguments of one log() call, captured but not yet formatted.
+ *
+ * `fmt` is the compile-time format string and outlives the record. `bytes`
+ * holds the arguments by value, strings copied inline, and is only valid
+ * for the duration of the logger_base::log_captured() call.
+ */
+struct log_args {
+    log_format_fn format;
+    std::string_view fmt;
+    std::span<const std::byte> bytes;
+};
+
+// Largest argument block log() captures on the stack; bigger calls format eagerly
+inline constexpr std::size_t k_log_args_capacity = 384;
+
+template <typename T>
+inline constexpr bool k_log_string_like =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, char const*> || std::is_same_v<T, char*> ||
+    (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>);
+
+/**
+ * @brief Argument types log() can capture without formatting: scalars are
+ *        copied by value, strings by content.
+ */
+template <typename T>
+concept log_capturable = std::is_arithmetic_v<T> || std::is_enum_v<T> || k_log_string_like<T> ||
+                         (std::is_pointer_v<T> && !k_log_string_like<T>) || std::is_null_pointer_v<T>;
+
+template <typename T>
+std::string_view log_text(T const& value) noexcept {
+    if constexpr (std::is_array_v<T>) return std::string_view(value, std::char_traits<char>::length(value));
+    else return std::string_view(value);
+}
+
+template <typename T>
+std::size_t log_arg_size(T const& value) noexcept {
+    if constexpr (k_log_string_like<T>) return sizeof(std::size_t) + log_text(value).size();
+    else return sizeof(T);
+}
+
+template <typename T>
+std::byte* log_arg_encode(std::byte* out, T const& value) noexcept {
+    if constexpr (k_log_string_like<T>) {
+        std::string_view text = log_text(value);
+        std::size_t size = text.size();
+        std::memcpy(out, &size, sizeof(size));
+        if (size) std::memcpy(out + sizeof(size), text.data(), size);
+        return out + sizeof(size) + size;
+    } else {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+}
+
+template <typename T>
+using log_decoded_t = std::conditional_t<k_log_string_like<T>, std::string_view, T>;
+
+template <typename T>
+log_decoded_t<T> log_arg_decode(std::byte const*& in) noexcept {
+    if constexpr (k_log_string_like<T>) {
+        std::size_t size = 0;
+        std::memcpy(&size, in, sizeof(size));
+        std::string_view text(reinterpret_cast<char const*>(in + sizeof(size)), size);
+        in += sizeof(size) + size;
+        return text;
+    } else {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    }
+}
+
+template <typename... Ts>
+void log_format_captured(std::string_view fmt, std::span<const std::byte> args, std::string& out) {
+    std::byte const* in = args.data();
+    // Braced initialisation decodes left to right
+    std::tuple<log_decoded_t<Ts>...> values{log_arg_decode<Ts>(in)...};
+    (void)in;
+    std::apply([&](auto const&... v) { std::vformat_to(std::back_inserter(out), fmt, std::make_format_args(v...)); },
+               values);
+}
+
+} // namespace detail
+
 class ION_CORE_API logger_base {
 public:
     virtual ~logger_base() = default;
-    
+
     virtual void log(log_level level, std::string_view msg) = 0;
 
+    /**
+     * @brief Logs a std::format message if `level` is enabled.
+     *
+     * The level is checked before anything else. When every argument is a
+     * scalar or a string, the arguments are captured unformatted and handed
+     * to log_captured(), so a logger that formats on another thread keeps
+     * the formatting off this one.
+     */
     template <typename... Args>
-    inline void log(log_level level, std::string_view fmt, Args&&... args) {
-        log(level,
-            std::vformat(fmt, std::make_format_args(std::forward<Args>(args)...)));
+    inline void log(log_level level, std::format_string<Args...> fmt, Args&&... args) {
+        if (!is_enabled(level)) {
+            return;
+        }
+        if constexpr ((detail::log_capturable<std::remove_cvref_t<Args>> && ...)) {
+            std::size_t size = (std::size_t{0} + ... + detail::log_arg_size(args));
+            if (size <= detail::k_log_args_capacity) {
+                std::byte bytes[detail::k_log_args_capacity];
+                std::byte* out = bytes;
+                ((out = detail::log_arg_encode(out, args)), ...);
+                (void)out;
+                log_captured(level, {&detail::log_format_captured<std::remove_cvref_t<Args>...>, fmt.get(),
+                                     std::span<const std::byte>(bytes, size)});
+                return;
+            }
+        }
+        log(level, std::string_view(std::vformat(fmt.get(), std::make_format_args(args...))));
     }
-    
+
     [[ION_NODISCARD("You should be actually checking this if you're bothering to call it.")]]
     virtual bool is_enabled(log_level level) const = 0;
+
+protected:
+    /**
+     * @brief Receives a log() call whose arguments were captured unformatted.
+     *
+     * The default formats on the calling thread and forwards to
+     * log(level, msg); asynchronous loggers copy the capture instead.
+     */
+    virtual void log_captured(log_level level, detail::log_args const& args) {
+        std::string msg;
+        args.format(args.fmt, args.bytes, msg);
+        log(level, std::string_view(msg));
+    }
 };
 
 } // namespace ion::core
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <ion/core/types.h>
+
+#include "metrics/metrics.h"
+#include "metrics/metrics_registry.h"
\ No newline at end of file
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "metrics.h"
+
+namespace ion::core {
+
+/**
+ * @brief Handle to a counter registered with a metrics_registry_base.
+ */
+struct ION_CORE_API counter_id {
+    uint32_t index = 0;
+};
+
+/**
+ * @brief Handle to a gauge registered with a metrics_registry_base.
+ */
+struct ION_CORE_API gauge_id {
+    uint32_t index = 0;
+};
+
+/**
+ * @brief Handle to a histogram registered with a metrics_registry_base.
+ */
+struct ION_CORE_API histogram_id {
+    uint32_t index = 0;
+};
+
+// Histogram buckets split every power of two into 2^k_histogram_sub_bucket_bits
+// linear steps, so a bucket is at most 12.5% wide relative to its values
+inline constexpr uint32_t k_histogram_sub_bucket_bits = 3;
+inline constexpr uint32_t k_histogram_sub_buckets = 1u << k_histogram_sub_bucket_bits;
+// Values from 2^k_histogram_max_exponent up (about 18 minutes in ns) share the last bucket
+inline constexpr uint32_t k_histogram_max_exponent = 40;
+inline constexpr std::size_t k_histogram_bucket_count =
+    (k_histogram_max_exponent - k_histogram_sub_bucket_bits + 1) * k_histogram_sub_buckets;
+
+/**
+ * @brief The histogram bucket that holds `value`.
+ */
+constexpr std::size_t histogram_bucket_of(uint64_t value) noexcept {
+    if (value < k_histogram_sub_buckets) return static_cast<std::size_t>(value);
+    uint32_t exponent = static_cast<uint32_t>(std::bit_width(value)) - 1;
+    if (exponent >= k_histogram_max_exponent) return k_histogram_bucket_count - 1;
+    uint32_t shift = exponent - k_histogram_sub_bucket_bits;
+    return (shift + 1) * k_histogram_sub_buckets + static_cast<std::size_t>((value >> shift) & (k_histogram_sub_buckets - 1));
+}
+
+/**
+ * @brief The smallest value that falls into bucket `index`.
+ */
+constexpr uint64_t histogram_bucket_lower(std::size_t index) noexcept {
+    if (index < k_histogram_sub_buckets) return index;
+    std::size_t shift = index / k_histogram_sub_buckets - 1;
+    return (uint64_t{k_histogram_sub_buckets} | (index & (k_histogram_sub_buckets - 1))) << shift;
+}
+
+/**
+ * @brief Options for make_metrics_registry().
+ */
+struct ION_CORE_API metrics_registry_options {
+    uint32_t max_counters = 256;   ///< Counters that can be registered.
+    uint32_t max_gauges = 64;      ///< Gauges that can be registered.
+    uint32_t max_histograms = 32;  ///< Histograms that can be registered.
+    uint32_t shard_count = 0;      ///< Counter shards; 0 means one per available CPU, up to 16.
+};
+
+struct ION_CORE_API counter_sample {
+    std::string name;
+    uint64_t value;
+};
+
+struct ION_CORE_API gauge_sample {
+    std::string name;
+    double value;
+};
+
+struct ION_CORE_API histogram_sample {
+    std::string name;
+    uint64_t count;                 ///< Samples recorded.
+    uint64_t sum;                   ///< Sum of the recorded values.
+    std::vector<uint64_t> buckets;  ///< k_histogram_bucket_count sample counts; see histogram_bucket_of().
+
+    /**
+     * @brief Lower bound of the bucket that holds the `q` quantile (0..1), or 0 without samples.
+     */
+    [[ION_NODISCARD("Use the quantile")]]
+    uint64_t quantile(double q) const noexcept {
+        if (count == 0) return 0;
+        double rank = q <= 0.0 ? 1.0 : q >= 1.0 ? static_cast<double>(count) : q * static_cast<double>(count);
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (static_cast<double>(seen) >= rank) return histogram_bucket_lower(i);
+        }
+        return histogram_bucket_lower(buckets.size() - 1);
+    }
+};
+
+/**
+ * @brief Every registered metric, summed over the shards, in registration order.
+ */
+struct ION_CORE_API metrics_snapshot {
+    std::vector<counter_sample> counters;
+    std::vector<gauge_sample> gauges;
+    std::vector<histogram_sample> histograms;
+};
+
+/**
+ * @brief A metrics_base whose hot path works on pre-registered handles.
+ *
+ * register_counter(), register_gauge() and register_histogram() turn a name
+ * into a handle once, typically when a service starts. add(), set() and
+ * record() with a handle then take no lock and allocate nothing: each
+ * thread writes relaxed atomics in its own cache-line aligned shard, and
+ * scrape() sums the shards. Histograms count samples in log-linear
+ * buckets (see histogram_bucket_of()) rather than storing them.
+ *
+ * The name-based metrics_base calls still work. They look the name up, and
+ * register it on first use, under a lock, so they suit cold paths only.
+ */
+class ION_CORE_API metrics_registry_base : public metrics_base {
+public:
+    virtual ~metrics_registry_base() = default;
+
+    /**
+     * @brief Registers a counter, or returns the handle already registered under `name`.
+     * @return Handle or error (IndexOutOfRange once max_counters are registered).
+     */
+    [[ION_NODISCARD("Keep the counter handle")]]
+    virtual std::expected<counter_id, std::error_code> register_counter(std::string_view name) = 0;
+
+    /**
+     * @brief Registers a gauge, or returns the handle already registered under `name`.
+     * @return Handle or error (IndexOutOfRange once max_gauges are registered).
+     */
+    [[ION_NODISCARD("Keep the gauge handle")]]
+    virtual std::expected<gauge_id, std::error_code> register_gauge(std::string_view name) = 0;
+
+    /**
+     * @brief Registers a histogram, or returns the handle already registered under `name`.
+     * @return Handle or error (IndexOutOfRange once max_histograms are registered).
+     */
+    [[ION_NODISCARD("Keep the histogram handle")]]
+    virtual std::expected<histogram_id, std::error_code> register_histogram(std::string_view name) = 0;
+
+    /**
+     * @brief Adds `value` to a counter.
+     */
+    virtual void add(counter_id id, uint64_t value = 1) noexcept = 0;
+
+    /**
+     * @brief Sets a gauge; the last write wins.
+     */
+    virtual void set(gauge_id id, double value) noexcept = 0;
+
+    /**
+     * @brief Counts one sample, e.g. a duration in nanoseconds, in a histogram.
+     */
+    virtual void record(histogram_id id, uint64_t value) noexcept = 0;
+
+    /**
+     * @brief Sums every shard into a snapshot. Concurrent updates may or may not be included.
+     */
+    [[ION_NODISCARD("Use the snapshot")]]
+    virtual std::expected<metrics_snapshot, std::error_code> scrape() const = 0;
+};
+
+/**
+ * @brief Creates a sharded metrics registry.
+ * @param options Capacity per metric kind and shard count.
+ * @return Unique pointer to metrics_registry_base or error.
+ */
+[[ION_NODISCARD("Check for error or valid metrics registry")]]
+ION_CORE_API std::expected<std::unique_ptr<metrics_registry_base>, std::error_code>
+make_metrics_registry(metrics_registry_options options = {});
+
+} // namespace ion::core
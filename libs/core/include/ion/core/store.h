@@ -2,6 +2,11 @@
 
 #include <ion/core/types.h>
 
+#include "store/store_entry.h"
 #include "store/store_handle.h"
+#include "store/store_path.h"
+#include "store/store_value.h"
+#include "store/read_transaction_base.h"
 #include "store/transaction_base.h"
-#include "store/store_base.h"
\ No newline at end of file
+#include "store/store_base.h"
+#include "store/store_binding.h"
\ No newline at end of file
@@ -0,0 +1,585 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <array>
+#include <expected>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <charconv>
+#include <type_traits>
+
+#include "store_entry.h"
+#include "store_handle.h"
+#include "store_key.h"
+#include "store_path.h"
+#include "store_value.h"
+
+
+/**
+ * @brief Read-only view of one committed version of a storage tree.
+ *
+ * Obtained from store_base::begin_read_transaction(). The view is pinned to the
+ * version that was current when it was opened; later commits never change what
+ * it sees, and the version stays alive until the last view on it is destroyed.
+ * There is nothing to commit or roll back.
+ *
+ * transaction_base extends this interface with the write operations, so the
+ * query helpers below work the same on both.
+ *
+ * @note Thread-safety: opening a read view does not take the store's writer lock,
+ * so any number of threads may open and use their own views concurrently. A single
+ * view object is not thread-safe; give each thread its own.
+ *
+ * @note Path rules: Keys in path-strings must match `[A-Za-z_][A-Za-z0-9_]*`. No quoting/escaping is supported; invalid segments yield PathSyntax.
+ */
+namespace ion::core {
+
+class store_cursor;
+
+class ION_CORE_API read_transaction_base {
+public:
+    /**
+     * @brief Destructor. Releases the pinned version.
+     */
+    virtual ~read_transaction_base() noexcept = default;
+
+    /**
+     * @brief Returns the root handle of the storage tree.
+     * @return store_handle on success, or an error (e.g. IoFailure) on failure.
+     */
+    [[ION_NODISCARD("Check for error or valid root handle")]]
+    virtual std::expected<store_handle, std::error_code> root() const = 0;
+
+    /**
+     * @brief Retrieves a boolean value from the given handle.
+     * @param h The handle to query.
+     * @return The boolean value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid bool value")]]
+    std::expected<bool, std::error_code>
+    get_bool   (store_handle h) const { return to_error_code(try_get_bool(h)); }
+
+    /**
+     * @brief Retrieves an integer value from the given handle.
+     * @param h The handle to query.
+     * @return The integer value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid int value")]]
+    std::expected<int64_t, std::error_code>
+    get_int    (store_handle h) const { return to_error_code(try_get_int(h)); }
+
+    /**
+     * @brief Retrieves a double value from the given handle.
+     * @param h The handle to query.
+     * @return The double value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid double value")]]
+    std::expected<double, std::error_code>
+    get_double (store_handle h) const { return to_error_code(try_get_double(h)); }
+
+    /**
+     * @brief Retrieves a string value from the given handle.
+     * @param h The handle to query.
+     * @return The string value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid string value")]]
+    std::expected<std::string, std::error_code>
+    get_string (store_handle h) const { return to_error_code(try_get_string(h)); }
+
+    /**
+     * @brief Retrieves a string value from the given handle without copying it.
+     *
+     * The view points into the tree the transaction reads. It stays valid
+     * until the transaction is destroyed, or until this transaction writes or
+     * removes the value or one of its parents.
+     * @param h The handle to query.
+     * @return A view of the string value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid string value")]]
+    std::expected<std::string_view, std::error_code>
+    get_string_view (store_handle h) const { return to_error_code(try_get_string_view(h)); }
+
+    /**
+     * @brief get_bool() with a one-byte core_errc error, for tight loops.
+     *
+     * The try_get_*() calls return the same value or error as their get_*()
+     * counterparts, which wrap them, but the result carries no
+     * std::error_code: no category pointer to pass back or compare. Use
+     * to_error_code() where a failure has to leave as a std::error_code.
+     * @param h The handle to query.
+     * @return The boolean value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid bool value")]]
+    virtual std::expected<bool, core_errc>
+    try_get_bool   (store_handle h) const = 0;
+
+    /**
+     * @brief get_int() with a core_errc error; see try_get_bool().
+     * @param h The handle to query.
+     * @return The integer value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid int value")]]
+    virtual std::expected<int64_t, core_errc>
+    try_get_int    (store_handle h) const = 0;
+
+    /**
+     * @brief get_double() with a core_errc error; see try_get_bool().
+     * @param h The handle to query.
+     * @return The double value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid double value")]]
+    virtual std::expected<double, core_errc>
+    try_get_double (store_handle h) const = 0;
+
+    /**
+     * @brief get_string() with a core_errc error; see try_get_bool().
+     * @param h The handle to query.
+     * @return The string value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid string value")]]
+    virtual std::expected<std::string, core_errc>
+    try_get_string (store_handle h) const = 0;
+
+    /**
+     * @brief get_string_view() with a core_errc error; see try_get_bool().
+     * @param h The handle to query.
+     * @return A view of the string value or an error.
+     */
+    [[ION_NODISCARD("Check for error or valid string value")]]
+    virtual std::expected<std::string_view, core_errc>
+    try_get_string_view (store_handle h) const = 0;
+
+    /**
+     * @brief Checks if a child with the given key exists under the parent.
+     * @param parent The parent handle.
+     * @param key The key to check.
+     * @return True if exists, false otherwise, or error.
+     */
+    [[ION_NODISCARD("Check for error or existence result")]]
+    virtual std::expected<bool, std::error_code>
+    has           (store_handle parent, std::string_view key) const = 0;
+
+    /**
+     * @brief Checks if an element exists at the given index in the parent array.
+     * @param parent The parent array handle.
+     * @param idx The index to check.
+     * @return True if exists, false otherwise, or error.
+     */
+    [[ION_NODISCARD("Check for error or existence result")]]
+    virtual std::expected<bool, std::error_code>
+    has_element   (store_handle parent, size_t idx) const = 0;
+
+    /**
+     * @brief Retrieves a child handle by key from the given parent.
+     * @param parent The parent handle.
+     * @param key The key to retrieve.
+     * @return The child handle or error.
+     */
+    [[ION_NODISCARD("Check for error or valid child handle")]]
+    virtual std::expected<store_handle, std::error_code>
+    child   (store_handle parent, std::string_view key) const = 0;
+
+    /**
+     * @brief Retrieves an element handle by index from the given parent array.
+     * @param parent The parent array handle.
+     * @param idx The index to retrieve.
+     * @return The element handle or error.
+     */
+    [[ION_NODISCARD("Check for error or valid element handle")]]
+    virtual std::expected<store_handle, std::error_code>
+    element (store_handle parent, size_t idx) const = 0;
+
+    /**
+     * @brief Returns the kind of node behind a handle.
+     * @param h The handle to query.
+     * @return The node type or error.
+     */
+    [[ION_NODISCARD("Check for error or valid node type")]]
+    virtual std::expected<store_node_type, std::error_code>
+    type    (store_handle h) const = 0;
+
+    /**
+     * @brief Returns the number of children of an object or array.
+     * @param h The object or array handle.
+     * @return The child count, or TypeMismatch for a scalar.
+     */
+    [[ION_NODISCARD("Check for error or valid size")]]
+    virtual std::expected<size_t, std::error_code>
+    size    (store_handle h) const = 0;
+
+    /**
+     * @brief Reads consecutive children of an object or array by position.
+     *
+     * Object children come in key order. No handles are allocated; see
+     * store_entry for how long the entries stay valid.
+     * @param parent The object or array handle.
+     * @param first Position of the first child to read.
+     * @param out Receives up to `out.size()` entries.
+     * @return The number of entries written; fewer than `out.size()` once the children run out.
+     */
+    [[ION_NODISCARD("Check for error or entry count")]]
+    virtual std::expected<size_t, std::error_code>
+    read_entries (store_handle parent, size_t first, std::span<store_entry> out) const = 0;
+
+    /**
+     * @brief Reads the children of an object in key order, starting at a key.
+     *
+     * The key need not exist; reading starts at the first key that sorts
+     * at or after it (strictly after it if `after` is set), so a caller can
+     * resume from the last key it saw even if the object changed meanwhile.
+     * @param parent The object handle.
+     * @param from Key to start at.
+     * @param after Skip a child named exactly `from`.
+     * @param out Receives up to `out.size()` entries.
+     * @return The number of entries written; fewer than `out.size()` once the children run out.
+     */
+    [[ION_NODISCARD("Check for error or entry count")]]
+    virtual std::expected<size_t, std::error_code>
+    scan_entries (store_handle parent, std::string_view from, bool after, std::span<store_entry> out) const = 0;
+
+    /**
+     * @brief Iterates the children of an object in key order.
+     * @param parent The object handle.
+     * @return A cursor over the children, or TypeMismatch if `parent` is not an object.
+     */
+    [[ION_NODISCARD("Check for error or valid cursor")]]
+    std::expected<store_cursor, std::error_code> children(store_handle parent) const;
+
+    /**
+     * @brief Iterates the elements of an array in order.
+     * @param parent The array handle.
+     * @return A cursor over the elements, or TypeMismatch if `parent` is not an array.
+     */
+    [[ION_NODISCARD("Check for error or valid cursor")]]
+    std::expected<store_cursor, std::error_code> elements(store_handle parent) const;
+
+    /**
+     * @brief Iterates the children of an object whose keys start with a prefix.
+     *
+     * Binary-searches to the first matching key and stops at the first key
+     * past the prefix, so the cost is the matches, not the object size.
+     * @param parent The object handle.
+     * @param prefix Key prefix; empty matches every child.
+     * @return A cursor over the matches, or TypeMismatch if `parent` is not an object.
+     */
+    [[ION_NODISCARD("Check for error or valid cursor")]]
+    std::expected<store_cursor, std::error_code> scan(store_handle parent, std::string_view prefix) const;
+
+    /**
+     * @brief Navigates from a base handle using a dot/bracket path.
+     *
+     * Supports dot notation for objects and bracket notation for arrays.
+     * @param base The starting handle.
+     * @param path The navigation path (e.g. "foo.bar[2].baz").
+     * @return The resulting handle or error.
+     */
+    [[ION_NODISCARD("Check for error or valid navigation result")]]
+    std::expected<store_handle, std::error_code>
+    navigate(store_handle base, std::string_view path) const {
+        if (!base.valid()) return std::unexpected(make_error_code(core_errc::invalid_handle));
+        store_handle cur = base;
+        size_t i = 0, n = path.size();
+        while (i < n) {
+            if (path[i] == '.') { ++i; continue; }
+            if (path[i] == '[') {
+                ++i; size_t start = i;
+                while (i < n && path[i] >= '0' && path[i] <= '9') ++i;
+                if (i >= n || path[i] != ']') return std::unexpected(make_error_code(core_errc::path_syntax));
+                uint64_t idx = 0;
+                auto [ptr, ec] = std::from_chars(path.data()+start, path.data()+i, idx);
+                if (ec == std::errc::invalid_argument)   return std::unexpected(make_error_code(core_errc::path_syntax));
+                if (ec == std::errc::result_out_of_range) return std::unexpected(make_error_code(core_errc::index_out_of_range));
+                auto next = element(cur, idx);
+                if (!next) return next;
+                cur = *next;
+                ++i;
+            } else {
+                size_t j = i + detail::find_delimiter(path.substr(i));
+                auto key = path.substr(i, j - i);
+                auto next = child(cur, key);
+                if (!next) return next;
+                cur = *next;
+                i = j;
+            }
+            if (!cur.valid()) return std::unexpected(make_error_code(core_errc::key_not_found));
+        }
+        return cur;
+    }
+
+    /**
+     * @brief Retrieves a value of type T from a path under a base handle.
+     *
+     * Supported types: bool, int64_t, double, std::string.
+     * @tparam T The value type to retrieve.
+     * @param base The starting handle.
+     * @param path The navigation path.
+     * @return The value or error.
+     */
+    template<typename T>
+    [[ION_NODISCARD("Check for error or valid value")]]
+    std::expected<T, std::error_code>
+    get(store_handle base, std::string_view path) const {
+        auto h = navigate(base, path);
+        if (!h) return std::unexpected(h.error());
+        return get<T>(*h);
+    }
+
+    /**
+     * @brief Navigates from a base handle along a compiled path.
+     *
+     * Skips tokenizing; the stores also remember per transaction what each
+     * path resolved to, so repeating a lookup does not walk the tree again.
+     * @param base The starting handle.
+     * @param path The compiled path.
+     * @return The resulting handle or error.
+     */
+    [[ION_NODISCARD("Check for error or valid navigation result")]]
+    virtual std::expected<store_handle, std::error_code>
+    navigate(store_handle base, store_path const& path) const {
+        if (!base.valid()) return std::unexpected(make_error_code(core_errc::invalid_handle));
+        store_handle cur = base;
+        for (auto const& seg : path.segments()) {
+            auto next = seg.is_element ? element(cur, seg.index) : child(cur, seg.key);
+            if (!next) return next;
+            cur = *next;
+            if (!cur.valid()) return std::unexpected(make_error_code(core_errc::key_not_found));
+        }
+        return cur;
+    }
+
+    /**
+     * @brief Retrieves a value of type T along a compiled path.
+     * @tparam T The value type to retrieve.
+     * @param base The starting handle.
+     * @param path The compiled path.
+     * @return The value or error.
+     */
+    template<typename T>
+    [[ION_NODISCARD("Check for error or valid value")]]
+    std::expected<T, std::error_code>
+    get(store_handle base, store_path const& path) const {
+        auto h = navigate(base, path);
+        if (!h) return std::unexpected(h.error());
+        return get<T>(*h);
+    }
+
+    /**
+     * @brief Retrieves the value at a handle as type T.
+     *
+     * Supported types: bool, int64_t, double, std::string, std::string_view
+     * (valid as for get_string_view()).
+     * @tparam T The value type to retrieve.
+     * @param h The handle to query.
+     * @return The value or error.
+     */
+    template<typename T>
+    [[ION_NODISCARD("Check for error or valid value")]]
+    std::expected<T, std::error_code>
+    get(store_handle h) const {
+        if constexpr (std::is_same_v<T,bool>)       return get_bool(h);
+        else if constexpr (std::is_same_v<T,int64_t>) return get_int(h);
+        else if constexpr (std::is_same_v<T,double>)  return get_double(h);
+        else if constexpr (std::is_same_v<T,std::string>) return get_string(h);
+        else if constexpr (std::is_same_v<T,std::string_view>) return get_string_view(h);
+        else static_assert(sizeof(T)==0, "Unsupported get<> type");
+    }
+
+    /**
+     * @brief Retrieves the value at a handle as the given type.
+     * @param h The handle to query.
+     * @param type The type to read the value as.
+     * @return The value or error.
+     */
+    [[ION_NODISCARD("Check for error or valid value")]]
+    std::expected<store_value, std::error_code>
+    get_value(store_handle h, store_value_type type) const {
+        auto wrap = [](auto result) -> std::expected<store_value, std::error_code> {
+            if (!result) return std::unexpected(make_error_code(result.error()));
+            return store_value(std::move(*result));
+        };
+        switch (type) {
+            case store_value_type::boolean:  return wrap(try_get_bool(h));
+            case store_value_type::integer:  return wrap(try_get_int(h));
+            case store_value_type::floating: return wrap(try_get_double(h));
+            case store_value_type::string:   return wrap(try_get_string(h));
+        }
+        return std::unexpected(make_error_code(core_errc::invalid_argument));
+    }
+
+    /**
+     * @brief Reads a batch of values under one base handle.
+     *
+     * Equivalent to one get<T>() per query, but backends resolve path prefixes
+     * shared by consecutive queries once and avoid per-segment dispatch, so
+     * sorting the queries by path (as a struct's fields naturally are) pays off.
+     * A failing query only fails its own result.
+     * @param base The starting handle.
+     * @param queries Paths and requested types.
+     * @param results Receives one result per query; must be at least as long as `queries`.
+     * @return Success, or InvalidArgument if `results` is too short.
+     */
+    [[ION_NODISCARD("Check for error on get_many")]]
+    virtual std::expected<void, std::error_code>
+    get_many(store_handle base, std::span<store_query const> queries,
+             std::span<std::expected<store_value, std::error_code>> results) const {
+        if (results.size() < queries.size()) return std::unexpected(make_error_code(core_errc::invalid_argument));
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto h = navigate(base, queries[i].path);
+            if (h) results[i] = get_value(*h, queries[i].type);
+            else   results[i] = std::unexpected(h.error());
+        }
+        return {};
+    }
+
+    /**
+     * @brief Reads a batch of string values under one base handle without copying them.
+     *
+     * As get_many() with every query asking for a string, but each result is
+     * a view as returned by get_string_view(), so the batch allocates nothing.
+     * A failing path only fails its own result.
+     * @param base The starting handle.
+     * @param paths Dot/bracket paths under `base`.
+     * @param results Receives one view per path; must be at least as long as `paths`.
+     * @return Success, or InvalidArgument if `results` is too short.
+     */
+    [[ION_NODISCARD("Check for error on get_string_views")]]
+    virtual std::expected<void, std::error_code>
+    get_string_views(store_handle base, std::span<std::string_view const> paths,
+                     std::span<std::expected<std::string_view, std::error_code>> results) const {
+        if (results.size() < paths.size()) return std::unexpected(make_error_code(core_errc::invalid_argument));
+        for (size_t i = 0; i < paths.size(); ++i) {
+            auto h = navigate(base, paths[i]);
+            if (h) results[i] = get_string_view(*h);
+            else   results[i] = std::unexpected(h.error());
+        }
+        return {};
+    }
+};
+
+/**
+ * @brief Input range over the children of one object or array.
+ *
+ * Returned by read_transaction_base::children(), elements() and scan().
+ * Entries are fetched k_batch at a time through read_entries() or
+ * scan_entries(), straight from the backend's nodes, so iterating allocates
+ * neither handles nor strings. A scan resumes each batch after the last key
+ * it returned rather than at a position. Iterate a cursor once, and do not
+ * move it after calling begin().
+ *
+ * Do not write under the parent while iterating: entries point into nodes a
+ * write may move. If a fetch fails, iteration ends early and error() says why.
+ */
+class store_cursor {
+public:
+    static constexpr size_t k_batch = 16;
+
+    class iterator {
+    public:
+        using value_type = store_entry;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        store_entry const& operator*() const noexcept { return cursor_->batch_[cursor_->pos_]; }
+        store_entry const* operator->() const noexcept { return &cursor_->batch_[cursor_->pos_]; }
+        iterator& operator++() { cursor_->advance(); return *this; }
+        void operator++(int) { cursor_->advance(); }
+        bool operator==(std::default_sentinel_t) const noexcept { return cursor_->pos_ == cursor_->count_; }
+
+    private:
+        friend class store_cursor;
+        explicit iterator(store_cursor* cursor) noexcept : cursor_(cursor) {}
+
+        store_cursor* cursor_ = nullptr;
+    };
+
+    iterator begin() {
+        if (!started_) {
+            started_ = true;
+            fetch();
+        }
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+    /**
+     * @brief Why iteration ended early; empty if it ran to the end.
+     */
+    [[ION_NODISCARD("Use the error")]]
+    std::error_code error() const noexcept { return error_; }
+
+private:
+    friend class read_transaction_base;
+
+    store_cursor(read_transaction_base const& txn, store_handle parent, bool by_key, std::string_view prefix)
+        : txn_(&txn), parent_(parent), prefix_(prefix), by_key_(by_key) {}
+
+    void advance() {
+        if (++pos_ == count_ && !exhausted_) fetch();
+    }
+
+    void fetch() {
+        pos_ = count_ = 0;
+        auto got = !by_key_          ? txn_->read_entries(parent_, next_, batch_)
+                 : resume_.empty()   ? txn_->scan_entries(parent_, prefix_, false, batch_)
+                                     : txn_->scan_entries(parent_, resume_, true, batch_);
+        if (!got) {
+            error_ = got.error();
+            exhausted_ = true;
+            return;
+        }
+        count_ = *got;
+        exhausted_ = count_ < k_batch;
+        if (by_key_) {
+            // Keys are sorted, so the matches end at the first key past the prefix
+            size_t matched = 0;
+            while (matched < count_ && batch_[matched].key.starts_with(prefix_)) ++matched;
+            if (matched < count_) {
+                count_ = matched;
+                exhausted_ = true;
+            }
+            if (count_ > 0) resume_.assign(batch_[count_ - 1].key);
+        }
+        next_ += count_;
+    }
+
+    read_transaction_base const* txn_;
+    store_handle parent_;
+    std::string prefix_;
+    std::string resume_;         // Last key returned by a scan
+    size_t next_ = 0;            // Position of the next child to fetch
+    size_t pos_ = 0;
+    size_t count_ = 0;
+    bool by_key_;
+    bool started_ = false;
+    bool exhausted_ = false;
+    std::error_code error_;
+    std::array<store_entry, k_batch> batch_{};
+};
+
+inline std::expected<store_cursor, std::error_code> read_transaction_base::children(store_handle parent) const {
+    auto t = type(parent);
+    if (!t) return std::unexpected(t.error());
+    if (*t != store_node_type::object) return std::unexpected(make_error_code(core_errc::type_mismatch));
+    return store_cursor(*this, parent, false, {});
+}
+
+inline std::expected<store_cursor, std::error_code> read_transaction_base::elements(store_handle parent) const {
+    auto t = type(parent);
+    if (!t) return std::unexpected(t.error());
+    if (*t != store_node_type::array) return std::unexpected(make_error_code(core_errc::type_mismatch));
+    return store_cursor(*this, parent, false, {});
+}
+
+inline std::expected<store_cursor, std::error_code> read_transaction_base::scan(store_handle parent, std::string_view prefix) const {
+    auto t = type(parent);
+    if (!t) return std::unexpected(t.error());
+    if (*t != store_node_type::object) return std::unexpected(make_error_code(core_errc::type_mismatch));
+    return store_cursor(*this, parent, true, prefix);
+}
+}
\ No newline at end of file
@@ -2,14 +2,53 @@
 
 #include <ion/core/export.h>
 #include <ion/core/error.h>
+#include <ion/core/metrics/metrics_registry.h>
 #include <ion/core/store/store_handle.h>
+#include <ion/core/thread/coroutine.h>
+#include <ion/core/time/clock.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <expected>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
 
 
 namespace ion::core {
 
+/**
+ * @brief Where a store reports what its operations cost.
+ *
+ * The store registers every metric below with the registry when it is
+ * made, and from then on reports through the handles: no name lookups and
+ * no locks on the hot path. A metric the registry has no room left for is
+ * not reported. With `metrics` null (the default) every hook is a single
+ * pointer test. Without a `clock` only counters and gauges are registered.
+ * Both must outlive the store. Reported metrics:
+ *
+ * - histogram `store.open_ns`: the whole open(); file stores add
+ *   `store.open.read_ns`, `store.open.parse_ns` and `store.open.replay_ns`.
+ * - histogram `store.begin_transaction_ns`.
+ * - counters `store.navigate.walks` and `store.navigate.segments` for each
+ *   compiled-path navigate() that walks the tree, `store.navigate.cached`
+ *   for each one answered from the transaction's memo.
+ * - histogram `store.commit_ns`: a commit including its wait for the batch.
+ * - histograms `store.persist.serialize_ns`, `store.persist.write_ns`
+ *   (write, sync and rename of the base file) and `store.persist.journal_ns`;
+ *   counter `store.persist.bytes`.
+ * - gauge `store.transaction_handles`: live handles of the transaction
+ *   committed last.
+ */
+struct ION_CORE_API store_instrumentation {
+    metrics_registry_base* metrics = nullptr;   ///< Receives the samples; null disables instrumentation.
+    clock_base const* clock = nullptr;          ///< Times operations; null reports counts only.
+};
+
 /**
  * @brief Options for file-backed stores (generic).
  *
@@ -17,13 +56,52 @@ namespace ion::core {
  */
 struct ION_CORE_API file_store_options {
     /**
-     * @brief Use memory-mapped writes if true.
+     * @brief Load the base file through a memory mapping.
+     *
+     * Loads parse straight from the mapped file, which is unmapped again
+     * before open() returns, so the store never holds a mapping that another
+     * process could truncate underneath it. Saves are unaffected: the
+     * serialized output is written to a temporary file in one call, synced
+     * and renamed over the original either way.
      */
     bool write_mmap  = false;
     /**
      * @brief Enable journaling for crash safety.
+     *
+     * Commits append only their mutations to `<path>.journal`; the base file is
+     * rewritten when the journal grows past journal_compact_bytes and on close().
      */
     bool use_journal = true;
+    /**
+     * @brief Journal size that triggers compaction into the base file.
+     */
+    uint64_t journal_compact_bytes = 4u << 20;
+    /**
+     * @brief How long the first committer of a batch waits for others to join it.
+     *
+     * Commits that queue up while a batch is being written always go out
+     * together in the next one; a non-zero window additionally holds each
+     * batch open to collect bursts.
+     */
+    std::chrono::microseconds group_commit_window{0};
+    /**
+     * @brief Most commits merged into one write.
+     */
+    size_t group_commit_max_batch = 64;
+    /**
+     * @brief Where journal compaction runs; null compacts inline.
+     *
+     * With an executor (e.g. a thread pool the application owns), the commit
+     * that crosses journal_compact_bytes only queues the base-file rewrite
+     * instead of performing it. The executor must run tasks asynchronously
+     * and outlive the store; destroying a store waits for its queued
+     * compaction, so don't do that from a task of a single-worker executor.
+     */
+    executor_base* compaction_executor = nullptr;
+    /**
+     * @brief Metrics sink and clock for the store's hot paths; detached by default.
+     */
+    store_instrumentation instrumentation;
 };
 
 
@@ -33,9 +111,15 @@ struct ION_CORE_API file_store_options {
  * Controls memory-mapping, journaling, and comment support for JSON backends.
  */
 struct ION_CORE_API json_store_options {
-    bool write_mmap     = false;   ///< Use memory-mapped writes if true.
-    bool use_journal    = true;    ///< Enable journaling for crash safety.
+    bool write_mmap     = false;   ///< Load the file through a memory mapping; ignored with lazy_load.
+    bool use_journal    = true;    ///< Append commits to `<path>.journal` instead of rewriting the file.
     bool allow_comments = false;   ///< Allow comments in JSON files.
+    bool lazy_load      = false;   ///< Build each top-level object or array member on first access; reading or saving one malformed inside fails with ParseError.
+    uint64_t journal_compact_bytes = 4u << 20;  ///< Journal size that triggers a rewrite of the base file.
+    std::chrono::microseconds group_commit_window{0};  ///< How long a commit batch stays open for more commits.
+    size_t group_commit_max_batch = 64;                ///< Most commits merged into one write.
+    executor_base* compaction_executor = nullptr;      ///< Runs journal compaction; null compacts inline.
+    store_instrumentation instrumentation;             ///< Metrics sink and clock; detached by default.
 };
 
 
@@ -45,17 +129,125 @@ struct ION_CORE_API json_store_options {
  * Controls memory-mapping, journaling, key order, and type strictness for TOML backends.
  */
 struct ION_CORE_API toml_store_options {
-    bool write_mmap     = false;   ///< Use memory-mapped writes if true.
-    bool use_journal    = true;    ///< Enable journaling for crash safety.
+    bool write_mmap     = false;   ///< Load the file through a memory mapping.
+    bool use_journal    = true;    ///< Append commits to `<path>.journal` instead of rewriting the file.
     bool preserve_order = false;   ///< Preserve key order in TOML files.
     bool strict_types   = true;    ///< Enforce strict TOML type rules.
+    uint64_t journal_compact_bytes = 4u << 20;  ///< Journal size that triggers a rewrite of the base file.
+    std::chrono::microseconds group_commit_window{0};  ///< How long a commit batch stays open for more commits.
+    size_t group_commit_max_batch = 64;                ///< Most commits merged into one write.
+    executor_base* compaction_executor = nullptr;      ///< Runs journal compaction; null compacts inline.
+    store_instrumentation instrumentation;             ///< Metrics sink and clock; detached by default.
+};
+
+
+/**
+ * @brief Options for binary snapshot stores.
+ *
+ * Controls memory-mapping and journaling for the binary backend. The file is
+ * an offset-addressed snapshot that loads without text parsing, so mapping is
+ * on by default.
+ */
+struct ION_CORE_API binary_store_options {
+    bool write_mmap     = true;    ///< Load the file through a memory mapping.
+    bool use_journal    = true;    ///< Append commits to `<path>.journal` instead of rewriting the file.
+    uint64_t journal_compact_bytes = 4u << 20;  ///< Journal size that triggers a rewrite of the base file.
+    std::chrono::microseconds group_commit_window{0};  ///< How long a commit batch stays open for more commits.
+    size_t group_commit_max_batch = 64;                ///< Most commits merged into one write.
+    executor_base* compaction_executor = nullptr;      ///< Runs journal compaction; null compacts inline.
+    store_instrumentation instrumentation;             ///< Metrics sink and clock; detached by default.
+};
+
+
+/**
+ * @brief On-disk formats understood by convert_store_file().
+ */
+enum class store_format : uint8_t {
+    json,     ///< Text file read by make_json_file_store().
+    toml,     ///< Text file read by make_toml_file_store().
+    binary,   ///< Snapshot file read by make_binary_file_store().
+};
+
+
+/**
+ * @brief What a subscription is told about one commit.
+ */
+struct ION_CORE_API store_change {
+    /**
+     * @brief Increases with every commit that notifies anyone.
+     *
+     * Deliveries through a multi-threaded executor may run out of order or
+     * concurrently; compare sequences to drop stale ones.
+     */
+    uint64_t sequence = 0;
+    /**
+     * @brief Changed paths at, below or above the subscribed path, as dot/bracket text.
+     *
+     * A path above the subscription means that whole subtree was replaced or
+     * removed. Erasing an array element reports the array, since the elements
+     * after it moved.
+     */
+    std::span<std::string const> paths;
+};
+
+/**
+ * @brief Callback a store_base::subscribe() subscription runs on its executor.
+ */
+using store_change_callback = std::function<void(store_change const&)>;
+
+class store_base;
+
+/**
+ * @brief Keeps a store subscription alive; unsubscribes when destroyed.
+ *
+ * Once reset() returns, deliveries still queued on the executor are dropped,
+ * but one that already started may finish afterwards. The store must outlive
+ * its subscriptions.
+ */
+class ION_CORE_API store_subscription {
+public:
+    store_subscription() noexcept = default;
+    store_subscription(store_subscription&& other) noexcept
+        : store_(std::exchange(other.store_, nullptr)), id_(other.id_) {}
+
+    store_subscription& operator=(store_subscription&& other) noexcept {
+        if (this != &other) {
+            reset();
+            store_ = std::exchange(other.store_, nullptr);
+            id_ = other.id_;
+        }
+        return *this;
+    }
+
+    store_subscription(store_subscription const&) = delete;
+    store_subscription& operator=(store_subscription const&) = delete;
+
+    ~store_subscription() { reset(); }
+
+    /**
+     * @brief Unsubscribes now; does nothing if already empty.
+     */
+    void reset() noexcept;
+
+    [[ION_NODISCARD("Check if the subscription is active")]]
+    bool active() const noexcept { return store_ != nullptr; }
+
+private:
+    friend class store_base;
+    store_subscription(store_base* store, uint64_t id) noexcept : store_(store), id_(id) {}
+
+    store_base* store_ = nullptr;
+    uint64_t id_ = 0;
 };
 
 
 /**
  * @brief Abstract interface for a transactional storage backend.
  *
- * @note Thread-safety: neither store_base nor transaction_base are thread-safe. Concurrent access must be synchronized externally.
+ * @note Thread-safety: store members may be called from any number of threads at once. Each transaction object
+ * belongs to one thread. Concurrent commits are grouped into a single durable write and applied in queue order,
+ * each replaying its own mutations on top of the others. Commits are optimistic: one whose reads were invalidated by
+ * an earlier commit fails with Conflict, so writers to disjoint subtrees need no external lock.
  *
  * @note Path rules: Keys in path-strings must match `[A-Za-z_][A-Za-z0-9_]*`. No quoting/escaping is supported; invalid segments yield PathSyntax.
  *
@@ -92,8 +284,80 @@ public:
     [[ION_NODISCARD("Check for error or valid transaction")]]
     virtual std::expected<std::unique_ptr<class transaction_base>, std::error_code>
     begin_transaction() = 0;
+
+    /**
+     * @brief Begins a read-only view of the most recently committed version.
+     *
+     * Does not take the store's writer lock and does not copy data; the view
+     * pins the published version until it is destroyed.
+     * @return Unique pointer to read_transaction_base or error (InvalidState if the store is closed).
+     */
+    [[ION_NODISCARD("Check for error or valid read transaction")]]
+    virtual std::expected<std::unique_ptr<class read_transaction_base>, std::error_code>
+    begin_read_transaction() = 0;
+
+    /**
+     * @brief Runs `callback` on `executor` after each commit that changes `path`.
+     *
+     * A commit notifies a subscription if it changed anything at or below
+     * `path`, or replaced or removed one of its parents. The changed paths
+     * come from the commit's own mutation log, so notifying costs nothing
+     * per unchanged key and nothing at all while there are no subscribers.
+     * Subscriptions survive close() and open().
+     * @param path Dot/bracket path to watch; empty watches the whole tree.
+     * @param executor Runs the callbacks; must outlive the subscription, and
+     *        must run tasks asynchronously if a callback commits to this store.
+     * @param callback Called with the changes relevant to `path`.
+     * @return The subscription, or PathSyntax / IndexOutOfRange for a malformed path.
+     */
+    [[ION_NODISCARD("Keep the subscription alive")]]
+    virtual std::expected<store_subscription, std::error_code>
+    subscribe(std::string_view path, executor_base& executor, store_change_callback callback) = 0;
+
+    /// @name Coroutine variants
+    /// Each runs the blocking call as a task on `io`, so a thread driving a
+    /// coroutine (e.g. a service tick) never waits on disk or on the writer
+    /// lock. The awaiting coroutine resumes on `io`; `co_await schedule_on()`
+    /// to continue elsewhere. The store must outlive the returned task.
+    /// @{
+
+    /**
+     * @brief open() on `io`.
+     */
+    [[ION_NODISCARD("co_await the result")]]
+    task<std::expected<void, std::error_code>> open_async(std::filesystem::path path, executor_base& io);
+
+    /**
+     * @brief close() on `io`; closing folds the journal into the base file.
+     */
+    [[ION_NODISCARD("co_await the result")]]
+    task<std::expected<void, std::error_code>> close_async(executor_base& io);
+
+    /**
+     * @brief begin_transaction() on `io`; it waits for the writer lock, which a commit holds while writing.
+     */
+    [[ION_NODISCARD("co_await the result")]]
+    task<std::expected<std::unique_ptr<class transaction_base>, std::error_code>> begin_transaction_async(executor_base& io);
+    /// @}
+
+protected:
+    friend class store_subscription;
+
+    /**
+     * @brief Wraps a subscription id for subscribe() to return.
+     */
+    store_subscription make_subscription(uint64_t id) noexcept { return store_subscription(this, id); }
+
+    /**
+     * @brief Ends the subscription `id` handed to make_subscription().
+     */
+    virtual void unsubscribe(uint64_t id) noexcept = 0;
 };
 
+inline void store_subscription::reset() noexcept {
+    if (store_) std::exchange(store_, nullptr)->unsubscribe(id_);
+}
+
 
 /**
  * @brief Creates a JSON file-backed store.
@@ -115,12 +379,48 @@ make_json_file_store(std::filesystem::path const&, json_store_options);
 ION_CORE_API std::expected<std::unique_ptr<store_base>, std::error_code>
 make_toml_file_store(std::filesystem::path const&, toml_store_options);
 
+/**
+ * @brief Creates a binary snapshot file-backed store.
+ *
+ * Same semantics as the text stores; only the base file format differs.
+ * @param path Filesystem path to the snapshot file.
+ * @param opts Options for the binary store.
+ * @return Unique pointer to store_base or error.
+ */
+[[ION_NODISCARD("Check for error or valid store")]]
+ION_CORE_API std::expected<std::unique_ptr<store_base>, std::error_code>
+make_binary_file_store(std::filesystem::path const&, binary_store_options);
+
 /**
  * @brief Creates an in-memory store.
+ *
+ * Behaves like the JSON store without a file: open() ignores its path and
+ * starts empty, commits are never written anywhere, and close() discards the data.
+ * @param instrumentation Metrics sink and clock; detached by default.
  * @return Unique pointer to store_base or error.
  */
 [[ION_NODISCARD("Check for error or valid store")]]
 ION_CORE_API std::expected<std::unique_ptr<store_base>, std::error_code>
-make_in_memory_store();
+make_in_memory_store(store_instrumentation instrumentation = {});
+
+/**
+ * @brief Rewrites a store file in another format.
+ *
+ * Reads `from` with its journal replayed, writing to neither, then
+ * atomically replaces `to` with the same data in `to_format` and removes any
+ * journal left beside `to`. Nothing is written if `from` holds a value
+ * `to_format` cannot express: a null for TOML, NaN or an infinity for JSON.
+ * TOML dates and times become JSON strings.
+ * @param from Existing store file to read.
+ * @param from_format Format of `from`.
+ * @param to File to write; may equal `from` only if the formats match.
+ * @param to_format Format to write.
+ * @return Success or error (IoFailure if `from` does not exist, ParseError if it is malformed,
+ *         TypeMismatch if `to_format` cannot express one of its values).
+ */
+[[ION_NODISCARD("Check for error on convert")]]
+ION_CORE_API std::expected<void, std::error_code>
+convert_store_file(std::filesystem::path const& from, store_format from_format,
+                   std::filesystem::path const& to, store_format to_format);
 
 }  // namespace ion::core
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <concepts>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "store_handle.h"
+#include "store_key.h"
+#include "read_transaction_base.h"
+#include "transaction_base.h"
+
+namespace ion::core {
+
+namespace detail {
+// Deliberately not constexpr: reaching it from the consteval store_field
+// constructor turns a malformed key into a compile error.
+inline void malformed_store_field_key() noexcept {}
+}  // namespace detail
+
+/**
+ * @brief One member of a bound struct and the key it is stored under.
+ *
+ * Keys must match `[A-Za-z_][A-Za-z0-9_]*`; they are checked when the field
+ * list is compiled, so a malformed key fails to build. An optional field
+ * keeps its current value when the key is missing on load().
+ */
+template <typename Owner, typename Member>
+struct store_field {
+    std::string_view key;
+    Member Owner::* member;
+    bool optional = false;
+
+    consteval store_field(std::string_view k, Member Owner::* m, bool opt = false)
+        : key(k), member(m), optional(opt) {
+        if (!detail::is_valid_key(k)) detail::malformed_store_field_key();
+    }
+};
+
+/**
+ * @brief Describes how a struct maps onto a store object.
+ *
+ * Specialize it with a constexpr tuple of store_field, one per member:
+ * @code
+ * struct window_config { int64_t width = 0; int64_t height = 0; std::string title; bool vsync = true; };
+ *
+ * template <> struct ion::core::store_binding<window_config> {
+ *     static constexpr auto fields = std::tuple{
+ *         store_field{"width", &window_config::width},
+ *         store_field{"height", &window_config::height},
+ *         store_field{"title", &window_config::title},
+ *         store_field{"vsync", &window_config::vsync, true},
+ *     };
+ * };
+ * @endcode
+ * Members may be bool, any integer type (range-checked against int64_t),
+ * float or double, std::string, std::string_view, or another bound struct,
+ * which maps onto a nested object. A loaded std::string_view points into
+ * the transaction's tree and is valid as for get_string_view().
+ */
+template <typename T>
+struct store_binding;
+
+/**
+ * @brief A struct with a store_binding specialization.
+ */
+template <typename T>
+concept store_bound = requires { store_binding<T>::fields; };
+
+namespace detail {
+
+template <typename T>
+std::expected<void, std::error_code> load_fields(read_transaction_base const& txn, store_handle h, T& out);
+
+template <typename T>
+std::expected<void, std::error_code> save_fields(transaction_base& txn, store_handle h, T const& value);
+
+template <typename M>
+std::expected<void, std::error_code> load_member(read_transaction_base const& txn, store_handle h, M& out) {
+    if constexpr (std::same_as<M, bool>) {
+        auto v = txn.try_get_bool(h);
+        if (!v) return std::unexpected(make_error_code(v.error()));
+        out = *v;
+    } else if constexpr (std::integral<M>) {
+        auto v = txn.try_get_int(h);
+        if (!v) return std::unexpected(make_error_code(v.error()));
+        if (!std::in_range<M>(*v)) return std::unexpected(make_error_code(core_errc::index_out_of_range));
+        out = static_cast<M>(*v);
+    } else if constexpr (std::floating_point<M>) {
+        auto v = txn.try_get_double(h);
+        if (!v) return std::unexpected(make_error_code(v.error()));
+        out = static_cast<M>(*v);
+    } else if constexpr (std::same_as<M, std::string> || std::same_as<M, std::string_view>) {
+        // Assigning from the view reuses the member's capacity
+        auto v = txn.try_get_string_view(h);
+        if (!v) return std::unexpected(make_error_code(v.error()));
+        out = *v;
+    } else if constexpr (store_bound<M>) {
+        return load_fields(txn, h, out);
+    } else {
+        static_assert(sizeof(M) == 0, "Unsupported store_field member type");
+    }
+    return {};
+}
+
+// Overwrites an existing value in place; set_*() keeps every handle valid
+template <typename M>
+std::expected<void, std::error_code> assign_member(transaction_base& txn, store_handle h, M const& value) {
+    if constexpr (std::same_as<M, bool>) {
+        return txn.set_bool(h, value);
+    } else if constexpr (std::integral<M>) {
+        if (!std::in_range<int64_t>(value)) return std::unexpected(make_error_code(core_errc::index_out_of_range));
+        return txn.set_int(h, static_cast<int64_t>(value));
+    } else if constexpr (std::floating_point<M>) {
+        return txn.set_double(h, static_cast<double>(value));
+    } else if constexpr (std::same_as<M, std::string> || std::same_as<M, std::string_view>) {
+        return txn.set_string(h, value);
+    } else if constexpr (store_bound<M>) {
+        return save_fields(txn, h, value);
+    } else {
+        static_assert(sizeof(M) == 0, "Unsupported store_field member type");
+    }
+}
+
+template <typename M>
+std::expected<void, std::error_code>
+create_member(transaction_base& txn, store_handle parent, std::string_view key, M const& value) {
+    if constexpr (std::same_as<M, bool>) {
+        return txn.make_bool(parent, key, value);
+    } else if constexpr (std::integral<M>) {
+        if (!std::in_range<int64_t>(value)) return std::unexpected(make_error_code(core_errc::index_out_of_range));
+        return txn.make_int(parent, key, static_cast<int64_t>(value));
+    } else if constexpr (std::floating_point<M>) {
+        return txn.make_double(parent, key, static_cast<double>(value));
+    } else if constexpr (std::same_as<M, std::string> || std::same_as<M, std::string_view>) {
+        return txn.make_string(parent, key, value);
+    } else if constexpr (store_bound<M>) {
+        auto object = txn.make_object(parent, key);
+        if (!object) return std::unexpected(object.error());
+        return save_fields(txn, *object, value);
+    } else {
+        static_assert(sizeof(M) == 0, "Unsupported store_field member type");
+    }
+}
+
+template <typename T>
+std::expected<void, std::error_code> load_fields(read_transaction_base const& txn, store_handle h, T& out) {
+    std::expected<void, std::error_code> result;
+    auto load_one = [&](auto const& field) {
+        auto c = txn.child(h, field.key);
+        if (!c) {
+            if (!(field.optional && c.error() == core_errc::key_not_found)) result = std::unexpected(c.error());
+            return result.has_value();
+        }
+        result = load_member(txn, *c, out.*field.member);
+        return result.has_value();
+    };
+    std::apply([&](auto const&... fields) { (load_one(fields) && ...); }, store_binding<T>::fields);
+    return result;
+}
+
+template <typename T>
+std::expected<void, std::error_code> save_fields(transaction_base& txn, store_handle h, T const& value) {
+    std::expected<void, std::error_code> result;
+    auto save_one = [&](auto const& field) {
+        auto const& member = value.*field.member;
+        auto c = txn.child(h, field.key);
+        if (c)                                          result = assign_member(txn, *c, member);
+        else if (c.error() == core_errc::key_not_found) result = create_member(txn, h, field.key, member);
+        else                                            result = std::unexpected(c.error());
+        return result.has_value();
+    };
+    std::apply([&](auto const&... fields) { (save_one(fields) && ...); }, store_binding<T>::fields);
+    return result;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Reads a bound struct from the object at a handle, into an existing value.
+ *
+ * One pass over the subtree: every field is a single child() step from its
+ * object's handle, never a path walk from the root, and strings are
+ * copied straight from get_string_view() into the member, so a reused
+ * value whose strings have the capacity allocates nothing. Reading into a
+ * reused value also keeps the members an optional field leaves alone.
+ * @param txn The transaction to read from.
+ * @param h Handle of the object holding the fields.
+ * @param out Receives the fields; on error, earlier fields may already be written.
+ * @return Success or the first field's error (KeyNotFound for a missing
+ *         required key, TypeMismatch, IndexOutOfRange for an integer that
+ *         does not fit its member).
+ */
+template <store_bound T>
+[[ION_NODISCARD("Check for error on load")]]
+std::expected<void, std::error_code> load(read_transaction_base const& txn, store_handle h, T& out) {
+    return detail::load_fields(txn, h, out);
+}
+
+/**
+ * @brief Reads a bound struct from the object at a handle.
+ *
+ * As load(txn, h, out), starting from a value-initialized T.
+ * @return The struct or the first field's error.
+ */
+template <store_bound T>
+[[ION_NODISCARD("Check for error or valid value")]]
+std::expected<T, std::error_code> load(read_transaction_base const& txn, store_handle h) {
+    T out{};
+    auto loaded = detail::load_fields(txn, h, out);
+    if (!loaded) return std::unexpected(loaded.error());
+    return out;
+}
+
+/**
+ * @brief Writes a bound struct into the object at a handle.
+ *
+ * Existing values are overwritten in place, so handles stay valid; missing
+ * keys, nested objects included, are created. Keys not in the binding are
+ * left alone.
+ * @param txn The transaction to write to.
+ * @param h Handle of the object to hold the fields.
+ * @param value The struct to write.
+ * @return Success or the first field's error; earlier fields stay written.
+ */
+template <store_bound T>
+[[ION_NODISCARD("Check for error on save")]]
+std::expected<void, std::error_code> save(transaction_base& txn, store_handle h, T const& value) {
+    return detail::save_fields(txn, h, value);
+}
+
+}  // namespace ion::core
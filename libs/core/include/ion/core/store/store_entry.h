@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <variant>
+
+namespace ion::core {
+
+/**
+ * @brief Kinds of node a storage tree holds.
+ */
+enum class store_node_type : uint8_t {
+    null,       ///< JSON null.
+    boolean,    ///< Read with get_bool().
+    integer,    ///< Read with get_int().
+    floating,   ///< Read with get_double().
+    string,     ///< Read with get_string() / get_string_view().
+    array,      ///< Children addressed by index.
+    object,     ///< Children addressed by key, kept sorted by key.
+    other,      ///< Backend-native scalar the API cannot express (e.g. a TOML date).
+};
+
+/**
+ * @brief One child of an object or array, read without allocating a handle.
+ *
+ * Filled by read_transaction_base::read_entries() and scan_entries() and
+ * handed out by the children()/elements()/scan() ranges. `key` and a string
+ * `value` point into the tree the transaction reads and stay valid as for
+ * get_string_view(). To descend into a container entry, ask for its handle
+ * with child(parent, key) or element(parent, index).
+ */
+struct ION_CORE_API store_entry {
+    std::string_view key;                 ///< Object key; empty for array elements.
+    size_t index = 0;                     ///< Position among the parent's children.
+    store_node_type type = store_node_type::null;
+    size_t size = 0;                      ///< Child count for arrays and objects, 0 otherwise.
+
+    /// Scalar value; monostate for null, containers and `other`.
+    std::variant<std::monostate, bool, int64_t, double, std::string_view> value;
+};
+
+}  // namespace ion::core
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <cstddef>
+#include <string_view>
+
+namespace ion::core::detail {
+
+/**
+ * @brief True for the bytes a key may start with: `[A-Za-z_]`.
+ */
+constexpr bool is_key_start(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+}
+
+/**
+ * @brief True for the bytes a key may continue with: `[A-Za-z0-9_]`.
+ */
+constexpr bool is_key_char(char c) noexcept {
+    return is_key_start(c) || (c >= '0' && c <= '9');
+}
+
+/**
+ * @brief Vectorized kernels behind key_prefix() and find_delimiter().
+ *
+ * Compare 16 bytes per step with SSE2 or NEON where the target has them, one
+ * byte at a time otherwise.
+ */
+ION_CORE_API size_t key_prefix_length(char const* data, size_t size) noexcept;
+ION_CORE_API size_t delimiter_offset(char const* data, size_t size) noexcept;
+
+/**
+ * @brief Length of the run of key characters `text` starts with.
+ */
+constexpr size_t key_prefix(std::string_view text) noexcept {
+    if consteval {
+        size_t i = 0;
+        while (i < text.size() && is_key_char(text[i])) ++i;
+        return i;
+    } else {
+        return key_prefix_length(text.data(), text.size());
+    }
+}
+
+/**
+ * @brief Offset of the first `.` or `[` in `text`, or its size if there is none.
+ *
+ * Splits a dot/bracket path: a key segment runs up to the next delimiter.
+ */
+constexpr size_t find_delimiter(std::string_view text) noexcept {
+    if consteval {
+        size_t i = 0;
+        while (i < text.size() && text[i] != '.' && text[i] != '[') ++i;
+        return i;
+    } else {
+        return delimiter_offset(text.data(), text.size());
+    }
+}
+
+/**
+ * @brief True if `key` matches `[A-Za-z_][A-Za-z0-9_]*`, the keys every backend accepts.
+ */
+constexpr bool is_valid_key(std::string_view key) noexcept {
+    return !key.empty() && is_key_start(key[0]) && key_prefix(key) == key.size();
+}
+
+}  // namespace ion::core::detail
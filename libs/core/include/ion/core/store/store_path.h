@@ -0,0 +1,144 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include "store_key.h"
+
+namespace ion::core {
+
+namespace detail {
+// Deliberately not constexpr: reaching it from a consteval store_path
+// constructor turns a malformed literal into a compile error.
+inline void malformed_store_path_literal() noexcept {}
+}  // namespace detail
+
+/**
+ * @brief A dot/bracket path parsed once and reused across lookups.
+ *
+ * navigate() and get<T>() re-tokenize their path string on every call. A
+ * store_path holds the segments pre-split, and the stores cache what each
+ * compiled path resolved to per transaction, so repeated lookups of the same
+ * path skip both tokenizing and the walk from the base handle.
+ *
+ * Build one from a string literal at compile time, where a malformed path
+ * fails to compile:
+ * @code
+ * static constexpr store_path k_width{"window.size.width"};
+ * auto width = txn->get<int64_t>(*root, k_width);
+ * @endcode
+ * or at run time with parse(). Keys reference the text the path was built
+ * from, which must outlive it (string literals always do).
+ *
+ * @note Path rules: as for navigate(), plus keys must match `[A-Za-z_][A-Za-z0-9_]*`
+ * and a path holds at most k_max_segments segments.
+ */
+class ION_CORE_API store_path {
+public:
+    static constexpr size_t k_max_segments = 16;
+
+    /**
+     * @brief One pre-split path segment.
+     */
+    struct segment {
+        std::string_view key;    ///< Object key; empty for array elements.
+        uint64_t index = 0;      ///< Array index when is_element is set.
+        bool is_element = false;
+    };
+
+    /**
+     * @brief Compiles a string literal; a malformed path is a compile error.
+     */
+    template <size_t N>
+    explicit consteval store_path(char const (&text)[N]) {
+        if (parse_into(std::string_view(text, N - 1)) != k_parsed) {
+            detail::malformed_store_path_literal();
+        }
+    }
+
+    /**
+     * @brief Compiles a path at run time.
+     * @param text Path text; must outlive the result.
+     * @return The path, or PathSyntax / IndexOutOfRange as navigate() reports them.
+     */
+    [[ION_NODISCARD("Check for error or valid path")]]
+    static std::expected<store_path, std::error_code> parse(std::string_view text) {
+        store_path path;
+        auto parsed = path.parse_into(text);
+        if (parsed != k_parsed) return std::unexpected(make_error_code(parsed));
+        return path;
+    }
+
+    /**
+     * @brief The path text this was built from.
+     */
+    [[ION_NODISCARD("Use the path text")]]
+    constexpr std::string_view text() const noexcept { return text_; }
+
+    /**
+     * @brief FNV-1a hash of text(), computed once when the path is built.
+     */
+    [[ION_NODISCARD("Use the path hash")]]
+    constexpr uint64_t hash() const noexcept { return hash_; }
+
+    /**
+     * @brief The segments, root first. Empty for a path naming the base itself.
+     */
+    [[ION_NODISCARD("Use the segments")]]
+    constexpr std::span<segment const> segments() const noexcept { return {segments_.data(), count_}; }
+
+private:
+    static constexpr core_errc k_parsed{};   // No error; core_errc values start at 1
+
+    constexpr store_path() = default;
+
+    constexpr core_errc parse_into(std::string_view text) noexcept {
+        text_ = text;
+        hash_ = 0xcbf29ce484222325ull;
+        for (char c : text) hash_ = (hash_ ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+
+        size_t i = 0, n = text.size();
+        while (i < n) {
+            if (text[i] == '.') { ++i; continue; }
+            if (count_ == k_max_segments) return core_errc::path_syntax;
+
+            segment& seg = segments_[count_++];
+            if (text[i] == '[') {
+                size_t start = ++i;
+                uint64_t idx = 0;
+                while (i < n && text[i] >= '0' && text[i] <= '9') {
+                    uint64_t digit = static_cast<uint64_t>(text[i] - '0');
+                    if (idx > (std::numeric_limits<uint64_t>::max() - digit) / 10) return core_errc::index_out_of_range;
+                    idx = idx * 10 + digit;
+                    ++i;
+                }
+                if (i == start || i >= n || text[i] != ']') return core_errc::path_syntax;
+                seg.index = idx;
+                seg.is_element = true;
+                ++i;
+            } else {
+                size_t start = i;
+                if (!detail::is_key_start(text[i])) return core_errc::path_syntax;
+                i += detail::key_prefix(text.substr(i));
+                if (i < n && text[i] != '.' && text[i] != '[') return core_errc::path_syntax;
+                seg.key = text.substr(start, i - start);
+            }
+        }
+        return k_parsed;
+    }
+
+    std::array<segment, k_max_segments> segments_{};
+    size_t count_ = 0;
+    std::string_view text_;
+    uint64_t hash_ = 0;
+};
+
+}  // namespace ion::core
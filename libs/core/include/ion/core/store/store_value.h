@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace ion::core {
+
+/**
+ * @brief Scalar types a batched read can ask for.
+ */
+enum class store_value_type : uint8_t {
+    boolean,    ///< bool, as get_bool().
+    integer,    ///< int64_t, as get_int().
+    floating,   ///< double, as get_double() (integers are widened).
+    string,     ///< std::string, as get_string().
+};
+
+/**
+ * @brief A scalar read from or written to a store.
+ *
+ * The alternative index matches store_value_type.
+ */
+using store_value = std::variant<bool, int64_t, double, std::string>;
+
+/**
+ * @brief One read in a read_transaction_base::get_many() batch.
+ */
+struct ION_CORE_API store_query {
+    std::string_view path;   ///< Dot/bracket path under the batch's base handle.
+    store_value_type type;   ///< Type to read the value as.
+};
+
+/**
+ * @brief One write in a transaction_base::set_many() batch.
+ */
+struct ION_CORE_API store_assignment {
+    std::string_view path;   ///< Dot/bracket path under the batch's base handle.
+    store_value value;       ///< Value to store there.
+};
+
+}  // namespace ion::core
@@ -3,11 +3,14 @@
 #include <ion/core/export.h>
 #include <ion/core/error.h>
 #include <expected>
+#include <span>
 #include <string_view>
 #include <system_error>
-#include <charconv>
+#include <ion/core/thread/coroutine.h>
 
+#include "read_transaction_base.h"
 #include "store_handle.h"
+#include "store_value.h"
 
 
 /**
@@ -17,19 +20,20 @@
  * supporting atomicity, consistency, isolation, and durability (ACID) semantics.
  * Implementations must ensure that changes are either fully committed or rolled back,
  * and provide methods for manipulating and querying hierarchical storage data.
+ * The query half of the interface lives in read_transaction_base.
  *
- * @note Thread-safety: neither store_base nor transaction_base are thread-safe. Concurrent access must be synchronized externally.
+ * @note Thread-safety: a transaction_base is not thread-safe. Concurrent access to one transaction must be synchronized externally.
  *
  * @note Path rules: Keys in path-strings must match `[A-Za-z_][A-Za-z0-9_]*`. No quoting/escaping is supported; invalid segments yield PathSyntax.
  */
 namespace ion::core {
 
-class ION_CORE_API transaction_base {
+class ION_CORE_API transaction_base : public read_transaction_base {
 public:
     /**
      * @brief Destructor. Rolls back if not committed.
      */
-    virtual ~transaction_base() noexcept = default;
+    ~transaction_base() noexcept override = default;
 
     /**
      * @brief Rolls back the transaction if not already committed.
@@ -43,49 +47,6 @@ public:
         }
     }
 
-    /**
-     * @brief Returns the root handle of the storage tree.
-     * @return store_handle on success, or an error (e.g. IoFailure) on failure.
-     */
-    [[ION_NODISCARD("Check for error or valid root handle")]]
-    virtual std::expected<store_handle, std::error_code> root() const = 0;
-
-    /**
-     * @brief Retrieves a boolean value from the given handle.
-     * @param h The handle to query.
-     * @return The boolean value or an error.
-     */
-    [[ION_NODISCARD("Check for error or valid bool value")]]
-    virtual std::expected<bool, std::error_code>
-    get_bool   (store_handle h) const = 0;
-
-    /**
-     * @brief Retrieves an integer value from the given handle.
-     * @param h The handle to query.
-     * @return The integer value or an error.
-     */
-    [[ION_NODISCARD("Check for error or valid int value")]]
-    virtual std::expected<int64_t, std::error_code>
-    get_int    (store_handle h) const = 0;
-
-    /**
-     * @brief Retrieves a double value from the given handle.
-     * @param h The handle to query.
-     * @return The double value or an error.
-     */
-    [[ION_NODISCARD("Check for error or valid double value")]]
-    virtual std::expected<double, std::error_code>
-    get_double (store_handle h) const = 0;
-
-    /**
-     * @brief Retrieves a string value from the given handle.
-     * @param h The handle to query.
-     * @return The string value or an error.
-     */
-    [[ION_NODISCARD("Check for error or valid string value")]]
-    virtual std::expected<std::string, std::error_code>
-    get_string (store_handle h) const = 0;
-
     /**
      * @brief Sets a boolean value at the given handle.
      * @param h The handle to modify.
@@ -200,16 +161,6 @@ public:
     virtual std::expected<void, std::error_code>
     remove        (store_handle parent, std::string_view key) = 0;
 
-    /**
-     * @brief Checks if a child with the given key exists under the parent.
-     * @param parent The parent handle.
-     * @param key The key to check.
-     * @return True if exists, false otherwise, or error.
-     */
-    [[ION_NODISCARD("Check for error or existence result")]]
-    virtual std::expected<bool, std::error_code>
-    has           (store_handle parent, std::string_view key) const = 0;
-
     /**
      * @brief Removes an element by index from the given parent array.
      * @param parent The parent array handle.
@@ -221,38 +172,94 @@ public:
     erase_element (store_handle parent, size_t idx) = 0;
 
     /**
-     * @brief Checks if an element exists at the given index in the parent array.
-     * @param parent The parent array handle.
-     * @param idx The index to check.
-     * @return True if exists, false otherwise, or error.
+     * @brief Overwrites the value at a handle, whatever its current type.
+     * @param h The handle to modify.
+     * @param v The value to set.
+     * @return Success or error.
      */
-    [[ION_NODISCARD("Check for error or existence result")]]
-    virtual std::expected<bool, std::error_code>
-    has_element   (store_handle parent, size_t idx) const = 0;
+    [[ION_NODISCARD("Check for error on set_value")]]
+    std::expected<void, std::error_code>
+    set_value(store_handle h, store_value const& v) {
+        switch (v.index()) {
+            case 0:  return set_bool(h, std::get<bool>(v));
+            case 1:  return set_int(h, std::get<int64_t>(v));
+            case 2:  return set_double(h, std::get<double>(v));
+            default: return set_string(h, std::get<std::string>(v));
+        }
+    }
 
     /**
-     * @brief Retrieves a child handle by key from the given parent.
+     * @brief Creates a value as a child of the given parent and key.
      * @param parent The parent handle.
-     * @param key The key to retrieve.
-     * @return The child handle or error.
+     * @param key The key for the new value.
+     * @param v The value to set.
+     * @return Success or error.
      */
-    [[ION_NODISCARD("Check for error or valid child handle")]]
-    virtual std::expected<store_handle, std::error_code>
-    child   (store_handle parent, std::string_view key) const = 0;
+    [[ION_NODISCARD("Check for error on make_value")]]
+    std::expected<void, std::error_code>
+    make_value(store_handle parent, std::string_view key, store_value const& v) {
+        switch (v.index()) {
+            case 0:  return make_bool(parent, key, std::get<bool>(v));
+            case 1:  return make_int(parent, key, std::get<int64_t>(v));
+            case 2:  return make_double(parent, key, std::get<double>(v));
+            default: return make_string(parent, key, std::get<std::string>(v));
+        }
+    }
 
     /**
-     * @brief Retrieves an element handle by index from the given parent array.
-     * @param parent The parent array handle.
-     * @param idx The index to retrieve.
-     * @return The element handle or error.
+     * @brief Writes a batch of values under one base handle, in order.
+     *
+     * Each path's parent must exist. A final key is created if missing and
+     * overwritten otherwise; a final index must name an existing element.
+     * Backends resolve parent paths shared by consecutive assignments once.
+     * Stops at the first failure; earlier assignments stay in the
+     * transaction, so roll back to discard them.
+     * @param base The starting handle.
+     * @param assignments Paths and the values to store there.
+     * @return Success or the first error.
      */
-    [[ION_NODISCARD("Check for error or valid element handle")]]
-    virtual std::expected<store_handle, std::error_code>
-    element (store_handle parent, size_t idx) const = 0;
+    [[ION_NODISCARD("Check for error on set_many")]]
+    virtual std::expected<void, std::error_code>
+    set_many(store_handle base, std::span<store_assignment const> assignments) {
+        for (auto const& a : assignments) {
+            if (a.path.empty()) return std::unexpected(make_error_code(core_errc::path_syntax));
+            auto cut = a.path.find_last_of(".[");
+            auto parent = navigate(base, cut == std::string_view::npos ? std::string_view{} : a.path.substr(0, cut));
+            if (!parent) return std::unexpected(parent.error());
+
+            auto leaf = cut == std::string_view::npos ? a.path : a.path.substr(cut);
+            if (leaf.front() == '[') {
+                auto target = navigate(*parent, leaf);
+                if (!target) return std::unexpected(target.error());
+                auto set = set_value(*target, a.value);
+                if (!set) return set;
+                continue;
+            }
+
+            auto key = leaf.front() == '.' ? leaf.substr(1) : leaf;
+            auto exists = has(*parent, key);
+            if (!exists) return std::unexpected(exists.error());
+            if (!*exists) {
+                auto made = make_value(*parent, key, a.value);
+                if (!made) return made;
+                continue;
+            }
+            auto target = child(*parent, key);
+            if (!target) return std::unexpected(target.error());
+            auto set = set_value(*target, a.value);
+            if (!set) return set;
+        }
+        return {};
+    }
 
     /**
      * @brief Commits the transaction, making all changes durable.
-     * @return Success or error.
+     *
+     * If other transactions committed since this one began, its changes are
+     * replayed on top of theirs. That fails with core_errc::conflict when one
+     * of them changed a value this transaction read, or a key or array it
+     * navigated through; roll back and retry on a fresh transaction.
+     * @return Success or error (Conflict if a concurrent commit invalidated what was read).
      */
     [[ION_NODISCARD("Check for error on commit")]]
     std::expected<void, std::error_code> commit() {
@@ -262,68 +269,14 @@ public:
     }
 
     /**
-     * @brief Navigates from a base handle using a dot/bracket path.
+     * @brief commit() run as a task on `io`, which writes the journal or file.
      *
-     * Supports dot notation for objects and bracket notation for arrays.
-     * @param base The starting handle.
-     * @param path The navigation path (e.g. "foo.bar[2].baz").
-     * @return The resulting handle or error.
+     * The awaiting coroutine resumes on `io`. The transaction must outlive the
+     * task and must not be touched by anyone else until it completes.
+     * @return Success or error, as commit().
      */
-    [[ION_NODISCARD("Check for error or valid navigation result")]]
-    std::expected<store_handle, std::error_code>
-    navigate(store_handle base, std::string_view path) const {
-        if (!base.valid()) return std::unexpected(make_error_code(core_errc::invalid_handle));
-        store_handle cur = base;
-        size_t i = 0, n = path.size();
-        while (i < n) {
-            if (path[i] == '.') { ++i; continue; }
-            if (path[i] == '[') {
-                ++i; size_t start = i;
-                while (i < n && path[i] >= '0' && path[i] <= '9') ++i;
-                if (i >= n || path[i] != ']') return std::unexpected(make_error_code(core_errc::path_syntax));
-                uint64_t idx = 0;
-                auto [ptr, ec] = std::from_chars(path.data()+start, path.data()+i, idx);
-                if (ec == std::errc::invalid_argument)   return std::unexpected(make_error_code(core_errc::path_syntax));
-                if (ec == std::errc::result_out_of_range) return std::unexpected(make_error_code(core_errc::index_out_of_range));
-                auto next = element(cur, idx);
-                if (!next) return next;
-                cur = *next;
-                ++i;
-            } else {
-                size_t j = i;
-                while (j < n && path[j] != '.' && path[j] != '[') ++j;
-                auto key = path.substr(i, j - i);
-                auto next = child(cur, key);
-                if (!next) return next;
-                cur = *next;
-                i = j;
-            }
-            if (!cur.valid()) return std::unexpected(make_error_code(core_errc::key_not_found));
-        }
-        return cur;
-    }
-
-    /**
-     * @brief Retrieves a value of type T from a path under a base handle.
-     *
-     * Supported types: bool, int64_t, double, std::string.
-     * @tparam T The value type to retrieve.
-     * @param base The starting handle.
-     * @param path The navigation path.
-     * @return The value or error.
-     */
-    template<typename T>
-    [[ION_NODISCARD("Check for error or valid value")]]
-    std::expected<T, std::error_code>
-    get(store_handle base, std::string_view path) const {
-        auto h = navigate(base, path);
-        if (!h) return std::unexpected(h.error());
-        if constexpr (std::is_same_v<T,bool>)       return get_bool(*h);
-        else if constexpr (std::is_same_v<T,int64_t>) return get_int(*h);
-        else if constexpr (std::is_same_v<T,double>)  return get_double(*h);
-        else if constexpr (std::is_same_v<T,std::string>) return get_string(*h);
-        else static_assert(sizeof(T)==0, "Unsupported get<> type");
-    }
+    [[ION_NODISCARD("co_await the result")]]
+    task<std::expected<void, std::error_code>> commit_async(executor_base& io);
 
 protected:
     /**
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <ion/core/types.h>
+
+#include "thread/task.h"
+#include "thread/executor.h"
+#include "thread/coroutine.h"
+#include "thread/thread_pool.h"
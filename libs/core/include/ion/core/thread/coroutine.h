@@ -0,0 +1,238 @@
+#pragma once
+
+#include <ion/core/types.h>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "executor.h"
+
+namespace ion::core {
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+struct task_promise_base {
+    struct final_awaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+            return self.promise().continuation;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    // Errors travel as values; an escaping exception is a bug
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+};
+
+template <typename T>
+struct task_promise : task_promise_base {
+    task<T> get_return_object() noexcept;
+
+    template <typename U>
+        requires std::is_constructible_v<T, U&&>
+    void return_value(U&& value) {
+        result.emplace(std::forward<U>(value));
+    }
+
+    std::optional<T> result;
+};
+
+template <>
+struct task_promise<void> : task_promise_base {
+    task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+};
+
+/**
+ * @brief Eagerly started coroutine that destroys itself when it finishes.
+ */
+struct detached_task {
+    struct promise_type {
+        detached_task get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+}  // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a `T`.
+ *
+ * Nothing runs until the task is co_awaited (or handed to sync_wait() or
+ * detach()); the awaiting coroutine is resumed on whichever thread the task
+ * finishes on. Errors are returned as values, typically
+ * `std::expected<U, std::error_code>`; an exception escaping the coroutine
+ * terminates.
+ *
+ * @code
+ * task<std::expected<void, std::error_code>> save(store_base& store, executor_base& io) {
+ *     auto txn = co_await store.begin_transaction_async(io);
+ *     if (!txn) co_return std::unexpected(txn.error());
+ *     ...
+ *     co_return co_await (*txn)->commit_async(io);
+ * }
+ * @endcode
+ */
+template <typename T>
+class [[nodiscard("A task does nothing until it is awaited")]] task {
+public:
+    using promise_type = detail::task_promise<T>;
+
+    task(task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    task(task const&) = delete;
+    task& operator=(task const&) = delete;
+
+    ~task() {
+        if (handle_) handle_.destroy();
+    }
+
+    auto operator co_await() && noexcept {
+        struct awaiter {
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() {
+                if constexpr (!std::is_void_v<T>) {
+                    return std::move(*handle.promise().result);
+                }
+            }
+
+            std::coroutine_handle<promise_type> handle;
+        };
+        return awaiter{handle_};
+    }
+
+private:
+    friend promise_type;
+
+    explicit task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+task<T> task_promise<T>::get_return_object() noexcept {
+    return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+struct sync_wait_state {
+    void finish() {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cv.notify_one();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return done; });
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+};
+
+template <typename T>
+detached_task run_sync_wait(task<T> t, std::optional<T>& out, sync_wait_state& state) {
+    out.emplace(co_await std::move(t));
+    state.finish();
+}
+
+inline detached_task run_sync_wait(task<void> t, sync_wait_state& state) {
+    co_await std::move(t);
+    state.finish();
+}
+
+inline detached_task run_detached(task<void> t) {
+    co_await std::move(t);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Awaitable that resumes the awaiting coroutine as a task on `executor`.
+ *
+ * `co_await schedule_on(io)` moves the rest of the coroutine onto `io`;
+ * awaiting it again with another executor moves it back.
+ */
+[[ION_NODISCARD("co_await the result")]]
+inline auto schedule_on(executor_base& executor) noexcept {
+    struct awaiter {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> awaiting) { executor.execute([awaiting] { awaiting.resume(); }); }
+        void await_resume() const noexcept {}
+
+        executor_base& executor;
+    };
+    return awaiter{executor};
+}
+
+/**
+ * @brief Runs `t` to completion, blocking the calling thread until it finishes.
+ *
+ * For tests and for bridging into code that is not a coroutine. Must not be
+ * called from a task `t` itself needs in order to finish (e.g. on the only
+ * worker of the executor it awaits).
+ */
+template <typename T>
+T sync_wait(task<T> t) {
+    detail::sync_wait_state state;
+    if constexpr (std::is_void_v<T>) {
+        detail::run_sync_wait(std::move(t), state);
+        state.wait();
+    } else {
+        std::optional<T> out;
+        detail::run_sync_wait(std::move(t), out, state);
+        state.wait();
+        return std::move(*out);
+    }
+}
+
+/**
+ * @brief Starts `t` without waiting for it; its frame is freed when it finishes.
+ *
+ * Whatever the task refers to must outlive it. Useful from a service's
+ * tick(): start the work, keep ticking, and let the task report back.
+ */
+inline void detach(task<void> t) {
+    detail::run_detached(std::move(t));
+}
+
+}  // namespace ion::core
@@ -1,26 +1,37 @@
 #pragma once
 
-#include <functional>
-
 #include <ion/core/export.h>
 
+#include "task.h"
+
 namespace ion::core {
 
-using Task = std::function<void()>;
+class ION_CORE_API executor_base {
+public:
+    virtual ~executor_base() = default;
+    
+    virtual void execute(Task&& task) = 0;
+};
 
-class ION_CORE_API thread_pool_base {
+/**
+ * @brief A set of worker threads that run submitted tasks.
+ *
+ * A pool is also an executor: execute() is submit(), so anything that takes
+ * an executor_base (e.g. a store's background compaction) can run on it.
+ */
+class ION_CORE_API thread_pool_base : public executor_base {
 public:
     virtual ~thread_pool_base() = default;
     
     virtual void submit(Task&& task) = 0;
+
+    /**
+     * @brief Blocks until every submitted task, including tasks those tasks
+     *        submitted, has finished. Must not be called from a pool task.
+     */
     virtual void wait_idle() = 0;
-};
 
-class ION_CORE_API executor_base {
-public:
-    virtual ~executor_base() = default;
-    
-    virtual void execute(Task&& task) = 0;
+    void execute(Task&& task) override { submit(std::move(task)); }
 };
 
 } // namespace ion::core
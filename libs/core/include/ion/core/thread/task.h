@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ion::core {
+
+/**
+ * @brief Move-only `void()` callable with an inline buffer of `InlineSize` bytes.
+ *
+ * Unlike std::function, a callable that fits the buffer (and is nothrow
+ * movable) is stored in place, so creating, moving and running the task
+ * never allocates, and move-only captures such as unique_ptr or promises are
+ * fine. Larger or over-aligned callables fall back to a single heap block.
+ *
+ * Invoking an empty task is undefined behaviour.
+ */
+template <size_t InlineSize>
+class basic_task {
+public:
+    static constexpr size_t k_inline_size = InlineSize;
+
+    /**
+     * @brief Whether a callable of type `F` is stored without allocating.
+     */
+    template <typename F>
+    static constexpr bool k_fits_inline = sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t) &&
+                                          std::is_nothrow_move_constructible_v<F>;
+
+    basic_task() noexcept = default;
+    basic_task(std::nullptr_t) noexcept {}
+
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, basic_task> && std::is_invocable_r_v<void, std::decay_t<F>&>)
+    basic_task(F&& fn) {
+        using stored = std::decay_t<F>;
+        if constexpr (k_fits_inline<stored>) {
+            ::new (static_cast<void*>(storage_)) stored(std::forward<F>(fn));
+            ops_ = &k_inline_ops<stored>;
+        } else {
+            ::new (static_cast<void*>(storage_)) stored*(new stored(std::forward<F>(fn)));
+            ops_ = &k_heap_ops<stored>;
+        }
+    }
+
+    basic_task(basic_task&& other) noexcept : ops_(other.ops_) {
+        if (ops_) {
+            ops_->relocate(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    basic_task& operator=(basic_task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_) {
+                other.ops_->relocate(storage_, other.storage_);
+                ops_ = std::exchange(other.ops_, nullptr);
+            }
+        }
+        return *this;
+    }
+
+    basic_task(basic_task const&) = delete;
+    basic_task& operator=(basic_task const&) = delete;
+
+    ~basic_task() { reset(); }
+
+    void operator()() { ops_->invoke(storage_); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    /**
+     * @brief Destroys the held callable, leaving the task empty.
+     */
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct ops {
+        void (*invoke)(void* self);
+        void (*relocate)(void* dst, void* src) noexcept;   // Move-constructs into dst, then destroys src
+        void (*destroy)(void* self) noexcept;
+    };
+
+    template <typename F>
+    static constexpr ops k_inline_ops{
+        [](void* self) { (*static_cast<F*>(self))(); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* self) noexcept { static_cast<F*>(self)->~F(); },
+    };
+
+    template <typename F>
+    static constexpr ops k_heap_ops{
+        [](void* self) { (**static_cast<F**>(self))(); },
+        [](void* dst, void* src) noexcept { ::new (dst) F*(*static_cast<F**>(src)); },
+        [](void* self) noexcept { delete *static_cast<F**>(self); },
+    };
+
+    alignas(std::max_align_t) std::byte storage_[InlineSize];
+    ops const* ops_ = nullptr;
+};
+
+/**
+ * @brief Inline capacity of Task: whatever keeps the whole task to one cache line.
+ */
+inline constexpr size_t k_task_inline_size = 64 - alignof(std::max_align_t);
+
+/**
+ * @brief The task type executors and thread pools accept.
+ */
+using Task = basic_task<k_task_inline_size>;
+
+static_assert(sizeof(Task) == 64, "Task should occupy exactly one cache line");
+
+}  // namespace ion::core
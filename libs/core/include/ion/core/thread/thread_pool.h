@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <system_error>
+
+#include "executor.h"
+
+namespace ion::core {
+
+/**
+ * @brief How a thread pool lays its workers out over the CPUs.
+ */
+enum class worker_placement : uint8_t {
+    any,       ///< Unpinned; the OS scheduler places workers.
+    compact,   ///< Pinned, filling one NUMA node's CPUs before the next.
+    spread,    ///< Pinned, round-robin across NUMA nodes.
+};
+
+/**
+ * @brief Options for make_thread_pool().
+ */
+struct ION_CORE_API thread_pool_options {
+    uint32_t worker_count = 0;                         ///< Worker threads; 0 means one per available CPU.
+    worker_placement placement = worker_placement::any; ///< CPU pinning and NUMA layout.
+    uint32_t spin_budget = 2048;                       ///< Empty polls an idle worker makes before it parks.
+};
+
+/**
+ * @brief Creates a work-stealing thread pool.
+ *
+ * Each worker owns a Chase-Lev deque: tasks submitted from a worker go to
+ * its own deque and run LIFO, tasks submitted from other threads go to a
+ * shared injection queue, and idle workers steal the oldest task of another
+ * worker, trying workers on their own NUMA node first. An idle worker polls
+ * for `spin_budget` rounds and then parks on its own wait flag, so a submit
+ * wakes at most one worker instead of broadcasting.
+ *
+ * The pool owns its threads and joins them on destruction, after running
+ * every task still queued. With a pinned placement, workers are bound to the
+ * CPUs the process may run on; placement falls back to `any` where the
+ * platform offers no affinity control.
+ * @param options Worker count, placement and idle behaviour.
+ * @return Unique pointer to thread_pool_base or error (InvalidState if a worker thread could not be started).
+ */
+[[ION_NODISCARD("Check for error or valid thread pool")]]
+ION_CORE_API std::expected<std::unique_ptr<thread_pool_base>, std::error_code>
+make_thread_pool(thread_pool_options options = {});
+
+} // namespace ion::core
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <ion/core/types.h>
+
+#include "time/clock.h"
+#include "time/tsc_clock.h"
+#include "time/cached_clock.h"
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <atomic>
+#include <cstdint>
+
+#include "clock.h"
+
+namespace ion::core {
+
+/**
+ * @brief A clock that returns the time of its last update().
+ *
+ * For code that wants "now" many times per frame but can live with the
+ * frame's start: a service calls update() once at the top of tick(), and
+ * every now_ns() until the next tick is one relaxed atomic load. Readings
+ * come from `source` and never go backwards as long as its readings don't.
+ *
+ * @note `source` must outlive the clock.
+ */
+class ION_CORE_API cached_clock final : public clock_base {
+public:
+    explicit cached_clock(clock_base const& source) : source_(source), now_(source.now_ns()) {}
+
+    cached_clock(cached_clock const&) = delete;
+    cached_clock& operator=(cached_clock const&) = delete;
+
+    /**
+     * @brief Reads the source clock and publishes the reading.
+     */
+    void update() { now_.store(source_.now_ns(), std::memory_order_relaxed); }
+
+    /**
+     * @brief The last published reading, without a virtual call.
+     */
+    uint64_t now_fast() const noexcept { return now_.load(std::memory_order_relaxed); }
+
+    uint64_t now_ns() const override { return now_fast(); }
+
+private:
+    clock_base const& source_;
+    std::atomic<uint64_t> now_;
+};
+
+} // namespace ion::core
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/error.h>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <system_error>
+
+#include "clock.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#  include <intrin.h>
+#endif
+
+namespace ion::core {
+
+/**
+ * @brief What a tsc_clock reads.
+ */
+enum class clock_source : uint8_t {
+    tsc,      ///< x86 time-stamp counter (rdtsc), when it is invariant.
+    cntvct,   ///< AArch64 virtual counter (cntvct_el0).
+    steady,   ///< std::chrono::steady_clock, where no usable counter exists.
+};
+
+/**
+ * @brief Options for make_tsc_clock().
+ */
+struct ION_CORE_API tsc_clock_options {
+    uint64_t calibration_ns = 10'000'000;   ///< How long to measure the TSC rate against steady_clock.
+    bool use_counter = true;                ///< False always falls back to steady_clock.
+};
+
+namespace detail {
+
+/**
+ * @brief steady_clock::now() in nanoseconds since its epoch.
+ */
+ION_CORE_API uint64_t steady_clock_ns() noexcept;
+
+/**
+ * @brief `(value * mult) >> 32` without overflowing the intermediate product.
+ */
+inline uint64_t mul_shift32(uint64_t value, uint64_t mult) noexcept {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(value) * mult) >> 32);
+#else
+    uint64_t vh = value >> 32, vl = value & 0xffffffffu;
+    uint64_t mh = mult >> 32, ml = mult & 0xffffffffu;
+    return ((vh * mh) << 32) + vh * ml + vl * mh + ((vl * ml) >> 32);
+#endif
+}
+
+/**
+ * @brief A tsc_clock's conversion from counter ticks to nanoseconds.
+ */
+struct tsc_calibration {
+    clock_source source = clock_source::steady;
+    uint64_t base_ticks = 0;      ///< Counter value at base_ns.
+    uint64_t base_ns = 0;         ///< steady_clock nanoseconds at base_ticks.
+    uint64_t mult = 1ull << 32;   ///< Nanoseconds per tick, in 32.32 fixed point.
+};
+
+} // namespace detail
+
+/**
+ * @brief A clock that reads the CPU's counter instead of calling into the OS.
+ *
+ * Counts nanoseconds on steady_clock's epoch, so readings can be mixed with
+ * it. On x86 it reads the TSC once the CPU reports it as invariant, scaled
+ * by a rate measured against steady_clock when the clock is made. On
+ * AArch64 it reads cntvct_el0, whose rate the CPU reports. Elsewhere, or
+ * without an invariant TSC, it calls steady_clock.
+ *
+ * The class is final and its reads are inline: code that holds a
+ * `tsc_clock&` calls now_fast(), or ticks() and ticks_to_ns() for spans,
+ * without a virtual call. now_ns() is the same read through clock_base.
+ */
+class ION_CORE_API tsc_clock final : public clock_base {
+public:
+    explicit tsc_clock(detail::tsc_calibration const& calibration) noexcept : cal_(calibration) {}
+
+    /**
+     * @brief The raw counter, or steady_clock nanoseconds on the fallback.
+     */
+    uint64_t ticks() const noexcept {
+        switch (cal_.source) {
+#if defined(_MSC_VER) && defined(_M_X64)
+            case clock_source::tsc: return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            case clock_source::tsc: return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+            case clock_source::cntvct: {
+                uint64_t value;
+                __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+                return value;
+            }
+#endif
+            default: return detail::steady_clock_ns();
+        }
+    }
+
+    /**
+     * @brief Converts a number of ticks, e.g. the difference of two ticks() reads, to nanoseconds.
+     */
+    uint64_t ticks_to_ns(uint64_t ticks) const noexcept { return detail::mul_shift32(ticks, cal_.mult); }
+
+    /**
+     * @brief Nanoseconds on steady_clock's epoch, without a virtual call.
+     */
+    uint64_t now_fast() const noexcept {
+        uint64_t t = ticks();
+        // Another core's counter may trail the calibrating one by a few ticks
+        return cal_.base_ns + (t > cal_.base_ticks ? ticks_to_ns(t - cal_.base_ticks) : 0);
+    }
+
+    uint64_t now_ns() const override { return now_fast(); }
+
+    /**
+     * @brief The counter this clock reads.
+     */
+    clock_source source() const noexcept { return cal_.source; }
+
+private:
+    detail::tsc_calibration cal_;
+};
+
+/**
+ * @brief Measures one span on a tsc_clock with inline reads.
+ *
+ * @code
+ * clock_span span(clock);
+ * run_tick();
+ * metrics.record(tick_ns, span.elapsed_ns());
+ * @endcode
+ */
+class clock_span {
+public:
+    explicit clock_span(tsc_clock const& clock) noexcept : clock_(clock), start_(clock.ticks()) {}
+
+    /**
+     * @brief Nanoseconds since construction or the last restart().
+     */
+    uint64_t elapsed_ns() const noexcept { return clock_.ticks_to_ns(clock_.ticks() - start_); }
+
+    /**
+     * @brief Returns elapsed_ns() and starts a new span.
+     */
+    uint64_t restart() noexcept {
+        uint64_t now = clock_.ticks();
+        uint64_t elapsed = clock_.ticks_to_ns(now - start_);
+        start_ = now;
+        return elapsed;
+    }
+
+private:
+    tsc_clock const& clock_;
+    uint64_t start_;
+};
+
+/**
+ * @brief Creates a counter-based clock, calibrating it first if needed.
+ *
+ * On x86 this blocks for `calibration_ns` while it measures the TSC rate.
+ * @param options Calibration time and whether to use a counter at all.
+ * @return The clock or error.
+ */
+[[ION_NODISCARD("Check for error or valid clock")]]
+ION_CORE_API std::expected<std::unique_ptr<tsc_clock>, std::error_code>
+make_tsc_clock(tsc_clock_options options = {});
+
+} // namespace ion::core
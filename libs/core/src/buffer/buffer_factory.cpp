@@ -1,5 +1,8 @@
 #include <ion/core/buffer.h>
-#include "vector_buffer_impl.h"
+#include "buffer_pool_impl.h"
+#include "chained_buffer_impl.h"
+
+#include <bit>
 
 namespace ion::core
 {
@@ -16,4 +19,20 @@ create_buffer(std::size_t initial_capacity)
     return buf;
 }
 
+std::expected<std::unique_ptr<chained_buffer_base>, std::error_code>
+create_chained_buffer(std::size_t segment_capacity)
+{
+    return std::make_unique<detail::chained_buffer>(segment_capacity);
+}
+
+std::expected<std::unique_ptr<buffer_pool_base>, std::error_code>
+create_buffer_pool(buffer_pool_options options)
+{
+    if (!std::has_single_bit(options.min_block) || !std::has_single_bit(options.max_block) ||
+        options.min_block > options.max_block) {
+        return std::unexpected(make_error_code(core_errc::invalid_argument));
+    }
+    return std::make_unique<detail::buffer_pool_impl>(options);
+}
+
 } // namespace ion::core
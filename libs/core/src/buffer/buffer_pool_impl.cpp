@@ -0,0 +1,227 @@
+#include "buffer_pool_impl.h"
+#include "thread/thread_slot.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <thread>
+
+using namespace ion::core::detail;
+using namespace ion::core;
+
+namespace {
+
+constexpr std::size_t k_max_buffer_pool_shards = 64;
+
+} // namespace
+
+buffer_pool_impl::buffer_pool_impl(buffer_pool_options const& options)
+    : min_block_(options.min_block),
+      max_block_(options.max_block),
+      max_cached_(options.max_cached_per_class),
+      class_count_(static_cast<std::size_t>(std::countr_zero(options.max_block) - std::countr_zero(options.min_block)) + 1) {
+    std::size_t shards = options.shard_count ? options.shard_count : std::max(1u, std::thread::hardware_concurrency());
+    shards = std::bit_ceil(std::min(shards, k_max_buffer_pool_shards));
+    shard_mask_ = shards - 1;
+    shards_ = std::make_unique<shard[]>(shards);
+
+    // Reserve the free lists up front so releasing never allocates
+    for (std::size_t i = 0; i < shards; ++i) {
+        shards_[i].slots.reserve(max_cached_ * class_count_);
+        shards_[i].blocks.resize(class_count_);
+        for (auto& list : shards_[i].blocks) list.reserve(max_cached_);
+    }
+}
+
+buffer_pool_impl::~buffer_pool_impl() {
+    for (std::size_t i = 0; i <= shard_mask_; ++i) {
+        for (void* slot : shards_[i].slots) ::operator delete(slot);
+        for (auto& list : shards_[i].blocks) {
+            for (std::byte* block : list) ::operator delete(block);
+        }
+    }
+}
+
+std::expected<std::unique_ptr<buffer_base>, std::error_code>
+buffer_pool_impl::acquire(std::size_t initial_capacity) {
+    if (initial_capacity > k_max_buffer_size) {
+        return std::unexpected(make_error_code(core_errc::message_too_long));
+    }
+
+    void* slot = nullptr;
+    {
+        auto& s = local_shard();
+        std::lock_guard lock(s.mutex);
+        if (!s.slots.empty()) {
+            slot = s.slots.back();
+            s.slots.pop_back();
+        }
+    }
+    if (!slot) slot = ::operator new(k_slot_size);
+
+    ::new (slot) buffer_pool_impl*(this);
+    std::unique_ptr<buffer_base> buf(::new (static_cast<std::byte*>(slot) + k_slot_header) pooled_buffer(*this));
+    if (initial_capacity) {
+        if (auto e = buf->reserve(initial_capacity); !e.has_value()) {
+            return std::unexpected(e.error());
+        }
+    }
+    return buf;
+}
+
+std::size_t buffer_pool_impl::block_size(std::size_t bytes) const noexcept {
+    return bytes > max_block_ ? bytes : std::max(min_block_, std::bit_ceil(bytes));
+}
+
+std::byte* buffer_pool_impl::take_block(std::size_t& capacity) {
+    capacity = block_size(capacity);
+    if (capacity <= max_block_) {
+        auto& s = local_shard();
+        std::lock_guard lock(s.mutex);
+        auto& list = s.blocks[class_of(capacity)];
+        if (!list.empty()) {
+            std::byte* block = list.back();
+            list.pop_back();
+            return block;
+        }
+    }
+    return static_cast<std::byte*>(::operator new(capacity));
+}
+
+void buffer_pool_impl::give_block(std::byte* block, std::size_t capacity) noexcept {
+    if (!block) return;
+    if (capacity <= max_block_) {
+        auto& s = local_shard();
+        std::lock_guard lock(s.mutex);
+        auto& list = s.blocks[class_of(capacity)];
+        if (list.size() < max_cached_) {
+            list.push_back(block);
+            return;
+        }
+    }
+    ::operator delete(block);
+}
+
+void buffer_pool_impl::release_object(void* object) noexcept {
+    void* slot = static_cast<std::byte*>(object) - k_slot_header;
+    auto* pool = *static_cast<buffer_pool_impl**>(slot);
+    {
+        auto& s = pool->local_shard();
+        std::lock_guard lock(s.mutex);
+        if (s.slots.size() < s.slots.capacity()) {
+            s.slots.push_back(slot);
+            return;
+        }
+    }
+    ::operator delete(slot);
+}
+
+buffer_pool_impl::shard& buffer_pool_impl::local_shard() noexcept {
+    return shards_[thread_slot() & shard_mask_];
+}
+
+std::size_t buffer_pool_impl::class_of(std::size_t capacity) const noexcept {
+    return static_cast<std::size_t>(std::countr_zero(capacity) - std::countr_zero(min_block_));
+}
+
+pooled_buffer::~pooled_buffer() {
+    pool_.give_block(data_, capacity_);
+}
+
+void pooled_buffer::operator delete(void* p) noexcept {
+    buffer_pool_impl::release_object(p);
+}
+
+std::expected<void, std::error_code>
+pooled_buffer::relocate(std::size_t bytes) {
+    std::byte* block = pool_.take_block(bytes);
+    if (size_) std::memcpy(block, data_, size_);
+    pool_.give_block(data_, capacity_);
+    data_ = block;
+    capacity_ = bytes;
+    return {};
+}
+
+std::expected<void, std::error_code>
+pooled_buffer::grow(std::size_t bytes) {
+    if (bytes <= capacity_) return {};
+    if (bytes > pool_.max_size()) {
+        return std::unexpected(make_error_code(core_errc::message_too_long));
+    }
+    return relocate(std::max(bytes, capacity_ * 2));
+}
+
+std::expected<void, std::error_code>
+pooled_buffer::resize(std::size_t bytes) {
+    if (auto e = grow(bytes); !e.has_value()) return e;
+    if (bytes > size_) std::memset(data_ + size_, 0, bytes - size_);
+    size_ = bytes;
+    return {};
+}
+
+std::expected<void, std::error_code>
+pooled_buffer::resize_uninitialized(std::size_t bytes) {
+    if (auto e = grow(bytes); !e.has_value()) return e;
+    size_ = bytes;
+    return {};
+}
+
+std::expected<void, std::error_code>
+pooled_buffer::reserve(std::size_t bytes) {
+    if (bytes <= capacity_) return {};
+    if (bytes > pool_.max_size()) {
+        return std::unexpected(make_error_code(core_errc::message_too_long));
+    }
+    return relocate(bytes);
+}
+
+std::expected<void, std::error_code>
+pooled_buffer::clear() {
+    size_ = 0;
+    return {};
+}
+
+std::expected<void, std::error_code>
+pooled_buffer::shrink_to_fit() {
+    if (size_ == 0) {
+        pool_.give_block(data_, capacity_);
+        data_ = nullptr;
+        capacity_ = 0;
+        return {};
+    }
+    if (pool_.block_size(size_) < capacity_) return relocate(size_);
+    return {};
+}
+
+std::expected<void, core_errc>
+pooled_buffer::try_append(std::span<const std::byte> src) {
+    if (src.size() > pool_.max_size() - size_) {
+        return std::unexpected(core_errc::message_too_long);
+    }
+    if (src.empty()) return {};
+    // Past the check above, grow() cannot fail
+    if (!grow(size_ + src.size()).has_value()) return std::unexpected(core_errc::message_too_long);
+    std::memcpy(data_ + size_, src.data(), src.size());
+    size_ += src.size();
+    return {};
+}
+
+std::span<const std::byte>
+pooled_buffer::view() const noexcept {
+    return std::span<const std::byte>(data_, size_);
+}
+
+std::span<std::byte>
+pooled_buffer::mutate() noexcept {
+    return std::span<std::byte>(data_, size_);
+}
+
+std::size_t
+pooled_buffer::size() const noexcept {
+    return size_;
+}
+
+std::size_t
+pooled_buffer::capacity() const noexcept {
+    return capacity_;
+}
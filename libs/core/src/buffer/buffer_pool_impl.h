@@ -0,0 +1,132 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/buffer.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ion::core::detail {
+
+class buffer_pool_impl;
+
+/**
+ * @brief A buffer whose block and object storage come from a buffer_pool_impl.
+ *
+ * The object lives in a pool slot rather than on the heap: its class-level
+ * operator delete hands the slot back to the pool, so destroying it through
+ * a unique_ptr<buffer_base> returns both the block and the object.
+ */
+class pooled_buffer final : public buffer_base {
+public:
+    explicit pooled_buffer(buffer_pool_impl& pool) noexcept : pool_(pool) {}
+    ~pooled_buffer() override;
+
+    pooled_buffer(pooled_buffer const&) = delete;
+    pooled_buffer& operator=(pooled_buffer const&) = delete;
+
+    static void operator delete(void* p) noexcept;
+
+    [[ION_NODISCARD("Handle resize result")]]
+    std::expected<void, std::error_code> resize(std::size_t bytes) override;
+
+    [[ION_NODISCARD("Handle resize result")]]
+    std::expected<void, std::error_code> resize_uninitialized(std::size_t bytes) override;
+
+    [[ION_NODISCARD("Handle reserve result")]]
+    std::expected<void, std::error_code> reserve(std::size_t bytes) override;
+
+    [[ION_NODISCARD("Handle clear result")]]
+    std::expected<void, std::error_code> clear() override;
+
+    [[ION_NODISCARD("Handle shrinkToFit result")]]
+    std::expected<void, std::error_code> shrink_to_fit() override;
+
+    [[ION_NODISCARD("Handle append result")]]
+    std::expected<void, core_errc> try_append(std::span<const std::byte> src) override;
+
+    std::span<const std::byte> view() const noexcept override;
+
+    std::span<std::byte> mutate() noexcept override;
+
+    std::size_t size() const noexcept override;
+
+    std::size_t capacity() const noexcept override;
+
+private:
+    // Moves the contents to a block of at least `bytes`
+    std::expected<void, std::error_code> relocate(std::size_t bytes);
+
+    // Makes room for `bytes`, at least doubling the capacity when it must move
+    std::expected<void, std::error_code> grow(std::size_t bytes);
+
+    buffer_pool_impl& pool_;
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+class buffer_pool_impl final : public buffer_pool_base {
+public:
+    explicit buffer_pool_impl(buffer_pool_options const& options);
+    ~buffer_pool_impl() override;
+
+    buffer_pool_impl(buffer_pool_impl const&) = delete;
+    buffer_pool_impl& operator=(buffer_pool_impl const&) = delete;
+
+    std::expected<std::unique_ptr<buffer_base>, std::error_code> acquire(std::size_t initial_capacity) override;
+
+    /**
+     * @brief Returns a block of at least `capacity` bytes; `capacity` is
+     *        raised to the block's real size.
+     */
+    std::byte* take_block(std::size_t& capacity);
+
+    /**
+     * @brief Returns a block obtained from take_block() with its real size.
+     */
+    void give_block(std::byte* block, std::size_t capacity) noexcept;
+
+    /**
+     * @brief Size of the block take_block() would return for `bytes`.
+     */
+    std::size_t block_size(std::size_t bytes) const noexcept;
+
+    /**
+     * @brief Largest size a buffer may grow to.
+     */
+    std::size_t max_size() const noexcept { return k_max_buffer_size; }
+
+    // Room in front of a buffer object for the pool it came from
+    static constexpr std::size_t k_slot_header = alignof(std::max_align_t);
+
+    /**
+     * @brief Returns the storage of a destroyed pooled_buffer to its pool.
+     */
+    static void release_object(void* object) noexcept;
+
+private:
+    static constexpr std::size_t k_max_buffer_size = std::size_t(1) << (sizeof(std::size_t) * 8 - 2);
+    static constexpr std::size_t k_slot_size = k_slot_header + sizeof(pooled_buffer);
+
+    // One lock and one set of free lists; aligned so shards don't share lines
+    struct alignas(64) shard {
+        std::mutex mutex;
+        std::vector<void*> slots;                        // Free object slots
+        std::vector<std::vector<std::byte*>> blocks;     // Free blocks per class
+    };
+
+    shard& local_shard() noexcept;
+    std::size_t class_of(std::size_t capacity) const noexcept;
+
+    std::size_t min_block_;
+    std::size_t max_block_;
+    std::size_t max_cached_;
+    std::size_t class_count_;
+    std::size_t shard_mask_;
+    std::unique_ptr<shard[]> shards_;
+};
+
+} // namespace ion::core::detail
@@ -0,0 +1,251 @@
+#include "chained_buffer_impl.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+using namespace ion::core::detail;
+using namespace ion::core;
+
+namespace {
+
+// Smallest owned chunk; small appends such as headers and trailers share one
+constexpr std::size_t k_chain_chunk_size = 4096;
+constexpr std::size_t k_max_chain_size   = PTRDIFF_MAX;
+
+} // namespace
+
+chunk_ref::chunk_ref(chunk_ref const& other) noexcept : header_(other.header_) {
+    if (header_) ++header_->refs;
+}
+
+chunk_ref& chunk_ref::operator=(chunk_ref const& other) noexcept {
+    if (other.header_) ++other.header_->refs;
+    reset();
+    header_ = other.header_;
+    return *this;
+}
+
+chunk_ref& chunk_ref::operator=(chunk_ref&& other) noexcept {
+    if (this != &other) {
+        reset();
+        header_ = std::exchange(other.header_, nullptr);
+    }
+    return *this;
+}
+
+chunk_ref::~chunk_ref() {
+    reset();
+}
+
+chunk_ref chunk_ref::allocate(std::size_t capacity) {
+    void* block = ::operator new(sizeof(header) + capacity);
+    return chunk_ref(::new (block) header{1});
+}
+
+void chunk_ref::reset() noexcept {
+    if (header_ && --header_->refs == 0) {
+        ::operator delete(header_);
+    }
+    header_ = nullptr;
+}
+
+chained_buffer::chained_buffer(std::size_t segment_capacity) {
+    spans_.reserve(segment_capacity);
+    holds_.reserve(segment_capacity);
+}
+
+std::byte* chained_buffer::extend(std::size_t bytes) {
+    std::byte* p = nullptr;
+    if (tail_ && tail_capacity_ - tail_used_ >= bytes) {
+        p = tail_.data() + tail_used_;
+        if (!spans_.empty() && holds_.back().chunk == tail_ && spans_.back().data() + spans_.back().size() == p) {
+            spans_.back() = {spans_.back().data(), spans_.back().size() + bytes};
+        } else {
+            spans_.emplace_back(p, bytes);
+            holds_.push_back({tail_, {}});
+        }
+        tail_used_ += bytes;
+    } else {
+        tail_capacity_ = std::max(bytes, k_chain_chunk_size);
+        tail_ = chunk_ref::allocate(tail_capacity_);
+        tail_used_ = bytes;
+        p = tail_.data();
+        spans_.emplace_back(p, bytes);
+        holds_.push_back({tail_, {}});
+    }
+    size_ += bytes;
+    return p;
+}
+
+void chained_buffer::truncate(std::size_t bytes) noexcept {
+    while (size_ > bytes) {
+        auto& last = spans_.back();
+        std::size_t drop = std::min(last.size(), size_ - bytes);
+        if (drop == last.size()) {
+            spans_.pop_back();
+            holds_.pop_back();
+        } else {
+            last = last.first(last.size() - drop);
+        }
+        size_ -= drop;
+    }
+    // The newest segment in the tail chunk marks where its free room starts
+    if (spans_.empty()) {
+        tail_used_ = 0;
+    } else if (tail_ && holds_.back().chunk == tail_) {
+        tail_used_ = static_cast<std::size_t>(spans_.back().data() + spans_.back().size() - tail_.data());
+    }
+}
+
+std::span<std::byte> chained_buffer::owned_contents() const noexcept {
+    if (spans_.size() != 1 || !holds_.front().chunk) return {};
+    // Our chunks are only ever written through this buffer, so the bytes may change
+    auto const& chunk = holds_.front().chunk;
+    return {chunk.data() + (spans_.front().data() - chunk.data()), spans_.front().size()};
+}
+
+std::expected<void, std::error_code>
+chained_buffer::resize(std::size_t bytes) {
+    if (bytes > k_max_chain_size) {
+        return std::unexpected(make_error_code(core_errc::message_too_long));
+    }
+    if (bytes <= size_) {
+        truncate(bytes);
+        return {};
+    }
+    std::size_t grow = bytes - size_;
+    std::memset(extend(grow), 0, grow);
+    return {};
+}
+
+std::expected<void, std::error_code>
+chained_buffer::resize_uninitialized(std::size_t bytes) {
+    if (bytes > k_max_chain_size) {
+        return std::unexpected(make_error_code(core_errc::message_too_long));
+    }
+    if (bytes <= size_) {
+        truncate(bytes);
+        return {};
+    }
+    (void)extend(bytes - size_);
+    return {};
+}
+
+std::expected<void, std::error_code>
+chained_buffer::reserve(std::size_t bytes) {
+    if (bytes > k_max_chain_size) {
+        return std::unexpected(make_error_code(core_errc::message_too_long));
+    }
+    if (bytes <= capacity()) return {};
+
+    // Start a chunk big enough for the rest; segments keep the old one alive
+    tail_capacity_ = bytes - size_;
+    tail_ = chunk_ref::allocate(tail_capacity_);
+    tail_used_ = 0;
+    return {};
+}
+
+std::expected<void, std::error_code>
+chained_buffer::clear() {
+    spans_.clear();
+    holds_.clear();
+    size_ = 0;
+    tail_used_ = 0;
+    return {};
+}
+
+std::expected<void, std::error_code>
+chained_buffer::shrink_to_fit() {
+    if (tail_ && tail_used_ == 0) {
+        tail_.reset();
+        tail_capacity_ = 0;
+    }
+    return {};
+}
+
+std::expected<void, core_errc>
+chained_buffer::try_append(std::span<const std::byte> src) {
+    if (src.size() > k_max_chain_size - size_) {
+        return std::unexpected(core_errc::message_too_long);
+    }
+    if (src.empty()) return {};
+    std::memcpy(extend(src.size()), src.data(), src.size());
+    return {};
+}
+
+std::expected<void, std::error_code>
+chained_buffer::append_ref(std::span<const std::byte> bytes, segment_owner owner) {
+    if (bytes.size() > k_max_chain_size - size_) {
+        return std::unexpected(make_error_code(core_errc::message_too_long));
+    }
+    if (bytes.empty()) return {};
+    spans_.push_back(bytes);
+    holds_.push_back({{}, std::move(owner)});
+    size_ += bytes.size();
+    return {};
+}
+
+std::span<const std::span<const std::byte>>
+chained_buffer::segments() const noexcept {
+    return spans_;
+}
+
+std::expected<std::span<const std::byte>, std::error_code>
+chained_buffer::contiguous_view() const noexcept {
+    if (spans_.size() > 1) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+    return spans_.empty() ? std::span<const std::byte>{} : spans_.front();
+}
+
+std::expected<std::span<std::byte>, std::error_code>
+chained_buffer::flatten() {
+    if (spans_.empty()) return std::span<std::byte>{};
+    // Linked memory is read-only, so even a single segment must be ours
+    if (auto owned = owned_contents(); !owned.empty()) return owned;
+
+    // The vectors keep their capacity through clear(), so only the chunk can fail
+    chunk_ref flat;
+    try {
+        flat = chunk_ref::allocate(size_);
+    } catch (std::bad_alloc const&) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    }
+    std::byte* out = flat.data();
+    for (auto span : spans_) {
+        std::memcpy(out, span.data(), span.size());
+        out += span.size();
+    }
+    spans_.clear();
+    holds_.clear();
+    spans_.emplace_back(flat.data(), size_);
+    holds_.push_back({flat, {}});
+    tail_ = std::move(flat);
+    tail_capacity_ = size_;
+    tail_used_ = size_;
+    return std::span<std::byte>{tail_.data(), size_};
+}
+
+std::span<const std::byte>
+chained_buffer::view() const noexcept {
+    auto contents = contiguous_view();
+    return contents ? *contents : std::span<const std::byte>{};
+}
+
+std::span<std::byte>
+chained_buffer::mutate() noexcept {
+    return owned_contents();
+}
+
+std::size_t
+chained_buffer::size() const noexcept {
+    return size_;
+}
+
+std::size_t
+chained_buffer::capacity() const noexcept {
+    return size_ + (tail_capacity_ - tail_used_);
+}
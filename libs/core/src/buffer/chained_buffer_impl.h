@@ -0,0 +1,115 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/buffer.h>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ion::core::detail {
+
+/**
+ * @brief Intrusively refcounted block of owned storage.
+ *
+ * append() copies into the current chunk, and every segment cut from it holds
+ * a reference, so a chunk is freed once neither the buffer nor any segment
+ * uses it. A buffer is used by one thread at a time, so the count is plain.
+ */
+class chunk_ref {
+public:
+    chunk_ref() noexcept = default;
+    chunk_ref(chunk_ref const& other) noexcept;
+    chunk_ref(chunk_ref&& other) noexcept : header_(other.header_) { other.header_ = nullptr; }
+    chunk_ref& operator=(chunk_ref const& other) noexcept;
+    chunk_ref& operator=(chunk_ref&& other) noexcept;
+    ~chunk_ref();
+
+    /**
+     * @brief Allocates an uninitialized chunk of `capacity` bytes.
+     */
+    static chunk_ref allocate(std::size_t capacity);
+
+    std::byte* data() const noexcept { return reinterpret_cast<std::byte*>(header_ + 1); }
+    explicit operator bool() const noexcept { return header_ != nullptr; }
+    friend bool operator==(chunk_ref const& a, chunk_ref const& b) noexcept { return a.header_ == b.header_; }
+
+    void reset() noexcept;
+
+private:
+    struct alignas(std::max_align_t) header {
+        std::size_t refs;
+    };
+
+    explicit chunk_ref(header* adopted) noexcept : header_(adopted) {}
+
+    header* header_ = nullptr;
+};
+
+class chained_buffer final : public chained_buffer_base {
+public:
+    explicit chained_buffer(std::size_t segment_capacity);
+
+    [[ION_NODISCARD("Handle resize result")]]
+    std::expected<void, std::error_code> resize(std::size_t bytes) override;
+
+    [[ION_NODISCARD("Handle resize result")]]
+    std::expected<void, std::error_code> resize_uninitialized(std::size_t bytes) override;
+
+    [[ION_NODISCARD("Handle reserve result")]]
+    std::expected<void, std::error_code> reserve(std::size_t bytes) override;
+
+    [[ION_NODISCARD("Handle clear result")]]
+    std::expected<void, std::error_code> clear() override;
+
+    [[ION_NODISCARD("Handle shrinkToFit result")]]
+    std::expected<void, std::error_code> shrink_to_fit() override;
+
+    [[ION_NODISCARD("Handle append result")]]
+    std::expected<void, core_errc> try_append(std::span<const std::byte> src) override;
+
+    [[ION_NODISCARD("Handle append result")]]
+    std::expected<void, std::error_code>
+    append_ref(std::span<const std::byte> bytes, segment_owner owner) override;
+
+    std::span<const std::span<const std::byte>> segments() const noexcept override;
+
+    std::expected<std::span<const std::byte>, std::error_code> contiguous_view() const noexcept override;
+
+    [[ION_NODISCARD("Handle flatten result")]]
+    std::expected<std::span<std::byte>, std::error_code> flatten() override;
+
+    std::span<const std::byte> view() const noexcept override;
+
+    std::span<std::byte> mutate() noexcept override;
+
+    std::size_t size() const noexcept override;
+
+    std::size_t capacity() const noexcept override;
+
+private:
+    // Extends the chain by `bytes` bytes of owned storage and returns them
+    std::byte* extend(std::size_t bytes);
+
+    // Drops bytes off the end until `bytes` remain
+    void truncate(std::size_t bytes) noexcept;
+
+    // The single segment as writable bytes when the buffer owns it, else empty
+    std::span<std::byte> owned_contents() const noexcept;
+
+    // What keeps one segment alive: a chunk of ours or the caller's owner
+    struct segment_hold {
+        chunk_ref chunk;
+        segment_owner linked;
+    };
+
+    std::vector<std::span<const std::byte>> spans_;
+    std::vector<segment_hold> holds_;   // Parallel to spans_
+    std::size_t size_ = 0;
+
+    // Owned chunk that append() copies into; the newest owned segment ends at tail_used_
+    chunk_ref tail_;
+    std::size_t tail_capacity_ = 0;
+    std::size_t tail_used_ = 0;
+};
+
+} // namespace ion::core::detail
@@ -0,0 +1,16 @@
+#include <ion/core/lifecycle.h>
+#include "service_host_impl.h"
+
+namespace ion::core
+{
+
+std::expected<std::unique_ptr<service_host_base>, std::error_code>
+make_service_host(service_host_options options)
+{
+    if ((options.frame_interval_ns || options.frame_budget_ns) && !options.clock) {
+        return std::unexpected(make_error_code(core_errc::invalid_argument));
+    }
+    return std::make_unique<detail::service_host>(options);
+}
+
+} // namespace ion::core
@@ -0,0 +1,202 @@
+/**
+ * @file service_host_impl.cpp
+ * @brief Phase ordering, parallel phase runs and tick accounting for service_host.
+ */
+
+#include "service_host_impl.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+std::expected<service_id, std::error_code>
+service_host::add(service_base& service, service_options const& options) {
+    if (state_ != host_state::adding) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+    if ((options.interval_ns || options.budget_ns) && !options_.clock) {
+        return std::unexpected(make_error_code(core_errc::invalid_argument));
+    }
+
+    // One phase past the latest dependency; dependencies are added first, so there are no cycles
+    std::size_t phase = 0;
+    for (auto dep : options.after) {
+        if (dep.index >= entries_.size()) {
+            return std::unexpected(make_error_code(core_errc::invalid_argument));
+        }
+        phase = std::max(phase, entries_[dep.index]->phase + 1);
+    }
+
+    auto e = std::make_unique<entry>();
+    e->service = &service;
+    e->name.assign(options.name);
+    e->phase = phase;
+    e->interval_ns = options.interval_ns;
+    e->budget_ns = options.budget_ns;
+    e->skippable = options.skippable;
+    if (options_.metrics && options_.clock) {
+        auto histogram = options_.metrics->register_histogram("service." + e->name + ".tick_ns");
+        if (!histogram) {
+            return std::unexpected(histogram.error());
+        }
+        e->has_histogram = true;
+        e->histogram = *histogram;
+    }
+
+    if (phases_.size() <= phase) phases_.resize(phase + 1);
+    phases_[phase].push_back(e.get());
+    auto id = service_id{static_cast<uint32_t>(entries_.size())};
+    entries_.push_back(std::move(e));
+    return id;
+}
+
+std::expected<void, std::error_code> service_host::init() {
+    if (state_ != host_state::adding) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+
+    std::size_t widest = 0;
+    for (auto const& phase : phases_) widest = std::max(widest, phase.size());
+    due_.reserve(widest);
+
+    for (auto const& phase : phases_) {
+        for (entry* e : phase) e->service->init();
+    }
+    state_ = host_state::running;
+    return {};
+}
+
+/**
+ * @brief Runs every phase in order, with the services in it that are due.
+ *
+ * A fixed-rate service is due once its next tick time has come; it keeps
+ * its cadence unless it falls a whole interval behind. Skippable services
+ * are left for the next frame once the frame has run past its budget.
+ */
+std::expected<void, std::error_code> service_host::tick() {
+    if (state_ != host_state::running) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+
+    if (options_.frame_clock) options_.frame_clock->update();
+    uint64_t frame_start = now();
+
+    for (std::size_t i = 0; i < phases_.size(); ++i) {
+        uint64_t phase_start = i == 0 ? frame_start : now();
+        bool over_budget = options_.frame_budget_ns && phase_start - frame_start > options_.frame_budget_ns;
+
+        due_.clear();
+        for (entry* e : phases_[i]) {
+            if (e->interval_ns && phase_start < e->next_due_ns) continue;
+            if (over_budget && e->skippable) {
+                e->skipped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (e->interval_ns) {
+                e->next_due_ns = e->next_due_ns + e->interval_ns > phase_start ? e->next_due_ns + e->interval_ns
+                                                                               : phase_start + e->interval_ns;
+            }
+            due_.push_back(e);
+        }
+        run_phase(due_);
+    }
+
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    return {};
+}
+
+/**
+ * @brief Ticks `due` to completion, spreading it over the executor.
+ *
+ * The first service runs on the calling thread, so a phase of one never
+ * touches the executor.
+ */
+void service_host::run_phase(std::span<entry* const> due) {
+    if (due.empty()) return;
+    if (!options_.executor || due.size() == 1) {
+        for (entry* e : due) run_one(*e);
+        return;
+    }
+
+    {
+        std::lock_guard lock(phase_mutex_);
+        pending_ = due.size() - 1;
+    }
+    for (entry* e : due.subspan(1)) {
+        options_.executor->execute([this, e] {
+            run_one(*e);
+            // Notify under the lock: once it is released the host may move on and be destroyed
+            std::lock_guard lock(phase_mutex_);
+            if (--pending_ == 0) phase_done_.notify_one();
+        });
+    }
+    run_one(*due.front());
+
+    std::unique_lock lock(phase_mutex_);
+    phase_done_.wait(lock, [this] { return pending_ == 0; });
+}
+
+void service_host::run_one(entry& e) {
+    uint64_t start = now();
+    e.service->tick();
+    e.ticks.fetch_add(1, std::memory_order_relaxed);
+    if (!options_.clock) return;
+
+    uint64_t elapsed = now() - start;
+    e.last_tick_ns.store(elapsed, std::memory_order_relaxed);
+    e.total_tick_ns.fetch_add(elapsed, std::memory_order_relaxed);
+    if (elapsed > e.max_tick_ns.load(std::memory_order_relaxed)) {
+        e.max_tick_ns.store(elapsed, std::memory_order_relaxed);   // Only this service's ticks write it
+    }
+    if (e.budget_ns && elapsed > e.budget_ns) e.overruns.fetch_add(1, std::memory_order_relaxed);
+    if (e.has_histogram) options_.metrics->record(e.histogram, elapsed);
+}
+
+std::expected<void, std::error_code> service_host::run(std::atomic<bool> const& stop) {
+    while (!stop.load(std::memory_order_acquire)) {
+        uint64_t frame_start = now();
+        auto ticked = tick();
+        if (!ticked) {
+            return ticked;
+        }
+        if (options_.frame_interval_ns) {
+            uint64_t elapsed = now() - frame_start;
+            if (elapsed < options_.frame_interval_ns) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(options_.frame_interval_ns - elapsed));
+            }
+        }
+    }
+    return {};
+}
+
+std::expected<void, std::error_code> service_host::shutdown() {
+    if (state_ != host_state::running) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+
+    for (auto phase = phases_.rbegin(); phase != phases_.rend(); ++phase) {
+        for (auto e = phase->rbegin(); e != phase->rend(); ++e) (*e)->service->shutdown();
+    }
+    state_ = host_state::stopped;
+    return {};
+}
+
+service_stats service_host::stats(service_id id) const noexcept {
+    if (id.index >= entries_.size()) return {};
+    entry const& e = *entries_[id.index];
+    return {e.ticks.load(std::memory_order_relaxed),        e.skipped.load(std::memory_order_relaxed),
+            e.overruns.load(std::memory_order_relaxed),     e.last_tick_ns.load(std::memory_order_relaxed),
+            e.max_tick_ns.load(std::memory_order_relaxed),  e.total_tick_ns.load(std::memory_order_relaxed)};
+}
+
+std::size_t service_host::phase_of(service_id id) const noexcept {
+    return id.index < entries_.size() ? entries_[id.index]->phase : 0;
+}
+
+uint64_t service_host::frames() const noexcept {
+    return frames_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <ion/core/lifecycle/service_host.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ion::core::detail {
+
+class service_host final : public service_host_base {
+public:
+    explicit service_host(service_host_options const& options) noexcept : options_(options) {}
+    ~service_host() override = default;
+
+    service_host(service_host const&) = delete;
+    service_host& operator=(service_host const&) = delete;
+
+    std::expected<service_id, std::error_code> add(service_base& service, service_options const& options) override;
+    std::expected<void, std::error_code> init() override;
+    std::expected<void, std::error_code> tick() override;
+    std::expected<void, std::error_code> run(std::atomic<bool> const& stop) override;
+    std::expected<void, std::error_code> shutdown() override;
+    service_stats stats(service_id id) const noexcept override;
+    std::size_t phase_of(service_id id) const noexcept override;
+    uint64_t frames() const noexcept override;
+
+private:
+    enum class host_state : uint8_t { adding, running, stopped };
+
+    struct entry {
+        service_base* service;
+        std::string name;
+        std::size_t phase;
+        uint64_t interval_ns;
+        uint64_t budget_ns;
+        bool skippable;
+        bool has_histogram = false;
+        histogram_id histogram;
+        uint64_t next_due_ns = 0;   // Touched only by the thread running the frame
+
+        // Written by whichever thread ticks the service, read by stats()
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<uint64_t> overruns{0};
+        std::atomic<uint64_t> last_tick_ns{0};
+        std::atomic<uint64_t> max_tick_ns{0};
+        std::atomic<uint64_t> total_tick_ns{0};
+    };
+
+    void run_phase(std::span<entry* const> due);
+    void run_one(entry& e);
+    uint64_t now() const { return options_.clock ? options_.clock->now_ns() : 0; }
+
+    service_host_options options_;
+    host_state state_ = host_state::adding;
+    std::vector<std::unique_ptr<entry>> entries_;
+    std::vector<std::vector<entry*>> phases_;
+    std::vector<entry*> due_;          // The phase being run; sized at init() so frames never allocate
+    std::atomic<uint64_t> frames_{0};
+
+    // Services of the running phase still on the executor
+    std::mutex phase_mutex_;
+    std::condition_variable phase_done_;
+    std::size_t pending_ = 0;
+};
+
+} // namespace ion::core::detail
@@ -0,0 +1,175 @@
+#include "async_logger_impl.h"
+#include "thread/thread_slot.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+#include <thread>
+
+using namespace ion::core::detail;
+using namespace ion::core;
+
+namespace {
+
+constexpr std::size_t k_max_log_rings   = 16;
+constexpr std::size_t k_log_drain_batch = 64;
+
+} // namespace
+
+async_logger::async_logger(async_logger_options const& options)
+    : level_(static_cast<int>(options.level)),
+      writer_(options.writer),
+      executor_(options.executor),
+      clock_(options.clock),
+      drain_threshold_(std::clamp<std::size_t>(options.drain_threshold, 1, k_log_ring_slots)) {
+    std::size_t rings = options.shard_count ? options.shard_count : std::max(1u, std::thread::hardware_concurrency());
+    rings = std::bit_ceil(std::min(rings, k_max_log_rings));
+    ring_mask_ = rings - 1;
+    rings_.reserve(rings);
+    for (std::size_t i = 0; i < rings; ++i) rings_.push_back(std::make_unique<record_ring>());
+    lines_.resize(k_log_drain_batch);
+    entries_.reserve(k_log_drain_batch);
+}
+
+async_logger::~async_logger() {
+    {
+        std::unique_lock lock(queued_mutex_);
+        drain_done_.wait(lock, [this] { return !drain_queued_.load(std::memory_order_acquire); });
+    }
+    flush();
+}
+
+void async_logger::log(log_level level, std::string_view msg) {
+    if (!is_enabled(level)) return;
+    push(level, nullptr, {}, std::as_bytes(std::span{msg}));
+}
+
+void async_logger::log_captured(log_level level, log_args const& args) {
+    push(level, args.format, args.fmt, args.bytes);
+}
+
+bool async_logger::is_enabled(log_level level) const {
+    return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+}
+
+void async_logger::set_level(log_level level) noexcept {
+    level_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+uint64_t async_logger::dropped() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void async_logger::push(log_level level, log_format_fn format, std::string_view fmt, std::span<const std::byte> bytes) {
+    // Captured arguments always fit; an oversized preformatted message goes to the heap
+    record_header header{format, fmt.data(), fmt.size(), nullptr, 0, clock_ ? clock_->now_ns() : 0, level};
+    std::size_t size = bytes.size();
+    if (size > k_log_slot_size - sizeof(header)) {
+        header.spilled = new (std::nothrow) char[size];
+        if (!header.spilled) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::memcpy(header.spilled, bytes.data(), size);
+        header.spilled_size = size;
+        size = 0;
+    }
+
+    auto& ring = *rings_[thread_slot() & ring_mask_];
+    auto batch = ring.try_reserve();
+    if (batch.empty()) {
+        delete[] header.spilled;
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& slot = batch[0];
+    (void)slot.resize_uninitialized(sizeof(header) + size);
+    std::byte* out = slot.mutate().data();
+    std::memcpy(out, &header, sizeof(header));
+    if (size) std::memcpy(out + sizeof(header), bytes.data(), size);
+    ring.commit(batch);
+
+    if (executor_ && (level >= log_level::warning || ring.size_approx() >= drain_threshold_)) {
+        schedule_drain();
+    }
+}
+
+/**
+ * @brief Hands a drain to the executor, once per backlog.
+ *
+ * A request that finds a drain already queued leaves drain_requested_ set
+ * instead. The running drain may have passed the ring that request wrote
+ * to, so it checks the flag after clearing drain_queued_ and drains again.
+ * Both sides store one flag and then read the other, so a request is never
+ * lost between them.
+ */
+void async_logger::schedule_drain() {
+    drain_requested_.store(true, std::memory_order_seq_cst);
+    if (drain_queued_.load(std::memory_order_seq_cst) || drain_queued_.exchange(true, std::memory_order_seq_cst)) {
+        return;
+    }
+
+    executor_->execute([this] {
+        for (;;) {
+            // Taking the flag also makes the records of whoever set it visible
+            (void)drain_requested_.exchange(false, std::memory_order_seq_cst);
+            {
+                std::lock_guard lock(drain_mutex_);
+                drain();
+            }
+
+            // Notify under the lock: once it is released the logger may be gone
+            std::lock_guard lock(queued_mutex_);
+            drain_queued_.store(false, std::memory_order_seq_cst);
+            if (drain_requested_.load(std::memory_order_seq_cst) &&
+                !drain_queued_.exchange(true, std::memory_order_seq_cst)) {
+                continue;
+            }
+            drain_done_.notify_all();
+            return;
+        }
+    });
+}
+
+void async_logger::flush() {
+    std::lock_guard lock(drain_mutex_);
+    drain();
+}
+
+void async_logger::drain() {
+    for (auto& ring : rings_) {
+        for (;;) {
+            auto taken = ring->try_consume(k_log_drain_batch);
+            if (taken.empty()) break;
+
+            entries_.clear();
+            for (std::size_t i = 0; i < taken.size(); ++i) {
+                auto record = taken[i].view();
+                record_header header;
+                std::memcpy(&header, record.data(), sizeof(header));
+                auto args = record.subspan(sizeof(header));
+
+                auto& line = lines_[i];
+                line.clear();
+                if (header.spilled) {
+                    line.assign(header.spilled, header.spilled_size);
+                    delete[] header.spilled;
+                } else if (header.format) {
+                    try {
+                        header.format({header.fmt, header.fmt_size}, args, line);
+                    } catch (...) {
+                        line.assign("<unformattable log record>");
+                    }
+                } else {
+                    line.assign(reinterpret_cast<char const*>(args.data()), args.size());
+                }
+                entries_.push_back({header.level, header.timestamp_ns, line});
+            }
+            // Every record is copied out, so producers may reuse the slots while we write
+            ring->release(taken);
+            writer_->write(entries_);
+        }
+    }
+}
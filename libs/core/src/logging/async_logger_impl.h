@@ -0,0 +1,79 @@
+#pragma once
+
+#include <ion/core/logging/async_logger.h>
+#include <ion/core/buffer/ring_buffer.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ion::core::detail {
+
+// One record per ring slot: a record_header followed by the captured arguments
+inline constexpr std::size_t k_log_slot_size  = 512;
+inline constexpr std::size_t k_log_ring_slots = 256;
+
+class async_logger final : public async_logger_base {
+public:
+    explicit async_logger(async_logger_options const& options);
+    ~async_logger() override;
+
+    async_logger(async_logger const&) = delete;
+    async_logger& operator=(async_logger const&) = delete;
+
+    using logger_base::log;
+
+    void log(log_level level, std::string_view msg) override;
+    bool is_enabled(log_level level) const override;
+    void set_level(log_level level) noexcept override;
+    void flush() override;
+    uint64_t dropped() const noexcept override;
+
+protected:
+    void log_captured(log_level level, log_args const& args) override;
+
+private:
+    using record_ring = ring_buffer<k_log_slot_size, k_log_ring_slots, ring_producers::multiple>;
+
+    struct record_header {
+        log_format_fn format;        // Null for a message logged preformatted
+        char const* fmt;
+        std::size_t fmt_size;
+        char* spilled;               // Heap copy of a preformatted message too big for its slot
+        std::size_t spilled_size;
+        uint64_t timestamp_ns;
+        log_level level;
+    };
+    static_assert(sizeof(record_header) + k_log_args_capacity <= k_log_slot_size,
+                  "captured arguments must fit in a ring slot");
+
+    void push(log_level level, log_format_fn format, std::string_view fmt, std::span<const std::byte> bytes);
+    void schedule_drain();
+    void drain();                    // Caller holds drain_mutex_
+
+    std::atomic<int> level_;
+    log_writer_base* writer_;
+    executor_base* executor_;
+    clock_base const* clock_;
+    std::size_t drain_threshold_;
+
+    std::vector<std::unique_ptr<record_ring>> rings_;
+    std::size_t ring_mask_;
+    std::atomic<uint64_t> dropped_{0};
+
+    // The consumer side: one drain at a time, with its buffers reused across drains
+    std::mutex drain_mutex_;
+    std::vector<std::string> lines_;
+    std::vector<log_entry> entries_;
+
+    std::atomic<bool> drain_queued_{false};      // A drain task sits on executor_
+    std::atomic<bool> drain_requested_{false};   // A producer asked for a drain since the last one began
+    std::mutex queued_mutex_;
+    std::condition_variable drain_done_;
+};
+
+} // namespace ion::core::detail
@@ -0,0 +1,23 @@
+#include <ion/core/logging.h>
+#include "async_logger_impl.h"
+#include "stderr_log_writer_impl.h"
+
+namespace ion::core
+{
+
+std::expected<std::unique_ptr<log_writer_base>, std::error_code>
+make_stderr_log_writer()
+{
+    return std::make_unique<detail::stderr_log_writer>();
+}
+
+std::expected<std::unique_ptr<async_logger_base>, std::error_code>
+make_async_logger(async_logger_options options)
+{
+    if (!options.writer) {
+        return std::unexpected(make_error_code(core_errc::invalid_argument));
+    }
+    return std::make_unique<detail::async_logger>(options);
+}
+
+} // namespace ion::core
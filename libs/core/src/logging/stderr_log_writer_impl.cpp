@@ -0,0 +1,36 @@
+#include "stderr_log_writer_impl.h"
+
+#include <cstdio>
+#include <format>
+#include <iterator>
+
+using namespace ion::core::detail;
+using namespace ion::core;
+
+namespace {
+
+std::string_view level_name(log_level level) noexcept {
+    switch (level) {
+        case log_level::trace:    return "trace";
+        case log_level::debug:    return "debug";
+        case log_level::info:     return "info";
+        case log_level::warning:  return "warning";
+        case log_level::error:    return "error";
+        case log_level::critical: return "critical";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+void stderr_log_writer::write(std::span<const log_entry> batch) {
+    text_.clear();
+    for (auto const& entry : batch) {
+        if (entry.timestamp_ns) {
+            std::format_to(std::back_inserter(text_), "{} [{}] {}\n", entry.timestamp_ns, level_name(entry.level), entry.message);
+        } else {
+            std::format_to(std::back_inserter(text_), "[{}] {}\n", level_name(entry.level), entry.message);
+        }
+    }
+    std::fwrite(text_.data(), 1, text_.size(), stderr);
+}
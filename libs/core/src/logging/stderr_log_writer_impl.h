@@ -0,0 +1,16 @@
+#pragma once
+
+#include <ion/core/logging/async_logger.h>
+#include <string>
+
+namespace ion::core::detail {
+
+class stderr_log_writer final : public log_writer_base {
+public:
+    void write(std::span<const log_entry> batch) override;
+
+private:
+    std::string text_;   // Reused so a batch costs no allocation once warm
+};
+
+} // namespace ion::core::detail
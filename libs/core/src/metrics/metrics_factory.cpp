@@ -0,0 +1,17 @@
+#include <ion/core/metrics.h>
+#include "metrics_registry_impl.h"
+
+namespace ion::core
+{
+
+std::expected<std::unique_ptr<metrics_registry_base>, std::error_code>
+make_metrics_registry(metrics_registry_options options)
+{
+    try {
+        return std::make_unique<detail::metrics_registry>(options);
+    } catch (std::bad_alloc const&) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    }
+}
+
+} // namespace ion::core
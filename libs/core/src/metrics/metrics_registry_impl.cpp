@@ -0,0 +1,160 @@
+#include "metrics_registry_impl.h"
+#include "thread/thread_slot.h"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <thread>
+
+using namespace ion::core::detail;
+using namespace ion::core;
+
+namespace {
+
+constexpr std::size_t k_max_metrics_shards = 16;
+
+constexpr std::size_t lines_for(std::size_t cells) noexcept {
+    return (cells + k_metric_cells_per_line - 1) / k_metric_cells_per_line;
+}
+
+} // namespace
+
+metrics_registry::metrics_registry(metrics_registry_options const& options) {
+    std::size_t shards = options.shard_count ? options.shard_count : std::max(1u, std::thread::hardware_concurrency());
+    shards = std::bit_ceil(std::min(shards, k_max_metrics_shards));
+    shard_mask_ = shards - 1;
+
+    histogram_base_ = lines_for(options.max_counters) * k_metric_cells_per_line;
+    histogram_stride_ = lines_for(k_histogram_first_bucket + k_histogram_bucket_count) * k_metric_cells_per_line;
+    lines_per_shard_ = lines_for(histogram_base_ + histogram_stride_ * options.max_histograms);
+    lines_ = std::make_unique<metric_line[]>(lines_per_shard_ * shards);
+    gauges_ = std::make_unique<metric_line[]>(lines_for(options.max_gauges));
+
+    counters_.limit = options.max_counters;
+    gauge_names_.limit = options.max_gauges;
+    histograms_.limit = options.max_histograms;
+    for (name_table* table : {&counters_, &gauge_names_, &histograms_}) {
+        table->ids.reserve(table->limit);
+        table->names.reserve(table->limit);
+    }
+}
+
+void metrics_registry::increment(std::string_view name, uint64_t value) {
+    if (auto id = register_counter(name); id.has_value()) add(*id, value);
+}
+
+void metrics_registry::gauge(std::string_view name, double value) {
+    if (auto id = register_gauge(name); id.has_value()) set(*id, value);
+}
+
+void metrics_registry::timing(std::string_view name, uint64_t nanoseconds) {
+    if (auto id = register_histogram(name); id.has_value()) record(*id, nanoseconds);
+}
+
+std::expected<counter_id, std::error_code>
+metrics_registry::register_counter(std::string_view name) {
+    auto index = lookup(counters_, name);
+    if (!index.has_value()) return std::unexpected(index.error());
+    return counter_id{*index};
+}
+
+std::expected<gauge_id, std::error_code>
+metrics_registry::register_gauge(std::string_view name) {
+    auto index = lookup(gauge_names_, name);
+    if (!index.has_value()) return std::unexpected(index.error());
+    return gauge_id{*index};
+}
+
+std::expected<histogram_id, std::error_code>
+metrics_registry::register_histogram(std::string_view name) {
+    auto index = lookup(histograms_, name);
+    if (!index.has_value()) return std::unexpected(index.error());
+    return histogram_id{*index};
+}
+
+void metrics_registry::add(counter_id id, uint64_t value) noexcept {
+    if (id.index >= counters_.limit) return;
+    cell(local_shard(), id.index).fetch_add(value, std::memory_order_relaxed);
+}
+
+void metrics_registry::set(gauge_id id, double value) noexcept {
+    if (id.index >= gauge_names_.limit) return;
+    gauges_[id.index / k_metric_cells_per_line].cells[id.index % k_metric_cells_per_line].store(
+        std::bit_cast<uint64_t>(value), std::memory_order_relaxed);
+}
+
+void metrics_registry::record(histogram_id id, uint64_t value) noexcept {
+    if (id.index >= histograms_.limit) return;
+    std::size_t shard = local_shard();
+    std::size_t base = histogram_base_ + histogram_stride_ * id.index;
+    cell(shard, base + k_histogram_count_cell).fetch_add(1, std::memory_order_relaxed);
+    cell(shard, base + k_histogram_sum_cell).fetch_add(value, std::memory_order_relaxed);
+    cell(shard, base + k_histogram_first_bucket + histogram_bucket_of(value)).fetch_add(1, std::memory_order_relaxed);
+}
+
+std::expected<metrics_snapshot, std::error_code>
+metrics_registry::scrape() const {
+    try {
+        metrics_snapshot snapshot;
+        std::lock_guard lock(names_mutex_);
+
+        snapshot.counters.reserve(counters_.names.size());
+        for (std::size_t i = 0; i < counters_.names.size(); ++i) {
+            snapshot.counters.push_back({counters_.names[i], sum_cell(i)});
+        }
+
+        snapshot.gauges.reserve(gauge_names_.names.size());
+        for (std::size_t i = 0; i < gauge_names_.names.size(); ++i) {
+            uint64_t bits = gauges_[i / k_metric_cells_per_line].cells[i % k_metric_cells_per_line].load(std::memory_order_relaxed);
+            snapshot.gauges.push_back({gauge_names_.names[i], std::bit_cast<double>(bits)});
+        }
+
+        snapshot.histograms.reserve(histograms_.names.size());
+        for (std::size_t i = 0; i < histograms_.names.size(); ++i) {
+            std::size_t base = histogram_base_ + histogram_stride_ * i;
+            histogram_sample sample{histograms_.names[i], sum_cell(base + k_histogram_count_cell),
+                                    sum_cell(base + k_histogram_sum_cell),
+                                    std::vector<uint64_t>(k_histogram_bucket_count)};
+            for (std::size_t b = 0; b < k_histogram_bucket_count; ++b) {
+                sample.buckets[b] = sum_cell(base + k_histogram_first_bucket + b);
+            }
+            snapshot.histograms.push_back(std::move(sample));
+        }
+        return snapshot;
+    } catch (std::bad_alloc const&) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    }
+}
+
+std::expected<uint32_t, std::error_code>
+metrics_registry::lookup(name_table& table, std::string_view name) {
+    try {
+        std::lock_guard lock(names_mutex_);
+        if (auto it = table.ids.find(name); it != table.ids.end()) return it->second;
+        if (table.names.size() >= table.limit) {
+            return std::unexpected(make_error_code(core_errc::index_out_of_range));
+        }
+        auto index = static_cast<uint32_t>(table.names.size());
+        table.names.emplace_back(name);
+        table.ids.emplace(table.names.back(), index);
+        return index;
+    } catch (std::bad_alloc const&) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    }
+}
+
+std::atomic<uint64_t>& metrics_registry::cell(std::size_t shard, std::size_t index) const noexcept {
+    return lines_[shard * lines_per_shard_ + index / k_metric_cells_per_line].cells[index % k_metric_cells_per_line];
+}
+
+std::size_t metrics_registry::local_shard() const noexcept {
+    return thread_slot() & shard_mask_;
+}
+
+uint64_t metrics_registry::sum_cell(std::size_t index) const noexcept {
+    uint64_t total = 0;
+    for (std::size_t shard = 0; shard <= shard_mask_; ++shard) {
+        total += cell(shard, index).load(std::memory_order_relaxed);
+    }
+    return total;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <ion/core/metrics/metrics_registry.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ion::core::detail {
+
+inline constexpr std::size_t k_metric_cells_per_line = 8;
+
+// One cache line of metric cells; no two shards share a line
+struct alignas(64) metric_line {
+    std::atomic<uint64_t> cells[k_metric_cells_per_line];
+};
+
+class metrics_registry final : public metrics_registry_base {
+public:
+    explicit metrics_registry(metrics_registry_options const& options);
+
+    metrics_registry(metrics_registry const&) = delete;
+    metrics_registry& operator=(metrics_registry const&) = delete;
+
+    void increment(std::string_view name, uint64_t value) override;
+    void gauge(std::string_view name, double value) override;
+    void timing(std::string_view name, uint64_t nanoseconds) override;
+
+    std::expected<counter_id, std::error_code> register_counter(std::string_view name) override;
+    std::expected<gauge_id, std::error_code> register_gauge(std::string_view name) override;
+    std::expected<histogram_id, std::error_code> register_histogram(std::string_view name) override;
+
+    void add(counter_id id, uint64_t value) noexcept override;
+    void set(gauge_id id, double value) noexcept override;
+    void record(histogram_id id, uint64_t value) noexcept override;
+
+    std::expected<metrics_snapshot, std::error_code> scrape() const override;
+
+private:
+    struct name_hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    // The names of one metric kind, in registration order
+    struct name_table {
+        std::unordered_map<std::string, uint32_t, name_hash, std::equal_to<>> ids;
+        std::vector<std::string> names;
+        uint32_t limit = 0;
+    };
+
+    // Histogram cells: count, sum, then the buckets
+    static constexpr std::size_t k_histogram_count_cell = 0;
+    static constexpr std::size_t k_histogram_sum_cell = 1;
+    static constexpr std::size_t k_histogram_first_bucket = 2;
+
+    std::expected<uint32_t, std::error_code> lookup(name_table& table, std::string_view name);
+    std::atomic<uint64_t>& cell(std::size_t shard, std::size_t index) const noexcept;
+    std::size_t local_shard() const noexcept;
+    uint64_t sum_cell(std::size_t index) const noexcept;
+
+    std::size_t shard_mask_;
+    std::size_t histogram_base_;     // Cell index of the first histogram within a shard
+    std::size_t histogram_stride_;   // Cells per histogram, a whole number of lines
+    std::size_t lines_per_shard_;
+    std::unique_ptr<metric_line[]> lines_;
+    std::unique_ptr<metric_line[]> gauges_;
+
+    mutable std::mutex names_mutex_;
+    name_table counters_;
+    name_table gauge_names_;
+    name_table histograms_;
+};
+
+} // namespace ion::core::detail
@@ -0,0 +1,280 @@
+/**
+ * @file binary_snapshot.cpp
+ * @brief Offset-addressed binary encoding of a whole cow_node tree.
+ *
+ * Layout (all integers little-endian):
+ *
+ *     header : u32 magic "IVSB" | u32 version | u32 key count | u32 reserved
+ *              | u64 key dictionary offset | u64 root offset
+ *     nodes  : node*, each written after all of its children
+ *     keys   : str*, referenced by index from object entries
+ *     node   : u8 node_kind | scalar bytes
+ *              | array : u32 count | u64 child offset*
+ *              | object: u32 count | (u32 key index | u64 child offset)*, sorted by key
+ *     str    : u32 length | bytes
+ *
+ * Children always precede their parent, so every child offset is smaller
+ * than the offset of the node referring to it and decoding cannot loop.
+ */
+
+#include "binary_snapshot.h"
+#include "byte_codec.h"
+
+#include <bit>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+constexpr uint32_t k_snapshot_magic       = 0x42535649;  // "IVSB"
+constexpr uint32_t k_snapshot_version     = 1;
+constexpr size_t   k_snapshot_header_size = 32;
+constexpr size_t   k_max_snapshot_depth   = 1024;
+
+/**
+ * Writes nodes children first. A tree the reader would reject, nested
+ * deeper than k_max_snapshot_depth or holding a count or length that does
+ * not fit in a u32, marks the writer failed instead of producing a file
+ * that can never be reopened.
+ */
+class snapshot_writer {
+public:
+    explicit snapshot_writer(std::string& out) : out_(out) {}
+
+    uint64_t write(cow_node const& n, size_t depth) {
+        if (depth > k_max_snapshot_depth) {
+            failed_ = true;
+            return 0;
+        }
+        switch (n.kind()) {
+            case node_kind::array: {
+                std::vector<uint64_t> children;
+                children.reserve(n.size());
+                for (auto const& item : n.elements()) {
+                    children.push_back(write(*item, depth + 1));
+                    if (failed_) return 0;
+                }
+
+                uint64_t offset = out_.size();
+                put_u8(out_, static_cast<uint8_t>(n.kind()));
+                put_len(children.size());
+                for (auto child : children) put_u64(out_, child);
+                return offset;
+            }
+            case node_kind::object: {
+                std::vector<uint64_t> children;
+                children.reserve(n.size());
+                for (auto const& entry : n.entries()) {
+                    children.push_back(write(*entry.value, depth + 1));
+                    if (failed_) return 0;
+                }
+
+                uint64_t offset = out_.size();
+                put_u8(out_, static_cast<uint8_t>(n.kind()));
+                put_len(children.size());
+                for (size_t i = 0; i < children.size(); ++i) {
+                    put_u32(out_, key_id(n.entries()[i].key));
+                    put_u64(out_, children[i]);
+                }
+                return offset;
+            }
+            default:
+                break;
+        }
+
+        uint64_t offset = out_.size();
+        put_u8(out_, static_cast<uint8_t>(n.kind()));
+        switch (n.kind()) {
+            case node_kind::boolean:  put_u8(out_, n.as_bool() ? 1 : 0); break;
+            case node_kind::integer:  put_u64(out_, static_cast<uint64_t>(n.as_int())); break;
+            case node_kind::floating: put_u64(out_, std::bit_cast<uint64_t>(n.as_double())); break;
+            case node_kind::string:
+            case node_kind::opaque:   put_text(n.as_string()); break;
+            default:                  break;
+        }
+        return offset;
+    }
+
+    void write_keys() {
+        for (auto key : keys_) put_text(key);
+    }
+
+    uint32_t key_count() const noexcept { return static_cast<uint32_t>(keys_.size()); }
+    bool failed() const noexcept { return failed_; }
+
+private:
+    static constexpr size_t k_max_len = std::numeric_limits<uint32_t>::max();
+
+    void put_len(size_t len) {
+        if (len > k_max_len) failed_ = true;
+        put_u32(out_, static_cast<uint32_t>(len));
+    }
+
+    void put_text(std::string_view text) {
+        put_len(text.size());
+        if (!failed_) out_.append(text);
+    }
+
+    uint32_t key_id(std::string_view key) {
+        auto [it, inserted] = key_ids_.try_emplace(key, static_cast<uint32_t>(keys_.size()));
+        if (inserted) {
+            if (keys_.size() == k_max_len) failed_ = true;
+            keys_.push_back(key);
+        }
+        return it->second;
+    }
+
+    std::string& out_;
+    std::vector<std::string_view> keys_;   // Views into the tree being written
+    std::unordered_map<std::string_view, uint32_t> key_ids_;
+    bool failed_ = false;
+};
+
+class snapshot_reader {
+public:
+    snapshot_reader(std::string_view data, std::vector<std::string_view> keys, uint64_t nodes_end)
+        : data_(data), keys_(std::move(keys)), nodes_end_(nodes_end),
+          budget_(nodes_end - k_snapshot_header_size) {}
+
+    /**
+     * Decodes the node at `offset`, which must lie below `limit` (the
+     * referring node's offset). The node budget bounds the work a crafted
+     * file whose nodes share children can cause: a real snapshot never holds
+     * more nodes than it has bytes.
+     */
+    node_ref read(uint64_t offset, uint64_t limit, size_t depth) {
+        if (depth > k_max_snapshot_depth || offset < k_snapshot_header_size || offset >= limit || budget_ == 0) {
+            return {};
+        }
+        --budget_;
+
+        byte_reader in(data_.substr(offset, nodes_end_ - offset));
+        uint8_t kind = 0;
+        if (!in.u8(kind)) return {};
+
+        switch (static_cast<node_kind>(kind)) {
+            case node_kind::null:
+                return cow_node::make_null();
+            case node_kind::boolean: {
+                uint8_t v = 0;
+                return in.u8(v) ? cow_node::make_bool(v != 0) : node_ref{};
+            }
+            case node_kind::integer: {
+                uint64_t v = 0;
+                return in.u64(v) ? cow_node::make_int(static_cast<int64_t>(v)) : node_ref{};
+            }
+            case node_kind::floating: {
+                uint64_t v = 0;
+                return in.u64(v) ? cow_node::make_double(std::bit_cast<double>(v)) : node_ref{};
+            }
+            case node_kind::string:
+            case node_kind::opaque: {
+                std::string_view v;
+                if (!in.str(v)) return {};
+                return static_cast<node_kind>(kind) == node_kind::string ? cow_node::make_string(v)
+                                                                         : cow_node::make_opaque(v);
+            }
+            case node_kind::array: {
+                uint32_t count = 0;
+                if (!in.u32(count) || count > in.remaining() / 8) return {};
+                auto arr = cow_node::make_array();
+                arr->elements().reserve(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    uint64_t child = 0;
+                    if (!in.u64(child)) return {};
+                    auto item = read(child, offset, depth + 1);
+                    if (!item) return {};
+                    arr->elements().push_back(std::move(item));
+                }
+                return arr;
+            }
+            case node_kind::object: {
+                uint32_t count = 0;
+                if (!in.u32(count) || count > in.remaining() / 12) return {};
+                auto obj = cow_node::make_object();
+                obj->entries().reserve(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    uint32_t key = 0;
+                    uint64_t child = 0;
+                    if (!in.u32(key) || !in.u64(child) || key >= keys_.size()) return {};
+                    auto value = read(child, offset, depth + 1);
+                    if (!value) return {};
+                    // Entries arrive sorted, so this appends
+                    obj->insert_or_assign(keys_[key], std::move(value));
+                }
+                return obj;
+            }
+        }
+        return {};
+    }
+
+private:
+    std::string_view data_;
+    std::vector<std::string_view> keys_;
+    uint64_t nodes_end_;
+    uint64_t budget_;
+};
+
+std::unexpected<std::error_code> malformed_snapshot() {
+    return std::unexpected(make_error_code(core_errc::parse_error));
+}
+
+}  // namespace
+
+std::expected<std::string, std::error_code> ion::core::detail::encode_snapshot(cow_node const& root) {
+    std::string out(k_snapshot_header_size, '\0');
+    snapshot_writer writer(out);
+    uint64_t root_offset = writer.write(root, 0);
+    uint64_t keys_offset = out.size();
+    if (!writer.failed()) writer.write_keys();
+    if (writer.failed()) {
+        return std::unexpected(make_error_code(core_errc::invalid_argument));
+    }
+
+    std::string header;
+    put_u32(header, k_snapshot_magic);
+    put_u32(header, k_snapshot_version);
+    put_u32(header, writer.key_count());
+    put_u32(header, 0);
+    put_u64(header, keys_offset);
+    put_u64(header, root_offset);
+    out.replace(0, header.size(), header);
+    return out;
+}
+
+std::expected<node_ref, std::error_code> ion::core::detail::decode_snapshot(std::string_view data) {
+    byte_reader header(data);
+    uint32_t magic = 0, version = 0, key_count = 0, reserved = 0;
+    uint64_t keys_offset = 0, root_offset = 0;
+    if (!header.u32(magic) || !header.u32(version) || !header.u32(key_count) || !header.u32(reserved) ||
+        !header.u64(keys_offset) || !header.u64(root_offset)) {
+        return malformed_snapshot();
+    }
+    if (magic != k_snapshot_magic || version != k_snapshot_version || keys_offset < k_snapshot_header_size ||
+        keys_offset > data.size()) {
+        return malformed_snapshot();
+    }
+
+    byte_reader dictionary(data.substr(keys_offset));
+    if (key_count > dictionary.remaining() / 4) {
+        return malformed_snapshot();
+    }
+    std::vector<std::string_view> keys(key_count);
+    for (auto& key : keys) {
+        if (!dictionary.str(key)) return malformed_snapshot();
+    }
+    if (!dictionary.at_end()) {
+        return malformed_snapshot();
+    }
+
+    snapshot_reader reader(data, std::move(keys), keys_offset);
+    auto root = reader.read(root_offset, keys_offset, 0);
+    if (!root || !root->is_object()) {
+        return malformed_snapshot();
+    }
+    return root;
+}
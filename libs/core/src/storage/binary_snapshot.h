@@ -0,0 +1,35 @@
+#pragma once
+
+#include <ion/core/error.h>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "cow_node.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief Encodes `root` as a binary snapshot.
+ *
+ * Nodes are written children first and refer to each other by file offset,
+ * so a reader can jump straight to any subtree; object keys are stored once
+ * in a shared dictionary and referenced by index.
+ * @return The encoded bytes, or core_errc::invalid_argument if `root` nests
+ *         deeper than decode_snapshot() accepts or holds a count or string
+ *         length above 2^32 - 1.
+ */
+std::expected<std::string, std::error_code> encode_snapshot(cow_node const& root);
+
+/**
+ * @brief Decodes a snapshot produced by encode_snapshot().
+ *
+ * Every offset, length and count is bounds-checked, so untrusted or torn
+ * input yields an error rather than undefined behaviour.
+ * @return The root object, or core_errc::parse_error if `data` is not a
+ *         well-formed snapshot.
+ */
+std::expected<node_ref, std::error_code> decode_snapshot(std::string_view data);
+
+}  // namespace ion::core::detail
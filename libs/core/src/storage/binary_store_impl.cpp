@@ -0,0 +1,46 @@
+/**
+ * @file binary_store_impl.cpp
+ * @brief Implementation of the binary_store class for snapshot-based storage.
+ *
+ * The base file is decoded straight into the cow_node tree without a text
+ * parser or an intermediate document, and keys are interned once per file.
+ */
+
+#include "binary_store_impl.h"
+#include "binary_snapshot.h"
+#include "cow_transaction.h"
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+/**
+ * @brief Constructs a binary_store instance.
+ * @param path Filesystem path to the snapshot file.
+ * @param options Options for configuring the binary store.
+ */
+binary_store::binary_store(std::filesystem::path const& path, binary_store_options const& options)
+    : file_store(path, file_options_of(options)) { }
+
+/**
+ * @brief Destructor for binary_store.
+ *
+ * Ensures the store is properly closed if it is still open.
+ */
+binary_store::~binary_store() {
+    close_on_destroy();
+}
+
+std::expected<node_ref, std::error_code> binary_store::parse(std::string_view content) {
+    return decode_snapshot(content);
+}
+
+std::expected<std::string, std::error_code> binary_store::serialize(cow_node const& root) {
+    return encode_snapshot(root);
+}
+
+/**
+ * @brief Creates a transaction on `snapshot` with the JSON value rules.
+ */
+std::unique_ptr<transaction_base> binary_store::make_transaction(node_ref snapshot, uint64_t txn_id) {
+    return std::make_unique<cow_transaction>(std::move(snapshot), this, cow_rules{}, txn_id);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/store.h>
+
+#include "file_store.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief File store whose base file is a binary snapshot (see binary_snapshot.h).
+ *
+ * Values follow the JSON store's rules (the default cow_rules).
+ */
+class binary_store final : public file_store {
+public:
+    binary_store(std::filesystem::path const& path, binary_store_options const& options);
+    ~binary_store() override;
+
+private:
+    std::expected<node_ref, std::error_code> parse(std::string_view content) override;
+    std::expected<std::string, std::error_code> serialize(cow_node const& root) override;
+    std::unique_ptr<transaction_base> make_transaction(node_ref snapshot, uint64_t txn_id) override;
+};
+
+}  // namespace ion::core::detail
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ion::core::detail {
+
+/// @name Little-endian encoding into a growing byte string.
+/// @{
+inline void put_u8(std::string& out, uint8_t v) {
+    out.push_back(static_cast<char>(v));
+}
+
+inline void put_u32(std::string& out, uint32_t v) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) bytes[i] = static_cast<char>(v >> (8 * i));
+    out.append(bytes, sizeof(bytes));
+}
+
+inline void put_u64(std::string& out, uint64_t v) {
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) bytes[i] = static_cast<char>(v >> (8 * i));
+    out.append(bytes, sizeof(bytes));
+}
+
+inline void put_str(std::string& out, std::string_view v) {
+    put_u32(out, static_cast<uint32_t>(v.size()));
+    out.append(v);
+}
+/// @}
+
+/**
+ * @brief Bounds-checked little-endian reader over a byte string.
+ *
+ * Every read returns false once the input is exhausted and leaves the reader
+ * failed, so a decoder can check once at the end of a record.
+ */
+class byte_reader {
+public:
+    explicit byte_reader(std::string_view data) noexcept : data_(data) {}
+
+    bool u8(uint8_t& v) noexcept {
+        if (!need(1)) return false;
+        v = static_cast<uint8_t>(data_[pos_++]);
+        return true;
+    }
+
+    bool u32(uint32_t& v) noexcept {
+        if (!need(4)) return false;
+        v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(static_cast<uint8_t>(data_[pos_++])) << (8 * i);
+        return true;
+    }
+
+    bool u64(uint64_t& v) noexcept {
+        if (!need(8)) return false;
+        v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(static_cast<uint8_t>(data_[pos_++])) << (8 * i);
+        return true;
+    }
+
+    bool str(std::string_view& v) noexcept {
+        uint32_t len = 0;
+        if (!u32(len) || !need(len)) return false;
+        v = data_.substr(pos_, len);
+        pos_ += len;
+        return true;
+    }
+
+    bool bytes(size_t len, std::string_view& v) noexcept {
+        if (!need(len)) return false;
+        v = data_.substr(pos_, len);
+        pos_ += len;
+        return true;
+    }
+
+    bool at_end() const noexcept { return pos_ == data_.size(); }
+    size_t position() const noexcept { return pos_; }
+    size_t remaining() const noexcept { return data_.size() - pos_; }
+
+private:
+    bool need(size_t n) noexcept {
+        if (failed_ || data_.size() - pos_ < n) {
+            failed_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    std::string_view data_;
+    size_t pos_ = 0;
+    bool failed_ = false;
+};
+
+}  // namespace ion::core::detail
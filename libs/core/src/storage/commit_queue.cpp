@@ -0,0 +1,90 @@
+/**
+ * @file commit_queue.cpp
+ * @brief Group commit: batching concurrent commits into one durable write.
+ */
+
+#include "commit_queue.h"
+#include "journal.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+commit_queue::commit_queue(batch_writer writer, std::chrono::microseconds window, size_t max_batch)
+    : writer_(std::move(writer)), window_(window), max_batch_(std::max<size_t>(max_batch, 1)) {
+}
+
+std::expected<void, std::error_code> commit_queue::submit(node_ref const& base, node_ref const& tree, std::string_view log,
+                                                         read_set const& reads) {
+    commit_request request;
+    request.base = &base;
+    request.tree = &tree;
+    request.log = log;
+    request.reads = &reads;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_.push_back(&request);
+    queued_.notify_one();
+
+    while (!request.done) {
+        if (leading_) {
+            done_.wait(lock);
+            continue;
+        }
+
+        // Nobody is writing: lead the next batch, which includes our request
+        leading_ = true;
+        if (window_.count() > 0) {
+            queued_.wait_for(lock, window_, [&] { return pending_.size() >= max_batch_; });
+        }
+
+        size_t count = std::min(pending_.size(), max_batch_);
+        std::vector<commit_request*> batch(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(count));
+        pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(count));
+
+        lock.unlock();
+        writer_(batch);
+        lock.lock();
+
+        for (auto* done : batch) done->done = true;
+        leading_ = false;
+        done_.notify_all();
+    }
+    return request.result;
+}
+
+node_ref ion::core::detail::merge_commits(node_ref head, std::span<commit_request* const> batch, std::string& log,
+                                          std::function<uint64_t()> const& next_owner) {
+    log.clear();
+
+    for (auto* request : batch) {
+        if (request->log.empty()) continue;
+
+        if (request->base->get() == head.get()) {
+            // Nothing committed since the transaction began: its tree is the result
+            head = *request->tree;
+        } else {
+            // The committing thread is blocked in submit(), so its handle
+            // table can be read from here
+            if (!reads_unchanged(request->base->get(), head.get(), request->reads->bytes())) {
+                request->result = std::unexpected(make_error_code(core_errc::conflict));
+                continue;
+            }
+
+            // Replay onto a copy so a failed replay leaves `head` untouched.
+            // The fresh owner makes the replay clone every node it touches,
+            // including ones an earlier request in this batch created.
+            node_ref candidate = head;
+            if (!apply_mutations(candidate, request->log, next_owner())) {
+                request->result = std::unexpected(make_error_code(core_errc::conflict));
+                continue;
+            }
+            head = std::move(candidate);
+        }
+        log.append(request->log);
+    }
+
+    return head;
+}
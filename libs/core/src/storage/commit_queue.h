@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ion/core/error.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "cow_node.h"
+
+namespace ion::core::detail {
+
+class read_set;
+
+/**
+ * @brief One transaction waiting in a commit_queue.
+ */
+struct commit_request {
+    node_ref const* base = nullptr;   // Committed version the transaction started from
+    node_ref const* tree = nullptr;   // The transaction's tree
+    std::string_view log;             // Mutations that turn *base into *tree
+    read_set const* reads = nullptr;  // Validated when *base is not the head
+    std::expected<void, std::error_code> result{};
+    bool done = false;
+};
+
+/**
+ * @brief Leader/follower group commit.
+ *
+ * Committing threads queue their request. Whichever thread finds no batch in
+ * flight becomes the leader: it optionally waits up to `window` for more
+ * requests (or until `max_batch` are queued), then hands the whole batch to
+ * the writer and completes every request in it. Followers sleep until their
+ * request is done, or take over as leader if it was left for the next batch.
+ *
+ * No threads are created; the batch is written on the leader's thread.
+ */
+class commit_queue {
+public:
+    using batch_writer = std::function<void(std::span<commit_request* const> batch)>;
+
+    commit_queue(batch_writer writer, std::chrono::microseconds window, size_t max_batch);
+
+    /**
+     * @brief Queues a commit and blocks until the batch holding it is durable.
+     */
+    std::expected<void, std::error_code> submit(node_ref const& base, node_ref const& tree, std::string_view log,
+                                                read_set const& reads);
+
+private:
+    batch_writer writer_;
+    std::chrono::microseconds window_;
+    size_t max_batch_;
+
+    std::mutex mutex_;
+    std::condition_variable done_;     // Signalled when a batch completes
+    std::condition_variable queued_;   // Signalled when a request is queued
+    std::vector<commit_request*> pending_;
+    bool leading_ = false;
+};
+
+/**
+ * @brief Applies a batch of commits to `head` in queue order.
+ *
+ * A request that started from the current version contributes its tree as
+ * is. Any other request is rebased: if nothing it read has changed since its
+ * base, its log is replayed on top, so writers to disjoint subtrees commit
+ * in parallel. Otherwise, or if the log no longer applies, the request fails
+ * with core_errc::conflict and the rest of the batch is unaffected. Each
+ * replay uses a fresh owner from `next_owner`, so a failed replay never
+ * disturbs nodes an earlier request in the batch created.
+ * @param log Receives the concatenated logs of the applied requests, which
+ *            turn `head` into the returned tree.
+ * @return The merged tree; `head` itself if nothing applied.
+ */
+node_ref merge_commits(node_ref head, std::span<commit_request* const> batch, std::string& log,
+                       std::function<uint64_t()> const& next_owner);
+
+}  // namespace ion::core::detail
@@ -0,0 +1,392 @@
+/**
+ * @file cow_node.cpp
+ * @brief Implementation of the persistent document tree used by the file stores.
+ */
+
+#include "cow_node.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+using namespace ion::core::detail;
+
+node_string::node_string(std::string_view text) {
+    if (text.size() <= inline_capacity) {
+        std::memcpy(bytes_, text.data(), text.size());
+        set_tag(static_cast<uint8_t>(text.size()));
+        return;
+    }
+    auto* data = new char[text.size()];
+    std::memcpy(data, text.data(), text.size());
+    set_outline(outline{data, text.size()}, heap_tag);
+}
+
+node_string node_string::borrow(std::string_view text) noexcept {
+    node_string result;
+    if (text.size() <= inline_capacity) {
+        std::memcpy(result.bytes_, text.data(), text.size());
+        result.set_tag(static_cast<uint8_t>(text.size()));
+    } else {
+        result.set_outline(outline{text.data(), text.size()}, borrowed_tag);
+    }
+    return result;
+}
+
+node_string::node_string(node_string const& other) {
+    if (other.tag() == heap_tag) {
+        auto text = other.view();
+        auto* data = new char[text.size()];
+        std::memcpy(data, text.data(), text.size());
+        set_outline(outline{data, text.size()}, heap_tag);
+    } else {
+        std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+    }
+}
+
+node_string::node_string(node_string&& other) noexcept {
+    std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+    other.set_tag(0);
+}
+
+node_string& node_string::operator=(node_string const& other) {
+    if (this != &other) {
+        node_string copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+node_string& node_string::operator=(node_string&& other) noexcept {
+    if (this != &other) {
+        if (tag() == heap_tag) delete[] outline_of().data;
+        std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+        other.set_tag(0);
+    }
+    return *this;
+}
+
+node_ref::node_ref(node_ref const& other) noexcept : node_(other.node_) {
+    if (node_) {
+        node_->refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+node_ref& node_ref::operator=(node_ref const& other) noexcept {
+    if (this != &other) {
+        node_ref copy(other);
+        std::swap(node_, copy.node_);
+    }
+    return *this;
+}
+
+node_ref& node_ref::operator=(node_ref&& other) noexcept {
+    if (this != &other) {
+        reset();
+        node_ = other.node_;
+        other.node_ = nullptr;
+    }
+    return *this;
+}
+
+node_ref::~node_ref() {
+    reset();
+}
+
+void node_ref::reset() noexcept {
+    if (node_ && node_->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // The last reference owns the node; nodes are only ever created by
+        // cow_node::adopt(), so this is the matching release.
+        cow_node::destroy(node_);
+    }
+    node_ = nullptr;
+}
+
+node_ref node_ref::retain(cow_node* node) noexcept {
+    if (node) {
+        node->refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node_ref(node);
+}
+
+cow_node* node_ref::release() noexcept {
+    cow_node* node = node_;
+    node_ = nullptr;
+    return node;
+}
+
+node_ref cow_node::adopt(node_kind kind, value_type value, uint64_t owner, node_cache* cache) {
+    void* slot = cache ? cache->allocate() : ::operator new(sizeof(cow_node));
+    return node_ref(::new (slot) cow_node(kind, std::move(value), owner, cache ? cache->arena() : nullptr));
+}
+
+void cow_node::destroy(cow_node* node) noexcept {
+    node_arena* arena = node->arena_;
+    node->~cow_node();
+    if (arena) {
+        arena->deallocate(node);
+    } else {
+        ::operator delete(node);
+    }
+}
+
+node_ref cow_node::make_null(uint64_t owner, node_cache* cache) {
+    return adopt(node_kind::null, std::monostate{}, owner, cache);
+}
+
+node_ref cow_node::make_bool(bool v, uint64_t owner, node_cache* cache) {
+    return adopt(node_kind::boolean, v, owner, cache);
+}
+
+node_ref cow_node::make_int(int64_t v, uint64_t owner, node_cache* cache) {
+    return adopt(node_kind::integer, v, owner, cache);
+}
+
+node_ref cow_node::make_double(double v, uint64_t owner, node_cache* cache) {
+    return adopt(node_kind::floating, v, owner, cache);
+}
+
+node_ref cow_node::make_string(std::string_view v, uint64_t owner, node_cache* cache) {
+    return adopt(node_kind::string, node_string(v), owner, cache);
+}
+
+node_ref cow_node::make_array(uint64_t owner, node_cache* cache) {
+    return adopt(node_kind::array, array_type{}, owner, cache);
+}
+
+node_ref cow_node::make_object(uint64_t owner, node_cache* cache) {
+    return adopt(node_kind::object, object_type{}, owner, cache);
+}
+
+node_ref cow_node::make_opaque(std::string_view text, uint64_t owner, node_cache* cache) {
+    return adopt(node_kind::opaque, node_string(text), owner, cache);
+}
+
+node_ref cow_node::make_deferred(deferred_source const& source, std::string_view text) {
+    auto node = adopt(node_kind::null, std::monostate{}, 0);
+    node->deferred_ = std::make_unique<deferred>(source);
+    node->deferred_->text = text;
+    return node;
+}
+
+void cow_node::materialize() const noexcept {
+    auto& d = *deferred_;
+    std::lock_guard<std::mutex> lock(d.source->mutex_);
+    if (d.ready.load(std::memory_order_relaxed)) return;
+
+    // Loaded nodes are shared by every version, so this is the one write a
+    // committed node ever sees; readers only look at it after `ready`.
+    auto parsed = d.source->parse(d.text);
+    auto* self = const_cast<cow_node*>(this);
+    if (parsed) {
+        self->kind_ = (*parsed)->kind_;
+        self->value_ = std::move((*parsed)->value_);
+    } else {
+        d.malformed = true;   // Stays null, flagged so nothing reads or saves it as such
+    }
+    d.ready.store(true, std::memory_order_release);
+}
+
+std::size_t cow_node::size() const noexcept {
+    if (kind() == node_kind::array) return elements().size();
+    if (kind() == node_kind::object) return entries().size();
+    return 0;
+}
+
+namespace {
+
+struct entry_key_less {
+    bool operator()(cow_entry const& e, std::string_view key) const noexcept { return e.key.view() < key; }
+};
+
+}  // namespace
+
+cow_node const* cow_node::find(std::string_view key) const noexcept {
+    auto const& items = entries();
+    auto it = std::lower_bound(items.begin(), items.end(), key, entry_key_less{});
+    if (it == items.end() || it->key.view() != key) return nullptr;
+    return it->value.get();
+}
+
+node_ref* cow_node::find_ref(std::string_view key) noexcept {
+    auto& items = entries();
+    auto it = std::lower_bound(items.begin(), items.end(), key, entry_key_less{});
+    if (it == items.end() || it->key.view() != key) return nullptr;
+    return &it->value;
+}
+
+void cow_node::insert_or_assign(std::string_view key, node_ref value) {
+    auto& items = entries();
+    auto stored_key = [&] {
+        return arena_ && key.size() > node_string::inline_capacity ? node_string::borrow(arena_->intern(key))
+                                                                    : node_string(key);
+    };
+    // Loaders insert in sorted order, so try the cheap append first.
+    if (items.empty() || items.back().key.view() < key) {
+        items.push_back(cow_entry{stored_key(), std::move(value)});
+        return;
+    }
+    auto it = std::lower_bound(items.begin(), items.end(), key, entry_key_less{});
+    if (it != items.end() && it->key.view() == key) {
+        it->value = std::move(value);
+    } else {
+        items.insert(it, cow_entry{stored_key(), std::move(value)});
+    }
+}
+
+bool cow_node::erase(std::string_view key) {
+    auto& items = entries();
+    auto it = std::lower_bound(items.begin(), items.end(), key, entry_key_less{});
+    if (it == items.end() || it->key.view() != key) return false;
+    items.erase(it);
+    return true;
+}
+
+void cow_node::assign_bool(bool v) {
+    kind_ = node_kind::boolean;
+    value_ = v;
+}
+
+void cow_node::assign_int(int64_t v) {
+    kind_ = node_kind::integer;
+    value_ = v;
+}
+
+void cow_node::assign_double(double v) {
+    kind_ = node_kind::floating;
+    value_ = v;
+}
+
+void cow_node::assign_string(std::string_view v) {
+    kind_ = node_kind::string;
+    value_ = node_string(v);
+}
+
+node_ref cow_node::clone(uint64_t owner, node_cache* cache) const {
+    load();
+    if (cache && cache->arena() == arena_) {
+        return adopt(kind_, value_, owner, cache);
+    }
+    void* slot = arena_ ? arena_->allocate() : ::operator new(sizeof(cow_node));
+    return node_ref(::new (slot) cow_node(kind_, value_, owner, arena_));
+}
+
+cow_node* ion::core::detail::make_mutable(node_ref& slot, uint64_t owner, node_cache* cache) {
+    if (slot->owner() != owner) {
+        slot = slot->clone(owner, cache);
+    }
+    return slot.get();
+}
+
+void deferred_source::release() const noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+void node_arena::release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+void* node_arena::allocate() {
+    std::size_t got = 0;
+    return take(1, got);
+}
+
+void node_arena::deallocate(void* slot) noexcept {
+    auto* node = ::new (slot) free_slot{returned_.load(std::memory_order_relaxed)};
+    while (!returned_.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+    }
+    release();
+}
+
+node_arena::free_slot* node_arena::take(std::size_t want, std::size_t& got) {
+    static_assert(sizeof(cow_node) <= slot_size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_slot* returned = returned_.exchange(nullptr, std::memory_order_acquire)) {
+        free_slot* last = returned;
+        while (last->next) {
+            last = last->next;
+        }
+        last->next = free_;
+        free_ = returned;
+    }
+    free_slot* head = nullptr;
+    for (got = 0; got < want; ++got) {
+        void* slot = nullptr;
+        if (free_) {
+            slot = free_;
+            free_ = free_->next;
+        } else {
+            if (carved_ == slots_per_slab) {
+                if (got > 0) {
+                    break;  // Hand out what we have rather than risk losing it to a throwing allocation
+                }
+                slabs_.push_back(std::make_unique_for_overwrite<std::byte[]>(slot_size * slots_per_slab));
+                carved_ = 0;
+            }
+            slot = slabs_.back().get() + slot_size * carved_++;
+        }
+        head = ::new (slot) free_slot{head};
+    }
+    refs_.fetch_add(static_cast<uint32_t>(got), std::memory_order_relaxed);
+    return head;
+}
+
+void node_arena::give_back(free_slot* first, std::size_t count) noexcept {
+    if (!first) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_slot* last = first;
+        while (last->next) {
+            last = last->next;
+        }
+        last->next = free_;
+        free_ = first;
+    }
+    if (refs_.fetch_sub(static_cast<uint32_t>(count), std::memory_order_acq_rel) == count) {
+        delete this;
+    }
+}
+
+node_cache::~node_cache() {
+    if (arena_) {
+        arena_->give_back(free_, count_);
+    }
+}
+
+void* node_cache::allocate() {
+    if (!arena_) {
+        return ::operator new(sizeof(cow_node));
+    }
+    if (!free_) {
+        free_ = arena_->take(node_arena::slots_per_refill, count_);
+    }
+    node_arena::free_slot* slot = free_;
+    free_ = slot->next;
+    --count_;
+    return slot;
+}
+
+std::string_view node_arena::intern(std::string_view key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = keys_.find(key); it != keys_.end()) {
+        return *it;
+    }
+    auto block = std::make_unique_for_overwrite<char[]>(key.size());
+    std::memcpy(block.get(), key.data(), key.size());
+    std::string_view stored(block.get(), key.size());
+    key_blocks_.push_back(std::move(block));
+    key_bytes_ += key.size();
+    keys_.insert(stored);
+    return stored;
+}
+
+std::size_t node_arena::footprint() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slabs_.size() * slot_size * slots_per_slab + key_bytes_;
+}
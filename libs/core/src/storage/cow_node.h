@@ -0,0 +1,447 @@
+#pragma once
+
+#include <ion/core/error.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+namespace ion::core::detail {
+
+class cow_node;
+class node_arena;
+class node_cache;
+
+/**
+ * @brief Intrusive, reference-counted pointer to a cow_node.
+ *
+ * Snapshots and transactions share subtrees structurally, so a node can be
+ * reachable from several committed versions at once. Ownership is therefore
+ * shared by design; the count lives inside the node so copying a reference is
+ * a single atomic increment and never allocates.
+ */
+class node_ref {
+public:
+    node_ref() noexcept = default;
+    node_ref(node_ref const& other) noexcept;
+    node_ref(node_ref&& other) noexcept : node_(other.node_) { other.node_ = nullptr; }
+    node_ref& operator=(node_ref const& other) noexcept;
+    node_ref& operator=(node_ref&& other) noexcept;
+    ~node_ref();
+
+    cow_node* get() const noexcept { return node_; }
+    cow_node* operator->() const noexcept { return node_; }
+    cow_node& operator*() const noexcept { return *node_; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    void reset() noexcept;
+
+    /**
+     * @brief Takes an additional reference to a node kept alive by someone else.
+     */
+    static node_ref retain(cow_node* node) noexcept;
+
+    /**
+     * @brief Gives up ownership without dropping the reference.
+     *
+     * The caller becomes responsible for the reference, typically by handing
+     * the pointer back to adopt_released() later.
+     */
+    cow_node* release() noexcept;
+
+    /**
+     * @brief Re-adopts a reference previously detached with release().
+     */
+    static node_ref adopt_released(cow_node* node) noexcept { return node_ref(node); }
+
+private:
+    friend class cow_node;
+    explicit node_ref(cow_node* adopted) noexcept : node_(adopted) {}
+
+    cow_node* node_ = nullptr;
+};
+
+/**
+ * @brief Value kinds a cow_node can hold.
+ *
+ * `opaque` carries a backend-native scalar the public API cannot express
+ * (e.g. TOML dates) as its textual form so it survives a load/save cycle.
+ */
+enum class node_kind : uint8_t {
+    null,
+    boolean,
+    integer,
+    floating,
+    string,
+    array,
+    object,
+    opaque,
+};
+
+/**
+ * @brief String storage of a cow_node: object keys and string values.
+ *
+ * Up to inline_capacity bytes live inside the object, so most keys and short
+ * values need no allocation and compare without a pointer chase. Longer text
+ * is either owned on the heap or borrowed from a node_arena's interned keys,
+ * which makes copying it (e.g. in cow_node::clone()) free.
+ */
+class node_string {
+public:
+    static constexpr std::size_t inline_capacity = 23;
+
+    node_string() noexcept { bytes_[inline_capacity] = 0; }
+    explicit node_string(std::string_view text);
+    node_string(node_string const& other);
+    node_string(node_string&& other) noexcept;
+    node_string& operator=(node_string const& other);
+    node_string& operator=(node_string&& other) noexcept;
+    ~node_string() { if (tag() == heap_tag) delete[] outline_of().data; }
+
+    /**
+     * @brief Borrows `text`, which must outlive every copy of the result.
+     *
+     * Only node_arena hands out such text, for its own nodes' keys.
+     */
+    static node_string borrow(std::string_view text) noexcept;
+
+    std::string_view view() const noexcept {
+        if (tag() <= inline_capacity) return std::string_view(bytes_, tag());
+        auto out = outline_of();
+        return std::string_view(out.data, out.size);
+    }
+    operator std::string_view() const noexcept { return view(); }
+
+    friend bool operator==(node_string const& a, std::string_view b) noexcept { return a.view() == b; }
+    friend auto operator<=>(node_string const& a, std::string_view b) noexcept { return a.view() <=> b; }
+
+private:
+    static constexpr uint8_t heap_tag = 0xFE;
+    static constexpr uint8_t borrowed_tag = 0xFF;
+
+    struct outline {
+        char const* data;
+        std::size_t size;
+    };
+
+    uint8_t tag() const noexcept { return static_cast<uint8_t>(bytes_[inline_capacity]); }
+    void set_tag(uint8_t tag) noexcept { bytes_[inline_capacity] = static_cast<char>(tag); }
+    outline outline_of() const noexcept { outline out; std::memcpy(&out, bytes_, sizeof(out)); return out; }
+    void set_outline(outline out, uint8_t tag) noexcept { std::memcpy(bytes_, &out, sizeof(out)); set_tag(tag); }
+
+    // Inline text, or an outline; the last byte is the inline length or heap_tag / borrowed_tag
+    alignas(outline) char bytes_[inline_capacity + 1];
+};
+
+static_assert(sizeof(node_string) == 24);
+
+/**
+ * @brief One key/value pair of an object node. Entries are kept sorted by key.
+ */
+struct cow_entry {
+    node_string key;
+    node_ref value;
+};
+
+/**
+ * @brief Parses the values of deferred nodes (see cow_node::make_deferred()).
+ *
+ * Owns the text the deferred nodes point into. A new source holds one
+ * reference, its creator's, dropped with release(); every deferred node made
+ * from it holds another, so the source lives as long as the last of them.
+ */
+class deferred_source {
+public:
+    void release() const noexcept;
+
+    /**
+     * @brief Builds the tree for `text`, one complete value cut out of the source.
+     *
+     * Called once per deferred node.
+     * @return The tree, or core_errc::parse_error if `text` is malformed; the
+     *         node then reports is_malformed().
+     */
+    virtual std::expected<node_ref, core_errc> parse(std::string_view text) const = 0;
+
+protected:
+    deferred_source() = default;
+    virtual ~deferred_source() = default;
+
+private:
+    friend class cow_node;
+    mutable std::atomic<uint32_t> refs_{1};
+    mutable std::mutex mutex_;   // Serializes materializing the source's nodes
+};
+
+/**
+ * @brief Node of the persistent document tree shared by the file stores.
+ *
+ * Committed versions are immutable: every node reachable from a published
+ * snapshot is owned by 0 (loaded) or by a transaction id that is no longer
+ * handed out. A transaction mutates only nodes whose owner matches its own
+ * live id; anything else is cloned first (see make_mutable()), so
+ * a write copies the nodes on the path from the root to the change and shares
+ * every other subtree with the snapshot it started from.
+ */
+class cow_node final {
+public:
+    using array_type  = std::vector<node_ref>;
+    using object_type = std::vector<cow_entry>;
+
+    /// @name Factories. With a `cache` the node is carved from its arena instead of the heap.
+    /// @{
+    static node_ref make_null(uint64_t owner = 0, node_cache* cache = nullptr);
+    static node_ref make_bool(bool v, uint64_t owner = 0, node_cache* cache = nullptr);
+    static node_ref make_int(int64_t v, uint64_t owner = 0, node_cache* cache = nullptr);
+    static node_ref make_double(double v, uint64_t owner = 0, node_cache* cache = nullptr);
+    static node_ref make_string(std::string_view v, uint64_t owner = 0, node_cache* cache = nullptr);
+    static node_ref make_array(uint64_t owner = 0, node_cache* cache = nullptr);
+    static node_ref make_object(uint64_t owner = 0, node_cache* cache = nullptr);
+    static node_ref make_opaque(std::string_view text, uint64_t owner = 0, node_cache* cache = nullptr);
+    /// @}
+
+    /**
+     * @brief A loaded node whose value is parsed from `text` on first access.
+     *
+     * Every accessor materializes the node first, so it behaves exactly like
+     * the node `source.parse(text)` returns, and keeps its identity. The node
+     * takes a reference to `source`; `text` must stay valid as long as it does.
+     */
+    static node_ref make_deferred(deferred_source const& source, std::string_view text);
+
+    node_kind kind() const noexcept { load(); return kind_; }
+    bool is_array() const noexcept { return kind() == node_kind::array; }
+    bool is_object() const noexcept { return kind() == node_kind::object; }
+
+    /**
+     * @brief True if the node is deferred and its text failed to parse.
+     *
+     * Such a node has kind null but stands for data that is still in the
+     * source, so reading it or writing it out as null would lose that data.
+     */
+    bool is_malformed() const noexcept { load(); return deferred_ && deferred_->malformed; }
+
+    /**
+     * @brief True while the node is deferred and has not been touched yet.
+     */
+    bool is_pending() const noexcept { return deferred_ && !deferred_->ready.load(std::memory_order_acquire); }
+
+    /// @name Scalar accessors. The caller checks kind() first.
+    /// @{
+    bool as_bool() const noexcept { load(); return std::get<bool>(value_); }
+    int64_t as_int() const noexcept { load(); return std::get<int64_t>(value_); }
+    double as_double() const noexcept { load(); return std::get<double>(value_); }
+    std::string_view as_string() const noexcept { load(); return std::get<node_string>(value_).view(); }
+    /// @}
+
+    /// @name Container accessors. The caller checks kind() first.
+    /// @{
+    array_type const& elements() const noexcept { load(); return std::get<array_type>(value_); }
+    array_type& elements() noexcept { load(); return std::get<array_type>(value_); }
+    object_type const& entries() const noexcept { load(); return std::get<object_type>(value_); }
+    object_type& entries() noexcept { load(); return std::get<object_type>(value_); }
+    std::size_t size() const noexcept;
+    /// @}
+
+    /// @name Object helpers (binary search over the sorted entries).
+    /// Keys too long to store inline are interned in the node's arena, if any.
+    /// @{
+    cow_node const* find(std::string_view key) const noexcept;
+    node_ref* find_ref(std::string_view key) noexcept;
+    void insert_or_assign(std::string_view key, node_ref value);
+    bool erase(std::string_view key);
+    /// @}
+
+    /// @name In-place value replacement. Only valid on nodes the caller owns.
+    /// @{
+    void assign_bool(bool v);
+    void assign_int(int64_t v);
+    void assign_double(double v);
+    void assign_string(std::string_view v);
+    /// @}
+
+    /**
+     * @brief Id of the transaction allowed to mutate this node, 0 if loaded.
+     */
+    uint64_t owner() const noexcept { return owner_; }
+
+    /**
+     * @brief Arena the node was carved from, nullptr for heap nodes.
+     */
+    node_arena* arena() const noexcept { return arena_; }
+
+    /**
+     * @brief Shallow copy owned by `owner`, in the same arena. Children are shared, not copied.
+     *
+     * The copy comes from `cache` when it serves this node's arena, otherwise
+     * from the arena directly under its lock.
+     */
+    node_ref clone(uint64_t owner, node_cache* cache = nullptr) const;
+
+private:
+    friend class node_ref;
+
+    using value_type = std::variant<std::monostate, bool, int64_t, double, node_string, array_type, object_type>;
+
+    struct deferred {
+        explicit deferred(deferred_source const& s) noexcept : source(&s) {
+            s.refs_.fetch_add(1, std::memory_order_relaxed);
+        }
+        ~deferred() { source->release(); }
+        deferred(deferred const&) = delete;
+        deferred& operator=(deferred const&) = delete;
+
+        deferred_source const* source;
+        std::string_view text;
+        bool malformed = false;           // parse() failed; written before `ready`
+        std::atomic<bool> ready{false};   // Set once value_ and kind_ hold the parsed value
+    };
+
+    cow_node(node_kind kind, value_type value, uint64_t owner, node_arena* arena)
+        : kind_(kind), owner_(owner), value_(std::move(value)), arena_(arena) {}
+
+    static node_ref adopt(node_kind kind, value_type value, uint64_t owner, node_cache* cache = nullptr);
+    static void destroy(cow_node* node) noexcept;
+
+    // deferred_ never changes after construction, so plain nodes pay one null test
+    void load() const noexcept {
+        if (deferred_ && !deferred_->ready.load(std::memory_order_acquire)) [[unlikely]] materialize();
+    }
+    void materialize() const noexcept;
+
+    mutable std::atomic<uint32_t> refs_{1};
+    node_kind kind_;
+    uint64_t owner_ = 0;
+    value_type value_;
+    std::unique_ptr<deferred> deferred_;
+    node_arena* arena_ = nullptr;
+};
+
+/**
+ * @brief Contiguous storage for the nodes of one tree, used by the memory store.
+ *
+ * Nodes are carved from slabs of cache-line sized slots instead of separate
+ * heap blocks, so a tree is dense in memory and pays no per-node allocator
+ * header. Keys longer than node_string::inline_capacity are interned: each
+ * distinct key is stored once and every entry using it borrows that copy.
+ *
+ * Every live node holds a reference to its arena, so the arena outlives the
+ * tree no matter which snapshot lets go of it last. Interned keys are kept
+ * until the arena goes away.
+ *
+ * Writers allocate through a node_cache, which takes slots in batches of
+ * slots_per_refill, so the arena's lock is taken once per batch rather than
+ * once per node. Freed slots are pushed onto a lock-free list and only merged
+ * back under the lock at the next refill, so dropping a snapshot never waits
+ * on a writer.
+ */
+class node_arena {
+public:
+    static constexpr std::size_t slot_size = 64;
+    static constexpr std::size_t slots_per_slab = 256;
+    static constexpr std::size_t slots_per_refill = 32;
+
+    /**
+     * @brief A new arena holding one reference, dropped with release().
+     */
+    static node_arena* create() { return new node_arena(); }
+
+    void release() noexcept;
+
+    /**
+     * @brief Returns the arena's copy of `key`, adding it on first use.
+     */
+    std::string_view intern(std::string_view key);
+
+    /**
+     * @brief Bytes held in node slabs and interned keys.
+     */
+    std::size_t footprint() const;
+
+private:
+    friend class cow_node;
+    friend class node_cache;
+
+    struct free_slot {
+        free_slot* next;
+    };
+
+    node_arena() = default;
+    ~node_arena() = default;
+
+    void* allocate();
+    void deallocate(void* slot) noexcept;
+    // Links up to `want` slots, each holding a reference, and returns the head; `got` is the count.
+    free_slot* take(std::size_t want, std::size_t& got);
+    void give_back(free_slot* first, std::size_t count) noexcept;
+
+    std::atomic<uint32_t> refs_{1};
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<std::byte[]>> slabs_;
+    std::size_t carved_ = slots_per_slab;  // Slots used in slabs_.back()
+    free_slot* free_ = nullptr;
+    // Pushed without the lock; only ever emptied whole, under it, so pops cannot hit ABA
+    std::atomic<free_slot*> returned_{nullptr};
+    std::vector<std::unique_ptr<char[]>> key_blocks_;
+    std::size_t key_bytes_ = 0;
+    std::unordered_set<std::string_view> keys_;
+};
+
+/**
+ * @brief Batch of free arena slots owned by one writer.
+ *
+ * A transaction, journal replay or rebase allocates every node it creates
+ * from its own cache, so the hot path is a pop from a private list with no
+ * lock and no atomic. Without an arena the cache falls back to the heap.
+ * Slots still unused when the cache goes away are handed back to the arena.
+ */
+class node_cache {
+public:
+    explicit node_cache(node_arena* arena) noexcept : arena_(arena) {}
+    ~node_cache();
+
+    node_cache(node_cache const&) = delete;
+    node_cache& operator=(node_cache const&) = delete;
+
+    node_arena* arena() const noexcept { return arena_; }
+
+    /**
+     * @brief Storage for one cow_node, carrying a reference to arena() if set.
+     */
+    void* allocate();
+
+private:
+    node_arena* arena_;
+    node_arena::free_slot* free_ = nullptr;
+    std::size_t count_ = 0;
+};
+
+/**
+ * @brief One step of a path from the root: an object key or an array index.
+ *
+ * `key` is a view; the segment is only valid as long as the string it refers to.
+ */
+struct path_segment {
+    std::string_view key;
+    std::size_t index = 0;
+    bool is_element = false;
+};
+
+/**
+ * @brief Returns a node in `slot` that `owner` may mutate.
+ *
+ * If the node is still shared with a snapshot it is cloned, from `cache` when
+ * given, and `slot` is repointed at the clone. The parent holding `slot` must
+ * already be owned.
+ */
+cow_node* make_mutable(node_ref& slot, uint64_t owner, node_cache* cache = nullptr);
+
+}  // namespace ion::core::detail
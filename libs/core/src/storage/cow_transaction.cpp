@@ -0,0 +1,480 @@
+#include "cow_transaction.h"
+#include "tree_store.h"
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+cow_transaction::cow_transaction(node_ref snapshot, tree_store* store, cow_rules const& rules, uint64_t txn_id)
+    : handles_(snapshot, txn_id), store_(store), rules_(rules),
+      base_(std::move(snapshot)), reads_(handles_) {
+}
+
+cow_transaction::~cow_transaction() noexcept {
+    if (!committed_) {
+        rollback_impl();
+    }
+}
+
+std::expected<store_handle, std::error_code> cow_transaction::root() const {
+    return store_handle{1};  // Root is always handle 1
+}
+
+cow_node const* cow_transaction::get_node(store_handle h) const {
+    return handles_.resolve(h);
+}
+
+cow_node* cow_transaction::mutable_node(store_handle h) {
+    return handles_.resolve_mutable(h);
+}
+
+void cow_transaction::log_put(store_handle target, cow_node const& value) {
+    if (!handles_.path_of(target, path_)) return;
+    log_.put(path_, value);
+}
+
+void cow_transaction::log_put(store_handle parent, path_segment last, cow_node const& value) {
+    if (!handles_.path_of(parent, path_)) return;
+    path_.push_back(last);
+    log_.put(path_, value);
+}
+
+void cow_transaction::log_erase(store_handle parent, path_segment last) {
+    if (!handles_.path_of(parent, path_)) return;
+    path_.push_back(last);
+    log_.erase(path_);
+}
+
+void cow_transaction::note_node(store_handle h) const {
+    // Read-only views (owner 0) never commit, so they skip the bookkeeping
+    if (handles_.owner() == 0) return;
+    handles_.note_node(h);
+}
+
+void cow_transaction::note_exists(store_handle parent, path_segment last) const {
+    if (handles_.owner() == 0) return;
+    handles_.note_exists(parent, last);
+}
+
+std::expected<cow_node const*, core_errc> cow_transaction::find_node(store_handle h) const {
+    if (h.raw == 0) {
+        return std::unexpected(rules_.null_handle);
+    }
+
+    auto const* node = get_node(h);
+    if (!node) {
+        return std::unexpected(rules_.stale_handle);
+    }
+    if (node->is_malformed()) [[unlikely]] {
+        return std::unexpected(core_errc::parse_error);
+    }
+
+    return node;
+}
+
+std::expected<cow_node const*, std::error_code> cow_transaction::get_node_checked(store_handle h) const {
+    return to_error_code(find_node(h));
+}
+
+std::expected<bool, core_errc> cow_transaction::try_get_bool(store_handle h) const {
+    auto node_result = find_node(h);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    note_node(h);
+    auto const* node = *node_result;
+    if (node->kind() != node_kind::boolean) {
+        return std::unexpected(core_errc::type_mismatch);
+    }
+
+    return node->as_bool();
+}
+
+std::expected<int64_t, core_errc> cow_transaction::try_get_int(store_handle h) const {
+    auto node_result = find_node(h);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    note_node(h);
+    auto const* node = *node_result;
+    if (node->kind() != node_kind::integer) {
+        return std::unexpected(core_errc::type_mismatch);
+    }
+
+    return node->as_int();
+}
+
+std::expected<double, core_errc> cow_transaction::try_get_double(store_handle h) const {
+    auto node_result = find_node(h);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    note_node(h);
+    auto const* node = *node_result;
+    if (rules_.widen_integers && node->kind() == node_kind::integer) {
+        return static_cast<double>(node->as_int());
+    }
+    if (node->kind() != node_kind::floating) {
+        return std::unexpected(core_errc::type_mismatch);
+    }
+
+    return node->as_double();
+}
+
+std::expected<std::string, core_errc> cow_transaction::try_get_string(store_handle h) const {
+    auto node_result = find_node(h);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    note_node(h);
+    auto const* node = *node_result;
+    if (node->kind() != node_kind::string) {
+        return std::unexpected(core_errc::type_mismatch);
+    }
+
+    return std::string(node->as_string());
+}
+
+std::expected<std::string_view, core_errc> cow_transaction::try_get_string_view(store_handle h) const {
+    auto node_result = find_node(h);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    note_node(h);
+    auto const* node = *node_result;
+    if (node->kind() != node_kind::string) {
+        return std::unexpected(core_errc::type_mismatch);
+    }
+
+    return node->as_string();
+}
+
+std::expected<cow_node*, std::error_code> cow_transaction::settable_node(store_handle h, node_kind kind) {
+    auto node_result = get_node_checked(h);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    if (!rules_.retype_on_set && (*node_result)->kind() != kind) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    return mutable_node(h);
+}
+
+std::expected<void, std::error_code> cow_transaction::set_bool(store_handle h, bool v) {
+    auto target = settable_node(h, node_kind::boolean);
+    if (!target) return std::unexpected(target.error());
+
+    (*target)->assign_bool(v);
+    log_put(h, **target);
+    return {};
+}
+
+std::expected<void, std::error_code> cow_transaction::set_int(store_handle h, int64_t v) {
+    auto target = settable_node(h, node_kind::integer);
+    if (!target) return std::unexpected(target.error());
+
+    (*target)->assign_int(v);
+    log_put(h, **target);
+    return {};
+}
+
+std::expected<void, std::error_code> cow_transaction::set_double(store_handle h, double v) {
+    auto target = settable_node(h, node_kind::floating);
+    if (!target) return std::unexpected(target.error());
+
+    (*target)->assign_double(v);
+    log_put(h, **target);
+    return {};
+}
+
+std::expected<void, std::error_code> cow_transaction::set_string(store_handle h, std::string_view v) {
+    auto target = settable_node(h, node_kind::string);
+    if (!target) return std::unexpected(target.error());
+
+    (*target)->assign_string(v);
+    log_put(h, **target);
+    return {};
+}
+
+std::expected<void, std::error_code> cow_transaction::insert_child(store_handle parent, std::string_view key, node_ref created) {
+    if (!is_valid_key(key)) {
+        return std::unexpected(make_error_code(core_errc::path_syntax));
+    }
+
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_object()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    bool replaced = node->find(key) != nullptr;
+    if (!rules_.replace_on_make) {
+        // Failing depends on the key being there, so that is what was read
+        note_exists(parent, path_segment{key});
+        if (replaced) {
+            return std::unexpected(make_error_code(core_errc::already_exists));
+        }
+    }
+
+    log_put(parent, path_segment{key}, *created);
+    mutable_node(parent)->insert_or_assign(key, std::move(created));
+    if (replaced) handles_.invalidate();
+    return {};
+}
+
+std::expected<store_handle, std::error_code> cow_transaction::make_array(store_handle parent, std::string_view key) {
+    auto created = cow_node::make_array(handles_.owner(), handles_.nodes());
+    cow_node const* created_node = created.get();
+    auto inserted = insert_child(parent, key, std::move(created));
+    if (!inserted) return std::unexpected(inserted.error());
+
+    return handles_.make_child(parent, key, created_node);
+}
+
+std::expected<store_handle, std::error_code> cow_transaction::make_object(store_handle parent, std::string_view key) {
+    auto created = cow_node::make_object(handles_.owner(), handles_.nodes());
+    cow_node const* created_node = created.get();
+    auto inserted = insert_child(parent, key, std::move(created));
+    if (!inserted) return std::unexpected(inserted.error());
+
+    return handles_.make_child(parent, key, created_node);
+}
+
+std::expected<void, std::error_code> cow_transaction::make_bool(store_handle parent, std::string_view key, bool v) {
+    return insert_child(parent, key, cow_node::make_bool(v, handles_.owner(), handles_.nodes()));
+}
+
+std::expected<void, std::error_code> cow_transaction::make_int(store_handle parent, std::string_view key, int64_t v) {
+    return insert_child(parent, key, cow_node::make_int(v, handles_.owner(), handles_.nodes()));
+}
+
+std::expected<void, std::error_code> cow_transaction::make_double(store_handle parent, std::string_view key, double v) {
+    return insert_child(parent, key, cow_node::make_double(v, handles_.owner(), handles_.nodes()));
+}
+
+std::expected<void, std::error_code> cow_transaction::make_string(store_handle parent, std::string_view key, std::string_view v) {
+    return insert_child(parent, key, cow_node::make_string(v, handles_.owner(), handles_.nodes()));
+}
+
+std::expected<void, std::error_code> cow_transaction::remove(store_handle parent, std::string_view key) {
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_object()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    note_exists(parent, path_segment{key});
+
+    if (!node->find(key)) {
+        return std::unexpected(make_error_code(core_errc::key_not_found));
+    }
+
+    log_erase(parent, path_segment{key});
+    mutable_node(parent)->erase(key);
+    handles_.invalidate();
+    return {};
+}
+
+std::expected<bool, std::error_code> cow_transaction::has(store_handle parent, std::string_view key) const {
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_object()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    note_exists(parent, path_segment{key});
+
+    return node->find(key) != nullptr;
+}
+
+std::expected<void, std::error_code> cow_transaction::erase_element(store_handle parent, size_t idx) {
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_array()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    note_exists(parent, path_segment{{}, idx, true});
+
+    if (idx >= node->size()) {
+        return std::unexpected(make_error_code(core_errc::index_out_of_range));
+    }
+
+    log_erase(parent, path_segment{{}, idx, true});
+    auto& elements = mutable_node(parent)->elements();
+    elements.erase(elements.begin() + static_cast<std::ptrdiff_t>(idx));
+    handles_.invalidate();
+    return {};
+}
+
+std::expected<bool, std::error_code> cow_transaction::has_element(store_handle parent, size_t idx) const {
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_array()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    note_exists(parent, path_segment{{}, idx, true});
+
+    return idx < node->size();
+}
+
+std::expected<store_handle, std::error_code> cow_transaction::child(store_handle parent, std::string_view key) const {
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_object()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    note_exists(parent, path_segment{key});
+
+    auto const* found = node->find(key);
+    if (!found) {
+        return std::unexpected(make_error_code(core_errc::key_not_found));
+    }
+
+    return handles_.make_child(parent, key, found);
+}
+
+std::expected<store_handle, std::error_code> cow_transaction::element(store_handle parent, size_t idx) const {
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_array()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    note_exists(parent, path_segment{{}, idx, true});
+
+    if (idx >= node->size()) {
+        return std::unexpected(make_error_code(core_errc::index_out_of_range));
+    }
+
+    return handles_.make_element(parent, idx, node->elements()[idx].get());
+}
+
+std::expected<store_node_type, std::error_code> cow_transaction::type(store_handle h) const {
+    auto node_result = get_node_checked(h);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    note_node(h);
+    return type_of(**node_result);
+}
+
+std::expected<size_t, std::error_code> cow_transaction::size(store_handle h) const {
+    auto node_result = get_node_checked(h);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_array() && !node->is_object()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    note_node(h);
+    return node->size();
+}
+
+std::expected<size_t, std::error_code> cow_transaction::read_entries(store_handle parent, size_t first, std::span<store_entry> out) const {
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_array() && !node->is_object()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    // The entries expose every child's value, so the whole parent counts as read
+    note_node(parent);
+    size_t count = read_node_entries(*node, first, out);
+    if (has_malformed_child(*node, first, count)) [[unlikely]] {
+        return std::unexpected(make_error_code(core_errc::parse_error));
+    }
+    return count;
+}
+
+std::expected<size_t, std::error_code> cow_transaction::scan_entries(store_handle parent, std::string_view from, bool after,
+                                                                      std::span<store_entry> out) const {
+    auto node_result = get_node_checked(parent);
+    if (!node_result) return std::unexpected(node_result.error());
+
+    auto const* node = *node_result;
+    if (!node->is_object()) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+
+    note_node(parent);
+    size_t first = 0;
+    size_t count = scan_node_entries(*node, from, after, out, &first);
+    if (has_malformed_child(*node, first, count)) [[unlikely]] {
+        return std::unexpected(make_error_code(core_errc::parse_error));
+    }
+    return count;
+}
+
+std::expected<void, std::error_code> cow_transaction::get_many(store_handle base, std::span<store_query const> queries,
+                                                                std::span<std::expected<store_value, std::error_code>> results) const {
+    return get_many_with(*this, base, queries, results);
+}
+
+std::expected<void, std::error_code> cow_transaction::get_string_views(store_handle base, std::span<std::string_view const> paths,
+                                                                        std::span<std::expected<std::string_view, std::error_code>> results) const {
+    return get_string_views_with(*this, base, paths, results);
+}
+
+std::expected<void, std::error_code> cow_transaction::set_many(store_handle base, std::span<store_assignment const> assignments) {
+    return set_many_with(*this, base, assignments);
+}
+
+std::expected<store_handle, std::error_code> cow_transaction::navigate(store_handle base, store_path const& path) const {
+    if (auto cached = resolved_.find(base, path); cached && get_node(*cached)) {
+        if (store_) store_->probe().count(store_metric::navigate_cached);
+        return *cached;
+    }
+
+    auto resolved = walk_path(*this, base, path);
+    if (resolved) resolved_.insert(base, path, *resolved);
+    if (store_) {
+        store_->probe().count(store_metric::navigate_walks);
+        store_->probe().count(store_metric::navigate_segments, path.segments().size());
+    }
+    return resolved;
+}
+
+std::expected<void, std::error_code> cow_transaction::commit_impl() {
+    if (!store_) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+
+    store_->probe().gauge(store_metric::transaction_handles, static_cast<double>(handles_.size()));
+    auto result = store_->commit(base_, handles_.tree(), log_, reads_);
+    if (result) {
+        // Our writes are committed. Unless the store had moved on and rebased
+        // them onto a newer version, our tree is now the committed one and
+        // shared, so take a fresh owner id: any later write clones again
+        // instead of mutating nodes other transactions can now see. base_
+        // stays our own tree either way; the next commit carries only the
+        // writes made after this point and is rebased if it no longer matches.
+        base_ = handles_.tree();
+        log_.clear();
+        handles_.clear_reads();
+        resolved_.clear();
+        handles_.set_owner(store_->next_txn_id());
+    }
+    return result;
+}
+
+void cow_transaction::rollback_impl() noexcept {
+    // Release the snapshot reference; private clones are freed with it
+    handles_.reset();
+    base_.reset();
+    log_.clear();
+    handles_.clear_reads();
+    resolved_.clear();
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <ion/core/store/store_base.h>
+#include <ion/core/store/transaction_base.h>
+#include <ion/core/error.h>
+#include <ion/core/store/store_handle.h>
+#include <expected>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "cow_node.h"
+#include "handle_table.h"
+#include "journal.h"
+#include "node_entries.h"
+#include "path_walker.h"
+
+namespace ion::core::detail {
+
+class tree_store;
+
+/**
+ * @brief Value rules that differ between the backends sharing cow_transaction.
+ *
+ * The defaults are the JSON store's: values are dynamically typed, make_*()
+ * replaces an existing key and get_double() reads integers. TOML keys have a
+ * fixed type once written, so the TOML store turns all three off.
+ */
+struct cow_rules {
+    bool widen_integers = true;      // get_double() accepts integer nodes
+    bool retype_on_set = true;       // set_*() may change the type of the value
+    bool replace_on_make = true;     // make_*() overwrites instead of failing with already_exists
+    core_errc null_handle = core_errc::invalid_handle;    // Error for a default-constructed handle
+    core_errc stale_handle = core_errc::invalid_handle;   // Error for a handle that no longer resolves
+};
+
+/**
+ * @brief Implementation of transaction_base over a copy-on-write node tree.
+ *
+ * Every tree_store backend edits its committed tree through this class; only
+ * the cow_rules differ. It supports ACID-compliant operations on hierarchical
+ * storage data.
+ *
+ * The transaction holds a reference to the store's committed tree and copies
+ * nodes lazily: the first write below a node clones the path from the root to
+ * it, and every untouched subtree stays shared with the snapshot. Handles are
+ * slots in a handle_table and resolve without walking the tree. New nodes are
+ * allocated like the snapshot's root: from its node_arena, if it has one,
+ * through the handle table's node_cache so that the arena's lock is taken
+ * once per batch of nodes.
+ */
+class cow_transaction final : public transaction_base {
+public:
+    cow_transaction(node_ref snapshot, tree_store* store, cow_rules const& rules, uint64_t txn_id);
+    ~cow_transaction() noexcept override;
+
+    std::expected<store_handle, std::error_code> root() const override;
+    std::expected<bool, core_errc> try_get_bool(store_handle h) const override;
+    std::expected<int64_t, core_errc> try_get_int(store_handle h) const override;
+    std::expected<double, core_errc> try_get_double(store_handle h) const override;
+    std::expected<std::string, core_errc> try_get_string(store_handle h) const override;
+    std::expected<std::string_view, core_errc> try_get_string_view(store_handle h) const override;
+    std::expected<void, std::error_code> set_bool(store_handle h, bool v) override;
+    std::expected<void, std::error_code> set_int(store_handle h, int64_t v) override;
+    std::expected<void, std::error_code> set_double(store_handle h, double v) override;
+    std::expected<void, std::error_code> set_string(store_handle h, std::string_view v) override;
+    std::expected<store_handle, std::error_code> make_array(store_handle parent, std::string_view key) override;
+    std::expected<store_handle, std::error_code> make_object(store_handle parent, std::string_view key) override;
+    std::expected<void, std::error_code> make_bool(store_handle parent, std::string_view key, bool v) override;
+    std::expected<void, std::error_code> make_int(store_handle parent, std::string_view key, int64_t v) override;
+    std::expected<void, std::error_code> make_double(store_handle parent, std::string_view key, double v) override;
+    std::expected<void, std::error_code> make_string(store_handle parent, std::string_view key, std::string_view v) override;
+    std::expected<void, std::error_code> remove(store_handle parent, std::string_view key) override;
+    std::expected<bool, std::error_code> has(store_handle parent, std::string_view key) const override;
+    std::expected<void, std::error_code> erase_element(store_handle parent, size_t idx) override;
+    std::expected<bool, std::error_code> has_element(store_handle parent, size_t idx) const override;
+    std::expected<store_handle, std::error_code> child(store_handle parent, std::string_view key) const override;
+    std::expected<store_handle, std::error_code> element(store_handle parent, size_t idx) const override;
+    std::expected<store_node_type, std::error_code> type(store_handle h) const override;
+    std::expected<size_t, std::error_code> size(store_handle h) const override;
+    std::expected<size_t, std::error_code> read_entries(store_handle parent, size_t first, std::span<store_entry> out) const override;
+    std::expected<size_t, std::error_code> scan_entries(store_handle parent, std::string_view from, bool after,
+                                                        std::span<store_entry> out) const override;
+    std::expected<void, std::error_code> get_many(store_handle base, std::span<store_query const> queries,
+                                                  std::span<std::expected<store_value, std::error_code>> results) const override;
+    std::expected<void, std::error_code> get_string_views(store_handle base, std::span<std::string_view const> paths,
+                                                          std::span<std::expected<std::string_view, std::error_code>> results) const override;
+    std::expected<void, std::error_code> set_many(store_handle base, std::span<store_assignment const> assignments) override;
+
+    using read_transaction_base::navigate;
+    std::expected<store_handle, std::error_code> navigate(store_handle base, store_path const& path) const override;
+
+private:
+    std::expected<void, std::error_code> commit_impl() override;
+    void rollback_impl() noexcept override;
+
+    handle_table handles_;  // Owns the tree reference; owner tag is 0 for read-only views
+    tree_store* store_;
+    cow_rules rules_;
+    node_ref base_;                       // Committed version this transaction started from
+    mutation_log log_;                    // Writes since base_; replayed onto newer commits and journaled
+    std::vector<path_segment> path_;      // Scratch buffer for recording paths
+    read_set reads_;                      // What was observed since base_, checked on rebase
+    mutable resolved_paths resolved_;     // Compiled paths navigated since base_
+
+    cow_node const* get_node(store_handle h) const;
+    std::expected<cow_node const*, core_errc> find_node(store_handle h) const;
+    std::expected<cow_node const*, std::error_code> get_node_checked(store_handle h) const;
+    cow_node* mutable_node(store_handle h);
+    std::expected<cow_node*, std::error_code> settable_node(store_handle h, node_kind kind);
+    std::expected<void, std::error_code> insert_child(store_handle parent, std::string_view key, node_ref created);
+    void log_put(store_handle target, cow_node const& value);
+    void log_put(store_handle parent, path_segment last, cow_node const& value);
+    void log_erase(store_handle parent, path_segment last);
+    void note_node(store_handle h) const;
+    void note_exists(store_handle parent, path_segment last) const;
+};
+
+} // namespace ion::core::detail
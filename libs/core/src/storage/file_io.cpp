@@ -0,0 +1,357 @@
+/**
+ * @file file_io.cpp
+ * @brief Durable file handles, the blocking (POSIX) and completion port
+ *        (Win32) file_io backends, and backend selection.
+ */
+
+#include "file_io.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <sys/uio.h>
+#  include <unistd.h>
+#endif
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+std::unexpected<std::error_code> io_failure() {
+    return std::unexpected(make_error_code(core_errc::io_failure));
+}
+
+std::filesystem::path temp_path_for(std::filesystem::path const& path) {
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    return temp;
+}
+
+#if defined(_WIN32)
+
+constexpr DWORD  k_write_chunk    = 1u << 22;
+constexpr size_t k_max_in_flight  = 8;
+
+/**
+ * @brief file_io on overlapped handles bound to an I/O completion port.
+ *
+ * Content is cut into chunks written at explicit offsets, up to
+ * k_max_in_flight at once, and completions are reaped from the port in
+ * batches. Win32 has no way to link a write, a flush and a rename into one
+ * request, so each call still waits for its writes before flushing.
+ */
+class overlapped_file_io final : public file_io {
+public:
+    overlapped_file_io() : port_(CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1)) {}
+    ~overlapped_file_io() override {
+        if (port_) CloseHandle(port_);
+    }
+
+    std::expected<void, std::error_code> replace(std::filesystem::path const& path, std::string_view content) override {
+        auto temp = temp_path_for(path);
+        HANDLE file = CreateFileW(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return io_failure();
+
+        std::string_view parts[] = {content};
+        bool ok = write_at(file, 0, parts) && FlushFileBuffers(file);
+        CloseHandle(file);
+        if (ok) {
+            if (auto renamed = durable_rename(temp, path)) return {};
+        }
+        DeleteFileW(temp.c_str());
+        return io_failure();
+    }
+
+    std::expected<void, std::error_code> append(durable_file& file, std::span<std::string_view const> parts) override {
+        HANDLE handle = file.native_handle();
+        // Writes in flight together need explicit offsets; the file store is the only appender
+        LARGE_INTEGER end{};
+        if (!GetFileSizeEx(handle, &end)) return io_failure();
+        if (!write_at(handle, static_cast<uint64_t>(end.QuadPart), parts)) return io_failure();
+        if (!FlushFileBuffers(handle)) return io_failure();
+        return {};
+    }
+
+private:
+    struct pending_write {
+        OVERLAPPED ov{};
+        char const* data = nullptr;
+        DWORD length = 0;
+        bool done = false;
+    };
+
+    bool write_at(HANDLE file, uint64_t offset, std::span<std::string_view const> parts) {
+        if (!port_) return false;
+        // A handle stays bound until it is closed; binding it again fails, which is fine
+        if (!CreateIoCompletionPort(file, port_, 0, 0) && GetLastError() != ERROR_INVALID_PARAMETER) return false;
+
+        std::vector<pending_write> writes;
+        for (auto part : parts) {
+            while (!part.empty()) {
+                auto& w = writes.emplace_back();
+                w.length = static_cast<DWORD>(std::min<size_t>(part.size(), k_write_chunk));
+                w.data = part.data();
+                w.ov.Offset = static_cast<DWORD>(offset);
+                w.ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+                offset += w.length;
+                part.remove_prefix(w.length);
+            }
+        }
+
+        bool ok = true;
+        size_t next = 0, in_flight = 0;
+        while (in_flight > 0 || (ok && next < writes.size())) {
+            while (ok && next < writes.size() && in_flight < k_max_in_flight) {
+                auto& w = writes[next];
+                if (!WriteFile(file, w.data, w.length, nullptr, &w.ov) && GetLastError() != ERROR_IO_PENDING) {
+                    ok = false;
+                    break;
+                }
+                ++next;
+                ++in_flight;
+            }
+            if (in_flight == 0) break;
+
+            OVERLAPPED_ENTRY entries[k_max_in_flight];
+            ULONG count = 0;
+            if (!GetQueuedCompletionStatusEx(port_, entries, static_cast<ULONG>(k_max_in_flight), &count, INFINITE, FALSE)) {
+                // The writes still point into the caller's buffers: cancel and wait them
+                // out, then drop the port so no later call reaps their stale packets
+                CancelIoEx(file, nullptr);
+                for (size_t i = 0; i < next; ++i) {
+                    DWORD written = 0;
+                    if (!writes[i].done) GetOverlappedResult(file, &writes[i].ov, &written, TRUE);
+                }
+                CloseHandle(std::exchange(port_, nullptr));
+                return false;
+            }
+            for (ULONG i = 0; i < count; ++i) {
+                auto* w = reinterpret_cast<pending_write*>(entries[i].lpOverlapped);  // ov comes first
+                DWORD written = 0;
+                ok = GetOverlappedResult(file, &w->ov, &written, FALSE) && written == w->length && ok;
+                w->done = true;
+                --in_flight;
+            }
+        }
+        return ok;
+    }
+
+    HANDLE port_;
+};
+
+#else
+
+bool write_all(int fd, std::string_view data) {
+    while (!data.empty()) {
+        ssize_t n = ::write(fd, data.data(), data.size());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(n));
+    }
+    return true;
+}
+
+bool sync_data(int fd) {
+#if defined(__APPLE__)
+    return ::fsync(fd) == 0;
+#else
+    return ::fdatasync(fd) == 0;
+#endif
+}
+
+class blocking_file_io final : public file_io {
+public:
+    std::expected<void, std::error_code> replace(std::filesystem::path const& path, std::string_view content) override {
+        auto temp = temp_path_for(path);
+        int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (fd < 0) return io_failure();
+
+        bool ok = write_all(fd, content) && ::fsync(fd) == 0;
+        ok = ::close(fd) == 0 && ok;
+        if (ok) {
+            if (auto renamed = durable_rename(temp, path)) return {};
+        }
+        ::unlink(temp.c_str());
+        return io_failure();
+    }
+
+    std::expected<void, std::error_code> append(durable_file& file, std::span<std::string_view const> parts) override {
+        int fd = file.native_handle();
+
+        // One writev; a short write finishes part by part
+        constexpr size_t k_max_parts = 8;
+        iovec iov[k_max_parts];
+        size_t count = std::min(parts.size(), k_max_parts);
+        for (size_t i = 0; i < count; ++i) {
+            iov[i].iov_base = const_cast<char*>(parts[i].data());
+            iov[i].iov_len = parts[i].size();
+        }
+        ssize_t n;
+        do {
+            n = ::writev(fd, iov, static_cast<int>(count));
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) return io_failure();
+
+        size_t done = static_cast<size_t>(n);
+        for (auto part : parts) {
+            size_t skip = std::min(done, part.size());
+            done -= skip;
+            if (!write_all(fd, part.substr(skip))) return io_failure();
+        }
+
+        if (!sync_data(fd)) return io_failure();
+        return {};
+    }
+};
+
+#endif
+
+}  // namespace
+
+durable_file::durable_file(durable_file&& other) noexcept {
+    *this = std::move(other);
+}
+
+durable_file& durable_file::operator=(durable_file&& other) noexcept {
+    if (this != &other) {
+        close();
+#if defined(_WIN32)
+        handle_ = std::exchange(other.handle_, nullptr);
+#else
+        fd_ = std::exchange(other.fd_, -1);
+#endif
+    }
+    return *this;
+}
+
+durable_file::~durable_file() {
+    close();
+}
+
+#if defined(_WIN32)
+
+std::expected<durable_file, std::error_code> durable_file::open_append(std::filesystem::path const& path, bool truncate) {
+    durable_file f;
+    f.handle_ = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                            truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+    if (f.handle_ == INVALID_HANDLE_VALUE) {
+        f.handle_ = nullptr;
+        return io_failure();
+    }
+    return f;
+}
+
+bool durable_file::is_open() const noexcept {
+    return handle_ != nullptr;
+}
+
+void durable_file::close() noexcept {
+    if (handle_) CloseHandle(handle_);
+    handle_ = nullptr;
+}
+
+std::expected<void, std::error_code> ion::core::detail::durable_rename(std::filesystem::path const& from, std::filesystem::path const& to) {
+    // Write-through returns once the rename itself is on disk
+    if (!MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) return io_failure();
+    return {};
+}
+
+std::expected<file_stamp, std::error_code> ion::core::detail::stamp_file(std::filesystem::path const& path) {
+    HANDLE handle = CreateFileW(path.c_str(), FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return io_failure();
+    BY_HANDLE_FILE_INFORMATION info{};
+    BOOL ok = GetFileInformationByHandle(handle, &info);
+    CloseHandle(handle);
+    if (!ok) return io_failure();
+
+    auto join = [](DWORD high, DWORD low) { return (static_cast<uint64_t>(high) << 32) | low; };
+    file_stamp stamp;
+    stamp.size = join(info.nFileSizeHigh, info.nFileSizeLow);
+    stamp.mtime_ns = join(info.ftLastWriteTime.dwHighDateTime, info.ftLastWriteTime.dwLowDateTime) * 100;
+    stamp.device = info.dwVolumeSerialNumber;
+    stamp.inode = join(info.nFileIndexHigh, info.nFileIndexLow);
+    return stamp;
+}
+
+std::unique_ptr<file_io> ion::core::detail::make_default_file_io() {
+    return std::make_unique<overlapped_file_io>();
+}
+
+#else
+
+std::expected<durable_file, std::error_code> durable_file::open_append(std::filesystem::path const& path, bool truncate) {
+    durable_file f;
+    f.fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0666);
+    if (f.fd_ < 0) return io_failure();
+    return f;
+}
+
+bool durable_file::is_open() const noexcept {
+    return fd_ >= 0;
+}
+
+void durable_file::close() noexcept {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+}
+
+std::expected<void, std::error_code> ion::core::detail::durable_rename(std::filesystem::path const& from, std::filesystem::path const& to) {
+    if (::rename(from.c_str(), to.c_str()) != 0) return io_failure();
+
+    // The rename is durable once the directory holding the new entry is synced
+    auto dir = to.parent_path();
+    int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return io_failure();
+    bool ok = ::fsync(fd) == 0 || errno == EINVAL;   // Some filesystems cannot sync directories
+    ::close(fd);
+    if (!ok) return io_failure();
+    return {};
+}
+
+std::expected<file_stamp, std::error_code> ion::core::detail::stamp_file(std::filesystem::path const& path) {
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0) return io_failure();
+
+#if defined(__APPLE__)
+    auto const& mtime = st.st_mtimespec;
+#else
+    auto const& mtime = st.st_mtim;
+#endif
+    file_stamp stamp;
+    stamp.size = static_cast<uint64_t>(st.st_size);
+    stamp.mtime_ns = static_cast<uint64_t>(mtime.tv_sec) * 1'000'000'000u + static_cast<uint64_t>(mtime.tv_nsec);
+    stamp.device = static_cast<uint64_t>(st.st_dev);
+    stamp.inode = static_cast<uint64_t>(st.st_ino);
+    return stamp;
+}
+
+std::unique_ptr<file_io> ion::core::detail::make_default_file_io() {
+    return std::make_unique<blocking_file_io>();
+}
+
+#endif
+
+std::unique_ptr<file_io> ion::core::detail::make_file_io() {
+#if defined(__linux__)
+    if (auto io = make_uring_file_io()) return io;
+#endif
+    return make_default_file_io();
+}
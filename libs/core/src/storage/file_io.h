@@ -0,0 +1,126 @@
+#pragma once
+
+#include <ion/core/error.h>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+namespace ion::core::detail {
+
+/**
+ * @brief Owning handle to a file opened for durable appends.
+ */
+class durable_file {
+public:
+    durable_file() noexcept = default;
+    durable_file(durable_file&& other) noexcept;
+    durable_file& operator=(durable_file&& other) noexcept;
+    durable_file(durable_file const&) = delete;
+    durable_file& operator=(durable_file const&) = delete;
+    ~durable_file();
+
+    /**
+     * @brief Opens (creating if needed) `path` so every write goes to its end.
+     * @param truncate Empty the file first.
+     */
+    static std::expected<durable_file, std::error_code> open_append(std::filesystem::path const& path, bool truncate);
+
+    bool is_open() const noexcept;
+
+    /**
+     * @brief Closes the file. Safe to call more than once.
+     */
+    void close() noexcept;
+
+#if defined(_WIN32)
+    void* native_handle() const noexcept { return handle_; }
+#else
+    int native_handle() const noexcept { return fd_; }
+#endif
+
+private:
+#if defined(_WIN32)
+    void* handle_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+/**
+ * @brief The durable writes file stores persist through.
+ *
+ * Both operations return only once their data is on stable storage, so a
+ * commit that succeeded survives power loss, not just a process crash.
+ * Implementations hand the whole sequence to the kernel in as few calls as
+ * the platform allows. Not thread-safe; each file store owns one.
+ */
+class file_io {
+public:
+    virtual ~file_io() = default;
+
+    /**
+     * @brief Replaces `path` with `content`: writes `<path>.tmp`, syncs it,
+     *        renames it over `path` and syncs the directory entry.
+     * @return Success, or core_errc::io_failure with `path` left untouched.
+     */
+    virtual std::expected<void, std::error_code> replace(std::filesystem::path const& path, std::string_view content) = 0;
+
+    /**
+     * @brief Appends `parts` to `file` in order, then syncs the file's data.
+     * @return Success or core_errc::io_failure; a failed append may leave a torn tail.
+     */
+    virtual std::expected<void, std::error_code> append(durable_file& file, std::span<std::string_view const> parts) = 0;
+};
+
+/**
+ * @brief The best file_io the platform offers: io_uring on Linux kernels
+ *        that support it, overlapped I/O on Windows, blocking syscalls elsewhere.
+ */
+std::unique_ptr<file_io> make_file_io();
+
+/**
+ * @brief The platform's file_io without io_uring: blocking system calls on
+ *        POSIX, overlapped I/O reaped from a completion port on Windows.
+ */
+std::unique_ptr<file_io> make_default_file_io();
+
+#if defined(__linux__)
+/**
+ * @brief file_io that submits each operation as one linked io_uring chain.
+ * @return The backend, or nullptr if the kernel lacks io_uring or an opcode it needs.
+ */
+std::unique_ptr<file_io> make_uring_file_io();
+#endif
+
+/**
+ * @brief What tells one version of a file from another without reading it.
+ *
+ * Every save writes a new file and renames it into place, so the identity
+ * (device and inode on POSIX, volume serial and file index on Windows)
+ * changes with each save even when the size and timestamp do not.
+ */
+struct file_stamp {
+    uint64_t size = 0;
+    uint64_t mtime_ns = 0;
+    uint64_t device = 0;
+    uint64_t inode = 0;
+
+    friend bool operator==(file_stamp const&, file_stamp const&) = default;
+};
+
+/**
+ * @brief Stamps `path` from its metadata alone.
+ * @return The stamp, or core_errc::io_failure if the file cannot be inspected.
+ */
+std::expected<file_stamp, std::error_code> stamp_file(std::filesystem::path const& path);
+
+/**
+ * @brief Renames `from` over `to` and makes the new directory entry durable.
+ */
+std::expected<void, std::error_code> durable_rename(std::filesystem::path const& from, std::filesystem::path const& to);
+
+}  // namespace ion::core::detail
@@ -0,0 +1,278 @@
+/**
+ * @file file_store.cpp
+ * @brief Base file and journal persistence shared by the file-backed stores.
+ *
+ * The stores ensure ACID compliance by journaling commits and replacing the
+ * base file only through atomic renames. The format-specific stores only
+ * translate between file content and cow_node trees.
+ */
+
+#include "file_store.h"
+#include "mapped_file.h"
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+/**
+ * @brief Constructs a closed file store.
+ * @param path Filesystem path to the base file.
+ * @param options Mapping, journaling and group-commit settings.
+ */
+file_store::file_store(std::filesystem::path const& path, file_store_options const& options)
+    : tree_store(options.group_commit_window, options.group_commit_max_batch, options.instrumentation),
+      path_(path), options_(options), io_(make_file_io()) {
+    journal_.set_io(io_.get());
+}
+
+file_store::~file_store() {
+    wait_for_compaction();
+}
+
+/**
+ * @brief Closes the store, then lets a queued compaction run to completion.
+ *
+ * Format stores call this from their destructors, while parse() and
+ * serialize() are still theirs to call.
+ */
+void file_store::close_on_destroy() noexcept {
+    tree_store::close_on_destroy();
+    wait_for_compaction();
+}
+
+/**
+ * @brief Loads an existing base file, or starts from an empty object.
+ *
+ * Commits that only reached the journal are replayed by load_from_file().
+ * @param path Filesystem path to the base file.
+ * @return The committed tree or an error if the file cannot be read or parsed.
+ */
+std::expected<node_ref, std::error_code> file_store::load(std::filesystem::path const& path) {
+    path_ = path;
+    journal_.set_path(journal_file::path_for(path_));
+
+    if (std::filesystem::exists(path_)) {
+        return load_from_file(true);
+    }
+
+    // A journal without its base file holds commits nothing can apply; keep it
+    std::error_code ec;
+    if (std::filesystem::exists(journal_file::path_for(path_), ec)) {
+        return std::unexpected(make_error_code(core_errc::journal_mismatch));
+    }
+    base_exists_ = false;
+    return cow_node::make_object();
+}
+
+/**
+ * @brief Persists a merged batch with a single write.
+ *
+ * With journaling on, the combined mutation log is appended as one journal
+ * frame. Otherwise (or before the base file exists) the merged tree is
+ * written out whole.
+ */
+std::expected<void, std::error_code> file_store::persist(cow_node const& head, cow_node const& merged,
+                                                         std::string_view log) {
+    if (&merged == &head && base_exists_) {
+        return {};  // Nothing to write; an empty first commit still creates the file
+    }
+
+    if (!options_.use_journal || !base_exists_) {
+        return save_to_file(merged);
+    }
+
+    uint64_t start = probe().now();
+    auto appended = journal_.append(log);
+    if (!appended) {
+        return appended;
+    }
+    probe().elapsed(store_metric::persist_journal_ns, start);
+    probe().count(store_metric::persist_bytes, log.size());
+
+    if (journal_.size() >= options_.journal_compact_bytes) {
+        // The batch is already durable in the journal; if compaction fails
+        // it is simply retried by the next commit or close().
+        if (options_.compaction_executor) {
+            schedule_compaction();
+        } else {
+            auto compacted = save_to_file(merged);
+            (void)compacted;
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Hands compaction to the configured executor, once per backlog.
+ *
+ * The task takes the store mutex, so it rewrites whatever head is current
+ * when it runs, and commits arriving meanwhile keep appending to the journal.
+ */
+void file_store::schedule_compaction() {
+    {
+        std::lock_guard<std::mutex> lock(compaction_mutex_);
+        if (compaction_queued_) {
+            return;
+        }
+        compaction_queued_ = true;
+    }
+
+    options_.compaction_executor->execute([this] {
+        with_open_head([this](cow_node const& head) {
+            if (journal_.size() >= options_.journal_compact_bytes) {
+                auto compacted = save_to_file(head);
+                (void)compacted;
+            }
+        });
+
+        // Notify under the lock: once it is released the store may be gone
+        std::lock_guard<std::mutex> lock(compaction_mutex_);
+        compaction_queued_ = false;
+        compaction_done_.notify_all();
+    });
+}
+
+void file_store::wait_for_compaction() noexcept {
+    std::unique_lock<std::mutex> lock(compaction_mutex_);
+    compaction_done_.wait(lock, [this] { return !compaction_queued_; });
+}
+
+/**
+ * @brief Folds the journal into the base file so the next open starts clean.
+ */
+std::expected<void, std::error_code> file_store::flush(cow_node const& head) {
+    if (journal_.size() == 0) {
+        return {};
+    }
+    return save_to_file(head);
+}
+
+/**
+ * @brief Reads and parses the base file, then replays the journal on top of it.
+ * @param repair Whether the journal may be truncated or removed as recovery needs.
+ * @return The committed tree or an error if the file cannot be read or parsed.
+ */
+std::expected<node_ref, std::error_code> file_store::load_from_file(bool repair) {
+    try {
+        // The journal names its base by stamp first; a stat costs the same at any file size
+        auto stamp = stamp_file(path_);
+        if (!stamp) {
+            return std::unexpected(stamp.error());
+        }
+        journal_.set_base(*stamp);
+
+        // Parse straight out of the mapping (or a single read) without further copies
+        uint64_t start = probe().now();
+        auto read = read_file(path_, options_.write_mmap);
+        if (!read) {
+            return std::unexpected(read.error());
+        }
+        probe().elapsed(store_metric::open_read_ns, start);
+
+        // Empty file, use empty object
+        start = probe().now();
+        auto root = read->view().empty() ? std::expected<node_ref, std::error_code>(cow_node::make_object())
+                                    : parse_contents(std::move(*read));
+        if (!root) {
+            return root;
+        }
+        probe().elapsed(store_metric::open_parse_ns, start);
+
+        start = probe().now();
+        auto replayed = journal_.recover(*root, repair);
+        if (!replayed) {
+            return std::unexpected(replayed.error());
+        }
+        probe().elapsed(store_metric::open_replay_ns, start);
+
+        base_exists_ = true;
+        return root;
+    } catch (const std::exception&) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    } catch (...) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    }
+}
+
+/**
+ * @brief Saves `data` as the new base file.
+ *
+ * Writes to a temporary file and atomically renames it to replace the
+ * original file. The journal is emptied, since the new base already contains
+ * every commit it held.
+ * @param data The tree to save.
+ * @return Success or an error if the file cannot be written.
+ */
+std::expected<void, std::error_code> file_store::save_to_file(cow_node const& data) {
+    try {
+        uint64_t start = probe().now();
+        auto content = serialize(data);
+        if (!content) {
+            return std::unexpected(content.error());
+        }
+        probe().elapsed(store_metric::persist_serialize_ns, start);
+
+        // A crash after the rename must leave a journal that knows it was folded in
+        auto digest = digest_of(*content);
+        auto marked = journal_.mark_compaction(digest);
+        if (!marked) {
+            return marked;
+        }
+
+        // Written to a temporary file and renamed over the original for atomicity
+        start = probe().now();
+        auto written = io_->replace(path_, *content);
+        if (!written) {
+            return written;
+        }
+        probe().elapsed(store_metric::persist_write_ns, start);
+        probe().count(store_metric::persist_bytes, content->size());
+
+        // The base now holds everything the journal did. If removing it fails
+        // the stale journal's marker names this base and it is dropped on open.
+        // Without a stamp, a new journal still names the base by its digest.
+        auto stamp = stamp_file(path_);
+        journal_.set_base(stamp.value_or(file_stamp{}), digest);
+        base_exists_ = true;
+        auto discarded = journal_.discard();
+        (void)discarded;
+
+        return {};
+    } catch (const std::exception&) {
+        return std::unexpected(make_error_code(core_errc::io_failure));
+    } catch (...) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    }
+}
+
+std::expected<node_ref, std::error_code> file_store::import_file(std::filesystem::path const& from) {
+    path_ = from;
+    journal_.set_path(journal_file::path_for(path_));
+    return load_from_file(false);
+}
+
+std::expected<void, std::error_code> file_store::export_file(std::filesystem::path const& to, cow_node const& root) {
+    try {
+        auto checked = exportable(root);
+        if (!checked) {
+            return checked;
+        }
+
+        auto content = serialize(root);
+        if (!content) {
+            return std::unexpected(content.error());
+        }
+
+        auto written = io_->replace(to, *content);
+        if (!written) {
+            return written;
+        }
+
+        // A journal left beside the target was written against its old content
+        journal_file stale(journal_file::path_for(to));
+        return stale.discard();
+    } catch (const std::exception&) {
+        return std::unexpected(make_error_code(core_errc::io_failure));
+    } catch (...) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    }
+}
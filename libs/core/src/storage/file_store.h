@@ -0,0 +1,121 @@
+#pragma once
+
+#include <ion/core/types.h>
+#include <ion/core/store.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "file_io.h"
+#include "mapped_file.h"
+#include "tree_store.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief A tree_store persisted to a single base file plus a journal.
+ *
+ * Handles everything but the file format: loading and journal replay on
+ * open, journal appends or whole-file rewrites on commit, compaction, and
+ * folding the journal back into the base file on close. Formats supply
+ * parse() and serialize().
+ */
+class file_store : public tree_store {
+public:
+    ~file_store() override;
+
+    /**
+     * @brief Writes `root` to `to` in this store's format, replacing the file
+     *        atomically and removing any journal left next to it.
+     */
+    std::expected<void, std::error_code> export_file(std::filesystem::path const& to, cow_node const& root);
+
+    /**
+     * @brief Reads the store file `from` with its journal replayed, without
+     *        opening the store or writing to either file.
+     */
+    std::expected<node_ref, std::error_code> import_file(std::filesystem::path const& from);
+
+protected:
+    file_store(std::filesystem::path const& path, file_store_options const& options);
+
+    /**
+     * @brief Closes the store if it is still open, then waits for a queued
+     *        background compaction. Hides tree_store::close_on_destroy().
+     */
+    void close_on_destroy() noexcept;
+
+    /**
+     * @brief Builds the tree held by a non-empty base file.
+     * @return The root, or core_errc::parse_error if the content is malformed.
+     */
+    virtual std::expected<node_ref, std::error_code> parse(std::string_view content) = 0;
+
+    /**
+     * @brief Builds the tree held by a non-empty base file it may keep views into.
+     *
+     * Formats that defer parsing override this to take `contents` over for as
+     * long as the tree points into it. The default calls parse().
+     */
+    virtual std::expected<node_ref, std::error_code> parse_contents(file_contents&& contents) {
+        return parse(contents.view());
+    }
+
+    /**
+     * @brief Produces the base file content for `root`.
+     */
+    virtual std::expected<std::string, std::error_code> serialize(cow_node const& root) = 0;
+
+    /**
+     * @brief Checks that serialize() writes every value in `root` as it is.
+     *
+     * Saves may drop or coerce what a format cannot hold; export_file() calls
+     * this first and fails instead. The default accepts every tree.
+     * @return Success or core_errc::type_mismatch.
+     */
+    virtual std::expected<void, std::error_code> exportable(cow_node const& root) const {
+        (void)root;
+        return {};
+    }
+
+private:
+    std::expected<node_ref, std::error_code> load(std::filesystem::path const& path) final;
+    std::expected<void, std::error_code> persist(cow_node const& head, cow_node const& merged,
+                                                 std::string_view log) final;
+    std::expected<void, std::error_code> flush(cow_node const& head) final;
+
+    std::expected<node_ref, std::error_code> load_from_file(bool repair);
+    std::expected<void, std::error_code> save_to_file(cow_node const& data);
+    void schedule_compaction();
+    void wait_for_compaction() noexcept;
+
+    std::filesystem::path path_;
+    file_store_options options_;
+    bool base_exists_ = false;               // Journal frames need a base file to apply to
+    std::unique_ptr<file_io> io_;            // Durable writes for the base file and journal
+    journal_file journal_;
+
+    std::mutex compaction_mutex_;
+    std::condition_variable compaction_done_;
+    bool compaction_queued_ = false;         // A compaction task sits on options_.compaction_executor
+};
+
+/**
+ * @brief Journaling and group-commit settings shared by every file format's options.
+ */
+template <typename Options>
+file_store_options file_options_of(Options const& options) {
+    file_store_options result;
+    result.write_mmap = options.write_mmap;
+    result.use_journal = options.use_journal;
+    result.journal_compact_bytes = options.journal_compact_bytes;
+    result.group_commit_window = options.group_commit_window;
+    result.group_commit_max_batch = options.group_commit_max_batch;
+    result.compaction_executor = options.compaction_executor;
+    result.instrumentation = options.instrumentation;
+    return result;
+}
+
+}  // namespace ion::core::detail
@@ -0,0 +1,256 @@
+/**
+ * @file handle_table.cpp
+ * @brief Implementation of the generation-checked handle slot table.
+ */
+
+#include "handle_table.h"
+#include <algorithm>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+constexpr uint32_t k_root_slot = 1;
+
+uint32_t slot_of(store_handle h) noexcept { return static_cast<uint32_t>(h.raw); }
+uint32_t generation_of(store_handle h) noexcept { return static_cast<uint32_t>(h.raw >> 32); }
+
+}  // namespace
+
+handle_table::handle_table(node_ref root, uint64_t owner)
+    : root_(std::move(root)), nodes_(root_ ? root_->arena() : nullptr), owner_(owner) {
+    // Slot 0 is never handed out so that raw 0 stays invalid
+    slots_.resize(2);
+    slots_[k_root_slot].node = root_.get();
+    slots_[k_root_slot].epoch = epoch_;
+}
+
+handle_table::slot* handle_table::lookup(store_handle h) const {
+    uint32_t idx = slot_of(h);
+    if (idx == 0 || idx >= slots_.size()) return nullptr;
+
+    auto& s = slots_[idx];
+    if (s.generation != generation_of(h)) return nullptr;
+    return &s;
+}
+
+void handle_table::retire(uint32_t idx) const {
+    auto& s = slots_[idx];
+    ++s.generation;
+    s.node = nullptr;
+    if (s.marks) {
+        // A recorded read still needs the slot's path: keep it out of the
+        // free list until clear_reads()
+        s.marks |= retired_mark;
+        return;
+    }
+    s.parent = 0;
+    s.key = node_string();
+    free_.push_back(idx);
+}
+
+store_handle handle_table::allocate(slot&& s) const {
+    uint32_t idx;
+    if (!free_.empty()) {
+        idx = free_.back();
+        free_.pop_back();
+        s.generation = slots_[idx].generation;
+        slots_[idx] = std::move(s);
+    } else {
+        idx = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(std::move(s));
+    }
+    return store_handle{(static_cast<uint64_t>(slots_[idx].generation) << 32) | idx};
+}
+
+cow_node const* handle_table::resolve(store_handle h) const {
+    auto* s = lookup(h);
+    if (!s) return nullptr;
+    if (s->epoch == epoch_) return s->node;
+
+    // Stale: the cached pointer may have been cloned away or freed, so find the
+    // node again through the (recursively revalidated) parent.
+    uint32_t idx = slot_of(h);
+    cow_node const* node = nullptr;
+    if (idx == k_root_slot) {
+        node = root_.get();
+    } else if (auto const* parent = resolve(store_handle{s->parent})) {
+        if (s->is_element) {
+            if (parent->is_array() && s->index < parent->size()) {
+                node = parent->elements()[s->index].get();
+            }
+        } else if (parent->is_object()) {
+            node = parent->find(s->key);
+        }
+    }
+
+    if (!node) {
+        if (idx != k_root_slot) retire(idx);
+        return nullptr;
+    }
+
+    s->node = node;
+    s->epoch = epoch_;
+    return node;
+}
+
+cow_node* handle_table::resolve_mutable(store_handle h) {
+    auto const* node = resolve(h);
+    if (!node) return nullptr;
+    if (node->owner() == owner_) {
+        // Nodes we own are never shared, so handing out a mutable pointer is safe
+        return const_cast<cow_node*>(node);
+    }
+
+    // h and all of its ancestors were just resolved, so their cached pointers
+    // are accurate; clone the shared part of the path and restamp it. Every
+    // other slot may still point at a pre-clone version and goes stale.
+    ++epoch_;
+
+    cow_node* result = nullptr;
+    std::vector<uint32_t> chain;
+    for (uint32_t idx = slot_of(h);; idx = slot_of(store_handle{slots_[idx].parent})) {
+        chain.push_back(idx);
+        if (idx == k_root_slot || slots_[idx].node->owner() == owner_) break;
+    }
+
+    // Walk back down from the topmost owned (or root) slot
+    cow_node* parent = nullptr;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        auto& s = slots_[*it];
+        if (*it == k_root_slot) {
+            result = make_mutable(root_, owner_, &nodes_);
+        } else if (!parent) {
+            // Topmost slot of the chain, already owned
+            result = const_cast<cow_node*>(s.node);
+        } else {
+            node_ref* ref = s.is_element ? &parent->elements()[s.index] : parent->find_ref(s.key);
+            result = make_mutable(*ref, owner_, &nodes_);
+        }
+        s.node = result;
+        s.epoch = epoch_;
+        parent = result;
+    }
+    return result;
+}
+
+store_handle handle_table::make_child(store_handle parent, std::string_view key, cow_node const* node) const {
+    slot s;
+    s.node = node;
+    s.parent = parent.raw;
+    s.epoch = epoch_;
+    s.key = node_string(key);
+    return allocate(std::move(s));
+}
+
+store_handle handle_table::make_element(store_handle parent, size_t idx, cow_node const* node) const {
+    slot s;
+    s.node = node;
+    s.parent = parent.raw;
+    s.epoch = epoch_;
+    s.index = idx;
+    s.is_element = true;
+    return allocate(std::move(s));
+}
+
+bool handle_table::path_of(store_handle h, std::vector<path_segment>& out) const {
+    out.clear();
+    for (auto* s = lookup(h); s; s = lookup(store_handle{s->parent})) {
+        if (s == &slots_[k_root_slot]) {
+            std::reverse(out.begin(), out.end());
+            return true;
+        }
+        out.push_back(path_segment{s->key, s->index, s->is_element});
+    }
+    return false;
+}
+
+void handle_table::reset() noexcept {
+    root_.reset();
+    slots_.clear();
+    free_.clear();
+    pinned_.clear();
+    lookups_.clear();
+}
+
+void handle_table::pin(uint32_t idx) const {
+    // Ancestors of a pinned slot are pinned already, so this stops early
+    while (!(slots_[idx].marks & pin_mark)) {
+        slots_[idx].marks |= pin_mark;
+        pinned_.push_back(idx);
+        if (idx == k_root_slot) break;
+        idx = slot_of(store_handle{slots_[idx].parent});
+    }
+}
+
+void handle_table::note_node(store_handle h) const {
+    auto* s = lookup(h);
+    if (!s || (s->marks & read_mark)) return;
+    s->marks |= read_mark;
+    pin(slot_of(h));
+}
+
+void handle_table::note_exists(store_handle parent, path_segment last) const {
+    if (!lookup(parent)) return;
+    uint32_t idx = slot_of(parent);
+
+    // Lookups in a loop tend to repeat the previous one
+    if (!lookups_.empty()) {
+        auto const& prev = lookups_.back();
+        if (prev.parent == idx && prev.is_element == last.is_element &&
+            (last.is_element ? prev.index == last.index : prev.key.view() == last.key)) {
+            return;
+        }
+    }
+
+    pin(idx);
+    lookup_read read;
+    read.parent = idx;
+    read.is_element = last.is_element;
+    if (last.is_element) {
+        read.index = last.index;
+    } else {
+        read.key = node_string(last.key);
+    }
+    lookups_.push_back(std::move(read));
+}
+
+void handle_table::raw_path(uint32_t idx, std::vector<path_segment>& out) const {
+    // Pinned slots keep their parent and key even when retired, so follow the
+    // raw slot indices rather than the generation-checked handles
+    out.clear();
+    for (; idx != k_root_slot; idx = slot_of(store_handle{slots_[idx].parent})) {
+        auto const& s = slots_[idx];
+        out.push_back(path_segment{s.key, s.index, s.is_element});
+    }
+    std::reverse(out.begin(), out.end());
+}
+
+void handle_table::for_each_read(std::function<void(bool, std::span<path_segment const>)> const& fn) const {
+    std::vector<path_segment> path;
+    for (uint32_t idx : pinned_) {
+        if (!(slots_[idx].marks & read_mark)) continue;
+        raw_path(idx, path);
+        fn(false, path);
+    }
+    for (auto const& read : lookups_) {
+        raw_path(read.parent, path);
+        path.push_back(path_segment{read.key, read.index, read.is_element});
+        fn(true, path);
+    }
+}
+
+void handle_table::clear_reads() noexcept {
+    for (uint32_t idx : pinned_) {
+        auto& s = slots_[idx];
+        if (s.marks & retired_mark) {
+            s.parent = 0;
+            s.key = node_string();
+            free_.push_back(idx);
+        }
+        s.marks = 0;
+    }
+    pinned_.clear();
+    lookups_.clear();
+}
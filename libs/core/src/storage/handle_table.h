@@ -0,0 +1,170 @@
+#pragma once
+
+#include <ion/core/types.h>
+#include <ion/core/store/store_handle.h>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cow_node.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief Slot table that maps store_handle values to nodes of a cow_node tree.
+ *
+ * A handle's raw value is `generation << 32 | slot`. Slot 1 is the root, so the
+ * root handle is always 1 and 0 is never valid. Each slot caches the node it
+ * resolved to; resolving a handle is an index plus a generation compare.
+ *
+ * Cached pointers are trusted only while the table's structure epoch is
+ * unchanged. Anything that can move or free a node (copy-on-write clones,
+ * replacing or erasing children) bumps the epoch, and stale slots are then
+ * re-resolved from their parent by key or index on next use. If the node is
+ * gone the slot is retired and its generation bumped, so stale handles fail
+ * instead of aliasing whatever reuses the slot.
+ *
+ * The table owns the transaction's reference to the tree and the node_cache
+ * that nodes it creates or clones are carved from. It also records what the
+ * transaction read, as marks on the slots the reads went through (see
+ * read_set).
+ */
+class handle_table {
+public:
+    handle_table(node_ref root, uint64_t owner);
+
+    /**
+     * @brief Returns the node behind `h`, or nullptr if the handle is stale or unknown.
+     */
+    cow_node const* resolve(store_handle h) const;
+
+    /**
+     * @brief Like resolve(), but makes the node and its ancestors writable first.
+     *
+     * Shared nodes on the way are cloned for the current owner.
+     */
+    cow_node* resolve_mutable(store_handle h);
+
+    /**
+     * @brief Allocates a handle for `node`, the child `key` of `parent`.
+     */
+    store_handle make_child(store_handle parent, std::string_view key, cow_node const* node) const;
+
+    /**
+     * @brief Allocates a handle for `node`, element `idx` of `parent`.
+     */
+    store_handle make_element(store_handle parent, size_t idx, cow_node const* node) const;
+
+    /**
+     * @brief Writes the root-to-node path of `h` into `out`.
+     *
+     * The segments view keys owned by the table and stay valid until the next
+     * handle is allocated.
+     * @return False if the handle is unknown.
+     */
+    bool path_of(store_handle h, std::vector<path_segment>& out) const;
+
+    /**
+     * @brief Marks every cached pointer stale. Call after replacing or erasing children.
+     */
+    void invalidate() noexcept { ++epoch_; }
+
+    /**
+     * @brief Owner tag for nodes created or cloned by this table.
+     */
+    uint64_t owner() const noexcept { return owner_; }
+
+    /**
+     * @brief Changes the owner tag, freezing every node owned so far.
+     */
+    void set_owner(uint64_t owner) noexcept { owner_ = owner; }
+
+    node_ref const& tree() const noexcept { return root_; }
+
+    /**
+     * @brief Where new nodes go: batches from the root's arena, or the heap.
+     */
+    node_cache* nodes() noexcept { return &nodes_; }
+
+    /**
+     * @brief Handles currently allocated, the root included.
+     */
+    size_t size() const noexcept { return slots_.empty() ? 0 : slots_.size() - 1 - free_.size(); }
+
+    /**
+     * @brief Drops the tree reference and every handle.
+     */
+    void reset() noexcept;
+
+    /// @name Read tracking for commit-time conflict checks.
+    /// A read marks the slot it went through and keeps the slot's ancestors
+    /// from being recycled, so recording one allocates nothing. Paths are only
+    /// built by for_each_read(), when a commit actually has to check them.
+    /// @{
+
+    /**
+     * @brief Records that the value behind `h`, which just resolved, was read.
+     */
+    void note_node(store_handle h) const;
+
+    /**
+     * @brief Records that `last` was looked up under `parent`, found or not.
+     */
+    void note_exists(store_handle parent, path_segment last) const;
+
+    /**
+     * @brief Calls `fn(exists, path)` for every recorded read, `exists` telling
+     *        a lookup from a value read. The path is valid during the call.
+     */
+    void for_each_read(std::function<void(bool, std::span<path_segment const>)> const& fn) const;
+
+    /**
+     * @brief Forgets every recorded read, e.g. after a commit.
+     */
+    void clear_reads() noexcept;
+    /// @}
+
+private:
+    struct slot {
+        cow_node const* node = nullptr;  // Cached resolution, valid while epoch matches
+        uint64_t parent = 0;             // Raw handle of the parent, 0 for the root
+        uint64_t epoch = 0;              // Table epoch the cached pointer was taken at
+        node_string key;                 // Object key; empty for array elements
+        size_t index = 0;                // Array index when is_element is set
+        uint32_t generation = 0;
+        bool is_element = false;
+        uint8_t marks = 0;               // read_mark / pin_mark / retired_mark
+    };
+
+    // A lookup recorded by note_exists(); `parent` is a pinned slot
+    struct lookup_read {
+        uint32_t parent = 0;
+        node_string key;
+        size_t index = 0;
+        bool is_element = false;
+    };
+
+    static constexpr uint8_t read_mark = 1;     // The slot's value was read
+    static constexpr uint8_t pin_mark = 2;      // The slot's path is needed by a read
+    static constexpr uint8_t retired_mark = 4;  // Retired while pinned; recycled by clear_reads()
+
+    node_ref root_;
+    node_cache nodes_;
+    uint64_t owner_;
+    uint64_t epoch_ = 1;
+    mutable std::vector<slot> slots_;
+    mutable std::vector<uint32_t> free_;
+    mutable std::vector<uint32_t> pinned_;        // Slots carrying marks
+    mutable std::vector<lookup_read> lookups_;
+
+    store_handle allocate(slot&& s) const;
+    slot* lookup(store_handle h) const;
+    void retire(uint32_t idx) const;
+    void pin(uint32_t idx) const;
+    void raw_path(uint32_t idx, std::vector<path_segment>& out) const;
+};
+
+}  // namespace ion::core::detail
@@ -0,0 +1,555 @@
+/**
+ * @file journal.cpp
+ * @brief Mutation log encoding, replay and the on-disk write-ahead journal.
+ *
+ * Layout (all integers little-endian):
+ *
+ *     header : u32 magic "IVJH" | u32 version | u64 base size | u32 base crc
+ *              | u64 base mtime ns | u64 base device | u64 base inode
+ *     frame  : u32 magic "IVJF" | u32 payload size | u32 payload crc | payload
+ *            | u32 magic "IVJC" | u64 next base size | u32 next base crc
+ *     payload: op*
+ *     op     : u8 kind | path | (kind == put ? value : nothing)
+ *     path   : u32 count | (u8 is_element | (is_element ? u64 index : str key))*
+ *     value  : u8 node_kind | scalar bytes, or u32 count and children
+ */
+
+#include "journal.h"
+#include "byte_codec.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <vector>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+constexpr uint32_t k_journal_magic   = 0x484a5649;  // "IVJH"
+constexpr uint32_t k_frame_magic     = 0x464a5649;  // "IVJF"
+constexpr uint32_t k_compact_magic   = 0x434a5649;  // "IVJC"
+constexpr uint32_t k_journal_version = 1;
+constexpr size_t   k_max_value_depth = 1024;
+
+enum class journal_op : uint8_t {
+    put   = 1,
+    erase = 2,
+};
+
+enum class read_kind : uint8_t {
+    exists = 1,
+    node   = 2,
+};
+
+constexpr std::array<uint32_t, 256> k_crc_table = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}();
+
+void encode_path(std::string& out, std::span<path_segment const> path) {
+    put_u32(out, static_cast<uint32_t>(path.size()));
+    for (auto const& seg : path) {
+        put_u8(out, seg.is_element ? 1 : 0);
+        if (seg.is_element) {
+            put_u64(out, seg.index);
+        } else {
+            put_str(out, seg.key);
+        }
+    }
+}
+
+void encode_value(std::string& out, cow_node const& n) {
+    put_u8(out, static_cast<uint8_t>(n.kind()));
+    switch (n.kind()) {
+        case node_kind::boolean:  put_u8(out, n.as_bool() ? 1 : 0); break;
+        case node_kind::integer:  put_u64(out, static_cast<uint64_t>(n.as_int())); break;
+        case node_kind::floating: put_u64(out, std::bit_cast<uint64_t>(n.as_double())); break;
+        case node_kind::string:
+        case node_kind::opaque:   put_str(out, n.as_string()); break;
+        case node_kind::array:
+            put_u32(out, static_cast<uint32_t>(n.size()));
+            for (auto const& item : n.elements()) encode_value(out, *item);
+            break;
+        case node_kind::object:
+            put_u32(out, static_cast<uint32_t>(n.size()));
+            for (auto const& entry : n.entries()) {
+                put_str(out, entry.key);
+                encode_value(out, *entry.value);
+            }
+            break;
+        case node_kind::null:
+            break;
+    }
+}
+
+node_ref decode_value(byte_reader& in, uint64_t owner, node_cache* cache, size_t depth) {
+    uint8_t kind = 0;
+    if (depth > k_max_value_depth || !in.u8(kind)) return {};
+
+    switch (static_cast<node_kind>(kind)) {
+        case node_kind::null:
+            return cow_node::make_null(owner, cache);
+        case node_kind::boolean: {
+            uint8_t v = 0;
+            return in.u8(v) ? cow_node::make_bool(v != 0, owner, cache) : node_ref{};
+        }
+        case node_kind::integer: {
+            uint64_t v = 0;
+            return in.u64(v) ? cow_node::make_int(static_cast<int64_t>(v), owner, cache) : node_ref{};
+        }
+        case node_kind::floating: {
+            uint64_t v = 0;
+            return in.u64(v) ? cow_node::make_double(std::bit_cast<double>(v), owner, cache) : node_ref{};
+        }
+        case node_kind::string:
+        case node_kind::opaque: {
+            std::string_view v;
+            if (!in.str(v)) return {};
+            return static_cast<node_kind>(kind) == node_kind::string ? cow_node::make_string(v, owner, cache)
+                                                                     : cow_node::make_opaque(v, owner, cache);
+        }
+        case node_kind::array: {
+            uint32_t count = 0;
+            if (!in.u32(count) || count > in.remaining()) return {};
+            auto arr = cow_node::make_array(owner, cache);
+            arr->elements().reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                auto item = decode_value(in, owner, cache, depth + 1);
+                if (!item) return {};
+                arr->elements().push_back(std::move(item));
+            }
+            return arr;
+        }
+        case node_kind::object: {
+            uint32_t count = 0;
+            if (!in.u32(count) || count > in.remaining()) return {};
+            auto obj = cow_node::make_object(owner, cache);
+            obj->entries().reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                std::string_view key;
+                if (!in.str(key)) return {};
+                auto value = decode_value(in, owner, cache, depth + 1);
+                if (!value) return {};
+                obj->insert_or_assign(key, std::move(value));
+            }
+            return obj;
+        }
+    }
+    return {};
+}
+
+bool skip_value(byte_reader& in, size_t depth) {
+    uint8_t kind = 0;
+    if (depth > k_max_value_depth || !in.u8(kind)) return false;
+
+    uint8_t flag = 0;
+    uint64_t scalar = 0;
+    std::string_view text;
+    uint32_t count = 0;
+    switch (static_cast<node_kind>(kind)) {
+        case node_kind::null:     return true;
+        case node_kind::boolean:  return in.u8(flag);
+        case node_kind::integer:
+        case node_kind::floating: return in.u64(scalar);
+        case node_kind::string:
+        case node_kind::opaque:   return in.str(text);
+        case node_kind::array:
+            if (!in.u32(count)) return false;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (!skip_value(in, depth + 1)) return false;
+            }
+            return true;
+        case node_kind::object:
+            if (!in.u32(count)) return false;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (!in.str(text) || !skip_value(in, depth + 1)) return false;
+            }
+            return true;
+    }
+    return false;
+}
+
+bool decode_path(byte_reader& in, std::vector<path_segment>& path) {
+    uint32_t count = 0;
+    if (!in.u32(count) || count > in.remaining()) return false;
+    path.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t is_element = 0;
+        path_segment seg;
+        if (!in.u8(is_element)) return false;
+        seg.is_element = is_element != 0;
+        if (seg.is_element) {
+            uint64_t idx = 0;
+            if (!in.u64(idx)) return false;
+            seg.index = static_cast<size_t>(idx);
+        } else if (!in.str(seg.key)) {
+            return false;
+        }
+        path.push_back(seg);
+    }
+    return true;
+}
+
+node_ref* child_slot(cow_node* parent, path_segment const& seg) {
+    if (seg.is_element) {
+        if (!parent->is_array() || seg.index >= parent->size()) return nullptr;
+        return &parent->elements()[seg.index];
+    }
+    if (!parent->is_object()) return nullptr;
+    return parent->find_ref(seg.key);
+}
+
+cow_node const* const_child(cow_node const* parent, path_segment const& seg) {
+    if (!parent) return nullptr;
+    if (seg.is_element) {
+        if (!parent->is_array() || seg.index >= parent->size()) return nullptr;
+        return parent->elements()[seg.index].get();
+    }
+    return parent->is_object() ? parent->find(seg.key) : nullptr;
+}
+
+}  // namespace
+
+uint32_t ion::core::detail::crc32(std::string_view data, uint32_t crc) noexcept {
+    crc = ~crc;
+    for (char ch : data) {
+        crc = k_crc_table[(crc ^ static_cast<uint8_t>(ch)) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void mutation_log::put(std::span<path_segment const> path, cow_node const& value) {
+    put_u8(bytes_, static_cast<uint8_t>(journal_op::put));
+    encode_path(bytes_, path);
+    encode_value(bytes_, value);
+}
+
+void mutation_log::erase(std::span<path_segment const> path) {
+    put_u8(bytes_, static_cast<uint8_t>(journal_op::erase));
+    encode_path(bytes_, path);
+}
+
+std::string_view read_set::bytes() const {
+    bytes_.clear();
+    handles_->for_each_read([&](bool exists, std::span<path_segment const> path) {
+        put_u8(bytes_, static_cast<uint8_t>(exists ? read_kind::exists : read_kind::node));
+        encode_path(bytes_, path);
+    });
+    return bytes_;
+}
+
+bool ion::core::detail::reads_unchanged(cow_node const* base, cow_node const* head, std::string_view reads) {
+    if (base == head) return true;
+
+    byte_reader in(reads);
+    std::vector<path_segment> path;
+    while (!in.at_end()) {
+        uint8_t kind = 0;
+        if (!in.u8(kind) || !decode_path(in, path)) return false;
+
+        cow_node const* b = base;
+        cow_node const* h = head;
+        for (auto const& seg : path) {
+            if (b == h) break;                // Same subtree: nothing below it changed
+            if (seg.is_element) return false; // Indices into a changed array may have shifted
+            b = const_child(b, seg);
+            h = const_child(h, seg);
+        }
+
+        if (b == h) continue;
+        if (kind == static_cast<uint8_t>(read_kind::node)) return false;
+        if ((b != nullptr) != (h != nullptr)) return false;
+    }
+    return true;
+}
+
+bool ion::core::detail::apply_mutations(node_ref& root, std::string_view payload, uint64_t owner) {
+    byte_reader in(payload);
+    std::vector<path_segment> path;
+    node_cache cache(root ? root->arena() : nullptr);  // Replayed and rebased nodes join the tree's arena
+
+    while (!in.at_end()) {
+        uint8_t op = 0;
+        if (!in.u8(op) || !decode_path(in, path)) return false;
+
+        node_ref value;
+        if (op == static_cast<uint8_t>(journal_op::put)) {
+            value = decode_value(in, owner, &cache, 0);
+            if (!value) return false;
+            if (path.empty()) {
+                root = std::move(value);
+                continue;
+            }
+        } else if (op != static_cast<uint8_t>(journal_op::erase) || path.empty()) {
+            return false;
+        }
+
+        // Make the parent of the target writable, cloning shared nodes on the way
+        cow_node* parent = make_mutable(root, owner, &cache);
+        for (size_t i = 0; i + 1 < path.size(); ++i) {
+            node_ref* slot = child_slot(parent, path[i]);
+            if (!slot) return false;
+            parent = make_mutable(*slot, owner, &cache);
+        }
+
+        auto const& last = path.back();
+        if (value) {
+            if (last.is_element) {
+                node_ref* slot = child_slot(parent, last);
+                if (!slot) return false;
+                *slot = std::move(value);
+            } else {
+                if (!parent->is_object()) return false;
+                parent->insert_or_assign(last.key, std::move(value));
+            }
+        } else if (last.is_element) {
+            if (parent->is_array() && last.index < parent->size()) {
+                auto& elements = parent->elements();
+                elements.erase(elements.begin() + static_cast<std::ptrdiff_t>(last.index));
+            }
+        } else if (parent->is_object()) {
+            parent->erase(last.key);
+        }
+    }
+    return true;
+}
+
+bool ion::core::detail::for_each_changed_path(std::string_view payload,
+                                              std::function<void(std::span<path_segment const>)> const& fn) {
+    byte_reader in(payload);
+    std::vector<path_segment> path;
+
+    while (!in.at_end()) {
+        uint8_t op = 0;
+        if (!in.u8(op) || !decode_path(in, path)) return false;
+
+        if (op == static_cast<uint8_t>(journal_op::put)) {
+            if (!skip_value(in, 0)) return false;
+        } else if (op != static_cast<uint8_t>(journal_op::erase)) {
+            return false;
+        } else if (!path.empty() && path.back().is_element) {
+            path.pop_back();
+        }
+        fn(path);
+    }
+    return true;
+}
+
+std::filesystem::path journal_file::path_for(std::filesystem::path const& base) {
+    auto path = base;
+    path += ".journal";
+    return path;
+}
+
+void journal_file::set_path(std::filesystem::path path) {
+    out_.close();
+    path_ = std::move(path);
+    size_ = 0;
+}
+
+std::filesystem::path journal_file::base_path() const {
+    return std::filesystem::path(path_).replace_extension();   // `<base>.journal` minus the extension
+}
+
+std::expected<base_digest, std::error_code> journal_file::current_digest() {
+    if (!digest_) {
+        auto base = read_file(base_path(), false);
+        if (!base) {
+            return std::unexpected(base.error());
+        }
+        digest_ = digest_of(base->view());
+    }
+    return *digest_;
+}
+
+std::expected<void, std::error_code> journal_file::recover(node_ref& root, bool repair) {
+    out_.close();
+    size_ = 0;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path_, ec)) {
+        return {};
+    }
+
+    auto file = read_file(path_, false);
+    if (!file) {
+        return std::unexpected(file.error());
+    }
+    std::string_view content = file->view();
+
+    byte_reader in(content);
+    uint32_t magic = 0, version = 0;
+    base_digest digest;
+    file_stamp stamp;
+    if (!in.u32(magic) || !in.u32(version) || !in.u64(digest.size) || !in.u32(digest.crc) ||
+        !in.u64(stamp.mtime_ns) || !in.u64(stamp.device) || !in.u64(stamp.inode)) {
+        // The header goes out with the first frame, so a torn one holds no commit
+        return repair ? discard() : std::expected<void, std::error_code>{};
+    }
+    if (magic != k_journal_magic || version != k_journal_version) {
+        return std::unexpected(make_error_code(core_errc::journal_mismatch));
+    }
+
+    // An untouched base matches its stamp; a copied or restored one only its contents
+    stamp.size = digest.size;
+    bool current = stamp == stamp_;
+    if (current) {
+        digest_ = digest;
+    } else {
+        auto base = current_digest();
+        if (!base) {
+            return std::unexpected(base.error());
+        }
+        current = *base == digest;
+    }
+
+    size_t good = in.position();
+    bool folded = false;
+    while (!in.at_end()) {
+        uint32_t frame_magic = 0;
+        if (!in.u32(frame_magic)) {
+            break;
+        }
+        if (frame_magic == k_compact_magic) {
+            base_digest next;
+            if (!in.u64(next.size) || !in.u32(next.crc)) {
+                break;
+            }
+            // Compaction got as far as writing the base this journal was folded into
+            folded = folded || (!current && next == *digest_);
+        } else {
+            uint32_t length = 0, crc = 0;
+            std::string_view payload;
+            if (!in.u32(length) || !in.u32(crc) || !in.bytes(length, payload) ||
+                frame_magic != k_frame_magic || crc32(payload) != crc) {
+                break;  // Torn write at the tail; everything before it is intact
+            }
+            if (current && !apply_mutations(root, payload, 0)) {
+                return std::unexpected(make_error_code(core_errc::parse_error));
+            }
+        }
+        good = in.position();
+    }
+
+    if (!current) {
+        if (folded) {
+            return repair ? discard() : std::expected<void, std::error_code>{};
+        }
+        // These commits were reported durable: leave them for whoever restores their base
+        return std::unexpected(make_error_code(core_errc::journal_mismatch));
+    }
+
+    if (repair && good < content.size()) {
+        std::filesystem::resize_file(path_, good, ec);
+        if (ec) {
+            return std::unexpected(make_error_code(core_errc::io_failure));
+        }
+    }
+    size_ = good;
+    return {};
+}
+
+std::expected<void, std::error_code> journal_file::append(std::string_view payload) {
+    std::string frame;
+    frame.reserve(12);
+    put_u32(frame, k_frame_magic);
+    put_u32(frame, static_cast<uint32_t>(payload.size()));
+    put_u32(frame, crc32(payload));
+
+    std::string_view parts[] = {frame, payload};
+    return write(parts);
+}
+
+std::expected<void, std::error_code> journal_file::mark_compaction(base_digest const& next) {
+    if (size_ == 0) {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+        if (ec) {
+            return std::unexpected(make_error_code(core_errc::io_failure));
+        }
+        return {};
+    }
+
+    std::string frame;
+    put_u32(frame, k_compact_magic);
+    put_u64(frame, next.size);
+    put_u32(frame, next.crc);
+
+    std::string_view parts[] = {frame};
+    return write(parts);
+}
+
+std::expected<void, std::error_code> journal_file::write(std::span<std::string_view const> parts) {
+    if (!io_) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+
+    std::string header;
+    if (size_ == 0) {
+        auto digest = current_digest();
+        if (!digest) {
+            return std::unexpected(digest.error());
+        }
+        put_u32(header, k_journal_magic);
+        put_u32(header, k_journal_version);
+        put_u64(header, digest->size);
+        put_u32(header, digest->crc);
+        put_u64(header, stamp_.mtime_ns);
+        put_u64(header, stamp_.device);
+        put_u64(header, stamp_.inode);
+    }
+
+    if (!out_.is_open()) {
+        // A fresh journal replaces whatever stale file a failed discard left behind
+        auto opened = durable_file::open_append(path_, size_ == 0);
+        if (!opened) {
+            return std::unexpected(opened.error());
+        }
+        out_ = std::move(*opened);
+    }
+
+    // Header (for a new journal) and frame go out as one durable write
+    std::array<std::string_view, 3> buffer;
+    size_t count = 0;
+    if (!header.empty()) {
+        buffer[count++] = header;
+    }
+    for (auto part : parts.first(std::min(parts.size(), buffer.size() - count))) {
+        buffer[count++] = part;
+    }
+    auto all = std::span<std::string_view const>(buffer.data(), count);
+    auto appended = io_->append(out_, all);
+    if (!appended) {
+        // Cut a torn frame off so later appends don't land behind it
+        out_.close();
+        if (size_ != 0) {
+            std::error_code ec;
+            std::filesystem::resize_file(path_, size_, ec);
+        }
+        return appended;
+    }
+    for (auto part : all) {
+        size_ += part.size();
+    }
+    return {};
+}
+
+std::expected<void, std::error_code> journal_file::discard() {
+    out_.close();
+    size_ = 0;
+
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+    if (ec) {
+        return std::unexpected(make_error_code(core_errc::io_failure));
+    }
+    return {};
+}
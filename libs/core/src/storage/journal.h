@@ -0,0 +1,214 @@
+#pragma once
+
+#include <ion/core/error.h>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "cow_node.h"
+#include "file_io.h"
+#include "handle_table.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief CRC-32 (IEEE) of `data`, continuing from `crc`.
+ */
+uint32_t crc32(std::string_view data, uint32_t crc = 0) noexcept;
+
+/**
+ * @brief What a base file holds, for telling a copy of it from another file.
+ */
+struct base_digest {
+    uint64_t size = 0;
+    uint32_t crc = 0;
+
+    friend bool operator==(base_digest const&, base_digest const&) = default;
+};
+
+inline base_digest digest_of(std::string_view content) noexcept {
+    return {content.size(), crc32(content)};
+}
+
+/**
+ * @brief Compact binary record of the mutations made by one transaction.
+ *
+ * Two operations cover the whole write API: `put` replaces (or inserts) the
+ * node at a path with a value, and `erase` removes the node at a path. The
+ * last path segment names the key or index inside the parent; an empty path
+ * refers to the root.
+ */
+class mutation_log {
+public:
+    void put(std::span<path_segment const> path, cow_node const& value);
+    void erase(std::span<path_segment const> path);
+
+    bool empty() const noexcept { return bytes_.empty(); }
+    std::string_view bytes() const noexcept { return bytes_; }
+    void clear() noexcept { bytes_.clear(); }
+
+private:
+    std::string bytes_;
+};
+
+/**
+ * @brief What a transaction observed, checked before its mutations are
+ *        replayed on top of commits it did not see.
+ *
+ * A lookup (a path navigated or tested for presence) stays valid as long as
+ * the path still resolves, or still does not. A value read stays valid only
+ * while that exact node is still there.
+ *
+ * The reads themselves are recorded by identity in the transaction's
+ * handle_table; bytes() turns them into paths, which only happens when the
+ * commit has to be rebased onto versions the transaction did not see.
+ */
+class read_set {
+public:
+    explicit read_set(handle_table const& handles) noexcept : handles_(&handles) {}
+
+    /**
+     * @brief The recorded reads, encoded for reads_unchanged().
+     */
+    std::string_view bytes() const;
+
+private:
+    handle_table const* handles_;
+    mutable std::string bytes_;
+};
+
+/**
+ * @brief True if every read in `reads` sees the same thing in `head` as in `base`.
+ *
+ * Committed trees are copy-on-write, so a commit that changes anything at or
+ * below a node replaces that node: node identity is the version of its
+ * subtree. `base` keeps its nodes alive, so an address cannot be reused in
+ * `head`. Array indices are positional, so a path through an array that
+ * changed at all is treated as stale.
+ */
+bool reads_unchanged(cow_node const* base, cow_node const* head, std::string_view reads);
+
+/**
+ * @brief Applies the operations in `payload` to `root`.
+ *
+ * Nodes are cloned for `owner` as needed, so the caller's snapshot is never
+ * modified; new and cloned nodes come from `root`'s arena when it has one.
+ * Erasing something that is already gone is not an error.
+ * @return False if the payload is malformed or refers to a path that does not exist.
+ */
+bool apply_mutations(node_ref& root, std::string_view payload, uint64_t owner);
+
+/**
+ * @brief Calls `fn` with the path each operation in `payload` changes.
+ *
+ * Values are skipped, not decoded. Erasing an array element shifts the
+ * elements after it, so it reports the array instead.
+ * @return False if the payload is malformed.
+ */
+bool for_each_changed_path(std::string_view payload, std::function<void(std::span<path_segment const>)> const& fn);
+
+/**
+ * @brief Append-only write-ahead log kept next to a store's base file.
+ *
+ * The file starts with a header naming the base file it applies to, followed
+ * by one checksummed frame per committed transaction. The header holds the
+ * base's file_stamp, which matches with one stat as long as nobody touched
+ * the file, and its base_digest, which still matches after the base was
+ * copied, restored or had its timestamp changed.
+ *
+ * Before compaction renames a new base into place it appends a marker frame
+ * with the new base's digest. A crash between the rename and removing the
+ * journal therefore leaves a journal that names the base it was folded into,
+ * and it is discarded on the next open instead of being replayed twice. A
+ * journal that matches neither is kept and fails the open, since its frames
+ * are commits that were reported durable.
+ */
+class journal_file {
+public:
+    explicit journal_file(std::filesystem::path path = {}) : path_(std::move(path)) {}
+
+    /**
+     * @brief Journal path used for a base file: `<base>.journal`.
+     */
+    static std::filesystem::path path_for(std::filesystem::path const& base);
+
+    void set_path(std::filesystem::path path);
+
+    /**
+     * @brief Sets the backend appends go through; required before append().
+     */
+    void set_io(file_io* io) noexcept { io_ = io; }
+
+    /**
+     * @brief Records the base file new frames apply to, as found on disk.
+     *
+     * Its digest is worked out from the file only if a new journal needs it.
+     */
+    void set_base(file_stamp const& stamp) noexcept {
+        stamp_ = stamp;
+        digest_.reset();
+    }
+
+    /**
+     * @brief Records the base file new frames apply to, just written with `digest`.
+     */
+    void set_base(file_stamp const& stamp, base_digest const& digest) noexcept {
+        stamp_ = stamp;
+        digest_ = digest;
+    }
+
+    /**
+     * @brief Replays a journal written against the current base onto `root`.
+     *
+     * A journal whose frames were already folded into the current base is
+     * removed. A torn or corrupt tail (a frame cut short by a crash) ends the
+     * replay and is truncated away. With `repair` false both are skipped and
+     * neither file is written.
+     * @return Success, core_errc::journal_mismatch (journal left in place) if
+     *         it applies to another base, or the error reading either file.
+     */
+    std::expected<void, std::error_code> recover(node_ref& root, bool repair = true);
+
+    /**
+     * @brief Records that the base is about to be replaced by one with `next` as its digest.
+     *
+     * Call before the new base is renamed into place. Without a journal it
+     * only removes a stale file a failed discard() left behind.
+     */
+    std::expected<void, std::error_code> mark_compaction(base_digest const& next);
+
+    /**
+     * @brief Appends one frame holding `payload` and waits until it is on stable storage.
+     */
+    std::expected<void, std::error_code> append(std::string_view payload);
+
+    /**
+     * @brief Bytes in the journal, header included. 0 if there is none.
+     */
+    uint64_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Closes and deletes the journal file.
+     */
+    std::expected<void, std::error_code> discard();
+
+private:
+    std::filesystem::path base_path() const;
+    std::expected<base_digest, std::error_code> current_digest();
+    std::expected<void, std::error_code> write(std::span<std::string_view const> parts);   // At most two parts
+
+    std::filesystem::path path_;
+    file_io* io_ = nullptr;
+    durable_file out_;
+    uint64_t size_ = 0;
+    file_stamp stamp_;                    // Base file as last seen on disk
+    std::optional<base_digest> digest_;   // Its contents, once known
+};
+
+}  // namespace ion::core::detail
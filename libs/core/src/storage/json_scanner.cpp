@@ -0,0 +1,414 @@
+/**
+ * @file json_scanner.cpp
+ * @brief JSON scanner behind lazy loading.
+ *
+ * Lazy loading reads the file once on open() and builds no tree at all.
+ * Scalars are checked against the full grammar (including UTF-8 and \u
+ * surrogate pairs, which nlohmann checks too); containers are only matched
+ * bracket to bracket, since checking every token inside them would cost as
+ * much as parsing them. Both run iteratively, so deep documents cannot
+ * exhaust the stack.
+ */
+
+#include "json_scanner.h"
+
+#include <ion/core/error.h>
+#include <nlohmann/json.hpp>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+constexpr uint64_t k_ones = 0x0101010101010101ull;
+constexpr uint64_t k_highs = 0x8080808080808080ull;
+
+/**
+ * @brief Marks the bytes of `word` that end a run of plain string characters.
+ *
+ * Sets the high bit of each byte that is a quote, a backslash, a control
+ * character or the start of a multi-byte sequence. Only the lowest marked
+ * byte is exact, which is the only one the caller looks at.
+ */
+constexpr uint64_t string_stops(uint64_t word) noexcept {
+    uint64_t quote = word ^ (k_ones * '"');
+    uint64_t slash = word ^ (k_ones * '\\');
+    uint64_t stops = ((quote - k_ones) & ~quote) | ((slash - k_ones) & ~slash) | ((word - k_ones * 0x20) & ~word);
+    return (stops | word) & k_highs;
+}
+
+class scanner {
+public:
+    scanner(std::string_view text, bool allow_comments) noexcept
+        : p_(text.data()), end_(text.data() + text.size()), allow_comments_(allow_comments) {}
+
+    char const* pos() const noexcept { return p_; }
+    bool at_end() const noexcept { return p_ == end_; }
+    char peek() const noexcept { return *p_; }
+    void advance() noexcept { ++p_; }
+
+    void skip_bom() noexcept {
+        if (end_ - p_ >= 3 && std::memcmp(p_, "\xEF\xBB\xBF", 3) == 0) p_ += 3;
+    }
+
+    /**
+     * @brief Skips whitespace and, if allowed, comments. False on a malformed comment.
+     */
+    bool skip_space() noexcept {
+        while (p_ != end_) {
+            char c = *p_;
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                ++p_;
+            } else if (c == '/' && allow_comments_) {
+                if (!skip_comment()) return false;
+            } else {
+                break;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Scans a string starting at its opening quote.
+     * @param escaped Set if the body holds an escape sequence.
+     */
+    bool scan_string(bool& escaped) noexcept {
+        ++p_;   // Opening quote
+        escaped = false;
+        for (;;) {
+            skip_plain();
+            if (p_ == end_) return false;
+            auto c = static_cast<unsigned char>(*p_);
+            if (c == '"') {
+                ++p_;
+                return true;
+            }
+            if (c == '\\') {
+                escaped = true;
+                if (!scan_escape()) return false;
+            } else if (c < 0x20) {
+                return false;
+            } else if (!scan_utf8()) {
+                return false;
+            }
+        }
+    }
+
+    bool scan_number() noexcept {
+        if (p_ != end_ && *p_ == '-') ++p_;
+        if (p_ == end_ || !is_digit(*p_)) return false;
+        if (*p_ == '0') {
+            ++p_;
+        } else {
+            skip_digits();
+        }
+        if (p_ != end_ && *p_ == '.') {
+            ++p_;
+            if (p_ == end_ || !is_digit(*p_)) return false;
+            skip_digits();
+        }
+        if (p_ != end_ && (*p_ == 'e' || *p_ == 'E')) {
+            ++p_;
+            if (p_ != end_ && (*p_ == '+' || *p_ == '-')) ++p_;
+            if (p_ == end_ || !is_digit(*p_)) return false;
+            skip_digits();
+        }
+        return true;
+    }
+
+    bool scan_literal(std::string_view word) noexcept {
+        if (static_cast<size_t>(end_ - p_) < word.size() || std::memcmp(p_, word.data(), word.size()) != 0) return false;
+        p_ += word.size();
+        return true;
+    }
+
+    /**
+     * @brief Scans one complete value, nested containers included.
+     */
+    bool scan_value() {
+        closers_.clear();
+        for (;;) {
+            // A value is expected here
+            if (!skip_space() || p_ == end_) return false;
+            char c = *p_;
+            bool opened = false;
+            if (c == '{' || c == '[') {
+                ++p_;
+                if (!skip_space() || p_ == end_) return false;
+                char close = c == '{' ? '}' : ']';
+                if (*p_ == close) {
+                    ++p_;
+                } else {
+                    closers_.push_back(close);
+                    if (close == '}' && !scan_key()) return false;
+                    opened = true;
+                }
+            } else if (!scan_scalar()) {
+                return false;
+            }
+            if (opened) continue;
+
+            // The value is complete: close containers until one needs another value
+            for (;;) {
+                if (closers_.empty()) return true;
+                if (!skip_space() || p_ == end_) return false;
+                if (*p_ == ',') {
+                    ++p_;
+                    if (closers_.back() == '}' && !scan_key()) return false;
+                    break;
+                }
+                if (*p_ != closers_.back()) return false;
+                ++p_;
+                closers_.pop_back();
+            }
+        }
+    }
+
+    /**
+     * @brief Skips a container starting at its opening bracket by structure alone.
+     *
+     * Brackets have to match, and strings and comments are stepped over so
+     * the brackets inside them do not count, but no token is checked: the
+     * parser that later reads the container finds any error inside it.
+     */
+    bool skip_container() {
+        closers_.clear();
+        while (p_ != end_) {
+            char c = *p_;
+            if (c == '{' || c == '[') {
+                closers_.push_back(c == '{' ? '}' : ']');
+                ++p_;
+            } else if (c == '}' || c == ']') {
+                if (closers_.empty() || c != closers_.back()) return false;
+                closers_.pop_back();
+                ++p_;
+                if (closers_.empty()) return true;
+            } else if (c == '"') {
+                if (!skip_string()) return false;
+            } else if (c == '/' && allow_comments_) {
+                if (!skip_comment()) return false;
+            } else {
+                ++p_;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Scans `"key" :` at the next token, leaving the position after the colon.
+     */
+    bool scan_key() noexcept {
+        bool escaped = false;
+        if (!skip_space() || p_ == end_ || *p_ != '"' || !scan_string(escaped)) return false;
+        if (!skip_space() || p_ == end_ || *p_ != ':') return false;
+        ++p_;
+        return true;
+    }
+
+private:
+    static bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+    static int hex_value(char c) noexcept {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    void skip_digits() noexcept {
+        while (p_ != end_ && is_digit(*p_)) ++p_;
+    }
+
+    /**
+     * @brief Advances to the next quote, backslash, control or non-ASCII byte.
+     */
+    void skip_plain() noexcept {
+        if constexpr (std::endian::native == std::endian::little) {
+            while (end_ - p_ >= 8) {
+                uint64_t word;
+                std::memcpy(&word, p_, sizeof(word));
+                if (uint64_t stops = string_stops(word)) {
+                    p_ += std::countr_zero(stops) / 8;
+                    return;
+                }
+                p_ += 8;
+            }
+        }
+        while (p_ != end_) {
+            auto c = static_cast<unsigned char>(*p_);
+            if (c == '"' || c == '\\' || c < 0x20 || c >= 0x80) return;
+            ++p_;
+        }
+    }
+
+    /**
+     * @brief Steps over a string starting at its opening quote without checking its body.
+     */
+    bool skip_string() noexcept {
+        ++p_;   // Opening quote
+        for (;;) {
+            auto quote = static_cast<char const*>(std::memchr(p_, '"', static_cast<size_t>(end_ - p_)));
+            if (!quote) return false;
+            // A quote behind an odd run of backslashes is escaped
+            char const* run = quote;
+            while (run != p_ && run[-1] == '\\') --run;
+            p_ = quote + 1;
+            if ((quote - run) % 2 == 0) return true;
+        }
+    }
+
+    bool scan_scalar() noexcept {
+        switch (*p_) {
+            case '"': {
+                bool escaped = false;
+                return scan_string(escaped);
+            }
+            case 't': return scan_literal("true");
+            case 'f': return scan_literal("false");
+            case 'n': return scan_literal("null");
+            default:  return scan_number();
+        }
+    }
+
+    bool read_hex4(uint32_t& code) noexcept {
+        if (end_ - p_ < 4) return false;
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            int digit = hex_value(p_[i]);
+            if (digit < 0) return false;
+            code = (code << 4) | static_cast<uint32_t>(digit);
+        }
+        p_ += 4;
+        return true;
+    }
+
+    bool scan_escape() noexcept {
+        ++p_;   // Backslash
+        if (p_ == end_) return false;
+        char c = *p_++;
+        switch (c) {
+            case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                return true;
+            case 'u': break;
+            default:  return false;
+        }
+        uint32_t code;
+        if (!read_hex4(code)) return false;
+        if (code >= 0xDC00 && code <= 0xDFFF) return false;   // Low surrogate without a high one
+        if (code < 0xD800 || code > 0xDBFF) return true;
+        if (end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u') return false;
+        p_ += 2;
+        return read_hex4(code) && code >= 0xDC00 && code <= 0xDFFF;
+    }
+
+    /**
+     * @brief Checks one well-formed UTF-8 sequence: no overlong forms, no surrogates, at most U+10FFFF.
+     */
+    bool scan_utf8() noexcept {
+        auto lead = static_cast<unsigned char>(*p_);
+        unsigned char low = 0x80, high = 0xBF;
+        int continuations;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            continuations = 1;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            continuations = 2;
+            if (lead == 0xE0) low = 0xA0;
+            if (lead == 0xED) high = 0x9F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            continuations = 3;
+            if (lead == 0xF0) low = 0x90;
+            if (lead == 0xF4) high = 0x8F;
+        } else {
+            return false;
+        }
+        if (end_ - p_ <= continuations) return false;
+        auto first = static_cast<unsigned char>(p_[1]);
+        if (first < low || first > high) return false;
+        for (int i = 2; i <= continuations; ++i) {
+            auto next = static_cast<unsigned char>(p_[i]);
+            if (next < 0x80 || next > 0xBF) return false;
+        }
+        p_ += continuations + 1;
+        return true;
+    }
+
+    bool skip_comment() noexcept {
+        if (end_ - p_ < 2) return false;
+        if (p_[1] == '/') {
+            p_ += 2;
+            while (p_ != end_ && *p_ != '\n' && *p_ != '\r') ++p_;
+            return true;
+        }
+        if (p_[1] != '*') return false;
+        p_ += 2;
+        for (; end_ - p_ >= 2; ++p_) {
+            if (p_[0] == '*' && p_[1] == '/') {
+                p_ += 2;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    char const* p_;
+    char const* end_;
+    bool allow_comments_;
+    std::vector<char> closers_;   // Closing brackets of the containers scan_value() is inside
+};
+
+}  // namespace
+
+std::expected<bool, std::error_code> ion::core::detail::index_json_object(std::string_view content, bool allow_comments,
+                                                                        std::vector<json_member>& members) {
+    auto malformed = std::unexpected(make_error_code(core_errc::parse_error));
+    scanner scan(content, allow_comments);
+    scan.skip_bom();
+    if (!scan.skip_space() || scan.at_end()) return malformed;
+
+    bool is_object = scan.peek() == '{';
+    if (!is_object) {
+        if (!scan.scan_value()) return malformed;
+    } else {
+        scan.advance();
+        if (!scan.skip_space() || scan.at_end()) return malformed;
+        if (scan.peek() == '}') {
+            scan.advance();
+        } else {
+            for (;;) {
+                if (!scan.skip_space() || scan.at_end() || scan.peek() != '"') return malformed;
+                char const* key_start = scan.pos();
+                bool escaped = false;
+                if (!scan.scan_string(escaped)) return malformed;
+                auto quoted = std::string_view(key_start, static_cast<size_t>(scan.pos() - key_start));
+                if (!scan.skip_space() || scan.at_end() || scan.peek() != ':') return malformed;
+                scan.advance();
+                if (!scan.skip_space()) return malformed;
+                char const* value_start = scan.pos();
+                bool container = !scan.at_end() && (scan.peek() == '{' || scan.peek() == '[');
+                if (!(container ? scan.skip_container() : scan.scan_value())) return malformed;
+
+                auto& member = members.emplace_back();
+                member.value = std::string_view(value_start, static_cast<size_t>(scan.pos() - value_start));
+                if (escaped) {
+                    member.key = nlohmann::json::parse(quoted).get<std::string>();
+                } else {
+                    member.key = quoted.substr(1, quoted.size() - 2);
+                }
+
+                if (!scan.skip_space() || scan.at_end()) return malformed;
+                if (scan.peek() == '}') {
+                    scan.advance();
+                    break;
+                }
+                if (scan.peek() != ',') return malformed;
+                scan.advance();
+            }
+        }
+    }
+
+    if (!scan.skip_space() || !scan.at_end()) return malformed;
+    return is_object;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <expected>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace ion::core::detail {
+
+/**
+ * @brief One member of a JSON document's root object, located but not parsed.
+ */
+struct json_member {
+    std::string key;          // Decoded key
+    std::string_view value;   // The member's value exactly, without surrounding space or comments
+};
+
+/**
+ * @brief Locates the members of a JSON document's root object.
+ *
+ * The root's own syntax, its keys and its scalar members are checked exactly
+ * as nlohmann::json::parse() checks them with the same comment setting. Object
+ * and array members are only skipped bracket to bracket, so one that is
+ * malformed inside fails when it is parsed, not here. A root that is not an
+ * object is checked in full. Nothing below the root is allocated: string
+ * bodies are skipped eight bytes at a time and containers only push their
+ * closing bracket.
+ * @param content The whole document.
+ * @param allow_comments Accept line and block comments between tokens.
+ * @param members Receives the root object's members in document order.
+ * @return True if the root is an object, false if it is some other valid
+ *         value, or core_errc::parse_error if the document is malformed.
+ */
+std::expected<bool, std::error_code> index_json_object(std::string_view content, bool allow_comments,
+                                                       std::vector<json_member>& members);
+
+}  // namespace ion::core::detail
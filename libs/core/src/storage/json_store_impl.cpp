@@ -3,172 +3,271 @@
  * @brief Implementation of the json_store class for managing JSON-based storage.
  *
  * This file contains the implementation of the json_store class, which provides
- * methods for opening, closing, and managing transactions on a JSON-based
- * storage backend. The class ensures ACID compliance by using atomic file
- * operations for saving data.
+ * the JSON file format for the file store machinery in file_store.cpp:
+ * parsing a base file into a tree and serializing a tree back out.
+ *
+ * The committed data is held as a persistent cow_node tree rather than an
+ * nlohmann::json document: nlohmann values own their children outright, so
+ * there is no way to share an unchanged subtree between two versions. The
+ * nlohmann types are used only to parse and serialize the file.
  */
 
 #include "json_store_impl.h"
-#include "json_transaction_impl.h"
-#include <fstream>
-#include <sstream>
+#include "json_scanner.h"
+#include "cow_transaction.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace ion::core;
 using namespace ion::core::detail;
 
-/**
- * @brief Constructs a json_store instance.
- * @param path Filesystem path to the JSON file.
- * @param options Options for configuring the JSON store.
- */
-json_store::json_store(std::filesystem::path const& path, json_store_options const& options)
-    : path_(path), options_(options), data_(nlohmann::json::object()) { }
+namespace {
 
-/**
- * @brief Destructor for json_store.
- *
- * Ensures the store is properly closed if it is still open.
- */
-json_store::~json_store() {
-    if (is_open_) {
-        auto result = close();
-        if (!result) {
-            // Not much we can do here if closing fails,
-            // but we should log or handle the error in a real application.
-            // For now, we just ignore it.
+node_ref node_from_json(nlohmann::json const& j) {
+    using value_t = nlohmann::json::value_t;
+    switch (j.type()) {
+        case value_t::boolean:
+            return cow_node::make_bool(j.get<bool>());
+        case value_t::number_integer:
+            return cow_node::make_int(j.get<int64_t>());
+        case value_t::number_unsigned: {
+            // nlohmann parses every non-negative integer as unsigned; only
+            // values beyond int64_t lose their integer-ness here.
+            auto v = j.get<uint64_t>();
+            if (v <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                return cow_node::make_int(static_cast<int64_t>(v));
+            }
+            return cow_node::make_double(static_cast<double>(v));
+        }
+        case value_t::number_float:
+            return cow_node::make_double(j.get<double>());
+        case value_t::string:
+            return cow_node::make_string(j.get_ref<std::string const&>());
+        case value_t::array: {
+            auto arr = cow_node::make_array();
+            auto& elements = arr->elements();
+            elements.reserve(j.size());
+            for (auto const& item : j) {
+                elements.push_back(node_from_json(item));
+            }
+            return arr;
+        }
+        case value_t::object: {
+            auto obj = cow_node::make_object();
+            obj->entries().reserve(j.size());
+            for (auto const& [key, value] : j.items()) {
+                obj->insert_or_assign(key, node_from_json(value));
+            }
+            return obj;
         }
+        default:
+            return cow_node::make_null();
     }
 }
 
 /**
- * @brief Opens the JSON store at the specified path.
- * @param path Filesystem path to the JSON file.
- * @return Success or an error if the store is already open or the file cannot be read.
+ * @brief Converts a tree to nlohmann values.
+ * @param malformed Set if the tree holds a deferred member that failed to parse.
  */
-std::expected<void, std::error_code> json_store::open(std::filesystem::path const& path) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (is_open_) {
-        return std::unexpected(make_error_code(core_errc::already_exists));
+nlohmann::json node_to_json(cow_node const& n, bool& malformed) {
+    if (n.is_malformed()) [[unlikely]] {
+        malformed = true;
+        return nullptr;
     }
-
-    path_ = path;
-
-    // Load an existing file or create an empty object.
-    if (std::filesystem::exists(path_)) {
-        auto result = load_from_file();
-        if (!result) {
-            return result; // Propagate error from load
+    switch (n.kind()) {
+        case node_kind::boolean:  return n.as_bool();
+        case node_kind::integer:  return n.as_int();
+        case node_kind::floating: return n.as_double();
+        case node_kind::string:
+        case node_kind::opaque:   return std::string(n.as_string());
+        case node_kind::array: {
+            auto arr = nlohmann::json::array();
+            for (auto const& item : n.elements()) {
+                arr.push_back(node_to_json(*item, malformed));
+            }
+            return arr;
+        }
+        case node_kind::object: {
+            auto obj = nlohmann::json::object();
+            for (auto const& entry : n.entries()) {
+                obj.emplace(std::string(entry.key.view()), node_to_json(*entry.value, malformed));
+            }
+            return obj;
         }
+        case node_kind::null:
+        default:
+            return nullptr;
     }
+}
 
-    is_open_ = true;
-    return {};
+bool holds_non_finite(cow_node const& n) {
+    switch (n.kind()) {
+        case node_kind::floating:
+            return !std::isfinite(n.as_double());
+        case node_kind::array:
+            return std::ranges::any_of(n.elements(), [](auto const& item) { return holds_non_finite(*item); });
+        case node_kind::object:
+            return std::ranges::any_of(n.entries(), [](auto const& entry) { return holds_non_finite(*entry.value); });
+        default:
+            return false;
+    }
 }
 
 /**
- * @brief Closes the JSON store.
+ * @brief The file_store settings for `options`.
  *
- * Clears the in-memory data and marks the store as closed.
- * @return Success or an error if the store is not open.
+ * A lazily loaded file is read into memory even with write_mmap: deferred
+ * members point into the contents for as long as they stay unread, and a
+ * mapping held that long faults (SIGBUS on POSIX) once another process
+ * truncates the file, and on Windows keeps compaction from renaming over it.
  */
-std::expected<void, std::error_code> json_store::close() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!is_open_) {
-        return std::unexpected(make_error_code(core_errc::invalid_state));
-    }
-
-    is_open_ = false;
-    data_.clear(); // Clear in-memory data
-    return {};
+file_store_options json_file_options(json_store_options const& options) {
+    auto result = file_options_of(options);
+    result.write_mmap = options.write_mmap && !options.lazy_load;
+    return result;
 }
 
 /**
- * @brief Begins a new transaction on the JSON store.
+ * @brief Parses the members of a lazily loaded file when they are first touched.
  *
- * Creates a new json_transaction instance for managing changes to the store.
- * @return A unique pointer to the transaction or an error if the store is not open.
+ * Owns the file contents while any deferred node still points into them.
  */
-std::expected<std::unique_ptr<transaction_base>, std::error_code> json_store::begin_transaction() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!is_open_) {
-        return std::unexpected(make_error_code(core_errc::invalid_state));
+class json_source final : public deferred_source {
+public:
+    json_source(file_contents contents, bool allow_comments)
+        : contents_(std::move(contents)), allow_comments_(allow_comments) {}
+
+    std::string_view text() const noexcept { return contents_.view(); }
+
+    std::expected<node_ref, core_errc> parse(std::string_view text) const override {
+        try {
+            return node_from_json(nlohmann::json::parse(text.begin(), text.end(), nullptr, true, allow_comments_));
+        } catch (const nlohmann::json::exception&) {
+            return std::unexpected(core_errc::parse_error);   // index_json_object() only matched the member's brackets
+        }
     }
 
-    auto txn = std::make_unique<json_transaction>(data_, this, options_);
-    return txn;
-}
+private:
+    file_contents contents_;   // Read into memory, never mapped; see json_file_options()
+    bool allow_comments_;
+};
+
+}  // namespace
 
 /**
- * @brief Loads the JSON data from the file into memory.
- *
- * Parses the JSON file and populates the in-memory representation.
- * @return Success or an error if the file cannot be read or parsed.
+ * @brief Constructs a json_store instance.
+ * @param path Filesystem path to the JSON file.
+ * @param options Options for configuring the JSON store.
  */
-std::expected<void, std::error_code> json_store::load_from_file() {
-    try {
-        std::ifstream file(path_, std::ios::in | std::ios::binary);
-        if (!file.is_open()) {
-            return std::unexpected(make_error_code(core_errc::io_failure));
-        }
+json_store::json_store(std::filesystem::path const& path, json_store_options const& options)
+    : file_store(path, json_file_options(options)), options_(options) { }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        
-        auto content = buffer.str();
-        if (content.empty()) {
-            // Empty file, use empty object
-            data_ = nlohmann::json::object();
-        } else {
-            data_ = nlohmann::json::parse(content, nullptr, options_.allow_comments);
-        }
+/**
+ * @brief Destructor for json_store.
+ *
+ * Ensures the store is properly closed if it is still open.
+ */
+json_store::~json_store() {
+    close_on_destroy();
+}
 
-        return {};
+/**
+ * @brief Parses JSON file content into a tree.
+ * @param content The whole base file.
+ * @return The root or core_errc::parse_error.
+ */
+std::expected<node_ref, std::error_code> json_store::parse(std::string_view content) {
+    try {
+        return node_from_json(nlohmann::json::parse(content.begin(), content.end(), nullptr, true, options_.allow_comments));
     } catch (const nlohmann::json::parse_error&) {
         return std::unexpected(make_error_code(core_errc::parse_error));
-    } catch (const std::exception&) {
-        return std::unexpected(make_error_code(core_errc::unknown));
-    } catch (...) {
-        return std::unexpected(make_error_code(core_errc::unknown));
     }
 }
 
 /**
- * @brief Saves the JSON data to the file.
+ * @brief Parses the base file, or with lazy_load only indexes its root object.
  *
- * Writes the in-memory JSON data to a temporary file and atomically renames it
- * to replace the original file.
- * @param data The JSON data to save.
- * @return Success or an error if the file cannot be written.
+ * Lazily, only the root object and its scalar members are validated here.
+ * Scalar members are built right away; object and array members are matched
+ * bracket to bracket and become deferred nodes parsed by the first read that
+ * reaches them. Reads of a member that turns out malformed inside fail with
+ * core_errc::parse_error, and so does saving the tree while it holds one.
+ * @param contents The whole base file.
+ * @return The root or core_errc::parse_error.
  */
-std::expected<void, std::error_code> json_store::save_to_file(nlohmann::json const& data) {
+std::expected<node_ref, std::error_code> json_store::parse_contents(file_contents&& contents) {
+    if (!options_.lazy_load) {
+        return parse(contents.view());
+    }
+
+    // Deferred nodes hold their own references; this one is dropped once the root is built
+    struct source_release {
+        void operator()(json_source* source) const noexcept { source->release(); }
+    };
+    std::unique_ptr<json_source, source_release> source(new json_source(std::move(contents), options_.allow_comments));
+
+    std::vector<json_member> members;
+    auto indexed = index_json_object(source->text(), options_.allow_comments, members);
+    if (!indexed) {
+        return std::unexpected(indexed.error());
+    }
+    if (!*indexed) {
+        return parse(source->text());
+    }
+
     try {
-        // Write to a temporary file for atomicity
-        std::filesystem::path temp_path = path_;
-        temp_path += ".tmp";
-
-        {
-            std::ofstream temp_file(temp_path, std::ios::out | std::ios::trunc);
-            if (!temp_file.is_open()) {
-                return std::unexpected(make_error_code(core_errc::io_failure));
+        auto root = cow_node::make_object();
+        root->entries().reserve(members.size());
+        for (auto const& member : members) {
+            bool container = member.value.front() == '{' || member.value.front() == '[';
+            if (container) {
+                root->insert_or_assign(member.key, cow_node::make_deferred(*source, member.value));
+                continue;
             }
-            
-            // Pretty print with 2-space indentation
-            temp_file << data.dump(2);
-            temp_file.flush();
-
-            if (!temp_file.good()) {
-                return std::unexpected(make_error_code(core_errc::io_failure));
+            auto scalar = source->parse(member.value);
+            if (!scalar) {
+                return std::unexpected(make_error_code(scalar.error()));
             }
+            root->insert_or_assign(member.key, std::move(*scalar));
         }
+        return root;
+    } catch (const nlohmann::json::exception&) {
+        return std::unexpected(make_error_code(core_errc::parse_error));
+    }
+}
 
-        // Atomic rename to replace the original file
-        std::filesystem::rename(temp_path, path_);
-        
-        return {};
-    } catch (const std::exception&) {
-        return std::unexpected(make_error_code(core_errc::io_failure));
-    } catch (...) {
-        return std::unexpected(make_error_code(core_errc::unknown));
+/**
+ * @brief Serializes a tree as pretty-printed JSON.
+ * @param root The tree to write.
+ * @return The file content.
+ */
+std::expected<std::string, std::error_code> json_store::serialize(cow_node const& root) {
+    // A member that failed to parse is still only in the old file; writing null would lose it
+    bool malformed = false;
+    auto json = node_to_json(root, malformed);
+    if (malformed) {
+        return std::unexpected(make_error_code(core_errc::parse_error));
     }
-}
\ No newline at end of file
+    // Pretty print with 2-space indentation
+    return json.dump(2);
+}
+
+/**
+ * @brief Rejects trees holding NaN or an infinity, which JSON would write as null.
+ *
+ * Dates and times (opaque values) are written as their text.
+ */
+std::expected<void, std::error_code> json_store::exportable(cow_node const& root) const {
+    if (holds_non_finite(root)) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
+    }
+    return {};
+}
+
+/**
+ * @brief Creates a transaction on `snapshot` with the JSON value rules.
+ */
+std::unique_ptr<transaction_base> json_store::make_transaction(node_ref snapshot, uint64_t txn_id) {
+    return std::make_unique<cow_transaction>(std::move(snapshot), this, cow_rules{}, txn_id);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Read-only whole-file memory mappings (POSIX mmap / Win32 file
+ *        mappings) and the read helper the file stores build on.
+ */
+
+#include "mapped_file.h"
+
+#include <fstream>
+#include <utility>
+
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+std::unexpected<std::error_code> mapping_failure() {
+    return std::unexpected(make_error_code(core_errc::io_failure));
+}
+
+}  // namespace
+
+mapped_file::mapped_file(mapped_file&& other) noexcept {
+    *this = std::move(other);
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#if defined(_WIN32)
+        file_ = std::exchange(other.file_, nullptr);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#else
+        fd_ = std::exchange(other.fd_, -1);
+#endif
+    }
+    return *this;
+}
+
+mapped_file::~mapped_file() {
+    close();
+}
+
+#if defined(_WIN32)
+
+std::expected<mapped_file, std::error_code> mapped_file::open_read(std::filesystem::path const& path) {
+    mapped_file m;
+    m.file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m.file_ == INVALID_HANDLE_VALUE) {
+        m.file_ = nullptr;
+        return mapping_failure();
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(m.file_, &size)) return mapping_failure();
+    if (size.QuadPart == 0) return m;
+
+    m.mapping_ = CreateFileMappingW(m.file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m.mapping_) return mapping_failure();
+    m.data_ = static_cast<char*>(MapViewOfFile(m.mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!m.data_) return mapping_failure();
+    m.size_ = static_cast<size_t>(size.QuadPart);
+    return m;
+}
+
+void mapped_file::close() noexcept {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_) CloseHandle(file_);
+    data_ = nullptr;
+    mapping_ = nullptr;
+    file_ = nullptr;
+    size_ = 0;
+}
+
+#else
+
+std::expected<mapped_file, std::error_code> mapped_file::open_read(std::filesystem::path const& path) {
+    mapped_file m;
+    m.fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m.fd_ < 0) return mapping_failure();
+
+    struct stat st{};
+    if (::fstat(m.fd_, &st) != 0) return mapping_failure();
+    if (st.st_size == 0) return m;
+
+    void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m.fd_, 0);
+    if (data == MAP_FAILED) return mapping_failure();
+    m.data_ = static_cast<char*>(data);
+    m.size_ = static_cast<size_t>(st.st_size);
+
+    // Parsers read front to back exactly once
+    ::madvise(data, m.size_, MADV_SEQUENTIAL);
+    return m;
+}
+
+void mapped_file::close() noexcept {
+    if (data_) ::munmap(data_, size_);
+    if (fd_ >= 0) ::close(fd_);
+    data_ = nullptr;
+    fd_ = -1;
+    size_ = 0;
+}
+
+#endif
+
+std::expected<file_contents, std::error_code> ion::core::detail::read_file(std::filesystem::path const& path, bool use_mmap) {
+    file_contents contents;
+    if (use_mmap) {
+        auto mapped = mapped_file::open_read(path);
+        if (!mapped) return std::unexpected(mapped.error());
+        contents.mapped_ = std::move(*mapped);
+        return contents;
+    }
+
+    std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return std::unexpected(make_error_code(core_errc::io_failure));
+    }
+
+    // Size the buffer once and read straight into it
+    auto size = static_cast<std::streamoff>(file.tellg());
+    if (size < 0) {
+        return std::unexpected(make_error_code(core_errc::io_failure));
+    }
+    contents.buffer_.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    if (!file.read(contents.buffer_.data(), size)) {
+        return std::unexpected(make_error_code(core_errc::io_failure));
+    }
+    return contents;
+}
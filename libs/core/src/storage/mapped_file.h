@@ -0,0 +1,69 @@
+#pragma once
+
+#include <ion/core/error.h>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace ion::core::detail {
+
+/**
+ * @brief Owning read-only memory mapping of a whole file.
+ *
+ * Empty files are never mapped, since neither mmap nor MapViewOfFile accept a
+ * zero length; they simply present an empty view.
+ */
+class mapped_file {
+public:
+    mapped_file() noexcept = default;
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+    ~mapped_file();
+
+    static std::expected<mapped_file, std::error_code> open_read(std::filesystem::path const& path);
+
+    size_t size() const noexcept { return size_; }
+    std::string_view view() const noexcept { return {data_, size_}; }
+
+    /**
+     * @brief Unmaps and closes the file. Safe to call more than once.
+     */
+    void close() noexcept;
+
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+/**
+ * @brief Contents of a whole file, either mapped or read into a string.
+ */
+class file_contents {
+public:
+    std::string_view view() const noexcept { return mapped_.size() ? mapped_.view() : std::string_view(buffer_); }
+
+private:
+    friend std::expected<file_contents, std::error_code> read_file(std::filesystem::path const&, bool);
+
+    mapped_file mapped_;
+    std::string buffer_;
+};
+
+/**
+ * @brief Reads `path` with a single copy at most: mapped when `use_mmap` is
+ * set, otherwise into a string sized up front.
+ */
+std::expected<file_contents, std::error_code> read_file(std::filesystem::path const& path, bool use_mmap);
+
+}  // namespace ion::core::detail
@@ -0,0 +1,72 @@
+/**
+ * @file memory_store_impl.cpp
+ * @brief Implementation of the memory_store class, a store without a file.
+ *
+ * The committed data is the same persistent cow_node tree the file stores
+ * use, so transactions, read views and commits behave identically; there is
+ * simply nothing to parse on open() and nothing to write on commit(). The
+ * nodes themselves live in a node_arena rather than on the heap.
+ */
+
+#include "memory_store_impl.h"
+#include "cow_transaction.h"
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+/**
+ * @brief Constructs a closed in-memory store.
+ *
+ * Commits are merged as they queue up; with nothing to write there is no
+ * reason to hold a batch open.
+ */
+memory_store::memory_store(store_instrumentation const& instrumentation)
+    : tree_store(std::chrono::microseconds(0), 64, instrumentation) { }
+
+/**
+ * @brief Destructor for memory_store.
+ */
+memory_store::~memory_store() {
+    close_on_destroy();  // Closing an open in-memory store cannot fail
+}
+
+/**
+ * @brief Starts every open() from an empty root object in a fresh node_arena.
+ * @param path Ignored; accepted for interface compatibility.
+ *
+ * Transactions build new nodes in the arena of the root they started from,
+ * so everything written through this store is packed into that arena. The
+ * nodes keep it alive; a closed store's arena goes with its last snapshot.
+ */
+std::expected<node_ref, std::error_code> memory_store::load(std::filesystem::path const& /*path*/) {
+    node_arena* arena = node_arena::create();
+    node_ref root;
+    {
+        node_cache cache(arena);
+        root = cow_node::make_object(0, &cache);
+    }
+    arena->release();
+    return root;
+}
+
+/**
+ * @brief Nothing to write: a merged batch is committed once it is published.
+ */
+std::expected<void, std::error_code> memory_store::persist(cow_node const& /*head*/, cow_node const& /*merged*/,
+                                                           std::string_view /*log*/) {
+    return {};
+}
+
+/**
+ * @brief Nothing to keep: close() discards the data.
+ */
+std::expected<void, std::error_code> memory_store::flush(cow_node const& /*head*/) {
+    return {};
+}
+
+/**
+ * @brief Creates a transaction on `snapshot` with the JSON value rules.
+ */
+std::unique_ptr<transaction_base> memory_store::make_transaction(node_ref snapshot, uint64_t txn_id) {
+    return std::make_unique<cow_transaction>(std::move(snapshot), this, cow_rules{}, txn_id);
+}
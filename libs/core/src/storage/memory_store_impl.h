@@ -0,0 +1,34 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/store.h>
+
+#include "tree_store.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief Store that keeps its committed tree in memory only.
+ *
+ * Shares the file stores' machinery (copy-on-write trees, lock-free read
+ * views, group commit with conflict detection) minus parsing and
+ * persistence. open() starts from an empty root object and close() discards
+ * everything.
+ *
+ * Nodes are packed into a node_arena with long keys interned, which makes the
+ * tree denser than a file store's heap-allocated one.
+ */
+class memory_store final : public tree_store {
+public:
+    explicit memory_store(store_instrumentation const& instrumentation = {});
+    ~memory_store() override;
+
+private:
+    std::expected<node_ref, std::error_code> load(std::filesystem::path const& path) override;
+    std::expected<void, std::error_code> persist(cow_node const& head, cow_node const& merged,
+                                                 std::string_view log) override;
+    std::expected<void, std::error_code> flush(cow_node const& head) override;
+    std::unique_ptr<transaction_base> make_transaction(node_ref snapshot, uint64_t txn_id) override;
+};
+
+}  // namespace ion::core::detail
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <ion/core/store/store_entry.h>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "cow_node.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief Public type of a node.
+ */
+inline store_node_type type_of(cow_node const& node) noexcept {
+    switch (node.kind()) {
+        case node_kind::null:     return store_node_type::null;
+        case node_kind::boolean:  return store_node_type::boolean;
+        case node_kind::integer:  return store_node_type::integer;
+        case node_kind::floating: return store_node_type::floating;
+        case node_kind::string:   return store_node_type::string;
+        case node_kind::array:    return store_node_type::array;
+        case node_kind::object:   return store_node_type::object;
+        case node_kind::opaque:   return store_node_type::other;
+    }
+    return store_node_type::other;
+}
+
+/**
+ * @brief Describes `node`, child `index` (named `key` in an object) of its parent.
+ */
+inline void fill_entry(store_entry& out, std::string_view key, size_t index, cow_node const& node) {
+    out.key = key;
+    out.index = index;
+    out.type = type_of(node);
+    out.size = node.size();
+    switch (node.kind()) {
+        case node_kind::boolean:  out.value = node.as_bool(); break;
+        case node_kind::integer:  out.value = node.as_int(); break;
+        case node_kind::floating: out.value = node.as_double(); break;
+        case node_kind::string:   out.value = std::string_view(node.as_string()); break;
+        default:                  out.value = std::monostate{}; break;
+    }
+}
+
+/**
+ * @brief read_transaction_base::read_entries() over an object or array node.
+ */
+inline size_t read_node_entries(cow_node const& parent, size_t first, std::span<store_entry> out) {
+    size_t total = parent.size();
+    if (first >= total) return 0;
+    size_t count = std::min(out.size(), total - first);
+    if (parent.is_array()) {
+        auto const& elements = parent.elements();
+        for (size_t i = 0; i < count; ++i) fill_entry(out[i], {}, first + i, *elements[first + i]);
+    } else {
+        auto const& entries = parent.entries();
+        for (size_t i = 0; i < count; ++i) fill_entry(out[i], entries[first + i].key, first + i, *entries[first + i].value);
+    }
+    return count;
+}
+
+/**
+ * @brief True if one of the `count` children of `parent` from position `first` is_malformed().
+ */
+inline bool has_malformed_child(cow_node const& parent, size_t first, size_t count) noexcept {
+    for (size_t i = first; i < first + count; ++i) {
+        auto const& child = parent.is_array() ? *parent.elements()[i] : *parent.entries()[i].value;
+        if (child.is_malformed()) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief read_transaction_base::scan_entries() over an object node.
+ * @param first_out Receives the position of the first entry read, if not null.
+ */
+inline size_t scan_node_entries(cow_node const& parent, std::string_view from, bool after, std::span<store_entry> out,
+                                size_t* first_out = nullptr) {
+    auto const& entries = parent.entries();
+    auto it = after ? std::upper_bound(entries.begin(), entries.end(), from,
+                                       [](std::string_view k, cow_entry const& e) { return k < std::string_view(e.key); })
+                    : std::lower_bound(entries.begin(), entries.end(), from,
+                                       [](cow_entry const& e, std::string_view k) { return std::string_view(e.key) < k; });
+    size_t first = static_cast<size_t>(it - entries.begin());
+    if (first_out) *first_out = first;
+    return read_node_entries(parent, first, out);
+}
+
+}  // namespace ion::core::detail
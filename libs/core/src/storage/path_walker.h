@@ -0,0 +1,248 @@
+#pragma once
+
+#include <ion/core/types.h>
+#include <ion/core/store.h>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace ion::core::detail {
+
+/**
+ * @brief Resolves a batch of dot/bracket paths under one base handle,
+ *        reusing the handles of segments shared with the previous path.
+ *
+ * Backs the get_many()/set_many() overrides. `Txn` is the concrete (final)
+ * transaction type, so its child()/element()/get_*() calls dispatch
+ * statically. Parsing and error codes follow read_transaction_base::navigate().
+ *
+ * Cached handles stay valid as long as the transaction does not invalidate
+ * its handle table, which neither reads nor in-place sets nor creating a new
+ * key does.
+ */
+template <typename Txn>
+class path_walker {
+public:
+    path_walker(Txn& txn, store_handle base) : txn_(txn), base_(base) {}
+
+    /**
+     * @brief Resolves the first `count` segments of the last parsed path.
+     */
+    std::expected<store_handle, std::error_code> resolve(std::string_view path, size_t count) {
+        if (!base_.valid()) return std::unexpected(make_error_code(core_errc::invalid_handle));
+
+        // Keep cached segments that end at the same place and cover identical text
+        size_t common = 0;
+        while (common < path.size() && common < previous_.size() && path[common] == previous_[common]) ++common;
+        size_t keep = 0;
+        while (keep < cached_.size() && keep < count && cached_[keep].end == segments_[keep].end &&
+               segments_[keep].end <= common) {
+            ++keep;
+        }
+        cached_.resize(keep);
+        previous_ = path;
+
+        store_handle cur = keep ? cached_.back().handle : base_;
+        for (size_t i = keep; i < count; ++i) {
+            auto const& seg = segments_[i];
+            auto next = seg.is_element ? txn_.element(cur, seg.index) : txn_.child(cur, seg.key);
+            if (!next) return next;
+            cur = *next;
+            if (!cur.valid()) return std::unexpected(make_error_code(core_errc::key_not_found));
+            cached_.push_back({seg.end, cur});
+        }
+        return cur;
+    }
+
+    /**
+     * @brief Splits `path` into segments; see segments().
+     * @return Success or PathSyntax / IndexOutOfRange as navigate() reports them.
+     */
+    std::expected<void, std::error_code> parse(std::string_view path) {
+        segments_.clear();
+        size_t i = 0, n = path.size();
+        while (i < n) {
+            if (path[i] == '.') { ++i; continue; }
+            segment seg;
+            if (path[i] == '[') {
+                ++i; size_t start = i;
+                while (i < n && path[i] >= '0' && path[i] <= '9') ++i;
+                if (i >= n || path[i] != ']') return std::unexpected(make_error_code(core_errc::path_syntax));
+                auto [ptr, ec] = std::from_chars(path.data() + start, path.data() + i, seg.index);
+                if (ec == std::errc::invalid_argument)    return std::unexpected(make_error_code(core_errc::path_syntax));
+                if (ec == std::errc::result_out_of_range) return std::unexpected(make_error_code(core_errc::index_out_of_range));
+                seg.is_element = true;
+                ++i;
+            } else {
+                size_t j = i + find_delimiter(path.substr(i));
+                seg.key = path.substr(i, j - i);
+                i = j;
+            }
+            seg.end = i;
+            segments_.push_back(seg);
+        }
+        return {};
+    }
+
+    struct segment {
+        size_t end = 0;            // Offset just past the segment in its path
+        bool is_element = false;
+        std::string_view key;
+        uint64_t index = 0;
+    };
+
+    std::span<segment const> segments() const noexcept { return segments_; }
+
+private:
+    struct cached_handle {
+        size_t end;
+        store_handle handle;
+    };
+
+    Txn& txn_;
+    store_handle base_;
+    std::string_view previous_;
+    std::vector<segment> segments_;
+    std::vector<cached_handle> cached_;
+};
+
+/**
+ * @brief Per-transaction memo of the handles compiled paths resolved to.
+ *
+ * Handles re-resolve by key or index after copy-on-write and fail once their
+ * node is gone, so a remembered handle that still resolves still names the
+ * path's current node. The walk that filled an entry recorded its reads, so
+ * the memo must be cleared whenever the read set is.
+ */
+class resolved_paths {
+public:
+    std::optional<store_handle> find(store_handle base, store_path const& path) const {
+        auto it = entries_.find(key_of(base, path));
+        if (it == entries_.end() || it->second.base != base || it->second.text != path.text()) return std::nullopt;
+        return it->second.handle;
+    }
+
+    void insert(store_handle base, store_path const& path, store_handle h) {
+        auto& e = entries_[key_of(base, path)];
+        e.base = base;
+        e.handle = h;
+        e.text.assign(path.text());
+    }
+
+    void clear() noexcept { entries_.clear(); }
+
+private:
+    struct entry {
+        store_handle base;
+        store_handle handle;
+        std::string text;          // Tells apart paths whose keys collide
+    };
+
+    static uint64_t key_of(store_handle base, store_path const& path) noexcept {
+        return path.hash() ^ (base.raw * 0x9e3779b97f4a7c15ull);
+    }
+
+    std::unordered_map<uint64_t, entry> entries_;
+};
+
+/**
+ * @brief read_transaction_base::navigate(store_path) for a concrete transaction type.
+ */
+template <typename Txn>
+std::expected<store_handle, std::error_code> walk_path(Txn const& txn, store_handle base, store_path const& path) {
+    if (!base.valid()) return std::unexpected(make_error_code(core_errc::invalid_handle));
+    store_handle cur = base;
+    for (auto const& seg : path.segments()) {
+        auto next = seg.is_element ? txn.element(cur, seg.index) : txn.child(cur, seg.key);
+        if (!next) return next;
+        cur = *next;
+        if (!cur.valid()) return std::unexpected(make_error_code(core_errc::key_not_found));
+    }
+    return cur;
+}
+
+/**
+ * @brief get_many() for a concrete transaction type.
+ */
+template <typename Txn>
+std::expected<void, std::error_code> get_many_with(Txn const& txn, store_handle base, std::span<store_query const> queries,
+                                                   std::span<std::expected<store_value, std::error_code>> results) {
+    if (results.size() < queries.size()) return std::unexpected(make_error_code(core_errc::invalid_argument));
+
+    path_walker<Txn const> walker(txn, base);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto parsed = walker.parse(queries[i].path);
+        if (!parsed) {
+            results[i] = std::unexpected(parsed.error());
+            continue;
+        }
+        auto h = walker.resolve(queries[i].path, walker.segments().size());
+        if (h) results[i] = txn.get_value(*h, queries[i].type);
+        else   results[i] = std::unexpected(h.error());
+    }
+    return {};
+}
+
+/**
+ * @brief get_string_views() for a concrete transaction type.
+ */
+template <typename Txn>
+std::expected<void, std::error_code> get_string_views_with(Txn const& txn, store_handle base, std::span<std::string_view const> paths,
+                                                           std::span<std::expected<std::string_view, std::error_code>> results) {
+    if (results.size() < paths.size()) return std::unexpected(make_error_code(core_errc::invalid_argument));
+
+    path_walker<Txn const> walker(txn, base);
+    for (size_t i = 0; i < paths.size(); ++i) {
+        auto parsed = walker.parse(paths[i]);
+        if (!parsed) {
+            results[i] = std::unexpected(parsed.error());
+            continue;
+        }
+        auto h = walker.resolve(paths[i], walker.segments().size());
+        if (h) results[i] = txn.get_string_view(*h);
+        else   results[i] = std::unexpected(h.error());
+    }
+    return {};
+}
+
+/**
+ * @brief set_many() for a concrete transaction type.
+ */
+template <typename Txn>
+std::expected<void, std::error_code> set_many_with(Txn& txn, store_handle base, std::span<store_assignment const> assignments) {
+    path_walker<Txn> walker(txn, base);
+    for (auto const& a : assignments) {
+        auto parsed = walker.parse(a.path);
+        if (!parsed) return parsed;
+        auto segments = walker.segments();
+        if (segments.empty()) return std::unexpected(make_error_code(core_errc::path_syntax));
+
+        auto parent = walker.resolve(a.path, segments.size() - 1);
+        if (!parent) return std::unexpected(parent.error());
+
+        auto const& leaf = segments.back();
+        std::expected<void, std::error_code> set;
+        if (leaf.is_element) {
+            auto target = txn.element(*parent, leaf.index);
+            if (!target) return std::unexpected(target.error());
+            set = txn.set_value(*target, a.value);
+        } else {
+            auto exists = txn.has(*parent, leaf.key);
+            if (!exists) return std::unexpected(exists.error());
+            set = *exists ? txn.set_value(*txn.child(*parent, leaf.key), a.value)
+                          : txn.make_value(*parent, leaf.key, a.value);
+        }
+        if (!set) return set;
+    }
+    return {};
+}
+
+}  // namespace ion::core::detail
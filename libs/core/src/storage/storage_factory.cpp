@@ -2,12 +2,25 @@
 #include <ion/core/store.h>
 
 #include "toml_store_impl.h"
-#include "toml_transaction_impl.h"
 #include "json_store_impl.h"
-#include "json_transaction_impl.h"
+#include "binary_store_impl.h"
+#include "memory_store_impl.h"
 
 namespace ion::core {
 
+namespace {
+
+std::unique_ptr<detail::file_store> make_file_store_for(std::filesystem::path const& path, store_format format) {
+    switch (format) {
+        case store_format::json:   return std::make_unique<detail::json_store>(path, json_store_options{});
+        case store_format::toml:   return std::make_unique<detail::toml_store>(path, toml_store_options{});
+        case store_format::binary: return std::make_unique<detail::binary_store>(path, binary_store_options{});
+    }
+    return nullptr;
+}
+
+}  // namespace
+
 std::expected<std::unique_ptr<store_base>, std::error_code>
 make_toml_file_store(std::filesystem::path const& path, toml_store_options opts) {
     auto store = std::make_unique<detail::toml_store>(path, opts);
@@ -20,5 +33,37 @@ make_json_file_store(std::filesystem::path const& path, json_store_options opts)
     return store;
 }
 
+std::expected<std::unique_ptr<store_base>, std::error_code>
+make_binary_file_store(std::filesystem::path const& path, binary_store_options opts) {
+    auto store = std::make_unique<detail::binary_store>(path, opts);
+    return store;
+}
+
+std::expected<std::unique_ptr<store_base>, std::error_code>
+make_in_memory_store(store_instrumentation instrumentation) {
+    auto store = std::make_unique<detail::memory_store>(instrumentation);
+    return store;
+}
+
+std::expected<void, std::error_code>
+convert_store_file(std::filesystem::path const& from, store_format from_format,
+                   std::filesystem::path const& to, store_format to_format) {
+    auto source = make_file_store_for(from, from_format);
+    auto target = make_file_store_for(to, to_format);
+    if (!source || !target) {
+        return std::unexpected(make_error_code(core_errc::invalid_argument));
+    }
+    if (!std::filesystem::exists(from)) {
+        return std::unexpected(make_error_code(core_errc::io_failure));
+    }
+
+    // Never opened, so neither `from` nor its journal is repaired or compacted
+    auto root = source->import_file(from);
+    if (!root) {
+        return std::unexpected(root.error());
+    }
+
+    return target->export_file(to, **root);
+}
 
 }  // namespace ion::core
@@ -0,0 +1,39 @@
+/**
+ * @file store_async.cpp
+ * @brief Coroutine wrappers that move the blocking store calls onto an executor.
+ */
+
+#include <ion/core/store.h>
+
+namespace ion::core
+{
+
+task<std::expected<void, std::error_code>>
+store_base::open_async(std::filesystem::path path, executor_base& io)
+{
+    co_await schedule_on(io);
+    co_return open(path);
+}
+
+task<std::expected<void, std::error_code>>
+store_base::close_async(executor_base& io)
+{
+    co_await schedule_on(io);
+    co_return close();
+}
+
+task<std::expected<std::unique_ptr<transaction_base>, std::error_code>>
+store_base::begin_transaction_async(executor_base& io)
+{
+    co_await schedule_on(io);
+    co_return begin_transaction();
+}
+
+task<std::expected<void, std::error_code>>
+transaction_base::commit_async(executor_base& io)
+{
+    co_await schedule_on(io);
+    co_return commit();
+}
+
+} // namespace ion::core
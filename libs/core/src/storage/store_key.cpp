@@ -0,0 +1,138 @@
+/**
+ * @file store_key.cpp
+ * @brief Vectorized key validation and path splitting.
+ *
+ * Keys and path segments are short, so one 16-byte step usually covers the
+ * whole input: wider AVX2 registers would only add a dispatch for bytes that
+ * are rarely there. SSE2 and NEON are baseline on x86-64 and AArch64 and need
+ * no runtime check.
+ */
+
+#include <ion/core/store/store_key.h>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ION_STORE_KEY_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define ION_STORE_KEY_NEON 1
+#include <arm_neon.h>
+#endif
+
+using namespace ion::core::detail;
+
+namespace {
+
+#if defined(ION_STORE_KEY_SSE2)
+
+using block = __m128i;
+
+inline block load(char const* p) noexcept { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)); }
+
+// Signed compares only: shift each range so it starts at -128, then test `< -128 + width`
+inline block in_range(block bytes, char first, char width) noexcept {
+    auto shifted = _mm_add_epi8(bytes, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + width)));
+}
+
+inline block key_bytes(block bytes) noexcept {
+    auto letter = in_range(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), 'a', 26);
+    auto digit = in_range(bytes, '0', 10);
+    auto underscore = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('_'));
+    return _mm_or_si128(_mm_or_si128(letter, digit), underscore);
+}
+
+inline block delimiter_bytes(block bytes) noexcept {
+    return _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('.')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('[')));
+}
+
+// Index of the first matching byte, 16 if none
+inline size_t first_match(block matches) noexcept {
+    return static_cast<size_t>(std::countr_zero(static_cast<uint32_t>(_mm_movemask_epi8(matches)) | 0x10000u));
+}
+
+inline size_t first_mismatch(block matches) noexcept {
+    return first_match(_mm_cmpeq_epi8(matches, _mm_setzero_si128()));
+}
+
+#elif defined(ION_STORE_KEY_NEON)
+
+using block = uint8x16_t;
+
+inline block load(char const* p) noexcept { return vld1q_u8(reinterpret_cast<uint8_t const*>(p)); }
+
+inline block key_bytes(block bytes) noexcept {
+    auto letter = vcltq_u8(vsubq_u8(vorrq_u8(bytes, vdupq_n_u8(0x20)), vdupq_n_u8('a')), vdupq_n_u8(26));
+    auto digit = vcltq_u8(vsubq_u8(bytes, vdupq_n_u8('0')), vdupq_n_u8(10));
+    return vorrq_u8(vorrq_u8(letter, digit), vceqq_u8(bytes, vdupq_n_u8('_')));
+}
+
+inline block delimiter_bytes(block bytes) noexcept {
+    return vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('.')), vceqq_u8(bytes, vdupq_n_u8('[')));
+}
+
+// NEON has no movemask; narrowing each 16-bit lane by 4 keeps one nibble per byte
+inline size_t first_match(block matches) noexcept {
+    uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+    return nibbles ? static_cast<size_t>(std::countr_zero(nibbles)) / 4 : 16;
+}
+
+inline size_t first_mismatch(block matches) noexcept {
+    return first_match(vmvnq_u8(matches));
+}
+
+#endif
+
+#if defined(ION_STORE_KEY_SSE2) || defined(ION_STORE_KEY_NEON)
+
+/**
+ * @brief Offset of the first byte `find` picks out of the `classify` results, or `size`.
+ *
+ * No load reads past `size`: a partial last block is re-read ending at `size`,
+ * and an input shorter than a block is copied into a zero-filled one (a zero
+ * byte is neither a key character nor a delimiter).
+ */
+template <typename Classify, typename Find>
+size_t scan_blocks(char const* data, size_t size, Classify classify, Find find) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        size_t at = find(classify(load(data + i)));
+        if (at < 16) return i + at;
+    }
+    if (i == size) return size;
+    if (size >= 16) {
+        // The last block overlaps bytes already seen, and none of those matched
+        size_t at = find(classify(load(data + size - 16)));
+        return at < 16 ? size - 16 + at : size;
+    }
+    alignas(16) char tail[16] = {};
+    std::memcpy(tail, data + i, size - i);
+    size_t at = find(classify(load(tail)));
+    return at < size - i ? i + at : size;
+}
+
+#endif
+
+}  // namespace
+
+size_t ion::core::detail::key_prefix_length(char const* data, size_t size) noexcept {
+#if defined(ION_STORE_KEY_SSE2) || defined(ION_STORE_KEY_NEON)
+    return scan_blocks(data, size, key_bytes, first_mismatch);
+#else
+    size_t i = 0;
+    while (i < size && is_key_char(data[i])) ++i;
+    return i;
+#endif
+}
+
+size_t ion::core::detail::delimiter_offset(char const* data, size_t size) noexcept {
+#if defined(ION_STORE_KEY_SSE2) || defined(ION_STORE_KEY_NEON)
+    return scan_blocks(data, size, delimiter_bytes, first_match);
+#else
+    size_t i = 0;
+    while (i < size && data[i] != '.' && data[i] != '[') ++i;
+    return i;
+#endif
+}
@@ -0,0 +1,67 @@
+/**
+ * @file store_probe.cpp
+ * @brief Registration of the store's metrics with a metrics registry.
+ */
+
+#include "store_probe.h"
+#include <string_view>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+enum class metric_kind : uint8_t { histogram, counter, gauge };
+
+struct metric_info {
+    std::string_view name;
+    metric_kind kind;
+};
+
+// Indexed by store_metric
+constexpr std::array<metric_info, static_cast<std::size_t>(store_metric::count_)> k_store_metrics{{
+    {"store.open_ns", metric_kind::histogram},
+    {"store.open.read_ns", metric_kind::histogram},
+    {"store.open.parse_ns", metric_kind::histogram},
+    {"store.open.replay_ns", metric_kind::histogram},
+    {"store.begin_transaction_ns", metric_kind::histogram},
+    {"store.commit_ns", metric_kind::histogram},
+    {"store.persist.serialize_ns", metric_kind::histogram},
+    {"store.persist.write_ns", metric_kind::histogram},
+    {"store.persist.journal_ns", metric_kind::histogram},
+    {"store.persist.bytes", metric_kind::counter},
+    {"store.navigate.walks", metric_kind::counter},
+    {"store.navigate.segments", metric_kind::counter},
+    {"store.navigate.cached", metric_kind::counter},
+    {"store.transaction_handles", metric_kind::gauge},
+}};
+
+template <typename Id>
+uint32_t index_of(std::expected<Id, std::error_code> const& id, uint32_t unregistered) noexcept {
+    return id ? id->index : unregistered;
+}
+
+} // namespace
+
+store_probe::store_probe(store_instrumentation const& instrumentation)
+    : metrics_(instrumentation.metrics),
+      clock_(instrumentation.metrics ? instrumentation.clock : nullptr) {
+    ids_.fill(k_unregistered);
+    if (!metrics_) return;
+
+    for (std::size_t i = 0; i < k_store_metrics.size(); ++i) {
+        auto const& metric = k_store_metrics[i];
+        switch (metric.kind) {
+        case metric_kind::histogram:
+            // Timings need a clock; without one they are never recorded
+            if (clock_) ids_[i] = index_of(metrics_->register_histogram(metric.name), k_unregistered);
+            break;
+        case metric_kind::counter:
+            ids_[i] = index_of(metrics_->register_counter(metric.name), k_unregistered);
+            break;
+        case metric_kind::gauge:
+            ids_[i] = index_of(metrics_->register_gauge(metric.name), k_unregistered);
+            break;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <ion/core/types.h>
+#include <ion/core/store.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ion::core::detail {
+
+/**
+ * @brief Every metric a store reports; see store_instrumentation.
+ */
+enum class store_metric : uint8_t {
+    open_ns,
+    open_read_ns,
+    open_parse_ns,
+    open_replay_ns,
+    begin_transaction_ns,
+    commit_ns,
+    persist_serialize_ns,
+    persist_write_ns,
+    persist_journal_ns,
+    persist_bytes,
+    navigate_walks,
+    navigate_segments,
+    navigate_cached,
+    transaction_handles,
+    count_
+};
+
+/**
+ * @brief The store's view of its store_instrumentation.
+ *
+ * Every metric is registered once, when the probe is made, and reported by
+ * handle afterwards. Every call starts with a test of the registry pointer,
+ * so a detached probe costs one predictable branch and never reads the clock.
+ */
+class store_probe {
+public:
+    store_probe() = default;
+    explicit store_probe(store_instrumentation const& instrumentation);
+
+    /**
+     * @brief Times a scope and records it in a histogram when it ends.
+     */
+    class scoped_timer {
+    public:
+        scoped_timer(store_probe const& probe, store_metric metric) noexcept
+            : probe_(probe), metric_(metric), start_(probe.now()) {}
+        ~scoped_timer() { probe_.elapsed(metric_, start_); }
+
+        scoped_timer(scoped_timer const&) = delete;
+        scoped_timer& operator=(scoped_timer const&) = delete;
+
+    private:
+        store_probe const& probe_;
+        store_metric metric_;
+        uint64_t start_;
+    };
+
+    [[nodiscard]] scoped_timer time(store_metric metric) const noexcept { return {*this, metric}; }
+
+    /**
+     * @brief A clock reading for elapsed(), or 0 without a clock.
+     */
+    uint64_t now() const noexcept { return clock_ ? clock_->now_ns() : 0; }
+
+    void elapsed(store_metric metric, uint64_t start) const noexcept {
+        if (clock_ && registered(metric)) metrics_->record(histogram_id{id(metric)}, clock_->now_ns() - start);
+    }
+
+    void count(store_metric metric, uint64_t value = 1) const noexcept {
+        if (metrics_ && registered(metric)) metrics_->add(counter_id{id(metric)}, value);
+    }
+
+    void gauge(store_metric metric, double value) const noexcept {
+        if (metrics_ && registered(metric)) metrics_->set(gauge_id{id(metric)}, value);
+    }
+
+private:
+    static constexpr uint32_t k_unregistered = UINT32_MAX;
+
+    bool registered(store_metric metric) const noexcept { return id(metric) != k_unregistered; }
+    uint32_t id(store_metric metric) const noexcept { return ids_[static_cast<std::size_t>(metric)]; }
+
+    metrics_registry_base* metrics_ = nullptr;
+    clock_base const* clock_ = nullptr;
+    std::array<uint32_t, static_cast<std::size_t>(store_metric::count_)> ids_{};   // Handle index per store_metric
+};
+
+}  // namespace ion::core::detail
@@ -0,0 +1,203 @@
+/**
+ * @file subscription_registry.cpp
+ * @brief Matching committed mutation logs against change subscriptions.
+ */
+
+#include "subscription_registry.h"
+#include "journal.h"
+
+#include <algorithm>
+#include <charconv>
+#include <unordered_map>
+#include <utility>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+struct subscription_registry::subscriber {
+    uint64_t id = 0;
+    std::string text;                            // Owns the path the segments point into
+    std::vector<store_path::segment> path;
+    executor_base* executor = nullptr;
+    store_change_callback callback;
+    std::atomic<bool> active{true};              // Cleared by remove(); queued deliveries check it
+    std::atomic<uint32_t> refs{1};               // The registry's reference plus one per queued delivery
+};
+
+struct subscription_registry::trie_node {
+    std::map<std::string, std::unique_ptr<trie_node>, std::less<>> keys;
+    std::map<uint64_t, std::unique_ptr<trie_node>> elements;
+    std::vector<subscriber*> here;               // Subscriptions whose path ends at this node
+
+    bool empty() const noexcept { return keys.empty() && elements.empty() && here.empty(); }
+};
+
+namespace {
+
+void append_path(std::string& out, std::span<path_segment const> path) {
+    out.clear();
+    for (auto const& seg : path) {
+        if (seg.is_element) {
+            char digits[24];
+            auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), seg.index);
+            out.push_back('[');
+            out.append(digits, end);
+            out.push_back(']');
+        } else {
+            if (!out.empty()) out.push_back('.');
+            out.append(seg.key);
+        }
+    }
+}
+
+}  // namespace
+
+subscription_registry::subscriber_ref&
+subscription_registry::subscriber_ref::operator=(subscriber_ref&& other) noexcept {
+    if (this != &other) {
+        subscriber_ref dropped(sub_);
+        sub_ = std::exchange(other.sub_, nullptr);
+    }
+    return *this;
+}
+
+subscription_registry::subscriber_ref::~subscriber_ref() {
+    if (sub_ && sub_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete sub_;
+}
+
+subscription_registry::subscriber_ref subscription_registry::subscriber_ref::retain(subscriber* sub) noexcept {
+    sub->refs.fetch_add(1, std::memory_order_relaxed);
+    return subscriber_ref(sub);
+}
+
+subscription_registry::subscription_registry() : root_(std::make_unique<trie_node>()) { }
+
+subscription_registry::~subscription_registry() = default;
+
+std::expected<uint64_t, std::error_code> subscription_registry::add(std::string_view path, executor_base& executor,
+                                                                    store_change_callback callback) {
+    subscriber_ref sub(new subscriber);
+    sub->text.assign(path);
+    auto parsed = store_path::parse(sub->text);
+    if (!parsed) return std::unexpected(parsed.error());
+    sub->path.assign(parsed->segments().begin(), parsed->segments().end());
+    sub->executor = &executor;
+    sub->callback = std::move(callback);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    trie_node* node = root_.get();
+    for (auto const& seg : sub->path) {
+        auto& next = seg.is_element ? node->elements[seg.index] : node->keys[std::string(seg.key)];
+        if (!next) next = std::make_unique<trie_node>();
+        node = next.get();
+    }
+    node->here.push_back(sub.get());
+
+    sub->id = next_id_++;
+    auto id = sub->id;
+    by_id_.emplace(id, std::move(sub));
+    count_.fetch_add(1, std::memory_order_release);
+    return id;
+}
+
+void subscription_registry::remove(uint64_t id) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_id_.find(id);
+    if (it == by_id_.end()) return;
+
+    auto sub = std::move(it->second);
+    by_id_.erase(it);
+    sub->active.store(false, std::memory_order_release);
+    unlink(*root_, sub->path, sub.get());
+    count_.fetch_sub(1, std::memory_order_release);
+}
+
+bool subscription_registry::unlink(trie_node& node, std::span<store_path::segment const> path, subscriber const* target) {
+    if (path.empty()) {
+        std::erase(node.here, target);
+        return node.empty();
+    }
+
+    auto const& seg = path.front();
+    if (seg.is_element) {
+        auto it = node.elements.find(seg.index);
+        if (it != node.elements.end() && unlink(*it->second, path.subspan(1), target)) node.elements.erase(it);
+    } else {
+        auto it = node.keys.find(seg.key);
+        if (it != node.keys.end() && unlink(*it->second, path.subspan(1), target)) node.keys.erase(it);
+    }
+    return node.empty();
+}
+
+void subscription_registry::collect_below(trie_node const& node, std::vector<subscriber*>& out) {
+    for (auto const& [key, child] : node.keys) {
+        out.insert(out.end(), child->here.begin(), child->here.end());
+        collect_below(*child, out);
+    }
+    for (auto const& [index, child] : node.elements) {
+        out.insert(out.end(), child->here.begin(), child->here.end());
+        collect_below(*child, out);
+    }
+}
+
+void subscription_registry::collect(std::string_view log, std::vector<delivery>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (by_id_.empty()) return;
+
+    std::unordered_map<subscriber*, size_t> slots;   // Subscriber -> its delivery in `out`
+    std::vector<subscriber*> matched;
+    std::string text;
+    size_t first = out.size();
+
+    // A malformed log only loses the paths after the damage; the commit itself already succeeded
+    (void)for_each_changed_path(log, [&](std::span<path_segment const> path) {
+        // Subscriptions on the way down watch a parent of the change, the
+        // ones below where the path ends watch something it replaced
+        matched.clear();
+        trie_node const* node = root_.get();
+        for (size_t i = 0; node; ++i) {
+            matched.insert(matched.end(), node->here.begin(), node->here.end());
+            if (i == path.size()) {
+                collect_below(*node, matched);
+                break;
+            }
+            auto const& seg = path[i];
+            if (seg.is_element) {
+                auto it = node->elements.find(seg.index);
+                node = it == node->elements.end() ? nullptr : it->second.get();
+            } else {
+                auto it = node->keys.find(seg.key);
+                node = it == node->keys.end() ? nullptr : it->second.get();
+            }
+        }
+        if (matched.empty()) return;
+
+        append_path(text, path);
+        for (auto* sub : matched) {
+            auto [slot, inserted] = slots.try_emplace(sub, out.size());
+            if (inserted) out.push_back({subscriber_ref::retain(sub), 0, {}});
+            out[slot->second].paths.push_back(text);
+        }
+    });
+
+    if (out.size() == first) return;
+    ++sequence_;
+    for (size_t i = first; i < out.size(); ++i) {
+        // A commit can touch one path many times; dedup once here rather than per path
+        auto& paths = out[i].paths;
+        std::sort(paths.begin(), paths.end());
+        paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+        out[i].sequence = sequence_;
+    }
+}
+
+void subscription_registry::dispatch(std::vector<delivery>& deliveries) {
+    for (auto& d : deliveries) {
+        auto* executor = d.target->executor;
+        executor->execute([target = std::move(d.target), sequence = d.sequence, paths = std::move(d.paths)] {
+            if (!target->active.load(std::memory_order_acquire)) return;
+            target->callback(store_change{sequence, paths});
+        });
+    }
+    deliveries.clear();
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <ion/core/store.h>
+#include <ion/core/thread.h>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cow_node.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief Change subscriptions of one store, indexed by path.
+ *
+ * Subscriptions hang off a trie of path segments, so matching a changed path
+ * touches only the subscriptions on its way down (parents of the change) and
+ * in the subtree where it ends (children of the change).
+ *
+ * collect() matches a commit under the registry lock; dispatch() hands the
+ * result to the executors afterwards, so a callback run inline may commit or
+ * subscribe again without deadlocking.
+ */
+class subscription_registry {
+public:
+    struct subscriber;
+
+    /**
+     * @brief Counted reference to a subscriber.
+     *
+     * The registry holds one per subscription and every queued delivery
+     * another, so a subscriber removed while its callback is queued lives
+     * until that task has run. The count sits in the subscriber itself.
+     */
+    class subscriber_ref {
+    public:
+        subscriber_ref() noexcept = default;
+        subscriber_ref(subscriber_ref&& other) noexcept : sub_(other.sub_) { other.sub_ = nullptr; }
+        subscriber_ref& operator=(subscriber_ref&& other) noexcept;
+        subscriber_ref(subscriber_ref const&) = delete;
+        subscriber_ref& operator=(subscriber_ref const&) = delete;
+        ~subscriber_ref();
+
+        /**
+         * @brief Takes an additional reference to a subscriber kept alive by someone else.
+         */
+        static subscriber_ref retain(subscriber* sub) noexcept;
+
+        subscriber* get() const noexcept { return sub_; }
+        subscriber* operator->() const noexcept { return sub_; }
+
+    private:
+        friend class subscription_registry;
+        explicit subscriber_ref(subscriber* adopted) noexcept : sub_(adopted) {}
+
+        subscriber* sub_ = nullptr;
+    };
+
+    /**
+     * @brief One callback to schedule: a subscriber and its part of a commit.
+     */
+    struct delivery {
+        subscriber_ref target;
+        uint64_t sequence = 0;
+        std::vector<std::string> paths;
+    };
+
+    subscription_registry();
+    ~subscription_registry();
+
+    /**
+     * @brief Registers a subscription.
+     * @return Its id, or PathSyntax / IndexOutOfRange for a malformed path.
+     */
+    std::expected<uint64_t, std::error_code> add(std::string_view path, executor_base& executor,
+                                                 store_change_callback callback);
+
+    /**
+     * @brief Removes a subscription; queued deliveries to it are dropped.
+     */
+    void remove(uint64_t id) noexcept;
+
+    /**
+     * @brief True while nobody is subscribed; checked without locking.
+     */
+    bool empty() const noexcept { return count_.load(std::memory_order_acquire) == 0; }
+
+    /**
+     * @brief Matches the paths a committed mutation log changed against the subscriptions.
+     * @param log Combined mutation log of the commit.
+     * @param out Receives one delivery per affected subscriber.
+     */
+    void collect(std::string_view log, std::vector<delivery>& out);
+
+    /**
+     * @brief Schedules collected deliveries on their executors.
+     */
+    void dispatch(std::vector<delivery>& deliveries);
+
+private:
+    struct trie_node;
+
+    static void collect_below(trie_node const& node, std::vector<subscriber*>& out);
+    static bool unlink(trie_node& node, std::span<store_path::segment const> path, subscriber const* target);
+
+    mutable std::mutex mutex_;
+    std::unique_ptr<trie_node> root_;
+    std::map<uint64_t, subscriber_ref> by_id_;
+    std::atomic<size_t> count_{0};
+    uint64_t next_id_ = 1;
+    uint64_t sequence_ = 0;
+};
+
+}  // namespace ion::core::detail
@@ -3,166 +3,236 @@
  * @brief Implementation of the toml_store class for managing TOML-based storage.
  *
  * This file contains the implementation of the toml_store class, which provides
- * methods for opening, closing, and managing transactions on a TOML-based
- * storage backend. The class ensures ACID compliance by using atomic file
- * operations for saving data.
+ * the TOML file format for the file store machinery in file_store.cpp:
+ * parsing a base file into a tree and serializing a tree back out.
+ *
+ * As with the JSON store, committed data lives in a persistent cow_node tree
+ * so transactions can share unchanged subtrees; toml++ is used only to parse
+ * and serialize. Dates and times have no counterpart in the store API and are
+ * carried through as opaque text.
  */
 
 #include "toml_store_impl.h"
-#include "toml_transaction_impl.h"
-#include <fstream>
+#include "cow_transaction.h"
+#include <algorithm>
+#include <optional>
 #include <sstream>
 
 using namespace ion::core;
 using namespace ion::core::detail;
 
-/**
- * @brief Constructs a toml_store instance.
- * @param path Filesystem path to the TOML file.
- * @param options Options for configuring the TOML store.
- */
-toml_store::toml_store(std::filesystem::path const& path, toml_store_options const& options)
-    : path_(path), options_(options), data_() { }
+namespace {
 
-/**
- * @brief Destructor for toml_store.
- *
- * Ensures the store is properly closed if it is still open.
- */
-toml_store::~toml_store() {
-    if (is_open_) {
-        auto result = close();
-        if (!result) {
-            // Not much we can do here if closing fails,
-            // but we should log or handle the error in a real application.
-            // For now, we just ignore it.
+template <typename T>
+node_ref opaque_from_toml(T const& value) {
+    std::ostringstream text;
+    text << value;
+    return cow_node::make_opaque(text.str());
+}
+
+node_ref node_from_toml(toml::node const& n) {
+    switch (n.type()) {
+        case toml::node_type::boolean:
+            return cow_node::make_bool(n.as_boolean()->get());
+        case toml::node_type::integer:
+            return cow_node::make_int(n.as_integer()->get());
+        case toml::node_type::floating_point:
+            return cow_node::make_double(n.as_floating_point()->get());
+        case toml::node_type::string:
+            return cow_node::make_string(n.as_string()->get());
+        case toml::node_type::date:
+            return opaque_from_toml(*n.as_date());
+        case toml::node_type::time:
+            return opaque_from_toml(*n.as_time());
+        case toml::node_type::date_time:
+            return opaque_from_toml(*n.as_date_time());
+        case toml::node_type::array: {
+            auto arr = cow_node::make_array();
+            auto& elements = arr->elements();
+            elements.reserve(n.as_array()->size());
+            for (auto const& item : *n.as_array()) {
+                elements.push_back(node_from_toml(item));
+            }
+            return arr;
+        }
+        case toml::node_type::table: {
+            auto obj = cow_node::make_object();
+            obj->entries().reserve(n.as_table()->size());
+            for (auto&& [key, value] : *n.as_table()) {
+                obj->insert_or_assign(key.str(), node_from_toml(value));
+            }
+            return obj;
         }
+        default:
+            return cow_node::make_null();
     }
 }
 
+bool append_toml(toml::array& out, cow_node const& n);
+bool insert_toml(toml::table& out, std::string_view key, cow_node const& n);
+
 /**
- * @brief Opens the TOML store at the specified path.
- * @param path Filesystem path to the TOML file.
- * @return Success or an error if the store is already open or the file cannot be read.
+ * Re-parses the literal an opaque node was loaded from and hands the date,
+ * time or date-time it holds to `sink`. False if the text is anything else.
  */
-std::expected<void, std::error_code> toml_store::open(std::filesystem::path const& path) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (is_open_) {
-        return std::unexpected(make_error_code(core_errc::already_exists));
+template <typename Sink>
+bool emit_opaque(std::string_view text, Sink&& sink) {
+    toml::table parsed;
+    try {
+        parsed = toml::parse("v = " + std::string(text));
+    } catch (const toml::parse_error&) {
+        return false;
     }
+    if (parsed.size() != 1) {
+        return false;
+    }
+    if (auto const* d = parsed["v"].as_date()) {
+        sink(d->get());
+    } else if (auto const* t = parsed["v"].as_time()) {
+        sink(t->get());
+    } else if (auto const* dt = parsed["v"].as_date_time()) {
+        sink(dt->get());
+    } else {
+        return false;
+    }
+    return true;
+}
 
-    path_ = path;
-
-    // Load an existing file or create an empty table.
-    if (std::filesystem::exists(path_)) {
-        auto result = load_from_file();
-        if (!result) {
-            return result; // Propagate error from load
+/**
+ * Hands the toml++ equivalent of `n` to `sink`, which inserts it into the
+ * parent table or array. Null nodes have no TOML form and are dropped.
+ * @return False if an opaque value below `n` is not a valid date or time.
+ */
+template <typename Sink>
+bool emit_toml(cow_node const& n, Sink&& sink) {
+    switch (n.kind()) {
+        case node_kind::boolean:  sink(n.as_bool()); break;
+        case node_kind::integer:  sink(n.as_int()); break;
+        case node_kind::floating: sink(n.as_double()); break;
+        case node_kind::string:   sink(std::string(n.as_string())); break;
+        case node_kind::opaque:
+            return emit_opaque(n.as_string(), sink);
+        case node_kind::array: {
+            toml::array arr;
+            for (auto const& item : n.elements()) {
+                if (!append_toml(arr, *item)) return false;
+            }
+            sink(std::move(arr));
+            break;
         }
+        case node_kind::object: {
+            toml::table table;
+            for (auto const& entry : n.entries()) {
+                if (!insert_toml(table, entry.key, *entry.value)) return false;
+            }
+            sink(std::move(table));
+            break;
+        }
+        case node_kind::null:
+        default:
+            break;
     }
+    return true;
+}
 
-    is_open_ = true;
-    return {};
+bool append_toml(toml::array& out, cow_node const& n) {
+    return emit_toml(n, [&](auto&& v) { out.push_back(std::forward<decltype(v)>(v)); });
 }
 
-/**
- * @brief Closes the TOML store.
- *
- * Clears the in-memory data and marks the store as closed.
- * @return Success or an error if the store is not open.
- */
-std::expected<void, std::error_code> toml_store::close() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!is_open_) {
-        return std::unexpected(make_error_code(core_errc::invalid_state));
+bool insert_toml(toml::table& out, std::string_view key, cow_node const& n) {
+    return emit_toml(n, [&](auto&& v) { out.insert(key, std::forward<decltype(v)>(v)); });
+}
+
+bool holds_null(cow_node const& n) {
+    switch (n.kind()) {
+        case node_kind::null:
+            return true;
+        case node_kind::array:
+            return std::ranges::any_of(n.elements(), [](auto const& item) { return holds_null(*item); });
+        case node_kind::object:
+            return std::ranges::any_of(n.entries(), [](auto const& entry) { return holds_null(*entry.value); });
+        default:
+            return false;
     }
+}
 
-    is_open_ = false;
-    data_.clear(); // Clear in-memory data
-    return {};
+std::optional<toml::table> table_from_node(cow_node const& root) {
+    toml::table result;
+    for (auto const& entry : root.entries()) {
+        if (!insert_toml(result, entry.key, *entry.value)) return std::nullopt;
+    }
+    return result;
 }
 
+}  // namespace
+
 /**
- * @brief Begins a new transaction on the TOML store.
- *
- * Creates a new toml_transaction instance for managing changes to the store.
- * @return A unique pointer to the transaction or an error if the store is not open.
+ * @brief Constructs a toml_store instance.
+ * @param path Filesystem path to the TOML file.
+ * @param options Options for configuring the TOML store.
  */
-std::expected<std::unique_ptr<transaction_base>, std::error_code> toml_store::begin_transaction() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!is_open_) {
-        return std::unexpected(make_error_code(core_errc::invalid_state));
-    }
+toml_store::toml_store(std::filesystem::path const& path, toml_store_options const& options)
+    : file_store(path, file_options_of(options)) { }
 
-    auto txn = std::make_unique<toml_transaction>(data_, this, options_);
-    return txn;
+/**
+ * @brief Destructor for toml_store.
+ *
+ * Ensures the store is properly closed if it is still open.
+ */
+toml_store::~toml_store() {
+    close_on_destroy();
 }
 
 /**
- * @brief Loads the TOML data from the file into memory.
- *
- * Parses the TOML file and populates the in-memory representation.
- * @return Success or an error if the file cannot be read or parsed.
+ * @brief Parses TOML file content into a tree.
+ * @param content The whole base file.
+ * @return The root or core_errc::parse_error.
  */
-std::expected<void, std::error_code> toml_store::load_from_file() {
+std::expected<node_ref, std::error_code> toml_store::parse(std::string_view content) {
     try {
-        std::ifstream file(path_, std::ios::in | std::ios::binary);
-        if (!file.is_open()) {
-            return std::unexpected(make_error_code(core_errc::io_failure));
-        }
-
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-
-        auto result = toml::parse(buffer.str());
-        data_ = std::move(result);
-
-        return {};
+        auto result = toml::parse(content);
+        return node_from_toml(result);
     } catch (const toml::parse_error&) {
         return std::unexpected(make_error_code(core_errc::parse_error));
-    } catch (const std::exception&) {
-        return std::unexpected(make_error_code(core_errc::unknown));
-    } catch (...) {
-        return std::unexpected(make_error_code(core_errc::unknown));
     }
 }
 
 /**
- * @brief Saves the TOML data to the file.
- *
- * Writes the in-memory TOML data to a temporary file and atomically renames it
- * to replace the original file.
- * @param data The TOML data to save.
- * @return Success or an error if the file cannot be written.
+ * @brief Serializes a tree as a TOML document.
+ * @param root The tree to write; its top level must be an object.
+ * @return The file content, or core_errc::parse_error if a stored date or
+ *         time no longer parses as one.
  */
-std::expected<void, std::error_code> toml_store::save_to_file(toml::table const& data) {
-    try {
-        // Write to a temporary file for atomicity
-        std::filesystem::path temp_path = path_;
-        temp_path += ".tmp";
-
-        {
-            std::ofstream temp_file(temp_path, std::ios::out | std::ios::trunc);
-            if (!temp_file.is_open()) {
-                return std::unexpected(make_error_code(core_errc::io_failure));
-            }
-            
-            temp_file << data;
-            temp_file.flush();
-
-            if (!temp_file.good()) {
-                return std::unexpected(make_error_code(core_errc::io_failure));
-            }
-        }
+std::expected<std::string, std::error_code> toml_store::serialize(cow_node const& root) {
+    auto table = table_from_node(root);
+    if (!table) {
+        return std::unexpected(make_error_code(core_errc::parse_error));
+    }
+    std::ostringstream text;
+    text << *table;
+    return text.str();
+}
 
-        // Atomic rename to replace the original file
-        std::filesystem::rename(temp_path, path_);
-        
-        return {};
-    } catch (const std::exception&) {
-        return std::unexpected(make_error_code(core_errc::io_failure));
-    } catch (...) {
-        return std::unexpected(make_error_code(core_errc::unknown));
+/**
+ * @brief Rejects trees holding a null, which TOML has no way to write.
+ */
+std::expected<void, std::error_code> toml_store::exportable(cow_node const& root) const {
+    if (holds_null(root)) {
+        return std::unexpected(make_error_code(core_errc::type_mismatch));
     }
-}
\ No newline at end of file
+    return {};
+}
+
+/**
+ * @brief Creates a transaction on `snapshot` that keeps every value's TOML type.
+ */
+std::unique_ptr<transaction_base> toml_store::make_transaction(node_ref snapshot, uint64_t txn_id) {
+    static constexpr cow_rules toml_rules{
+        .widen_integers = false,
+        .retype_on_set = false,
+        .replace_on_make = false,
+        .null_handle = core_errc::invalid_argument,
+        .stale_handle = core_errc::key_not_found,
+    };
+    return std::make_unique<cow_transaction>(std::move(snapshot), this, toml_rules, txn_id);
+}
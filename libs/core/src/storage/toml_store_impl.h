@@ -3,37 +3,21 @@
 #include <ion/core/export.h>
 #include <ion/core/store.h>
 #include <toml++/toml.hpp>
-#include <mutex>
-#include <fstream>
 
-namespace ion::core::detail {
+#include "file_store.h"
 
-class toml_transaction;
+namespace ion::core::detail {
 
-class toml_store final : public store_base {
+class toml_store final : public file_store {
 public:
     toml_store(std::filesystem::path const& path, toml_store_options const& options);
-    ~toml_store();
-
-    std::expected<void, std::error_code> open(std::filesystem::path const& path) override;
-    std::expected<void, std::error_code> close() override;
-    std::expected<std::unique_ptr<transaction_base>, std::error_code> begin_transaction() override;
+    ~toml_store() override;
 
 private:
-    friend class toml_transaction;
-
-    std::filesystem::path path_;
-    toml_store_options options_;
-    toml::table data_;
-    bool is_open_ = false;
-    mutable std::mutex mutex_;
-    
-    std::expected<void, std::error_code> load_from_file();
-    std::expected<void, std::error_code> save_to_file(toml::table const& data);
-    void update_data(toml::table const& new_data) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        data_ = new_data;
-    }
+    std::expected<node_ref, std::error_code> parse(std::string_view content) override;
+    std::expected<std::string, std::error_code> serialize(cow_node const& root) override;
+    std::expected<void, std::error_code> exportable(cow_node const& root) const override;
+    std::unique_ptr<transaction_base> make_transaction(node_ref snapshot, uint64_t txn_id) override;
 };
 
 }  // namespace ion::core::detail
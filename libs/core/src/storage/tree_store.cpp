@@ -0,0 +1,169 @@
+/**
+ * @file tree_store.cpp
+ * @brief Lifecycle, transactions and group commit shared by all store backends.
+ */
+
+#include "tree_store.h"
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+tree_store::tree_store(std::chrono::microseconds group_commit_window, size_t group_commit_max_batch,
+                       store_instrumentation const& instrumentation)
+    : probe_(instrumentation),
+      commits_([this](std::span<commit_request* const> batch) { write_batch(batch); },
+               group_commit_window, group_commit_max_batch) { }
+
+void tree_store::close_on_destroy() noexcept {
+    if (is_open_) {
+        auto result = close();
+        if (!result) {
+            // Not much we can do here if closing fails,
+            // but we should log or handle the error in a real application.
+            // For now, we just ignore it.
+        }
+    }
+}
+
+/**
+ * @brief Opens the store at the specified path.
+ * @param path Filesystem path handed to the backend's load().
+ * @return Success or an error if the store is already open or the data cannot be loaded.
+ */
+std::expected<void, std::error_code> tree_store::open(std::filesystem::path const& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_open_) {
+        return std::unexpected(make_error_code(core_errc::already_exists));
+    }
+
+    auto timer = probe_.time(store_metric::open_ns);
+    auto root = load(path);
+    if (!root) {
+        return std::unexpected(root.error());
+    }
+
+    committed_.publish(std::move(*root));
+    is_open_ = true;
+    return {};
+}
+
+/**
+ * @brief Closes the store.
+ *
+ * Gives the backend a chance to persist pending state, then drops the
+ * committed version and marks the store as closed.
+ * @return Success or an error if the store is not open or flushing failed.
+ */
+std::expected<void, std::error_code> tree_store::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!is_open_) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+
+    auto head = committed_.acquire();
+    auto flushed = flush(*head);
+    if (!flushed) {
+        return flushed;
+    }
+
+    is_open_ = false;
+    committed_.publish({}); // Drop our reference; open transactions keep theirs
+    return {};
+}
+
+/**
+ * @brief Begins a new transaction on the store.
+ *
+ * The transaction starts from a reference to the committed tree, so this is
+ * O(1) regardless of store size; nodes are copied only when the transaction
+ * writes to them.
+ * @return A unique pointer to the transaction or an error if the store is not open.
+ */
+std::expected<std::unique_ptr<transaction_base>, std::error_code> tree_store::begin_transaction() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!is_open_) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+
+    auto timer = probe_.time(store_metric::begin_transaction_ns);
+    return make_transaction(committed_.acquire(), next_txn_id());
+}
+
+/**
+ * @brief Begins a read-only view of the most recently committed version.
+ *
+ * Does not lock mutex_: the committed root is pinned through the version
+ * publisher, so any number of threads can open views while a writer commits.
+ * The view is an ordinary transaction with owner 0 that is only ever exposed
+ * through read_transaction_base; it never writes.
+ * @return A unique pointer to the view or an error if the store is not open.
+ */
+std::expected<std::unique_ptr<read_transaction_base>, std::error_code> tree_store::begin_read_transaction() {
+    auto root = committed_.acquire();
+    if (!root) {
+        return std::unexpected(make_error_code(core_errc::invalid_state));
+    }
+
+    return make_transaction(std::move(root), 0);
+}
+
+std::expected<void, std::error_code> tree_store::commit(node_ref const& base, node_ref const& tree, mutation_log const& log,
+                                                        read_set const& reads) {
+    auto timer = probe_.time(store_metric::commit_ns);
+    return commits_.submit(base, tree, log.bytes(), reads);
+}
+
+std::expected<store_subscription, std::error_code> tree_store::subscribe(std::string_view path, executor_base& executor,
+                                                                         store_change_callback callback) {
+    auto id = subscriptions_.add(path, executor, std::move(callback));
+    if (!id) {
+        return std::unexpected(id.error());
+    }
+    return make_subscription(*id);
+}
+
+void tree_store::unsubscribe(uint64_t id) noexcept {
+    subscriptions_.remove(id);
+}
+
+/**
+ * @brief Merges a batch of commits onto the committed version, persists it
+ *        with a single backend write and publishes it.
+ *
+ * Every request in the batch that merged cleanly shares the outcome of that
+ * write. Subscribers of the changed paths are notified once it is published.
+ * @param batch Requests to complete; their results are set in place.
+ */
+void tree_store::write_batch(std::span<commit_request* const> batch) {
+    std::vector<subscription_registry::delivery> deliveries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!is_open_) {
+            for (auto* request : batch) {
+                request->result = std::unexpected(make_error_code(core_errc::invalid_state));
+            }
+            return;
+        }
+
+        auto head = committed_.acquire();
+        auto merged = merge_commits(head, batch, batch_log_, [this] { return next_txn_id(); });
+
+        auto persisted = persist(*head, *merged, batch_log_);
+        if (!persisted) {
+            for (auto* request : batch) {
+                if (request->result) request->result = std::unexpected(persisted.error());
+            }
+            return;
+        }
+
+        if (merged.get() != head.get()) {
+            committed_.publish(std::move(merged));
+            if (!subscriptions_.empty()) {
+                subscriptions_.collect(batch_log_, deliveries);
+            }
+        }
+    }
+
+    // Outside the store lock, so callbacks can open transactions right away
+    subscriptions_.dispatch(deliveries);
+}
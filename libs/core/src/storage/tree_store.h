@@ -0,0 +1,141 @@
+#pragma once
+
+#include <ion/core/types.h>
+#include <ion/core/store.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "commit_queue.h"
+#include "cow_node.h"
+#include "journal.h"
+#include "store_probe.h"
+#include "subscription_registry.h"
+#include "version_publisher.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief Common base of every store backend.
+ *
+ * Owns the committed cow_node tree, the lock-free version publisher behind
+ * read views, transaction ids and the group-commit queue. Backends only say
+ * where the initial tree comes from, how a merged batch is made durable, and
+ * which transaction type edits it.
+ *
+ * The hooks are called with the store mutex held. Because they are virtual,
+ * the most-derived destructor must call close_on_destroy(); by the time this
+ * destructor runs the backend is already gone.
+ */
+class tree_store : public store_base {
+public:
+    std::expected<void, std::error_code> open(std::filesystem::path const& path) final;
+    std::expected<void, std::error_code> close() final;
+    std::expected<std::unique_ptr<transaction_base>, std::error_code> begin_transaction() final;
+    std::expected<std::unique_ptr<read_transaction_base>, std::error_code> begin_read_transaction() final;
+    std::expected<store_subscription, std::error_code> subscribe(std::string_view path, executor_base& executor,
+                                                                 store_change_callback callback) final;
+
+    /**
+     * @brief The committed version, or a null ref while closed.
+     */
+    node_ref head() const noexcept { return committed_.acquire(); }
+
+    /**
+     * @brief Hands out the owner tag for a new (or just committed) transaction.
+     */
+    uint64_t next_txn_id() noexcept { return next_txn_id_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Commits a transaction's tree through the group-commit queue.
+     *
+     * Blocks until the batch holding this commit is durable.
+     * @param base The version the transaction started from.
+     * @param tree The transaction's tree.
+     * @param log The mutations that turn `base` into `tree`.
+     * @param reads What the transaction observed, validated if `base` is stale.
+     * @return Success, core_errc::conflict if a newer commit changed something
+     *         the transaction read, or an error if the batch could not be persisted.
+     */
+    std::expected<void, std::error_code> commit(node_ref const& base, node_ref const& tree, mutation_log const& log,
+                                                read_set const& reads);
+
+    /**
+     * @brief Reports to the store's instrumentation; detached unless configured.
+     */
+    store_probe const& probe() const noexcept { return probe_; }
+
+protected:
+    tree_store(std::chrono::microseconds group_commit_window, size_t group_commit_max_batch,
+               store_instrumentation const& instrumentation);
+    ~tree_store() override = default;
+
+    void unsubscribe(uint64_t id) noexcept final;
+
+    /**
+     * @brief Closes the store if it is still open, ignoring errors.
+     */
+    void close_on_destroy() noexcept;
+
+    /**
+     * @brief Runs `fn(head)` with the store mutex held, if the store is open.
+     *
+     * For backend work scheduled outside a commit, such as background
+     * compaction, which must not interleave with batches being written.
+     */
+    template <typename Fn>
+    void with_open_head(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (is_open_) {
+            fn(*committed_.acquire());
+        }
+    }
+
+    /// @name Backend hooks, called with the store mutex held.
+    /// @{
+
+    /**
+     * @brief Produces the tree an open() of `path` starts from.
+     */
+    virtual std::expected<node_ref, std::error_code> load(std::filesystem::path const& path) = 0;
+
+    /**
+     * @brief Makes a merged batch durable before it is published.
+     *
+     * `merged` is `head` itself when no commit in the batch changed anything.
+     * @param log Combined mutation log that turns `head` into `merged`.
+     */
+    virtual std::expected<void, std::error_code> persist(cow_node const& head, cow_node const& merged,
+                                                         std::string_view log) = 0;
+
+    /**
+     * @brief Last chance to persist `head` before close() drops it.
+     */
+    virtual std::expected<void, std::error_code> flush(cow_node const& head) = 0;
+
+    /**
+     * @brief Creates a transaction on `snapshot`. `txn_id` 0 makes a read-only view.
+     */
+    virtual std::unique_ptr<transaction_base> make_transaction(node_ref snapshot, uint64_t txn_id) = 0;
+    /// @}
+
+private:
+    void write_batch(std::span<commit_request* const> batch);
+
+    store_probe probe_;
+    version_publisher committed_;            // Committed version, shared by open transactions
+    bool is_open_ = false;
+    mutable std::mutex mutex_;
+    std::atomic<uint64_t> next_txn_id_{1};   // 0 marks loaded nodes and read-only views, so ids start at 1
+    std::string batch_log_;                  // Combined log of the batch being written
+    subscription_registry subscriptions_;   // Before commits_, which notifies it
+    commit_queue commits_;
+};
+
+}  // namespace ion::core::detail
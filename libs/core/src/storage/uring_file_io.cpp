@@ -0,0 +1,338 @@
+/**
+ * @file uring_file_io.cpp
+ * @brief io_uring file_io backend (Linux).
+ *
+ * Talks to the kernel through the raw io_uring syscalls, so no liburing is
+ * needed. Every operation is queued as one chain of linked requests and
+ * submitted with a single io_uring_enter(); a failing or short step cancels
+ * the rest of its chain, so a rename never runs after a torn write.
+ */
+
+#if defined(__linux__)
+
+#include "file_io.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+constexpr unsigned k_ring_entries   = 32;
+constexpr size_t   k_max_uring_write = 1u << 30;   // Per request; larger buffers are split
+constexpr uint64_t k_cancel_tag      = ~uint64_t{0};  // user_data of cancel requests
+constexpr int      k_max_drain_errors = 3;
+
+int uring_setup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int uring_register(int fd, unsigned opcode, void* arg, unsigned count) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+std::unexpected<std::error_code> uring_failure() {
+    return std::unexpected(make_error_code(core_errc::io_failure));
+}
+
+/**
+ * @brief One request of a chain and the result that counts as success.
+ */
+struct uring_step {
+    io_uring_sqe sqe{};
+    int32_t expect = 0;
+    bool tolerate_einval = false;   // Directory fsync on filesystems that cannot
+};
+
+uring_step write_step(int fd, std::string_view data, uint64_t offset) {
+    uring_step s;
+    s.sqe.opcode = IORING_OP_WRITE;
+    s.sqe.fd = fd;
+    s.sqe.addr = reinterpret_cast<uint64_t>(data.data());
+    s.sqe.len = static_cast<uint32_t>(data.size());
+    s.sqe.off = offset;
+    s.expect = static_cast<int32_t>(data.size());
+    return s;
+}
+
+uring_step fsync_step(int fd, uint32_t flags) {
+    uring_step s;
+    s.sqe.opcode = IORING_OP_FSYNC;
+    s.sqe.fd = fd;
+    s.sqe.fsync_flags = flags;
+    return s;
+}
+
+uring_step rename_step(char const* from, char const* to) {
+    uring_step s;
+    s.sqe.opcode = IORING_OP_RENAMEAT;
+    s.sqe.fd = AT_FDCWD;
+    s.sqe.addr = reinterpret_cast<uint64_t>(from);
+    s.sqe.len = static_cast<uint32_t>(AT_FDCWD);
+    s.sqe.off = reinterpret_cast<uint64_t>(to);
+    return s;
+}
+
+// Splits `data` into write requests at consecutive offsets (ignored under O_APPEND)
+void add_writes(std::vector<uring_step>& chain, int fd, std::string_view data, uint64_t offset) {
+    while (!data.empty()) {
+        auto chunk = data.substr(0, k_max_uring_write);
+        chain.push_back(write_step(fd, chunk, offset));
+        offset += chunk.size();
+        data.remove_prefix(chunk.size());
+    }
+}
+
+class uring_file_io final : public file_io {
+public:
+    uring_file_io() : fallback_(make_default_file_io()) {}
+
+    ~uring_file_io() override {
+        if (sqes_) ::munmap(sqes_, sqes_size_);
+        if (cq_ring_ && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+        if (sq_ring_) ::munmap(sq_ring_, sq_ring_size_);
+        if (ring_fd_ >= 0) ::close(ring_fd_);
+    }
+
+    bool init() {
+        io_uring_params params{};
+        ring_fd_ = uring_setup(k_ring_entries, &params);
+        if (ring_fd_ < 0) return false;
+
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+        sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+        if (!sq_ring_) return false;
+        cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_size_, IORING_OFF_CQ_RING);
+        if (!cq_ring_) return false;
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (!sqes_) return false;
+
+        auto* sq = static_cast<char*>(sq_ring_);
+        auto* cq = static_cast<char*>(cq_ring_);
+        sq_head_  = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_  = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cq_head_  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_  = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_     = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        capacity_ = std::min(params.sq_entries, params.cq_entries);
+
+        // Every opcode a chain uses must exist (RENAMEAT needs Linux 5.11)
+        alignas(io_uring_probe) unsigned char buffer[sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op)]{};
+        auto* probe = reinterpret_cast<io_uring_probe*>(buffer);
+        if (uring_register(ring_fd_, IORING_REGISTER_PROBE, probe, 256) < 0) return false;
+        for (unsigned op : {IORING_OP_WRITE, IORING_OP_FSYNC, IORING_OP_RENAMEAT, IORING_OP_ASYNC_CANCEL}) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) return false;
+        }
+        return true;
+    }
+
+    std::expected<void, std::error_code> replace(std::filesystem::path const& path, std::string_view content) override {
+        if (broken_ || content.size() / k_max_uring_write + 4 > capacity_) return fallback_->replace(path, content);
+
+        std::filesystem::path temp = path;
+        temp += ".tmp";
+        auto dir = path.parent_path();
+
+        int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (fd < 0) return uring_failure();
+        int dir_fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dir_fd < 0) {
+            ::close(fd);
+            ::unlink(temp.c_str());
+            return uring_failure();
+        }
+
+        // write... -> fsync -> rename -> fsync(dir), one submission
+        chain_.clear();
+        add_writes(chain_, fd, content, 0);
+        chain_.push_back(fsync_step(fd, 0));
+        chain_.push_back(rename_step(temp.c_str(), path.c_str()));
+        chain_.push_back(fsync_step(dir_fd, 0));
+        chain_.back().tolerate_einval = true;
+
+        bool ok = run_chain();
+        ::close(dir_fd);
+        ok = ::close(fd) == 0 && ok;
+        if (!ok) {
+            ::unlink(temp.c_str());   // Gone already if only the directory sync failed
+            return uring_failure();
+        }
+        return {};
+    }
+
+    std::expected<void, std::error_code> append(durable_file& file, std::span<std::string_view const> parts) override {
+        size_t requests = 1;
+        for (auto part : parts) requests += (part.size() + k_max_uring_write - 1) / k_max_uring_write;
+        if (broken_ || requests > capacity_) return fallback_->append(file, parts);
+
+        // write... -> fdatasync, one submission; the links keep the parts in order
+        chain_.clear();
+        for (auto part : parts) add_writes(chain_, file.native_handle(), part, 0);
+        chain_.push_back(fsync_step(file.native_handle(), IORING_FSYNC_DATASYNC));
+        if (!run_chain()) return uring_failure();
+        return {};
+    }
+
+private:
+    void* map(size_t size, uint64_t offset) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, static_cast<off_t>(offset));
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    /**
+     * @brief Submits chain_ as linked requests and reaps every completion.
+     * @return Whether each step produced its expected result.
+     */
+    bool run_chain() {
+        unsigned n = static_cast<unsigned>(chain_.size());
+        unsigned first = *sq_tail_;   // Only this thread moves the tail
+        unsigned tail = first;
+        for (unsigned i = 0; i < n; ++i) {
+            unsigned idx = tail & sq_mask_;
+            sqes_[idx] = chain_[i].sqe;
+            sqes_[idx].user_data = i;
+            if (i + 1 < n) sqes_[idx].flags |= IOSQE_IO_LINK;
+            sq_array_[idx] = idx;
+            ++tail;
+        }
+        std::atomic_ref<unsigned>(*sq_tail_).store(tail, std::memory_order_release);
+
+        // Usually a single enter: submit the whole chain and wait for all of it
+        bool ok = true;
+        unsigned submitted = 0, reaped = 0;
+        while (true) {
+            unsigned head = *cq_head_;
+            unsigned ready = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+            for (; head != ready; ++head, ++reaped) {
+                auto const& cqe = cqes_[head & cq_mask_];
+                if (cqe.user_data < n) {
+                    auto const& step = chain_[cqe.user_data];
+                    ok = ok && (cqe.res == step.expect || (step.tolerate_einval && cqe.res == -EINVAL));
+                }
+            }
+            std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+            if (reaped >= n) break;
+
+            int r = uring_enter(ring_fd_, n - submitted, n - reaped, IORING_ENTER_GETEVENTS);
+            if (r < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+                // The ring is in an unknown state; later operations use blocking calls
+                broken_ = true;
+                cancel_chain(first, reaped);
+                return false;
+            }
+            submitted += static_cast<unsigned>(r);
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Withdraws what the kernel has not taken of the chain starting at
+     *        sq index `first`, cancels what it has and waits for all of it.
+     *
+     * Requests in flight still point into the caller's buffers and paths, so
+     * run_chain() must not return before each one has completed. Should the
+     * ring keep failing, it is closed and the kernel cancels whatever is left
+     * as it tears the ring down.
+     */
+    void cancel_chain(unsigned first, unsigned reaped) {
+        unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+        unsigned taken = head - first;
+        unsigned tail = head;
+        for (unsigned i = 0; i < taken; ++i) {
+            unsigned idx = tail & sq_mask_;
+            sqes_[idx] = io_uring_sqe{};
+            sqes_[idx].opcode = IORING_OP_ASYNC_CANCEL;
+            sqes_[idx].fd = -1;
+            sqes_[idx].addr = i;   // user_data of the request to cancel
+            sqes_[idx].user_data = k_cancel_tag;
+            sq_array_[idx] = idx;
+            ++tail;
+        }
+        std::atomic_ref<unsigned>(*sq_tail_).store(tail, std::memory_order_release);
+
+        // Completed cancels just report ENOENT or EALREADY; only the count matters
+        unsigned to_submit = taken, cancels = 0;
+        for (int errors = 0; reaped < taken || cancels > 0 || to_submit > 0;) {
+            unsigned cq = *cq_head_;
+            unsigned ready = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+            for (; cq != ready; ++cq) {
+                if (cqes_[cq & cq_mask_].user_data == k_cancel_tag) {
+                    --cancels;
+                } else {
+                    ++reaped;
+                }
+            }
+            std::atomic_ref<unsigned>(*cq_head_).store(cq, std::memory_order_release);
+            if (reaped >= taken && cancels == 0 && to_submit == 0) break;
+
+            unsigned wait = (taken - std::min(reaped, taken)) + cancels;
+            int r = uring_enter(ring_fd_, to_submit, wait, IORING_ENTER_GETEVENTS);
+            if (r < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+                if (++errors == k_max_drain_errors) {
+                    ::close(ring_fd_);
+                    ring_fd_ = -1;
+                    return;
+                }
+                continue;
+            }
+            to_submit -= static_cast<unsigned>(r);
+            cancels += static_cast<unsigned>(r);
+        }
+    }
+
+    std::unique_ptr<file_io> fallback_;   // For oversized chains, or once the ring broke
+    std::vector<uring_step> chain_;
+    bool broken_ = false;
+
+    int ring_fd_ = -1;
+    void* sq_ring_ = nullptr;
+    void* cq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    size_t cq_ring_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned capacity_ = 0;
+};
+
+}  // namespace
+
+std::unique_ptr<file_io> ion::core::detail::make_uring_file_io() {
+    auto io = std::make_unique<uring_file_io>();
+    if (!io->init()) return nullptr;
+    return io;
+}
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file version_publisher.cpp
+ * @brief Lock-free publication of committed store versions.
+ */
+
+#include "version_publisher.h"
+#include <thread>
+
+using namespace ion::core::detail;
+
+version_publisher::~version_publisher() {
+    // No readers can be inside acquire() once the owner is being destroyed
+    node_ref::adopt_released(root_.exchange(nullptr, std::memory_order_acquire));
+}
+
+node_ref version_publisher::acquire() const noexcept {
+    uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    for (;;) {
+        readers_[epoch & 1].fetch_add(1, std::memory_order_seq_cst);
+        uint64_t again = epoch_.load(std::memory_order_seq_cst);
+        if (again == epoch) break;
+        // A writer advanced the epoch between our load and registration and may
+        // already be past its wait; register on the new epoch instead.
+        readers_[epoch & 1].fetch_sub(1, std::memory_order_release);
+        epoch = again;
+    }
+
+    node_ref result = node_ref::retain(root_.load(std::memory_order_seq_cst));
+    readers_[epoch & 1].fetch_sub(1, std::memory_order_release);
+    return result;
+}
+
+void version_publisher::publish(node_ref root) noexcept {
+    node_ref old = node_ref::adopt_released(root_.exchange(root.release(), std::memory_order_seq_cst));
+
+    // Readers registered on the old epoch may have loaded `old` and not yet
+    // retained it. Readers that register after the flip see the new root.
+    uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    while (readers_[epoch & 1].load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    // `old` drops the publisher's reference here
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "cow_node.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief Publishes the committed root of a store to lock-free readers.
+ *
+ * Readers call acquire() to pin the current version without touching the
+ * store mutex. The only window that needs protection is between loading the
+ * root pointer and bumping its reference count: a writer must not drop the
+ * last reference to a root a reader has loaded but not yet retained.
+ *
+ * That window is covered by two reader counters selected by the parity of an
+ * epoch. A reader registers on the current epoch's counter, re-checks the
+ * epoch, then loads and retains the root. publish() swaps the root, advances
+ * the epoch and waits for the previous epoch's counter to drain before it
+ * releases the old root. Readers hold the counter for a handful of
+ * instructions, so the writer's wait is short and bounded.
+ *
+ * publish() calls must be serialized by the caller (the store mutex).
+ */
+class version_publisher {
+public:
+    version_publisher() noexcept = default;
+    ~version_publisher();
+
+    version_publisher(version_publisher const&) = delete;
+    version_publisher& operator=(version_publisher const&) = delete;
+
+    /**
+     * @brief Returns a reference to the current root, or an empty ref if none.
+     *
+     * Safe to call concurrently with other acquire() and publish() calls.
+     */
+    node_ref acquire() const noexcept;
+
+    /**
+     * @brief Replaces the current root. Writers only; see class comment.
+     */
+    void publish(node_ref root) noexcept;
+
+private:
+    std::atomic<cow_node*> root_{nullptr};
+    std::atomic<uint64_t> epoch_{0};
+    mutable std::atomic<uint32_t> readers_[2] = {0, 0};
+};
+
+}  // namespace ion::core::detail
@@ -0,0 +1,124 @@
+/**
+ * @file cpu_topology.cpp
+ * @brief NUMA node discovery and thread pinning for the thread pools
+ *        (Linux sysfs + sched affinity, Win32 affinity masks).
+ */
+
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+using namespace ion::core::detail;
+
+namespace {
+
+std::vector<uint32_t> all_cpus() {
+    uint32_t n = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<uint32_t> cpus(n);
+    for (uint32_t i = 0; i < n; ++i) cpus[i] = i;
+    return cpus;
+}
+
+#if defined(__linux__)
+// Parses a sysfs CPU list such as "0-7,16-23"
+std::vector<uint32_t> parse_cpu_list(std::string_view text) {
+    std::vector<uint32_t> cpus;
+    while (!text.empty()) {
+        size_t comma = text.find(',');
+        std::string_view range = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+
+        uint32_t first = 0, last = 0;
+        auto [p, ec] = std::from_chars(range.data(), range.data() + range.size(), first);
+        if (ec != std::errc{}) continue;
+        last = first;
+        if (p != range.data() + range.size() && *p == '-') {
+            auto [q, ec2] = std::from_chars(p + 1, range.data() + range.size(), last);
+            if (ec2 != std::errc{} || last < first) continue;
+        }
+        for (uint32_t c = first; c <= last; ++c) cpus.push_back(c);
+    }
+    return cpus;
+}
+#endif
+
+}  // namespace
+
+std::vector<std::vector<uint32_t>> ion::core::detail::usable_cpus_by_node() {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    std::vector<std::pair<uint32_t, std::vector<uint32_t>>> nodes;
+    std::error_code ec;
+    for (auto const& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+        std::string name = entry.path().filename().string();
+        if (!name.starts_with("node")) continue;
+        uint32_t id = 0;
+        auto [p, err] = std::from_chars(name.data() + 4, name.data() + name.size(), id);
+        if (err != std::errc{} || p != name.data() + name.size()) continue;
+
+        std::ifstream in(entry.path() / "cpulist");
+        std::string list;
+        if (!std::getline(in, list)) continue;
+
+        std::vector<uint32_t> cpus;
+        for (uint32_t c : parse_cpu_list(list)) {
+            if (!have_mask || (c < CPU_SETSIZE && CPU_ISSET(c, &allowed))) cpus.push_back(c);
+        }
+        if (!cpus.empty()) nodes.emplace_back(id, std::move(cpus));
+    }
+
+    if (!nodes.empty()) {
+        std::sort(nodes.begin(), nodes.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+        std::vector<std::vector<uint32_t>> out;
+        for (auto& [id, cpus] : nodes) out.push_back(std::move(cpus));
+        return out;
+    }
+
+    if (have_mask) {
+        std::vector<uint32_t> cpus;
+        for (uint32_t c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+        }
+        if (!cpus.empty()) return {std::move(cpus)};
+    }
+#endif
+    return {all_cpus()};
+}
+
+bool ion::core::detail::pin_thread(std::thread& thread, uint32_t cpu) noexcept {
+#if defined(_WIN32)
+    if (cpu >= 64) return false;
+    return SetThreadAffinityMask(thread.native_handle(), DWORD_PTR{1} << cpu) != 0;
+#elif defined(__linux__)
+    if (cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)thread;
+    (void)cpu;
+    return false;
+#endif
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ion::core::detail {
+
+/**
+ * @brief The CPUs this process may run on, grouped by NUMA node.
+ *
+ * Never empty: where the platform reports no topology, all CPUs form one
+ * node numbered 0 to hardware_concurrency() - 1.
+ */
+std::vector<std::vector<uint32_t>> usable_cpus_by_node();
+
+/**
+ * @brief Restricts `thread` to `cpu`.
+ * @return Whether the platform applied the affinity.
+ */
+bool pin_thread(std::thread& thread, uint32_t cpu) noexcept;
+
+}  // namespace ion::core::detail
@@ -0,0 +1,17 @@
+#include <ion/core/thread.h>
+#include "work_stealing_pool_impl.h"
+
+namespace ion::core
+{
+
+std::expected<std::unique_ptr<thread_pool_base>, std::error_code>
+make_thread_pool(thread_pool_options options)
+{
+    auto pool = std::make_unique<detail::work_stealing_pool>(options);
+    if (auto e = pool->start(); !e.has_value()) {
+        return std::unexpected(e.error());
+    }
+    return pool;
+}
+
+} // namespace ion::core
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace ion::core::detail {
+
+/**
+ * @brief A small number that identifies the calling thread, handed out in
+ *        the order threads first ask for one.
+ *
+ * This is process-wide state: one counter shared by every buffer pool,
+ * async logger and metrics registry, and a thread_local caching each
+ * thread's number. Only integers live there, so nothing in it depends on
+ * the lifetime of the objects that use it, and numbers of exited threads
+ * are not reused. Sharded structures
+ * mask the number to pick a shard, so each thread keeps to one shard and
+ * consecutive threads land on different ones.
+ */
+inline std::size_t thread_slot() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local std::size_t const slot = next.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+} // namespace ion::core::detail
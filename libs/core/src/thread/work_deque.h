@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ion::core::detail {
+
+/**
+ * @brief Chase-Lev work-stealing deque of pointers.
+ *
+ * One owner thread pushes and pops at the bottom; any thread may steal from
+ * the top. The ring grows when full; a ring it outgrew stays alive until the
+ * deque is destroyed because a thief may still be reading from it.
+ *
+ * Follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Lê et al., PPoPP 2013), with the fences folded into the seq_cst
+ * operations on top and bottom.
+ */
+template <typename T>
+class work_deque {
+    static_assert(std::is_pointer_v<T>, "work_deque holds pointers");
+
+public:
+    explicit work_deque(size_t capacity = 256) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        rings_.push_back(std::make_unique<ring>(cap));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    work_deque(work_deque const&) = delete;
+    work_deque& operator=(work_deque const&) = delete;
+
+    /**
+     * @brief Owner only: adds `item` at the bottom.
+     */
+    void push(T item) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        ring* r = ring_.load(std::memory_order_relaxed);
+        if (b - t >= static_cast<int64_t>(r->capacity)) r = grow(r, t, b);
+        r->put(b, item);
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Owner only: removes the most recently pushed item.
+     * @return The item, or nullptr if the deque is empty.
+     */
+    T pop() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        ring* r = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_seq_cst);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T item = r->get(b);
+        if (t == b) {
+            // Last item: race thieves for it
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * @brief Any thread: removes the oldest item.
+     * @return The item, or nullptr if the deque is empty or another thread won it.
+     */
+    T steal() {
+        int64_t t = top_.load(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_seq_cst);
+        if (t >= b) return nullptr;
+        ring* r = ring_.load(std::memory_order_acquire);
+        T item = r->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    /**
+     * @brief Any thread: whether the deque looked non-empty at some point during the call.
+     */
+    bool has_items() const noexcept {
+        int64_t t = top_.load(std::memory_order_seq_cst);
+        return bottom_.load(std::memory_order_seq_cst) > t;
+    }
+
+private:
+    struct ring {
+        explicit ring(size_t cap) : capacity(cap), mask(cap - 1), slots(std::make_unique<std::atomic<T>[]>(cap)) {}
+
+        T get(int64_t i) const noexcept { return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T item) noexcept { slots[static_cast<size_t>(i) & mask].store(item, std::memory_order_relaxed); }
+
+        size_t capacity;
+        size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    ring* grow(ring* old, int64_t t, int64_t b) {
+        auto bigger = std::make_unique<ring>(old->capacity * 2);
+        for (int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        ring* r = bigger.get();
+        rings_.push_back(std::move(bigger));
+        ring_.store(r, std::memory_order_release);
+        return r;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<ring*> ring_{nullptr};
+    std::vector<std::unique_ptr<ring>> rings_;   // Owner only; current ring is last
+};
+
+}  // namespace ion::core::detail
@@ -0,0 +1,302 @@
+/**
+ * @file work_stealing_pool_impl.cpp
+ * @brief Work-stealing thread pool: worker layout, the scheduling loop, and
+ *        spin-then-park idling.
+ */
+
+#include "work_stealing_pool_impl.h"
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <intrin.h>
+#endif
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+namespace {
+
+// The worker running on this thread, if it belongs to a work_stealing_pool
+thread_local work_stealing_pool const* tl_current_pool = nullptr;
+thread_local uint32_t tl_worker_index = 0;
+
+constexpr uint32_t k_local_free_max = 128;   // A worker's free list spills past this
+constexpr uint32_t k_free_batch     = 64;    // Nodes moved per spill or refill
+
+inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+inline uint64_t next_random(uint64_t& state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+}  // namespace
+
+work_stealing_pool::work_stealing_pool(thread_pool_options const& options) : spin_budget_(options.spin_budget) {
+    auto nodes = usable_cpus_by_node();
+    size_t cpu_count = 0;
+    for (auto const& node : nodes) cpu_count += node.size();
+    uint32_t count = options.worker_count ? options.worker_count : static_cast<uint32_t>(cpu_count);
+
+    // Assign each worker a node (and, when pinned, a CPU on it)
+    std::vector<uint32_t> node_of(count, 0);
+    workers_.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto w = std::make_unique<worker>();
+        w->rng = 0x9e3779b97f4a7c15ull * (i + 1);
+        switch (options.placement) {
+            case worker_placement::any:
+                break;
+            case worker_placement::compact: {
+                size_t slot = i % cpu_count;
+                uint32_t n = 0;
+                while (slot >= nodes[n].size()) slot -= nodes[n++].size();
+                node_of[i] = n;
+                w->cpu = nodes[n][slot];
+                break;
+            }
+            case worker_placement::spread: {
+                uint32_t n = i % static_cast<uint32_t>(nodes.size());
+                node_of[i] = n;
+                w->cpu = nodes[n][(i / nodes.size()) % nodes[n].size()];
+                break;
+            }
+        }
+        workers_.push_back(std::move(w));
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t k = 1; k < count; ++k) {
+            uint32_t v = (i + k) % count;
+            (node_of[v] == node_of[i] ? workers_[i]->local_victims : workers_[i]->remote_victims).push_back(v);
+        }
+    }
+}
+
+work_stealing_pool::~work_stealing_pool() {
+    stopping_.store(true, std::memory_order_seq_cst);
+    for (auto& w : workers_) {
+        w->parked.store(0, std::memory_order_seq_cst);
+        w->parked.notify_one();
+    }
+    for (auto& w : workers_) {
+        if (w->thread.joinable()) w->thread.join();
+    }
+    // Tasks are left over only if start() failed part-way
+    auto delete_list = [](task_node* n) {
+        while (n) delete std::exchange(n, n->next);
+    };
+    for (auto& w : workers_) {
+        while (task_node* n = w->deque.pop()) delete n;
+        delete_list(w->free);
+    }
+    for (size_t i = 0; i < injected_size_.load(std::memory_order_relaxed); ++i) {
+        delete injected_[(inject_head_ + i) % injected_.size()];
+    }
+    delete_list(spare_);
+}
+
+std::expected<void, std::error_code> work_stealing_pool::start() {
+    for (uint32_t i = 0; i < workers_.size(); ++i) {
+        auto& w = *workers_[i];
+        try {
+            w.thread = std::thread([this, i] { run(i); });
+        } catch (std::system_error const&) {
+            return std::unexpected(make_error_code(core_errc::invalid_state));
+        }
+        if (w.cpu) {
+            // Best effort: a CPU taken away since discovery leaves the worker unpinned
+            (void)pin_thread(w.thread, *w.cpu);
+        }
+    }
+    return {};
+}
+
+void work_stealing_pool::submit(Task&& task) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    if (tl_current_pool == this) {
+        worker& self = *workers_[tl_worker_index];
+        task_node* n = acquire_node(self);
+        n->task = std::move(task);
+        self.deque.push(n);
+    } else {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        task_node* n = acquire_spare();
+        n->task = std::move(task);
+        push_injected(n);
+    }
+    wake_one();
+}
+
+void work_stealing_pool::wait_idle() {
+    idle_waiters_.fetch_add(1, std::memory_order_seq_cst);
+    for (uint64_t n = pending_.load(std::memory_order_seq_cst); n != 0; n = pending_.load(std::memory_order_seq_cst)) {
+        pending_.wait(n, std::memory_order_seq_cst);
+    }
+    idle_waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void work_stealing_pool::run(uint32_t index) {
+    tl_current_pool = this;
+    tl_worker_index = index;
+    worker& self = *workers_[index];
+
+    uint32_t polls = 0;
+    while (true) {
+        if (task_node* n = find_work(self)) {
+            run_task(self, n);
+            polls = 0;
+            continue;
+        }
+        if (stopping_.load(std::memory_order_seq_cst)) {
+            // Drain before exiting: leave only once nothing is queued anywhere
+            if (!has_visible_work()) break;
+            cpu_relax();
+            continue;
+        }
+        if (polls++ < spin_budget_) {
+            cpu_relax();
+            continue;
+        }
+        polls = 0;
+        park(self);
+    }
+    tl_current_pool = nullptr;
+}
+
+work_stealing_pool::task_node* work_stealing_pool::find_work(worker& self) {
+    if (task_node* n = self.deque.pop()) return n;
+
+    if (size_t queued = injected_size_.load(std::memory_order_relaxed); queued != 0) {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        queued = injected_size_.load(std::memory_order_relaxed);
+        if (queued != 0) {
+            task_node* n = injected_[inject_head_];
+            inject_head_ = (inject_head_ + 1) % injected_.size();
+            injected_size_.store(queued - 1, std::memory_order_relaxed);
+            return n;
+        }
+    }
+
+    if (task_node* n = steal_from(self.local_victims, self)) return n;
+    return steal_from(self.remote_victims, self);
+}
+
+work_stealing_pool::task_node* work_stealing_pool::steal_from(std::vector<uint32_t> const& victims, worker& self) {
+    if (victims.empty()) return nullptr;
+    size_t start = next_random(self.rng) % victims.size();
+    for (size_t k = 0; k < victims.size(); ++k) {
+        if (task_node* n = workers_[victims[(start + k) % victims.size()]]->deque.steal()) return n;
+    }
+    return nullptr;
+}
+
+bool work_stealing_pool::has_visible_work() const noexcept {
+    if (injected_size_.load(std::memory_order_seq_cst) != 0) return true;
+    return std::any_of(workers_.begin(), workers_.end(), [](auto const& w) { return w->deque.has_items(); });
+}
+
+void work_stealing_pool::park(worker& self) {
+    // Announce the nap before the final look for work; a submitter publishes
+    // work before checking parked_, so one of the two always sees the other.
+    self.parked.store(1, std::memory_order_seq_cst);
+    parked_.fetch_add(1, std::memory_order_seq_cst);
+    if (has_visible_work() || stopping_.load(std::memory_order_seq_cst)) {
+        self.parked.store(0, std::memory_order_relaxed);
+    } else {
+        self.parked.wait(1, std::memory_order_seq_cst);
+    }
+    parked_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void work_stealing_pool::wake_one() noexcept {
+    // A read-modify-write rather than a load: it orders against park()'s
+    // increment, so a worker that missed the new task is seen here.
+    if (parked_.fetch_add(0, std::memory_order_seq_cst) == 0) return;
+    for (auto& w : workers_) {
+        uint32_t asleep = 1;
+        if (w->parked.compare_exchange_strong(asleep, 0, std::memory_order_seq_cst)) {
+            w->parked.notify_one();
+            return;
+        }
+    }
+}
+
+void work_stealing_pool::run_task(worker& self, task_node* node) {
+    node->task();
+    node->task.reset();   // Release captures before the task counts as done
+    release_node(self, node);
+    if (pending_.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+        idle_waiters_.load(std::memory_order_seq_cst) != 0) {
+        pending_.notify_all();
+    }
+}
+
+work_stealing_pool::task_node* work_stealing_pool::acquire_node(worker& self) {
+    if (!self.free) {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        for (uint32_t i = 0; i < k_free_batch && spare_; ++i) {
+            task_node* n = std::exchange(spare_, spare_->next);
+            n->next = self.free;
+            self.free = n;
+            ++self.free_count;
+        }
+    }
+    if (task_node* n = self.free) {
+        self.free = n->next;
+        --self.free_count;
+        return n;
+    }
+    return new task_node;
+}
+
+void work_stealing_pool::release_node(worker& self, task_node* node) {
+    node->next = self.free;
+    self.free = node;
+    if (++self.free_count <= k_local_free_max) return;
+
+    // Hand surplus to the spare list, where external submits find it
+    std::lock_guard<std::mutex> lock(inject_mutex_);
+    for (uint32_t i = 0; i < k_free_batch; ++i) {
+        task_node* n = std::exchange(self.free, self.free->next);
+        n->next = spare_;
+        spare_ = n;
+    }
+    self.free_count -= k_free_batch;
+}
+
+work_stealing_pool::task_node* work_stealing_pool::acquire_spare() {
+    if (task_node* n = spare_) {
+        spare_ = n->next;
+        return n;
+    }
+    return new task_node;
+}
+
+void work_stealing_pool::push_injected(task_node* node) {
+    size_t queued = injected_size_.load(std::memory_order_relaxed);
+    if (queued == injected_.size()) {
+        std::vector<task_node*> bigger(std::max<size_t>(64, injected_.size() * 2));
+        for (size_t i = 0; i < queued; ++i) bigger[i] = injected_[(inject_head_ + i) % injected_.size()];
+        injected_.swap(bigger);
+        inject_head_ = 0;
+    }
+    injected_[(inject_head_ + queued) % injected_.size()] = node;
+    injected_size_.store(queued + 1, std::memory_order_seq_cst);
+}
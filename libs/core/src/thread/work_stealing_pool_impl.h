@@ -0,0 +1,91 @@
+#pragma once
+
+#include <ion/core/export.h>
+#include <ion/core/thread.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "work_deque.h"
+
+namespace ion::core::detail {
+
+/**
+ * @brief Thread pool whose workers own Chase-Lev deques and steal from each other.
+ *
+ * Submits from a worker thread land on that worker's deque; submits from
+ * anywhere else go through a mutex-guarded injection queue. Idle workers
+ * spin for a bounded number of polls, then park on their own atomic flag:
+ * a submit wakes one parked worker, and only when some worker is parked.
+ * wait_idle() waits on the pending-task counter itself.
+ *
+ * Queued tasks live in recycled nodes: each worker keeps a private free
+ * list and trades surplus nodes through a shared spare list, so once the
+ * pool has seen its peak queue depth a submit performs no allocation.
+ */
+class work_stealing_pool final : public thread_pool_base {
+public:
+    explicit work_stealing_pool(thread_pool_options const& options);
+    ~work_stealing_pool() override;
+
+    /**
+     * @brief Starts the workers; called once by make_thread_pool().
+     * @return Success or error (InvalidState if a thread could not be started).
+     */
+    [[ION_NODISCARD("Check for start failure")]]
+    std::expected<void, std::error_code> start();
+
+    void submit(Task&& task) override;
+    void wait_idle() override;
+
+private:
+    struct task_node {
+        Task task;
+        task_node* next = nullptr;
+    };
+
+    struct alignas(64) worker {
+        work_deque<task_node*> deque;
+        std::atomic<uint32_t> parked{0};       // 1 while asleep; a waker swaps it to 0
+        std::vector<uint32_t> local_victims;   // Workers on the same NUMA node
+        std::vector<uint32_t> remote_victims;  // Everyone else
+        std::optional<uint32_t> cpu;           // Set when pinned
+        uint64_t rng = 0;                      // Randomizes the first victim
+        task_node* free = nullptr;             // Owner only
+        uint32_t free_count = 0;
+        std::thread thread;
+    };
+
+    void run(uint32_t index);
+    task_node* find_work(worker& self);
+    task_node* steal_from(std::vector<uint32_t> const& victims, worker& self);
+    bool has_visible_work() const noexcept;
+    void park(worker& self);
+    void wake_one() noexcept;
+    void run_task(worker& self, task_node* node);
+
+    task_node* acquire_node(worker& self);
+    void release_node(worker& self, task_node* node);
+    task_node* acquire_spare();                      // inject_mutex_ held
+    void push_injected(task_node* node);             // inject_mutex_ held
+
+    std::vector<std::unique_ptr<worker>> workers_;
+    uint32_t spin_budget_;
+
+    std::mutex inject_mutex_;                        // Guards the injection ring and spare list
+    std::vector<task_node*> injected_;               // Ring of injected_size_ nodes from inject_head_
+    size_t inject_head_ = 0;
+    std::atomic<size_t> injected_size_{0};
+    task_node* spare_ = nullptr;
+
+    alignas(64) std::atomic<uint64_t> pending_{0};   // Submitted, not yet finished
+    std::atomic<uint32_t> idle_waiters_{0};          // Threads inside wait_idle()
+    alignas(64) std::atomic<uint32_t> parked_{0};    // Workers asleep or about to be
+    std::atomic<bool> stopping_{false};
+};
+
+}  // namespace ion::core::detail
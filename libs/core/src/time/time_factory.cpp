@@ -0,0 +1,20 @@
+#include <ion/core/time.h>
+#include "tsc_calibration.h"
+
+#include <new>
+
+namespace ion::core
+{
+
+std::expected<std::unique_ptr<tsc_clock>, std::error_code>
+make_tsc_clock(tsc_clock_options options)
+{
+    try {
+        auto calibration = options.use_counter ? detail::calibrate_tsc(options.calibration_ns) : detail::tsc_calibration{};
+        return std::make_unique<tsc_clock>(calibration);
+    } catch (std::bad_alloc const&) {
+        return std::unexpected(make_error_code(core_errc::unknown));
+    }
+}
+
+} // namespace ion::core
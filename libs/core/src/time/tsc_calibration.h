@@ -0,0 +1,15 @@
+#pragma once
+
+#include <ion/core/time/tsc_clock.h>
+#include <cstdint>
+
+namespace ion::core::detail {
+
+/**
+ * @brief Picks the counter for a tsc_clock and measures its rate.
+ * @param window_ns How long to measure a TSC against steady_clock.
+ * @return The calibration, or the steady_clock fallback if no counter is usable.
+ */
+tsc_calibration calibrate_tsc(uint64_t window_ns);
+
+} // namespace ion::core::detail
@@ -0,0 +1,101 @@
+/**
+ * @file tsc_clock.cpp
+ * @brief Counter detection and calibration for tsc_clock.
+ */
+
+#include "tsc_calibration.h"
+
+#include <chrono>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#  include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#  include <cpuid.h>
+#endif
+
+using namespace ion::core;
+using namespace ion::core::detail;
+
+uint64_t ion::core::detail::steady_clock_ns() noexcept {
+    auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count());
+}
+
+#if (defined(_MSC_VER) && defined(_M_X64)) || defined(__x86_64__) || defined(__i386__)
+
+namespace {
+
+// CPUID 0x80000007 EDX bit 8: the TSC ticks at a constant rate in every P-, C- and T-state
+bool has_invariant_tsc() noexcept {
+#if defined(_MSC_VER)
+    int regs[4] = {};
+    __cpuid(regs, static_cast<int>(0x80000000));
+    if (static_cast<unsigned>(regs[0]) < 0x80000007u) return false;
+    __cpuid(regs, static_cast<int>(0x80000007));
+    return (static_cast<unsigned>(regs[3]) & (1u << 8)) != 0;
+#else
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) return false;
+    return (edx & (1u << 8)) != 0;
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief Measures the TSC against steady_clock for `window_ns`.
+ *
+ * Falls back to steady_clock unless the TSC is invariant; a TSC that
+ * changes rate with the core's frequency cannot be scaled by one factor.
+ */
+tsc_calibration ion::core::detail::calibrate_tsc(uint64_t window_ns) {
+    if (!has_invariant_tsc()) return {};
+
+    tsc_calibration probe;
+    probe.source = clock_source::tsc;
+    tsc_clock reader(probe);
+
+    uint64_t t0 = steady_clock_ns();
+    uint64_t c0 = reader.ticks();
+    uint64_t t1 = t0;
+    while (t1 - t0 < window_ns) t1 = steady_clock_ns();
+    uint64_t c1 = reader.ticks();
+    if (c1 <= c0 || t1 <= t0) return {};
+
+    tsc_calibration result;
+    result.source = clock_source::tsc;
+    result.base_ticks = c1;
+    result.base_ns = t1;
+    result.mult = static_cast<uint64_t>(static_cast<double>(t1 - t0) * 4294967296.0 / static_cast<double>(c1 - c0));
+    return result;
+}
+
+#elif defined(__aarch64__)
+
+/**
+ * @brief Reads the virtual counter's rate from cntfrq_el0; there is nothing to measure.
+ */
+tsc_calibration ion::core::detail::calibrate_tsc(uint64_t /*window_ns*/) {
+    uint64_t frequency = 0;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+    if (frequency == 0) return {};
+
+    tsc_calibration probe;
+    probe.source = clock_source::cntvct;
+    tsc_clock reader(probe);
+
+    tsc_calibration result;
+    result.source = clock_source::cntvct;
+    result.base_ns = steady_clock_ns();
+    result.base_ticks = reader.ticks();
+    result.mult = static_cast<uint64_t>(1'000'000'000.0 * 4294967296.0 / static_cast<double>(frequency));
+    return result;
+}
+
+#else
+
+tsc_calibration ion::core::detail::calibrate_tsc(uint64_t /*window_ns*/) {
+    return {};
+}
+
+#endif
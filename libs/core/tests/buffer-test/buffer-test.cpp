@@ -1,7 +1,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include <ion/core/buffer.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <string_view>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE("Buffer - VectorBuffer", "[vector_buffer]") {
     using namespace std::literals::string_view_literals;
@@ -62,7 +68,23 @@ TEST_CASE("Buffer - VectorBuffer", "[vector_buffer]") {
         REQUIRE(buf->size() > 0);
         REQUIRE(buf->shrink_to_fit().has_value());
         REQUIRE(buf->capacity() >= buf->size());
-    }    
+    }
+
+    SECTION("Resize zeroes, resize_uninitialized keeps contents") {
+        auto buffer = create_buffer();
+        REQUIRE(buffer.has_value());
+        auto & buf = *buffer;
+        REQUIRE(buf->append(std::as_bytes(std::span{"abcd"sv})).has_value());
+        REQUIRE(buf->resize_uninitialized(2).has_value());
+        REQUIRE(buf->resize_uninitialized(4).has_value());
+        REQUIRE(buf->size() == 4);
+        REQUIRE(buf->view()[0] == std::byte{'a'});
+        REQUIRE(buf->resize(2).has_value());
+        REQUIRE(buf->resize(6).has_value());
+        REQUIRE(buf->view()[1] == std::byte{'b'});
+        REQUIRE(buf->view()[2] == std::byte{0});
+        REQUIRE(buf->view()[5] == std::byte{0});
+    }
 }
 
 TEST_CASE("Buffer - StaticBuffer", "[static_buffer]") {
@@ -85,6 +107,18 @@ TEST_CASE("Buffer - StaticBuffer", "[static_buffer]") {
         REQUIRE(buf->size() == 11);
     }
 
+    SECTION("try_append reports overflow as core_errc") {
+        auto buffer = create_static_buffer<8>();
+        REQUIRE(buffer.has_value());
+        auto & buf = *buffer;
+        REQUIRE(buf->try_append(std::as_bytes(std::span{"8 bytes!"sv})).has_value());
+        auto full = buf->try_append(std::as_bytes(std::span{"x"sv}));
+        REQUIRE_FALSE(full.has_value());
+        REQUIRE(full.error() == core_errc::message_too_long);
+        REQUIRE(buf->append(std::as_bytes(std::span{"x"sv})).error() == make_error_code(core_errc::message_too_long));
+        REQUIRE(buf->size() == 8);
+    }
+
     SECTION("Resize static buffer") {
         auto buffer = create_static_buffer<256>();
         REQUIRE(buffer.has_value());
@@ -102,4 +136,388 @@ TEST_CASE("Buffer - StaticBuffer", "[static_buffer]") {
         REQUIRE(buf->clear().has_value());
         REQUIRE(buf->size() == 0);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Buffer - PooledBuffer", "[buffer_pool]") {
+    using namespace std::literals::string_view_literals;
+    using namespace ion::core;
+
+    auto pool = create_buffer_pool({.min_block = 64, .max_block = 4096, .max_cached_per_class = 4, .shard_count = 1});
+    REQUIRE(pool.has_value());
+
+    SECTION("Invalid options") {
+        REQUIRE(create_buffer_pool({.min_block = 48}).error() == core_errc::invalid_argument);
+        REQUIRE(create_buffer_pool({.min_block = 128, .max_block = 64}).error() == core_errc::invalid_argument);
+    }
+
+    SECTION("Capacity rounds up to a class") {
+        auto buffer = (*pool)->acquire(100);
+        REQUIRE(buffer.has_value());
+        auto & buf = *buffer;
+        REQUIRE(buf->size() == 0);
+        REQUIRE(buf->capacity() == 128);
+    }
+
+    SECTION("Append grows and keeps data") {
+        auto buffer = (*pool)->acquire();
+        REQUIRE(buffer.has_value());
+        auto & buf = *buffer;
+        REQUIRE(buf->capacity() == 0);
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(buf->append(std::as_bytes(std::span{"Hello, World!"sv})).has_value());
+        }
+        REQUIRE(buf->size() == 1300);
+        REQUIRE(buf->capacity() == 2048);
+        auto text = std::string_view(reinterpret_cast<const char*>(buf->view().data()), buf->view().size());
+        REQUIRE(text.substr(1287) == "Hello, World!");
+    }
+
+    SECTION("Resize zeroes, resize_uninitialized does not") {
+        auto buffer = (*pool)->acquire(64);
+        REQUIRE(buffer.has_value());
+        auto & buf = *buffer;
+        REQUIRE(buf->resize_uninitialized(64).has_value());
+        std::memset(buf->mutate().data(), 0xab, 64);
+        REQUIRE(buf->resize_uninitialized(8).has_value());
+        REQUIRE(buf->resize_uninitialized(16).has_value());
+        REQUIRE(buf->view()[12] == std::byte{0xab});
+        REQUIRE(buf->resize(8).has_value());
+        REQUIRE(buf->resize(16).has_value());
+        REQUIRE(buf->view()[7] == std::byte{0xab});
+        REQUIRE(buf->view()[12] == std::byte{0});
+    }
+
+    SECTION("Released storage is reused") {
+        std::byte const* first = nullptr;
+        {
+            auto buffer = (*pool)->acquire(256);
+            REQUIRE(buffer.has_value());
+            REQUIRE((*buffer)->resize(256).has_value());
+            first = (*buffer)->view().data();
+        }
+        auto buffer = (*pool)->acquire(200);
+        REQUIRE(buffer.has_value());
+        REQUIRE((*buffer)->resize_uninitialized(200).has_value());
+        REQUIRE((*buffer)->view().data() == first);
+    }
+
+    SECTION("Buffers beyond the largest class") {
+        auto buffer = (*pool)->acquire(10000);
+        REQUIRE(buffer.has_value());
+        auto & buf = *buffer;
+        REQUIRE(buf->capacity() == 10000);
+        REQUIRE(buf->resize(10000).has_value());
+        REQUIRE(buf->view()[9999] == std::byte{0});
+    }
+
+    SECTION("Shrink to fit") {
+        auto buffer = (*pool)->acquire(1024);
+        REQUIRE(buffer.has_value());
+        auto & buf = *buffer;
+        REQUIRE(buf->append(std::as_bytes(std::span{"Data to shrink"sv})).has_value());
+        REQUIRE(buf->shrink_to_fit().has_value());
+        REQUIRE(buf->capacity() == 64);
+        REQUIRE(std::string_view(reinterpret_cast<const char*>(buf->view().data()), buf->view().size()) == "Data to shrink");
+        REQUIRE(buf->clear().has_value());
+        REQUIRE(buf->shrink_to_fit().has_value());
+        REQUIRE(buf->capacity() == 0);
+    }
+}
+
+TEST_CASE("Buffer - ChainedBuffer", "[chained_buffer]") {
+    using namespace std::literals::string_view_literals;
+    using namespace ion::core;
+
+    auto text_of = [](std::span<const std::byte> bytes) {
+        return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    };
+
+    auto buffer = create_chained_buffer(4);
+    REQUIRE(buffer.has_value());
+    auto & buf = *buffer;
+
+    SECTION("Linked payload is not copied") {
+        // Reports its own destruction so the test can see when the buffer lets go
+        struct tracked_payload {
+            std::string text;
+            bool* released;
+            ~tracked_payload() { *released = true; }
+        };
+        bool released = false;
+        auto payload = std::make_unique<tracked_payload>("payload bytes", &released);
+        auto payload_bytes = std::as_bytes(std::span{payload->text.data(), payload->text.size()});
+
+        REQUIRE(buf->append(std::as_bytes(std::span{"HDR:"sv})).has_value());
+        REQUIRE(buf->append_ref(payload_bytes, make_segment_owner(std::move(payload))).has_value());
+        REQUIRE(buf->append(std::as_bytes(std::span{":END"sv})).has_value());
+        REQUIRE(buf->size() == 21);
+
+        auto segments = buf->segments();
+        REQUIRE(segments.size() == 3);
+        REQUIRE(text_of(segments[0]) == "HDR:");
+        REQUIRE(segments[1].data() == payload_bytes.data());
+        REQUIRE(text_of(segments[2]) == ":END");
+
+        // The buffer keeps the payload alive until the segment goes away
+        REQUIRE_FALSE(released);
+        REQUIRE(buf->clear().has_value());
+        REQUIRE(released);
+    }
+
+    SECTION("Consecutive copies share one segment") {
+        REQUIRE(buf->append(std::as_bytes(std::span{"Hello, "sv})).has_value());
+        REQUIRE(buf->append(std::as_bytes(std::span{"World!"sv})).has_value());
+        REQUIRE(buf->segments().size() == 1);
+        REQUIRE(text_of(buf->view()) == "Hello, World!");
+    }
+
+    SECTION("View needs one segment and only flatten makes one") {
+        static constexpr auto k_payload = "payload"sv;
+        REQUIRE(buf->append(std::as_bytes(std::span{"<"sv})).has_value());
+        REQUIRE(buf->append_ref(std::as_bytes(std::span{k_payload})).has_value());
+        REQUIRE(buf->append(std::as_bytes(std::span{">"sv})).has_value());
+        REQUIRE(buf->segments().size() == 3);
+        REQUIRE(buf->view().empty());
+        auto chained = buf->contiguous_view();
+        REQUIRE_FALSE(chained.has_value());
+        REQUIRE(chained.error() == core_errc::invalid_state);
+        REQUIRE(buf->segments().size() == 3);
+
+        auto flat = buf->flatten();
+        REQUIRE(flat.has_value());
+        REQUIRE(text_of(*flat) == "<payload>");
+        REQUIRE(buf->segments().size() == 1);
+        REQUIRE(text_of(buf->view()) == "<payload>");
+        REQUIRE(text_of(*buf->contiguous_view()) == "<payload>");
+
+        // The flattened chunk is full, so the next append starts a segment
+        REQUIRE(buf->append(std::as_bytes(std::span{"!"sv})).has_value());
+        REQUIRE(buf->view().empty());
+        REQUIRE(text_of(*buf->flatten()) == "<payload>!");
+    }
+
+    SECTION("Mutate needs linked memory copied by flatten first") {
+        static constexpr auto k_payload = "abc"sv;
+        REQUIRE(buf->append_ref(std::as_bytes(std::span{k_payload})).has_value());
+        REQUIRE(text_of(buf->view()) == "abc");
+        REQUIRE(buf->mutate().empty());
+        REQUIRE(buf->flatten().has_value());
+        auto bytes = buf->mutate();
+        REQUIRE(bytes.size() == 3);
+        REQUIRE(static_cast<const void*>(bytes.data()) != static_cast<const void*>(k_payload.data()));
+        bytes[0] = std::byte{'x'};
+        REQUIRE(text_of(buf->view()) == "xbc");
+        REQUIRE(k_payload == "abc");
+    }
+
+    SECTION("Resize truncates across segments and zero-fills") {
+        static constexpr auto k_payload = "0123456789"sv;
+        REQUIRE(buf->append(std::as_bytes(std::span{"ab"sv})).has_value());
+        REQUIRE(buf->append_ref(std::as_bytes(std::span{k_payload})).has_value());
+        REQUIRE(buf->append(std::as_bytes(std::span{"cd"sv})).has_value());
+        REQUIRE(buf->resize(7).has_value());
+        REQUIRE(buf->segments().size() == 2);
+        REQUIRE(buf->resize(9).has_value());
+        REQUIRE(buf->size() == 9);
+        REQUIRE(text_of(*buf->flatten()) == "ab01234\0\0"sv);
+        REQUIRE(buf->resize(0).has_value());
+        REQUIRE(buf->segments().empty());
+    }
+
+    SECTION("Reserve and capacity") {
+        REQUIRE(buf->reserve(10000).has_value());
+        REQUIRE(buf->capacity() >= 10000);
+        REQUIRE(buf->resize_uninitialized(10000).has_value());
+        REQUIRE(buf->segments().size() == 1);
+        REQUIRE(buf->size() == 10000);
+    }
+}
+
+TEST_CASE("Buffer - RingBuffer", "[ring_buffer]") {
+    using namespace ion::core;
+
+    auto put_u32 = [](buffer_base& slot, uint32_t v) {
+        return slot.append(std::as_bytes(std::span{&v, 1})).has_value();
+    };
+    auto get_u32 = [](buffer_base const& slot) {
+        uint32_t v = 0;
+        std::memcpy(&v, slot.view().data(), sizeof(v));
+        return v;
+    };
+
+    SECTION("Reserve, commit, consume, release") {
+        auto ring = std::make_unique<ring_buffer<64, 4>>();
+        auto batch = ring->try_reserve(3);
+        REQUIRE(batch.size() == 3);
+        for (uint32_t i = 0; i < 3; ++i) REQUIRE(put_u32(batch[i], i));
+        REQUIRE(batch[0].capacity() == 64);
+
+        // Nothing is visible before commit
+        REQUIRE(ring->try_consume(4).empty());
+        ring->commit(batch);
+
+        // Only one slot is left
+        REQUIRE(ring->try_reserve(4).size() == 1);
+
+        auto taken = ring->try_consume(8);
+        REQUIRE(taken.size() == 3);
+        for (uint32_t i = 0; i < 3; ++i) REQUIRE(get_u32(taken[i]) == i);
+        REQUIRE(ring->try_reserve().empty());
+        ring->release(taken);
+        REQUIRE(ring->try_reserve(8).size() == 3);
+    }
+
+    SECTION("Slots reject oversized messages") {
+        auto ring = std::make_unique<ring_buffer<8, 2>>();
+        auto batch = ring->try_reserve();
+        REQUIRE(batch.size() == 1);
+        std::byte big[9]{};
+        REQUIRE(batch[0].append(big).error() == core_errc::message_too_long);
+        ring->commit(batch);
+    }
+
+    SECTION("Single producer across threads") {
+        constexpr uint32_t k_messages = 100000;
+        auto ring = std::make_unique<ring_buffer<16, 64>>();
+        std::thread producer([&] {
+            uint32_t next = 0;
+            while (next < k_messages) {
+                auto batch = ring->try_reserve(8);
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    uint32_t v = next < k_messages ? next++ : k_messages;
+                    if (!put_u32(batch[i], v)) std::abort();
+                }
+                ring->commit(batch);
+            }
+        });
+        uint32_t expected = 0;
+        bool ordered = true;
+        while (expected < k_messages) {
+            auto taken = ring->try_consume(16);
+            for (size_t i = 0; i < taken.size(); ++i) {
+                uint32_t v = get_u32(taken[i]);
+                if (v == k_messages) continue;
+                ordered = ordered && v == expected;
+                ++expected;
+            }
+            ring->release(taken);
+        }
+        producer.join();
+        REQUIRE(ordered);
+    }
+
+    SECTION("Multiple producers across threads") {
+        constexpr uint32_t k_producers = 4;
+        constexpr uint32_t k_messages = 50000;
+        auto ring = std::make_unique<ring_buffer<16, 128, ring_producers::multiple>>();
+        std::vector<std::thread> producers;
+        for (uint32_t p = 0; p < k_producers; ++p) {
+            producers.emplace_back([&, p] {
+                uint32_t next = 0;
+                while (next < k_messages) {
+                    auto batch = ring->try_reserve(4);
+                    for (size_t i = 0; i < batch.size(); ++i) {
+                        // An empty slot still has to be committed
+                        if (next < k_messages && !put_u32(batch[i], (p << 24) | next++)) std::abort();
+                    }
+                    ring->commit(batch);
+                }
+            });
+        }
+        std::vector<uint32_t> next(k_producers, 0);
+        uint32_t received = 0;
+        bool ordered = true;
+        while (received < k_producers * k_messages) {
+            auto taken = ring->try_consume(32);
+            for (size_t i = 0; i < taken.size(); ++i) {
+                if (taken[i].size() == 0) continue;
+                uint32_t v = get_u32(taken[i]);
+                uint32_t p = v >> 24;
+                ordered = ordered && p < k_producers && (v & 0xffffff) == next[p];
+                if (p < k_producers) ++next[p];
+                ++received;
+            }
+            ring->release(taken);
+        }
+        for (auto& t : producers) t.join();
+        REQUIRE(ordered);
+    }
+}
+
+TEST_CASE("Buffer - byte_writer", "[byte_sink]") {
+    using namespace std::literals::string_view_literals;
+    using namespace ion::core;
+
+    static_assert(byte_sink<buffer_base>);
+    static_assert(byte_sink<dynamic_buffer>);
+    static_assert(byte_sink<static_buffer<64>>);
+
+    auto expected_bytes = [] {
+        std::vector<std::byte> bytes = {std::byte{0x78}, std::byte{0x56}, std::byte{0x34}, std::byte{0x12},
+                                        std::byte{0x02}, std::byte{0x01}};
+        for (char c : "payload"sv) bytes.push_back(static_cast<std::byte>(c));
+        return bytes;
+    }();
+
+    auto fill = [](auto& sink) {
+        auto start = sink.size();
+        byte_writer out(sink);
+        REQUIRE(out.reserve(6).has_value());
+        out.put_le(uint32_t{0x12345678});
+        out.put_le(uint16_t{0x0102});
+        REQUIRE(out.write(std::as_bytes(std::span{"payload"sv})).has_value());
+        REQUIRE(out.position() == start + 13);
+        REQUIRE(out.finish().has_value());
+    };
+
+    SECTION("Dynamic buffer") {
+        dynamic_buffer buf;
+        fill(buf);
+        REQUIRE(std::ranges::equal(buf.view(), expected_bytes));
+    }
+
+    SECTION("Static buffer") {
+        static_buffer<64> buf;
+        fill(buf);
+        REQUIRE(std::ranges::equal(buf.view(), expected_bytes));
+
+        byte_writer out(buf);
+        REQUIRE(out.reserve(64).error() == core_errc::message_too_long);
+        REQUIRE(out.reserve(51).has_value());
+        REQUIRE(out.finish().has_value());
+        REQUIRE(buf.size() == 13);
+    }
+
+    SECTION("Type-erased buffer") {
+        auto buffer = create_buffer();
+        REQUIRE(buffer.has_value());
+        REQUIRE((*buffer)->append(std::as_bytes(std::span{"#"sv})).has_value());
+        fill(**buffer);
+        REQUIRE((*buffer)->size() == 14);
+        REQUIRE(std::ranges::equal((*buffer)->view().subspan(1), expected_bytes));
+    }
+
+    SECTION("Many small writes") {
+        dynamic_buffer buf;
+        byte_writer out(buf);
+        bool written = true;
+        for (uint32_t i = 0; i < 10000; ++i) {
+            written = out.write(std::as_bytes(std::span{&i, 1})).has_value() && written;
+        }
+        REQUIRE(written);
+        REQUIRE(out.finish().has_value());
+        REQUIRE(buf.size() == 40000);
+        uint32_t last = 0;
+        std::memcpy(&last, buf.view().data() + 39996, 4);
+        REQUIRE(last == 9999);
+    }
+
+    SECTION("Free helpers") {
+        static_buffer<8> buf;
+        REQUIRE(write_le<uint32_t>(buf, 0x12345678).has_value());
+        REQUIRE(write_bytes(buf, std::as_bytes(std::span{"ab"sv})).has_value());
+        REQUIRE(buf.size() == 6);
+        REQUIRE(buf.view()[0] == std::byte{0x78});
+        REQUIRE(write_le<uint32_t>(buf, 0).error() == core_errc::message_too_long);
+    }
+}
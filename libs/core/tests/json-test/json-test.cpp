@@ -2,8 +2,14 @@
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <catch2/catch_approx.hpp>
 #include <ion/core/store.h>
+#include <ion/core/thread.h>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <map>
+#include <thread>
+#include <vector>
 
 using namespace ion::core;
 using namespace Catch::Matchers;
@@ -172,6 +178,146 @@ TEST_CASE("JSON Transaction - ACID Properties", "[storage][json][acid]") {
             REQUIRE_FALSE(*has_key3); // This should not exist
         }
     }
+
+    SECTION("Isolation - Open transactions keep their snapshot") {
+        {
+            auto txn_result = store->begin_transaction();
+            REQUIRE(txn_result.has_value());
+            auto& txn = *txn_result;
+            auto root = txn->root();
+            auto settings = txn->make_object(*root, "settings");
+            REQUIRE(settings.has_value());
+            REQUIRE(txn->make_int(*settings, "volume", 5).has_value());
+            REQUIRE(txn->make_string(*settings, "name", "old").has_value());
+            REQUIRE(txn->commit().has_value());
+        }
+
+        auto reader_result = store->begin_transaction();
+        REQUIRE(reader_result.has_value());
+        auto& reader = *reader_result;
+        auto reader_root = reader->root();
+        auto reader_settings = reader->child(*reader_root, "settings");
+        REQUIRE(reader_settings.has_value());
+
+        // A writer that started from the same snapshot changes one leaf
+        {
+            auto txn_result = store->begin_transaction();
+            REQUIRE(txn_result.has_value());
+            auto& txn = *txn_result;
+            auto root = txn->root();
+            auto settings = txn->child(*root, "settings");
+            auto volume = txn->child(*settings, "volume");
+            REQUIRE(txn->set_int(*volume, 9).has_value());
+            REQUIRE(txn->commit().has_value());
+
+            // Still usable after commit; later writes do not leak into the
+            // version that was just published
+            REQUIRE(txn->set_int(*volume, 11).has_value());
+        }
+
+        auto volume = reader->child(*reader_settings, "volume");
+        REQUIRE(volume.has_value());
+        REQUIRE(*reader->get_int(*volume) == 5);
+
+        // Writing in the older transaction does not disturb the committed tree
+        REQUIRE(reader->set_int(*volume, 7).has_value());
+        REQUIRE(*reader->get_int(*volume) == 7);
+
+        auto check_result = store->begin_transaction();
+        REQUIRE(check_result.has_value());
+        auto& check = *check_result;
+        auto check_root = check->root();
+        auto check_settings = check->child(*check_root, "settings");
+        auto check_volume = check->child(*check_settings, "volume");
+        REQUIRE(*check->get_int(*check_volume) == 9);
+        auto check_name = check->child(*check_settings, "name");
+        REQUIRE(*check->get_string(*check_name) == "old");
+    }
+}
+
+TEST_CASE("JSON Store - Read Transactions", "[storage][json][read]") {
+    temp_file temp("test_read.json");
+    json_store_options opts{};
+
+    auto store_result = make_json_file_store(temp.path(), opts);
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+
+    SECTION("Cannot begin read transaction on closed store") {
+        auto view = store->begin_read_transaction();
+        REQUIRE_FALSE(view.has_value());
+        REQUIRE(view.error() == core_errc::invalid_state);
+    }
+
+    REQUIRE(store->open(temp.path()).has_value());
+    {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        auto stats = (*txn)->make_object(*root, "stats");
+        REQUIRE(stats.has_value());
+        REQUIRE((*txn)->make_int(*stats, "counter", 0).has_value());
+        REQUIRE((*txn)->commit().has_value());
+    }
+
+    SECTION("View is pinned to the version it was opened on") {
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        REQUIRE(root.has_value());
+
+        {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto txn_root = (*txn)->root();
+            auto counter = (*txn)->navigate(*txn_root, "stats.counter");
+            REQUIRE((*txn)->set_int(*counter, 1).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+
+        REQUIRE((*view)->get<int64_t>(*root, "stats.counter").value() == 0);
+
+        auto fresh = store->begin_read_transaction();
+        REQUIRE(fresh.has_value());
+        auto fresh_root = (*fresh)->root();
+        REQUIRE((*fresh)->get<int64_t>(*fresh_root, "stats.counter").value() == 1);
+    }
+
+    SECTION("Concurrent readers while a writer commits") {
+        constexpr int k_readers = 4;
+        constexpr int64_t k_commits = 200;
+        std::atomic<bool> done{false};
+        std::atomic<int> failures{0};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < k_readers; ++r) {
+            readers.emplace_back([&] {
+                int64_t last = 0;
+                while (!done.load()) {
+                    auto view = store->begin_read_transaction();
+                    if (!view) { ++failures; return; }
+                    auto root = (*view)->root();
+                    auto value = (*view)->get<int64_t>(*root, "stats.counter");
+                    // Committed values only ever grow
+                    if (!value || *value < last) { ++failures; return; }
+                    last = *value;
+                }
+            });
+        }
+
+        for (int64_t i = 1; i <= k_commits; ++i) {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            auto counter = (*txn)->navigate(*root, "stats.counter");
+            REQUIRE((*txn)->set_int(*counter, i).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+
+        done = true;
+        for (auto& t : readers) t.join();
+        REQUIRE(failures.load() == 0);
+    }
 }
 
 TEST_CASE("JSON Transaction - Data Types", "[storage][json][types]") {
@@ -268,4 +414,1323 @@ TEST_CASE("JSON Transaction - Data Types", "[storage][json][types]") {
         REQUIRE(has_nested.has_value());
         REQUIRE(*has_nested);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("JSON Transaction - Handles", "[storage][json][handles]") {
+    temp_file temp("test_handles.json");
+    json_store_options opts{};
+
+    auto store_result = make_json_file_store(temp.path(), opts);
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open(temp.path()).has_value());
+
+    {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        auto a = (*txn)->make_object(*root, "a");
+        auto b = (*txn)->make_object(*a, "b");
+        REQUIRE((*txn)->make_int(*b, "x", 1).has_value());
+        REQUIRE((*txn)->make_int(*b, "y", 2).has_value());
+        REQUIRE((*txn)->commit().has_value());
+    }
+
+    auto txn_result = store->begin_transaction();
+    REQUIRE(txn_result.has_value());
+    auto& txn = *txn_result;
+    auto root = txn->root();
+
+    SECTION("Handles survive copy-on-write of their ancestors") {
+        auto x = txn->navigate(*root, "a.b.x");
+        auto y = txn->navigate(*root, "a.b.y");
+        REQUIRE(x.has_value());
+        REQUIRE(y.has_value());
+
+        // The first write clones root, a and b; y must follow the clone
+        REQUIRE(txn->set_int(*x, 10).has_value());
+        REQUIRE(txn->set_int(*y, 20).has_value());
+        REQUIRE(*txn->get_int(*x) == 10);
+        REQUIRE(*txn->get_int(*y) == 20);
+        REQUIRE(txn->get<int64_t>(*root, "a.b.y").value() == 20);
+    }
+
+    SECTION("Handles below a removed key become invalid") {
+        auto b = txn->navigate(*root, "a.b");
+        auto x = txn->navigate(*root, "a.b.x");
+        REQUIRE(b.has_value());
+        REQUIRE(x.has_value());
+
+        auto a = txn->child(*root, "a");
+        REQUIRE(txn->remove(*a, "b").has_value());
+
+        auto stale = txn->get_int(*x);
+        REQUIRE_FALSE(stale.has_value());
+        REQUIRE(stale.error() == core_errc::invalid_handle);
+        REQUIRE_FALSE(txn->has(*b, "x").has_value());
+
+        // The retired handle is not resurrected by a new "b"
+        REQUIRE(txn->make_object(*a, "b").has_value());
+        REQUIRE_FALSE(txn->has(*b, "x").has_value());
+    }
+}
+
+TEST_CASE("JSON Transaction - Batch Access", "[storage][json][batch]") {
+    temp_file temp("test_batch.json");
+    json_store_options opts{};
+
+    auto store_result = make_json_file_store(temp.path(), opts);
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open(temp.path()).has_value());
+
+    {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        auto window = (*txn)->make_object(*root, "window");
+        REQUIRE((*txn)->make_int(*window, "width", 1280).has_value());
+        REQUIRE((*txn)->make_int(*window, "height", 720).has_value());
+        REQUIRE((*txn)->make_bool(*window, "fullscreen", false).has_value());
+        REQUIRE((*txn)->make_string(*window, "title", "ion").has_value());
+        REQUIRE((*txn)->make_array(*root, "scales").has_value());
+        REQUIRE((*txn)->commit().has_value());
+    }
+
+    SECTION("get_many reads mixed types and reports errors per query") {
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        std::vector<store_query> queries = {
+            {"window.width", store_value_type::integer},
+            {"window.height", store_value_type::floating},
+            {"window.fullscreen", store_value_type::boolean},
+            {"window.title", store_value_type::string},
+            {"window.missing", store_value_type::integer},
+            {"window.title", store_value_type::integer},
+            {"scales[0]", store_value_type::floating},
+            {"window[", store_value_type::integer},
+        };
+        std::vector<std::expected<store_value, std::error_code>> results(queries.size());
+        REQUIRE((*view)->get_many(*(*view)->root(), queries, results).has_value());
+
+        REQUIRE(std::get<int64_t>(*results[0]) == 1280);
+        REQUIRE(std::get<double>(*results[1]) == Catch::Approx(720.0));
+        REQUIRE_FALSE(std::get<bool>(*results[2]));
+        REQUIRE(std::get<std::string>(*results[3]) == "ion");
+        REQUIRE(results[4].error() == core_errc::key_not_found);
+        REQUIRE(results[5].error() == core_errc::type_mismatch);
+        REQUIRE(results[6].error() == core_errc::index_out_of_range);
+        REQUIRE(results[7].error() == core_errc::path_syntax);
+
+        std::vector<std::expected<store_value, std::error_code>> short_results(1);
+        auto too_short = (*view)->get_many(*(*view)->root(), queries, short_results);
+        REQUIRE_FALSE(too_short.has_value());
+        REQUIRE(too_short.error() == core_errc::invalid_argument);
+    }
+
+    SECTION("get_string_view and get_string_views read strings without copying") {
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = *(*view)->root();
+        auto title = (*view)->get_string_view(*(*view)->navigate(root, "window.title"));
+        REQUIRE(title.has_value());
+        REQUIRE(*title == "ion");
+        REQUIRE((*view)->get<std::string_view>(root, "window.title").value().data() == title->data());
+        REQUIRE((*view)->get_string_view(*(*view)->navigate(root, "window.width")).error() == core_errc::type_mismatch);
+
+        std::vector<std::string_view> paths = {"window.title", "window.missing", "window.width", "window["};
+        std::vector<std::expected<std::string_view, std::error_code>> results(paths.size());
+        REQUIRE((*view)->get_string_views(root, paths, results).has_value());
+        REQUIRE(*results[0] == "ion");
+        REQUIRE(results[0]->data() == title->data());
+        REQUIRE(results[1].error() == core_errc::key_not_found);
+        REQUIRE(results[2].error() == core_errc::type_mismatch);
+        REQUIRE(results[3].error() == core_errc::path_syntax);
+
+        std::vector<std::expected<std::string_view, std::error_code>> short_results(1);
+        REQUIRE((*view)->get_string_views(root, paths, short_results).error() == core_errc::invalid_argument);
+    }
+
+    SECTION("set_many overwrites existing keys and creates missing ones") {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        std::vector<store_assignment> assignments = {
+            {"window.width", int64_t{1920}},
+            {"window.height", int64_t{1080}},
+            {"window.fullscreen", true},
+            {"window.scale", 1.5},
+            {"window.title", std::string("ion editor")},
+        };
+        REQUIRE((*txn)->set_many(*(*txn)->root(), assignments).has_value());
+        REQUIRE((*txn)->commit().has_value());
+
+        auto view = store->begin_read_transaction();
+        auto root = (*view)->root();
+        REQUIRE((*view)->get<int64_t>(*root, "window.width").value() == 1920);
+        REQUIRE((*view)->get<int64_t>(*root, "window.height").value() == 1080);
+        REQUIRE((*view)->get<bool>(*root, "window.fullscreen").value());
+        REQUIRE((*view)->get<double>(*root, "window.scale").value() == Catch::Approx(1.5));
+        REQUIRE((*view)->get<std::string>(*root, "window.title").value() == "ion editor");
+    }
+
+    SECTION("set_many stops at a missing parent") {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        std::vector<store_assignment> assignments = {
+            {"window.width", int64_t{640}},
+            {"audio.volume", 0.5},
+            {"window.height", int64_t{480}},
+        };
+        auto result = (*txn)->set_many(*(*txn)->root(), assignments);
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::key_not_found);
+
+        auto root = (*txn)->root();
+        REQUIRE((*txn)->get<int64_t>(*root, "window.width").value() == 640);
+        REQUIRE((*txn)->get<int64_t>(*root, "window.height").value() == 720);
+    }
+}
+
+TEST_CASE("JSON Transaction - Key validation and path splitting", "[storage][json][keys]") {
+    // Cover the scalar tail, whole 16-byte blocks and everything in between
+    for (size_t length = 1; length <= 40; ++length) {
+        std::string key(length, 'a');
+        for (size_t i = 0; i < length; ++i) key[i] = "aZ_9"[i % 4];
+        REQUIRE(detail::is_valid_key(key));
+        REQUIRE(detail::find_delimiter(key) == length);
+
+        for (size_t at = 0; at < length; ++at) {
+            for (char bad : {'-', '.', '[', ' ', '\0', '\x80', '@', '`', '{', '/', ':'}) {
+                std::string text = key;
+                text[at] = bad;
+                REQUIRE(detail::key_prefix(text) == at);
+                REQUIRE_FALSE(detail::is_valid_key(text));
+                bool delimiter = bad == '.' || bad == '[';
+                REQUIRE(detail::find_delimiter(text) == (delimiter ? at : length));
+            }
+        }
+    }
+
+    REQUIRE_FALSE(detail::is_valid_key(""));
+    REQUIRE_FALSE(detail::is_valid_key("9lives"));
+    static_assert(detail::is_valid_key("_under_score9"));
+    static_assert(detail::find_delimiter("ab.cd[1]") == 2);
+}
+
+TEST_CASE("JSON Transaction - Compiled Paths", "[storage][json][path]") {
+    static constexpr store_path k_width{"window.size[1].width"};
+    static_assert(k_width.segments().size() == 4);
+    static_assert(k_width.segments()[2].is_element && k_width.segments()[2].index == 1);
+    static_assert(k_width.segments()[3].key == "width");
+
+    temp_file temp("test_paths.json");
+    json_store_options opts{};
+
+    auto store_result = make_json_file_store(temp.path(), opts);
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open(temp.path()).has_value());
+
+    {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        auto window = (*txn)->make_object(*root, "window");
+        REQUIRE((*txn)->make_int(*window, "width", 800).has_value());
+        REQUIRE((*txn)->make_string(*window, "title", "ion").has_value());
+        REQUIRE((*txn)->commit().has_value());
+    }
+
+    static constexpr store_path k_window_width{"window.width"};
+    static constexpr store_path k_window_title{"window.title"};
+
+    SECTION("Runtime parsing reports malformed paths") {
+        REQUIRE(store_path::parse("a.b[3].c").has_value());
+        REQUIRE(store_path::parse("a[").error() == core_errc::path_syntax);
+        REQUIRE(store_path::parse("a[]").error() == core_errc::path_syntax);
+        REQUIRE(store_path::parse("a.9b").error() == core_errc::path_syntax);
+        REQUIRE(store_path::parse("a[99999999999999999999]").error() == core_errc::index_out_of_range);
+        REQUIRE(store_path::parse("a.a.a.a.a.a.a.a.a.a.a.a.a.a.a.a.a").error() == core_errc::path_syntax);
+    }
+
+    SECTION("Compiled lookups match string lookups") {
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE((*view)->get<int64_t>(*root, k_window_width).value() == 800);
+            REQUIRE((*view)->get<std::string>(*root, k_window_title).value() == "ion");
+        }
+        REQUIRE((*view)->navigate(*root, k_window_width).value() == (*view)->navigate(*root, k_window_width).value());
+        REQUIRE((*view)->get<int64_t>(*root, store_path{"window.height"}).error() == core_errc::key_not_found);
+        REQUIRE((*view)->get<int64_t>(*root, k_window_title).error() == core_errc::type_mismatch);
+    }
+
+    SECTION("Remembered resolutions follow writes and removals") {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        REQUIRE((*txn)->get<int64_t>(*root, k_window_width).value() == 800);
+
+        REQUIRE((*txn)->set_int(*(*txn)->navigate(*root, "window.width"), 1024).has_value());
+        REQUIRE((*txn)->get<int64_t>(*root, k_window_width).value() == 1024);
+
+        REQUIRE((*txn)->remove(*(*txn)->child(*root, "window"), "width").has_value());
+        REQUIRE((*txn)->get<int64_t>(*root, k_window_width).error() == core_errc::key_not_found);
+
+        REQUIRE((*txn)->make_int(*(*txn)->child(*root, "window"), "width", 640).has_value());
+        REQUIRE((*txn)->get<int64_t>(*root, k_window_width).value() == 640);
+        REQUIRE((*txn)->commit().has_value());
+
+        // The same transaction keeps working after its commit
+        REQUIRE((*txn)->get<int64_t>(*root, k_window_width).value() == 640);
+    }
+}
+
+TEST_CASE("JSON Transaction - Iteration", "[storage][json][iterate]") {
+    temp_file temp("test_iterate.json");
+    temp.write(R"({"routes": {"api_users": "users", "api_orders": "orders", "home": "index", "limits": {"rps": 10}},
+                  "weights": [1, 2.5, "heavy", true, null, [3]]})");
+    json_store_options opts{};
+
+    auto store_result = make_json_file_store(temp.path(), opts);
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open(temp.path()).has_value());
+
+    SECTION("children and elements read every child without handles") {
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = *(*view)->root();
+        auto routes = *(*view)->child(root, "routes");
+        REQUIRE((*view)->size(routes).value() == 4);
+        REQUIRE((*view)->type(routes).value() == store_node_type::object);
+
+        std::vector<std::string> keys;
+        auto children = (*view)->children(routes);
+        REQUIRE(children.has_value());
+        for (auto const& e : *children) keys.emplace_back(e.key);
+        REQUIRE(keys == std::vector<std::string>{"api_orders", "api_users", "home", "limits"});
+        REQUIRE_FALSE(children->error());
+
+        auto weights = *(*view)->child(root, "weights");
+        auto elements = (*view)->elements(weights);
+        REQUIRE(elements.has_value());
+        std::vector<store_entry> seen;
+        for (auto const& e : *elements) seen.push_back(e);
+        REQUIRE(seen.size() == 6);
+        REQUIRE(std::get<int64_t>(seen[0].value) == 1);
+        REQUIRE(std::get<double>(seen[1].value) == Catch::Approx(2.5));
+        REQUIRE(std::get<std::string_view>(seen[2].value) == "heavy");
+        REQUIRE(std::get<bool>(seen[3].value));
+        REQUIRE(seen[4].type == store_node_type::null);
+        REQUIRE(seen[5].type == store_node_type::array);
+        REQUIRE(seen[5].size == 1);
+        REQUIRE(seen[5].index == 5);
+
+        REQUIRE((*view)->elements(routes).error() == core_errc::type_mismatch);
+        REQUIRE((*view)->children(weights).error() == core_errc::type_mismatch);
+        REQUIRE((*view)->size(*(*view)->navigate(root, "routes.home")).error() == core_errc::type_mismatch);
+    }
+
+    SECTION("scan visits only keys with the prefix") {
+        auto view = store->begin_read_transaction();
+        auto routes = *(*view)->navigate(*(*view)->root(), "routes");
+
+        std::vector<std::string> targets;
+        auto api = (*view)->scan(routes, "api_");
+        REQUIRE(api.has_value());
+        for (auto const& e : *api) targets.emplace_back(std::get<std::string_view>(e.value));
+        REQUIRE(targets == std::vector<std::string>{"orders", "users"});
+
+        auto none = (*view)->scan(routes, "zzz");
+        REQUIRE(none->begin() == none->end());
+
+        store_entry batch[2];
+        REQUIRE((*view)->scan_entries(routes, "api_orders", true, batch).value() == 2);
+        REQUIRE(batch[0].key == "api_users");
+        REQUIRE(batch[1].key == "home");
+    }
+
+    SECTION("Cursors fetch large objects in batches") {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto routes = *(*txn)->navigate(*(*txn)->root(), "routes");
+        for (int i = 0; i < 40; ++i) {
+            REQUIRE((*txn)->make_int(routes, "r" + std::to_string(100 + i), i).has_value());
+        }
+        REQUIRE((*txn)->size(routes).value() == 44);
+
+        int64_t expected = 0;
+        auto scan = (*txn)->scan(routes, "r");
+        REQUIRE(scan.has_value());
+        for (auto const& e : *scan) REQUIRE(std::get<int64_t>(e.value) == expected++);
+        REQUIRE(expected == 40);
+        REQUIRE_FALSE(scan->error());
+
+        size_t count = 0;
+        auto children = (*txn)->children(routes);
+        REQUIRE(children.has_value());
+        for (auto const& e : *children) REQUIRE(e.index == count++);
+        REQUIRE(count == 44);
+    }
+}
+
+TEST_CASE("JSON Store - Journal", "[storage][json][journal]") {
+    temp_file temp("test_journal.json");
+    temp_file journal("test_journal.json.journal");
+    json_store_options opts{};
+
+    auto store_result = make_json_file_store(temp.path(), opts);
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open(temp.path()).has_value());
+
+    // The first commit has no base file to journal against and writes it out whole
+    {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        auto list = (*txn)->make_array(*root, "list");
+        REQUIRE(list.has_value());
+        REQUIRE((*txn)->make_int(*root, "counter", 0).has_value());
+        REQUIRE((*txn)->make_string(*root, "gone", "soon").has_value());
+        REQUIRE((*txn)->commit().has_value());
+    }
+    REQUIRE(temp.exists());
+    REQUIRE_FALSE(journal.exists());
+    std::string base = temp.read();
+
+    SECTION("Commits are appended and replayed on open") {
+        for (int64_t i = 1; i <= 3; ++i) {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            auto counter = (*txn)->child(*root, "counter");
+            REQUIRE((*txn)->set_int(*counter, i).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+        {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            auto nested = (*txn)->make_object(*root, "nested");
+            REQUIRE((*txn)->make_double(*nested, "pi", 3.5).has_value());
+            REQUIRE((*txn)->remove(*root, "gone").has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+
+        REQUIRE(journal.exists());
+        REQUIRE(temp.read() == base);
+
+        // Reopen without closing, as after a crash
+        auto reopened = make_json_file_store(temp.path(), opts);
+        REQUIRE(reopened.has_value());
+        REQUIRE((*reopened)->open(temp.path()).has_value());
+        auto view = (*reopened)->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        REQUIRE((*view)->get<int64_t>(*root, "counter").value() == 3);
+        REQUIRE((*view)->get<double>(*root, "nested.pi").value() == 3.5);
+        REQUIRE_FALSE(*(*view)->has(*root, "gone"));
+    }
+
+    SECTION("A torn tail is ignored") {
+        {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            auto counter = (*txn)->child(*root, "counter");
+            REQUIRE((*txn)->set_int(*counter, 7).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+        {
+            std::ofstream f(journal.path(), std::ios::app | std::ios::binary);
+            f << "IVJF\x10";
+        }
+
+        auto reopened = make_json_file_store(temp.path(), opts);
+        REQUIRE(reopened.has_value());
+        REQUIRE((*reopened)->open(temp.path()).has_value());
+        auto view = (*reopened)->begin_read_transaction();
+        REQUIRE(view.has_value());
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "counter").value() == 7);
+    }
+
+    SECTION("A journal follows its base through a touch or a copy") {
+        {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            auto counter = (*txn)->child(*root, "counter");
+            REQUIRE((*txn)->set_int(*counter, 5).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+        REQUIRE(journal.exists());
+
+        // Same bytes in a new file with a new timestamp, as a restore from backup leaves it
+        auto replacement = temp.path();
+        replacement += ".new";
+        {
+            std::ofstream f(replacement, std::ios::binary);
+            f << base;
+        }
+        std::filesystem::last_write_time(replacement, std::filesystem::last_write_time(temp.path()) + std::chrono::hours(1));
+        std::filesystem::rename(replacement, temp.path());
+
+        auto reopened = make_json_file_store(temp.path(), opts);
+        REQUIRE(reopened.has_value());
+        REQUIRE((*reopened)->open(temp.path()).has_value());
+        auto view = (*reopened)->begin_read_transaction();
+        REQUIRE(view.has_value());
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "counter").value() == 5);
+    }
+
+    SECTION("A journal for another base is kept and fails the open") {
+        {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            auto counter = (*txn)->child(*root, "counter");
+            REQUIRE((*txn)->set_int(*counter, 5).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+        std::string frames = journal.read();
+        temp.write(R"({"counter": 1})");
+
+        auto reopened = make_json_file_store(temp.path(), opts);
+        REQUIRE(reopened.has_value());
+        auto opened = (*reopened)->open(temp.path());
+        REQUIRE_FALSE(opened.has_value());
+        REQUIRE(opened.error() == core_errc::journal_mismatch);
+        REQUIRE(journal.read() == frames);
+
+        // Likewise once the base is gone altogether
+        std::filesystem::remove(temp.path());
+        REQUIRE((*reopened)->open(temp.path()).error() == core_errc::journal_mismatch);
+        REQUIRE(journal.exists());
+    }
+
+    SECTION("A journal already folded into the base is discarded") {
+        {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            auto counter = (*txn)->child(*root, "counter");
+            REQUIRE((*txn)->set_int(*counter, 5).has_value());
+            REQUIRE((*txn)->make_int(*root, "extra", 1).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+
+        // A second name keeps the journal as compaction leaves it just before removing it
+        auto kept = journal.path();
+        kept += ".kept";
+        std::filesystem::create_hard_link(journal.path(), kept);
+        REQUIRE(store->close().has_value());
+        REQUIRE_FALSE(journal.exists());
+        std::filesystem::rename(kept, journal.path());
+
+        auto reopened = make_json_file_store(temp.path(), opts);
+        REQUIRE(reopened.has_value());
+        REQUIRE((*reopened)->open(temp.path()).has_value());
+        REQUIRE_FALSE(journal.exists());
+        auto view = (*reopened)->begin_read_transaction();
+        REQUIRE(view.has_value());
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "counter").value() == 5);
+    }
+
+    SECTION("Close folds the journal into the base file") {
+        {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            REQUIRE((*txn)->make_string(*root, "note", "kept").has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+        REQUIRE(journal.exists());
+        REQUIRE(store->close().has_value());
+        REQUIRE_FALSE(journal.exists());
+        REQUIRE_THAT(temp.read(), ContainsSubstring("kept"));
+    }
+
+    SECTION("Large journals are compacted") {
+        opts.journal_compact_bytes = 256;
+        auto small = make_json_file_store(temp.path(), opts);
+        REQUIRE(small.has_value());
+        REQUIRE((*small)->open(temp.path()).has_value());
+        for (int i = 0; i < 32; ++i) {
+            auto txn = (*small)->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            REQUIRE((*txn)->make_string(*root, "payload", std::string(32, static_cast<char>('a' + i % 26))).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+        REQUIRE(fs::file_size(temp.path()) > 0);
+        REQUIRE((!journal.exists() || fs::file_size(journal.path()) < 256));
+        REQUIRE_THAT(temp.read(), ContainsSubstring("payload"));
+    }
+
+    SECTION("Compaction runs on the injected executor") {
+        struct deferred_executor final : executor_base {
+            std::vector<Task> tasks;
+            void execute(Task&& task) override { tasks.push_back(std::move(task)); }
+        } executor;
+
+        opts.journal_compact_bytes = 256;
+        opts.compaction_executor = &executor;
+        auto small = make_json_file_store(temp.path(), opts);
+        REQUIRE(small.has_value());
+        REQUIRE((*small)->open(temp.path()).has_value());
+        for (int i = 0; i < 32; ++i) {
+            auto txn = (*small)->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            REQUIRE((*txn)->make_string(*root, "payload", std::string(32, static_cast<char>('a' + i % 26))).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+
+        // Commits only queued the rewrite, once
+        REQUIRE(executor.tasks.size() == 1);
+        REQUIRE(fs::file_size(journal.path()) >= 256);
+
+        executor.tasks.front()();
+        REQUIRE_FALSE(journal.exists());
+        REQUIRE_THAT(temp.read(), ContainsSubstring(std::string(32, 'f')));
+    }
+}
+
+TEST_CASE("JSON Store - Memory-mapped I/O", "[storage][json][mmap]") {
+    temp_file temp("test_mmap.json");
+    temp_file journal("test_mmap.json.journal");
+    json_store_options opts{};
+    opts.write_mmap = true;
+    opts.use_journal = false;
+
+    SECTION("Round trip through mapped save and load") {
+        {
+            auto store = make_json_file_store(temp.path(), opts);
+            REQUIRE(store.has_value());
+            REQUIRE((*store)->open(temp.path()).has_value());
+            auto txn = (*store)->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto root = (*txn)->root();
+            auto config = (*txn)->make_object(*root, "config");
+            REQUIRE((*txn)->make_string(*config, "name", std::string(4096, 'x')).has_value());
+            REQUIRE((*txn)->make_int(*config, "port", 8080).has_value());
+            REQUIRE((*txn)->commit().has_value());
+            REQUIRE((*store)->close().has_value());
+        }
+        REQUIRE_FALSE(fs::exists(temp.path().string() + ".tmp"));
+
+        auto store = make_json_file_store(temp.path(), opts);
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        auto view = (*store)->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        REQUIRE((*view)->get<int64_t>(*root, "config.port").value() == 8080);
+        REQUIRE((*view)->get<std::string>(*root, "config.name").value().size() == 4096);
+    }
+
+    SECTION("Empty files load as an empty object") {
+        temp.write("");
+        auto store = make_json_file_store(temp.path(), opts);
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        auto view = (*store)->begin_read_transaction();
+        REQUIRE(view.has_value());
+        REQUIRE_FALSE(*(*view)->has(*(*view)->root(), "anything"));
+    }
+}
+
+TEST_CASE("JSON Store - Group Commit", "[storage][json][group]") {
+    temp_file temp("test_group.json");
+    temp_file journal("test_group.json.journal");
+    json_store_options opts{};
+    opts.group_commit_window = std::chrono::microseconds(200);
+
+    auto store_result = make_json_file_store(temp.path(), opts);
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open(temp.path()).has_value());
+
+    SECTION("Commits from the same snapshot are merged") {
+        auto first = store->begin_transaction();
+        auto second = store->begin_transaction();
+        REQUIRE(first.has_value());
+        REQUIRE(second.has_value());
+
+        REQUIRE((*first)->make_int(*(*first)->root(), "from_first", 1).has_value());
+        REQUIRE((*second)->make_int(*(*second)->root(), "from_second", 2).has_value());
+        REQUIRE((*first)->commit().has_value());
+        REQUIRE((*second)->commit().has_value());
+
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        REQUIRE((*view)->get<int64_t>(*root, "from_first").value() == 1);
+        REQUIRE((*view)->get<int64_t>(*root, "from_second").value() == 2);
+    }
+
+    SECTION("Concurrent writers to different keys all land") {
+        constexpr int k_writers = 8;
+        constexpr int k_commits = 25;
+        std::atomic<int> failures{0};
+        std::vector<std::thread> writers;
+        for (int w = 0; w < k_writers; ++w) {
+            writers.emplace_back([&, w] {
+                std::string key = "writer_" + std::to_string(w);
+                for (int i = 0; i < k_commits; ++i) {
+                    auto txn = store->begin_transaction();
+                    if (!txn || !(*txn)->make_int(*(*txn)->root(), key, i).has_value() || !(*txn)->commit()) {
+                        ++failures;
+                    }
+                }
+            });
+        }
+        for (auto& t : writers) t.join();
+        REQUIRE(failures.load() == 0);
+
+        REQUIRE(store->close().has_value());
+        REQUIRE(store->open(temp.path()).has_value());
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        for (int w = 0; w < k_writers; ++w) {
+            REQUIRE((*view)->get<int64_t>(*root, "writer_" + std::to_string(w)).value() == k_commits - 1);
+        }
+    }
+
+    SECTION("A commit into a removed subtree is rejected") {
+        {
+            auto setup = store->begin_transaction();
+            REQUIRE(setup.has_value());
+            REQUIRE((*setup)->make_object(*(*setup)->root(), "section").has_value());
+            REQUIRE((*setup)->commit().has_value());
+        }
+
+        auto writer = store->begin_transaction();
+        auto remover = store->begin_transaction();
+        REQUIRE(writer.has_value());
+        REQUIRE(remover.has_value());
+
+        auto section = (*writer)->child(*(*writer)->root(), "section");
+        REQUIRE((*writer)->make_int(*section, "value", 1).has_value());
+        REQUIRE((*remover)->remove(*(*remover)->root(), "section").has_value());
+        REQUIRE((*remover)->commit().has_value());
+
+        auto result = (*writer)->commit();
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::conflict);
+    }
+}
+
+TEST_CASE("JSON Transaction - Conflict Detection", "[storage][json][occ]") {
+    temp_file temp("test_occ.json");
+    temp_file journal("test_occ.json.journal");
+    json_store_options opts{};
+
+    auto store_result = make_json_file_store(temp.path(), opts);
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open(temp.path()).has_value());
+    {
+        auto setup = store->begin_transaction();
+        REQUIRE(setup.has_value());
+        auto root = (*setup)->root();
+        REQUIRE((*setup)->make_int(*root, "counter", 0).has_value());
+        auto left = (*setup)->make_object(*root, "left");
+        auto right = (*setup)->make_object(*root, "right");
+        REQUIRE((*setup)->make_int(*left, "value", 0).has_value());
+        REQUIRE((*setup)->make_int(*right, "value", 0).has_value());
+        auto list = (*setup)->make_array(*root, "list");
+        REQUIRE(list.has_value());
+        REQUIRE((*setup)->commit().has_value());
+    }
+
+    SECTION("Read-modify-write on the same value conflicts") {
+        auto first = store->begin_transaction();
+        auto second = store->begin_transaction();
+        REQUIRE(first.has_value());
+        REQUIRE(second.has_value());
+
+        for (auto* txn : {&*first, &*second}) {
+            auto counter = (*txn)->child(*(*txn)->root(), "counter");
+            auto value = (*txn)->get_int(*counter);
+            REQUIRE(value.has_value());
+            REQUIRE((*txn)->set_int(*counter, *value + 1).has_value());
+        }
+
+        REQUIRE((*first)->commit().has_value());
+        auto result = (*second)->commit();
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::conflict);
+
+        auto view = store->begin_read_transaction();
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "counter").value() == 1);
+    }
+
+    SECTION("Writers on disjoint subtrees both commit") {
+        auto first = store->begin_transaction();
+        auto second = store->begin_transaction();
+        REQUIRE(first.has_value());
+        REQUIRE(second.has_value());
+
+        auto a = (*first)->navigate(*(*first)->root(), "left.value");
+        auto b = (*second)->navigate(*(*second)->root(), "right.value");
+        REQUIRE((*first)->set_int(*a, *(*first)->get_int(*a) + 1).has_value());
+        REQUIRE((*second)->set_int(*b, *(*second)->get_int(*b) + 2).has_value());
+        REQUIRE((*first)->commit().has_value());
+        REQUIRE((*second)->commit().has_value());
+
+        auto view = store->begin_read_transaction();
+        auto root = (*view)->root();
+        REQUIRE((*view)->get<int64_t>(*root, "left.value").value() == 1);
+        REQUIRE((*view)->get<int64_t>(*root, "right.value").value() == 2);
+    }
+
+    SECTION("Blind writes do not conflict") {
+        auto first = store->begin_transaction();
+        auto second = store->begin_transaction();
+        REQUIRE((*first)->make_int(*(*first)->root(), "counter", 10).has_value());
+        REQUIRE((*second)->make_int(*(*second)->root(), "counter", 20).has_value());
+        REQUIRE((*first)->commit().has_value());
+        REQUIRE((*second)->commit().has_value());
+
+        auto view = store->begin_read_transaction();
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "counter").value() == 20);
+    }
+
+    SECTION("Navigating a key that was removed conflicts") {
+        auto reader = store->begin_transaction();
+        auto remover = store->begin_transaction();
+        REQUIRE(*(*reader)->has(*(*reader)->root(), "left"));
+        REQUIRE((*reader)->make_int(*(*reader)->root(), "saw_left", 1).has_value());
+        REQUIRE((*remover)->remove(*(*remover)->root(), "left").has_value());
+        REQUIRE((*remover)->commit().has_value());
+
+        auto result = (*reader)->commit();
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::conflict);
+    }
+
+    SECTION("A value read before removing it still conflicts") {
+        auto mover = store->begin_transaction();
+        auto writer = store->begin_transaction();
+
+        // Move left.value to a new key: the read's handle is retired by the remove
+        auto left = *(*mover)->child(*(*mover)->root(), "left");
+        auto value = (*mover)->get_int(*(*mover)->child(left, "value"));
+        REQUIRE(value.has_value());
+        REQUIRE((*mover)->remove(left, "value").has_value());
+        REQUIRE_FALSE((*mover)->child(left, "value").has_value());
+        REQUIRE((*mover)->make_int(*(*mover)->root(), "moved", *value).has_value());
+
+        REQUIRE((*writer)->set_int(*(*writer)->navigate(*(*writer)->root(), "left.value"), 5).has_value());
+        REQUIRE((*writer)->commit().has_value());
+
+        auto result = (*mover)->commit();
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::conflict);
+    }
+}
+
+TEST_CASE("Binary Store - Snapshots", "[storage][binary]") {
+    temp_file temp("test_snapshot.bin");
+    temp_file journal("test_snapshot.bin.journal");
+    temp_file json("test_snapshot.json");
+    temp_file json_journal("test_snapshot.json.journal");
+
+    auto populate = [](store_base& store) {
+        auto txn = store.begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        REQUIRE((*txn)->make_bool(*root, "enabled", true).has_value());
+        REQUIRE((*txn)->make_int(*root, "offset", -42).has_value());
+        REQUIRE((*txn)->make_double(*root, "ratio", 0.25).has_value());
+        REQUIRE((*txn)->make_array(*root, "tags").has_value());
+        auto servers = (*txn)->make_object(*root, "servers");
+        REQUIRE(servers.has_value());
+        for (int i = 0; i < 3; ++i) {
+            // Every server repeats the same keys, which share one dictionary entry
+            auto server = (*txn)->make_object(*servers, "s" + std::to_string(i));
+            REQUIRE(server.has_value());
+            REQUIRE((*txn)->make_string(*server, "host", "node" + std::to_string(i)).has_value());
+            REQUIRE((*txn)->make_int(*server, "port", 9000 + i).has_value());
+        }
+        REQUIRE((*txn)->commit().has_value());
+    };
+
+    auto verify = [](store_base& store) {
+        auto view = store.begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        REQUIRE((*view)->get<bool>(*root, "enabled").value());
+        REQUIRE((*view)->get<int64_t>(*root, "offset").value() == -42);
+        REQUIRE((*view)->get<double>(*root, "ratio").value() == Catch::Approx(0.25));
+        REQUIRE_FALSE(*(*view)->has_element(*(*view)->child(*root, "tags"), 0));
+        auto servers = (*view)->child(*root, "servers");
+        REQUIRE(servers.has_value());
+        for (size_t i = 0; i < 3; ++i) {
+            auto server = (*view)->child(*servers, "s" + std::to_string(i));
+            REQUIRE(server.has_value());
+            REQUIRE((*view)->get<std::string>(*server, "host").value() == "node" + std::to_string(i));
+            REQUIRE((*view)->get<int64_t>(*server, "port").value() == static_cast<int64_t>(9000 + i));
+        }
+    };
+
+    SECTION("Round trip through the snapshot file and its journal") {
+        {
+            auto store = make_binary_file_store(temp.path(), binary_store_options{});
+            REQUIRE(store.has_value());
+            REQUIRE((*store)->open(temp.path()).has_value());
+            populate(**store);
+
+            // Lands in the journal on top of the snapshot written by the first commit
+            auto txn = (*store)->begin_transaction();
+            REQUIRE((*txn)->make_int(*(*txn)->root(), "extra", 7).has_value());
+            REQUIRE((*txn)->commit().has_value());
+            REQUIRE(journal.exists());
+        }
+        REQUIRE_FALSE(journal.exists());
+
+        auto store = make_binary_file_store(temp.path(), binary_store_options{});
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        verify(**store);
+        auto view = (*store)->begin_read_transaction();
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "extra").value() == 7);
+    }
+
+    SECTION("Truncated or foreign files are rejected") {
+        {
+            auto store = make_binary_file_store(temp.path(), binary_store_options{});
+            REQUIRE((*store)->open(temp.path()).has_value());
+            populate(**store);
+        }
+        auto content = temp.read();
+        std::ofstream(temp.path(), std::ios::binary | std::ios::trunc).write(content.data(), 40);
+
+        auto store = make_binary_file_store(temp.path(), binary_store_options{});
+        auto opened = (*store)->open(temp.path());
+        REQUIRE_FALSE(opened.has_value());
+        REQUIRE(opened.error() == core_errc::parse_error);
+
+        temp.write("{\"not\": \"a snapshot\"}");
+        opened = (*store)->open(temp.path());
+        REQUIRE_FALSE(opened.has_value());
+        REQUIRE(opened.error() == core_errc::parse_error);
+    }
+
+    SECTION("A tree nested deeper than the reader accepts is not saved") {
+        auto store = make_binary_file_store(temp.path(), binary_store_options{});
+        REQUIRE((*store)->open(temp.path()).has_value());
+        auto txn = (*store)->begin_transaction();
+        auto node = (*txn)->root();
+        for (int i = 0; i < 1100; ++i) node = (*txn)->make_object(*node, "n");
+        REQUIRE(node.has_value());
+
+        auto committed = (*txn)->commit();
+        REQUIRE_FALSE(committed.has_value());
+        REQUIRE(committed.error() == core_errc::invalid_argument);
+        REQUIRE_FALSE(temp.exists());
+    }
+
+    SECTION("Converts to and from JSON") {
+        {
+            auto store = make_json_file_store(json.path(), json_store_options{});
+            REQUIRE((*store)->open(json.path()).has_value());
+            populate(**store);
+        }
+
+        REQUIRE(convert_store_file(json.path(), store_format::json, temp.path(), store_format::binary).has_value());
+        {
+            auto store = make_binary_file_store(temp.path(), binary_store_options{});
+            REQUIRE((*store)->open(temp.path()).has_value());
+            verify(**store);
+        }
+
+        json.write("{}");
+        REQUIRE(convert_store_file(temp.path(), store_format::binary, json.path(), store_format::json).has_value());
+        auto store = make_json_file_store(json.path(), json_store_options{});
+        REQUIRE((*store)->open(json.path()).has_value());
+        verify(**store);
+    }
+
+    SECTION("Converting only reads the source and its journal") {
+        auto source = make_json_file_store(json.path(), json_store_options{});
+        REQUIRE((*source)->open(json.path()).has_value());
+        populate(**source);
+        auto txn = (*source)->begin_transaction();
+        REQUIRE((*txn)->make_int(*(*txn)->root(), "extra", 7).has_value());
+        REQUIRE((*txn)->commit().has_value());
+        // A torn frame at the tail, which opening the store would truncate away
+        std::ofstream(json_journal.path(), std::ios::binary | std::ios::app) << "IVJF";
+        auto base = json.read();
+        auto log = json_journal.read();
+
+        REQUIRE(convert_store_file(json.path(), store_format::json, temp.path(), store_format::binary).has_value());
+        REQUIRE(json.read() == base);
+        REQUIRE(json_journal.read() == log);
+
+        auto store = make_binary_file_store(temp.path(), binary_store_options{});
+        REQUIRE((*store)->open(temp.path()).has_value());
+        verify(**store);
+        auto view = (*store)->begin_read_transaction();
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "extra").value() == 7);
+    }
+
+    SECTION("Converting a value the target cannot express fails") {
+        {
+            auto store = make_binary_file_store(temp.path(), binary_store_options{});
+            REQUIRE((*store)->open(temp.path()).has_value());
+            auto txn = (*store)->begin_transaction();
+            REQUIRE((*txn)->make_double(*(*txn)->root(), "ratio", std::numeric_limits<double>::quiet_NaN()).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+
+        auto result = convert_store_file(temp.path(), store_format::binary, json.path(), store_format::json);
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::type_mismatch);
+        REQUIRE_FALSE(json.exists());
+    }
+
+    SECTION("Converting a missing file fails") {
+        auto result = convert_store_file(json.path(), store_format::json, temp.path(), store_format::binary);
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::io_failure);
+        REQUIRE_FALSE(temp.exists());
+    }
+}
+
+TEST_CASE("JSON Store - Coroutine API", "[storage][json][coroutine]") {
+    temp_file temp("test_async.json");
+    temp_file journal("test_async.json.journal");
+    thread_pool_options pool_opts{};
+    pool_opts.worker_count = 1;
+    auto io = make_thread_pool(pool_opts);
+    REQUIRE(io.has_value());
+
+    auto store = make_json_file_store(temp.path(), json_store_options{});
+    REQUIRE(store.has_value());
+
+    auto write = [](store_base& s, executor_base& ex, std::filesystem::path path) -> task<std::expected<void, std::error_code>> {
+        auto opened = co_await s.open_async(path, ex);
+        if (!opened) co_return opened;
+
+        auto txn = co_await s.begin_transaction_async(ex);
+        if (!txn) co_return std::unexpected(txn.error());
+        auto root = (*txn)->root();
+        auto made = (*txn)->make_int(*root, "answer", 42);
+        if (!made) co_return std::unexpected(made.error());
+        auto committed = co_await (*txn)->commit_async(ex);
+        if (!committed) co_return committed;
+
+        co_return co_await s.close_async(ex);
+    };
+
+    REQUIRE(sync_wait(write(**store, **io, temp.path())).has_value());
+    REQUIRE_THAT(temp.read(), ContainsSubstring("answer"));
+
+    SECTION("Errors come back as values") {
+        auto closed = sync_wait((*store)->close_async(**io));
+        REQUIRE_FALSE(closed.has_value());
+        REQUIRE(closed.error() == core_errc::invalid_state);
+    }
+}
+
+TEST_CASE("JSON Store - Instrumentation", "[storage][json][metrics]") {
+    // Flattens a scrape into samples per histogram and values per counter or gauge
+    struct recorded_metrics {
+        std::map<std::string, uint64_t, std::less<>> counts;
+        std::map<std::string, uint64_t, std::less<>> timings;
+        std::map<std::string, double, std::less<>> gauges;
+    };
+    auto scrape = [](metrics_registry_base const& registry) {
+        auto snapshot = registry.scrape();
+        REQUIRE(snapshot.has_value());
+        recorded_metrics out;
+        for (auto const& c : snapshot->counters) out.counts[c.name] = c.value;
+        for (auto const& h : snapshot->histograms) out.timings[h.name] = h.count;
+        for (auto const& g : snapshot->gauges) out.gauges[g.name] = g.value;
+        return out;
+    };
+    struct ticking_clock final : clock_base {
+        mutable uint64_t now = 0;
+        uint64_t now_ns() const override { return now += 10; }
+    };
+
+    temp_file temp("test_metrics.json");
+    auto registry = make_metrics_registry();
+    REQUIRE(registry.has_value());
+    ticking_clock clock;
+    json_store_options opts{};
+    opts.use_journal = false;
+    opts.instrumentation = {registry->get(), &clock};
+
+    {
+        auto store = make_json_file_store(temp.path(), opts);
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        auto txn = (*store)->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        auto window = (*txn)->make_object(*root, "window");
+        REQUIRE((*txn)->make_int(*window, "width", 800).has_value());
+        REQUIRE((*txn)->commit().has_value());
+
+        static constexpr store_path k_width{"window.width"};
+        REQUIRE((*txn)->get<int64_t>(*root, k_width).value() == 800);
+        REQUIRE((*txn)->get<int64_t>(*root, k_width).value() == 800);
+        REQUIRE((*store)->close().has_value());
+    }
+
+    auto metrics = scrape(**registry);
+    REQUIRE(metrics.timings["store.open_ns"] == 1);
+    REQUIRE(metrics.timings["store.begin_transaction_ns"] == 1);
+    REQUIRE(metrics.timings["store.commit_ns"] == 1);
+    REQUIRE(metrics.timings["store.persist.serialize_ns"] == 1);
+    REQUIRE(metrics.timings["store.persist.write_ns"] == 1);
+    REQUIRE(metrics.counts["store.persist.bytes"] == temp.read().size());
+    REQUIRE(metrics.counts["store.navigate.walks"] == 1);
+    REQUIRE(metrics.counts["store.navigate.segments"] == 2);
+    REQUIRE(metrics.counts["store.navigate.cached"] == 1);
+    REQUIRE(metrics.gauges["store.transaction_handles"] == 2);   // The root and "window"
+
+    SECTION("Opening an existing file splits read and parse") {
+        auto store = make_json_file_store(temp.path(), opts);
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        metrics = scrape(**registry);
+        REQUIRE(metrics.timings["store.open.read_ns"] == 1);
+        REQUIRE(metrics.timings["store.open.parse_ns"] == 1);
+        REQUIRE(metrics.timings["store.open.replay_ns"] == 1);
+    }
+
+    SECTION("Without a clock only counts are reported") {
+        auto counts_only = make_metrics_registry();
+        REQUIRE(counts_only.has_value());
+        opts.instrumentation = {counts_only->get(), nullptr};
+        auto store = make_json_file_store(temp.path(), opts);
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        REQUIRE(scrape(**counts_only).timings.empty());
+        REQUIRE(scrape(**counts_only).counts.contains("store.persist.bytes"));
+    }
+
+    SECTION("A full registry drops the metrics it has no room for") {
+        auto small = make_metrics_registry({.max_counters = 1, .max_gauges = 0, .max_histograms = 1});
+        REQUIRE(small.has_value());
+        opts.instrumentation = {small->get(), &clock};
+        auto store = make_json_file_store(temp.path(), opts);
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        auto limited = scrape(**small);
+        REQUIRE(limited.timings.size() == 1);
+        REQUIRE(limited.timings["store.open_ns"] == 1);
+        REQUIRE(limited.counts.size() == 1);
+        REQUIRE(limited.gauges.empty());
+    }
+}
+
+TEST_CASE("JSON Store - Subscriptions", "[storage][json][subscribe]") {
+    temp_file temp("test_subscribe.json");
+    temp_file journal("test_subscribe.json.journal");
+    temp.write(R"({"routes": {"home": "index", "users": "users"}, "limits": {"rps": 10}})");
+
+    struct deferred_executor final : executor_base {
+        std::vector<Task> tasks;
+        void execute(Task&& task) override { tasks.push_back(std::move(task)); }
+        void run() {
+            auto pending = std::move(tasks);
+            for (auto& task : pending) task();
+        }
+    } executor;
+
+    auto store_result = make_json_file_store(temp.path(), json_store_options{});
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open(temp.path()).has_value());
+
+    std::vector<std::string> home_changes;
+    std::vector<std::string> routes_changes;
+    uint64_t last_sequence = 0;
+    auto home = store->subscribe("routes.home", executor, [&](store_change const& change) {
+        home_changes.assign(change.paths.begin(), change.paths.end());
+        last_sequence = change.sequence;
+    });
+    auto routes = store->subscribe("routes", executor, [&](store_change const& change) {
+        routes_changes.assign(change.paths.begin(), change.paths.end());
+    });
+    REQUIRE(home.has_value());
+    REQUIRE(routes.has_value());
+
+    auto commit = [&](auto&& edit) {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        edit(**txn, *(*txn)->root());
+        REQUIRE((*txn)->commit().has_value());
+    };
+
+    SECTION("Only subscribers of changed paths are notified") {
+        commit([](transaction_base& txn, store_handle root) {
+            REQUIRE(txn.set_int(*txn.navigate(root, "limits.rps"), 20).has_value());
+        });
+        REQUIRE(executor.tasks.empty());
+
+        commit([](transaction_base& txn, store_handle root) {
+            REQUIRE(txn.set_string(*txn.navigate(root, "routes.users"), "people").has_value());
+        });
+        executor.run();
+        REQUIRE(home_changes.empty());
+        REQUIRE(routes_changes == std::vector<std::string>{"routes.users"});
+
+        commit([](transaction_base& txn, store_handle root) {
+            REQUIRE(txn.set_string(*txn.navigate(root, "routes.home"), "start").has_value());
+        });
+        executor.run();
+        REQUIRE(home_changes == std::vector<std::string>{"routes.home"});
+        REQUIRE(last_sequence == 2);
+    }
+
+    SECTION("Replacing a parent notifies the subscribers below it") {
+        commit([](transaction_base& txn, store_handle root) {
+            REQUIRE(txn.remove(root, "routes").has_value());
+        });
+        executor.run();
+        REQUIRE(home_changes == std::vector<std::string>{"routes"});
+        REQUIRE(routes_changes == std::vector<std::string>{"routes"});
+    }
+
+    SECTION("Unsubscribing drops queued deliveries") {
+        commit([](transaction_base& txn, store_handle root) {
+            REQUIRE(txn.set_string(*txn.navigate(root, "routes.home"), "start").has_value());
+        });
+        REQUIRE(executor.tasks.size() == 2);
+        home->reset();
+        REQUIRE_FALSE(home->active());
+        executor.run();
+        REQUIRE(home_changes.empty());
+        REQUIRE(routes_changes == std::vector<std::string>{"routes.home"});
+    }
+
+    SECTION("Malformed paths are rejected") {
+        auto bad = store->subscribe("routes..9", executor, [](store_change const&) {});
+        REQUIRE_FALSE(bad.has_value());
+        REQUIRE(bad.error() == core_errc::path_syntax);
+    }
+}
+
+TEST_CASE("JSON Store - Lazy Loading", "[storage][json][lazy]") {
+    temp_file temp("test_lazy.json");
+    temp_file journal("test_lazy.json.journal");
+    json_store_options opts{};
+    opts.lazy_load = true;
+    opts.allow_comments = true;
+
+    temp.write(R"({
+        // Only the members a read reaches are parsed
+        "server": {"host": "localhost", "ports": [80, 443]},
+        "name": "café",
+        "we\"ird": {"k": true},
+        "limits": {"max": 10} /* trailing */
+    })");
+
+    auto open_store = [&](json_store_options const& options) {
+        auto store = make_json_file_store(temp.path(), options);
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        return std::move(*store);
+    };
+
+    SECTION("Reads match an eager load") {
+        auto lazy = open_store(opts);
+        auto view = lazy->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = *(*view)->root();
+        REQUIRE((*view)->get<std::string>(root, "server.host").value() == "localhost");
+        REQUIRE((*view)->get<int64_t>(root, "server.ports[1]").value() == 443);
+        REQUIRE((*view)->get<std::string>(root, "name").value() == "caf\xC3\xA9");
+        REQUIRE((*view)->get<bool>(*(*view)->child(root, "we\"ird"), "k").value());
+        REQUIRE((*view)->size(root).value() == 4);
+    }
+
+    SECTION("Writes into deferred members survive a reopen") {
+        {
+            auto store = open_store(opts);
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            auto max = (*txn)->navigate(*(*txn)->root(), "limits.max");
+            REQUIRE((*txn)->set_int(*max, 20).has_value());
+            REQUIRE((*txn)->commit().has_value());
+            REQUIRE(store->close().has_value());
+        }
+        auto store = open_store(opts);
+        auto view = store->begin_read_transaction();
+        auto root = *(*view)->root();
+        REQUIRE((*view)->get<int64_t>(root, "limits.max").value() == 20);
+        REQUIRE((*view)->get<int64_t>(root, "server.ports[0]").value() == 80);
+    }
+
+    SECTION("Unread members survive the file being truncated") {
+        auto mapped = opts;
+        mapped.write_mmap = true;
+        auto store = open_store(mapped);
+        std::filesystem::resize_file(temp.path(), 0);
+        auto view = store->begin_read_transaction();
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "server.ports[0]").value() == 80);
+    }
+
+    SECTION("Malformed structure or scalars fail to open") {
+        temp.write(R"({"a": 1, "deep": {"list": [1, 2}})");
+        auto store = make_json_file_store(temp.path(), opts);
+        REQUIRE(store.has_value());
+        auto opened = (*store)->open(temp.path());
+        REQUIRE_FALSE(opened.has_value());
+        REQUIRE(opened.error() == core_errc::parse_error);
+
+        temp.write("{\"a\": \"\xC0\xAF\"}");
+        REQUIRE((*store)->open(temp.path()).error() == core_errc::parse_error);
+    }
+
+    SECTION("A member malformed inside fails its reads and the save, but never turns null") {
+        std::string text = R"({"a": 1, "deep": {"list": [1, 2,], "s": "]\"}"}, "next": ["\\", {}]})";
+        temp.write(text);
+        auto store = open_store(opts);
+        {
+            auto view = store->begin_read_transaction();
+            auto root = *(*view)->root();
+            REQUIRE((*view)->get<int64_t>(root, "a").value() == 1);
+            REQUIRE((*view)->get<std::string>(root, "next[0]").value() == "\\");
+            REQUIRE((*view)->size(*(*view)->child(root, "next")).value() == 2);
+            auto deep = (*view)->child(root, "deep");
+            REQUIRE(deep.has_value());
+            REQUIRE((*view)->type(*deep).error() == core_errc::parse_error);
+            REQUIRE((*view)->navigate(root, "deep.s").error() == core_errc::parse_error);
+            store_entry entries[4];
+            REQUIRE((*view)->read_entries(root, 0, entries).error() == core_errc::parse_error);
+        }
+
+        // Nothing can be written over the member's text by accident
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        REQUIRE((*txn)->set_int(*(*txn)->child(*(*txn)->root(), "a"), 2).has_value());
+        REQUIRE((*txn)->commit().has_value());
+        REQUIRE_FALSE(store->close().has_value());
+        REQUIRE(temp.read() == text);
+
+        // Replacing the member clears the way
+        store = open_store(opts);
+        txn = store->begin_transaction();
+        REQUIRE((*txn)->make_object(*(*txn)->root(), "deep").has_value());
+        REQUIRE((*txn)->commit().has_value());
+        REQUIRE(store->close().has_value());
+        REQUIRE_THAT(temp.read(), ContainsSubstring("\"a\": 2"));
+    }
+
+    SECTION("Roots other than objects load eagerly") {
+        temp.write("[1, {\"a\": 2}]");
+        auto store = open_store(opts);
+        auto view = store->begin_read_transaction();
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "[1].a").value() == 2);
+    }
+}
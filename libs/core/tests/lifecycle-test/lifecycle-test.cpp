@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ion/core/lifecycle.h>
+#include <ion/core/metrics.h>
+#include <ion/core/thread.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace ion::core;
+
+namespace {
+
+// Advances only when told to, so pacing and budgets are deterministic
+struct manual_clock final : clock_base {
+    std::atomic<uint64_t> now{1000};
+    uint64_t now_ns() const override { return now.load(); }
+};
+
+struct event_log {
+    std::mutex mutex;
+    std::vector<std::string> events;
+
+    void push(std::string event) {
+        std::lock_guard lock(mutex);
+        events.push_back(std::move(event));
+    }
+
+    std::size_t index_of(std::string const& event) {
+        std::lock_guard lock(mutex);
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            if (events[i] == event) return i;
+        }
+        return events.size();
+    }
+};
+
+class recording_service final : public service_base {
+public:
+    recording_service(std::string name, event_log& log, manual_clock* clock = nullptr, uint64_t cost_ns = 0)
+        : name_(std::move(name)), log_(log), clock_(clock), cost_ns_(cost_ns) {}
+
+    void init() override { log_.push(name_ + ".init"); }
+    void tick() override {
+        log_.push(name_ + ".tick");
+        if (clock_) clock_->now += cost_ns_;
+    }
+    void shutdown() override { log_.push(name_ + ".shutdown"); }
+
+private:
+    std::string name_;
+    event_log& log_;
+    manual_clock* clock_;
+    uint64_t cost_ns_;
+};
+
+} // namespace
+
+TEST_CASE("Lifecycle - Service host phases", "[lifecycle]") {
+    event_log log;
+    recording_service input("input", log), physics("physics", log), audio("audio", log), render("render", log);
+
+    auto host = make_service_host();
+    REQUIRE(host.has_value());
+    auto in = (*host)->add(input, {.name = "input"});
+    REQUIRE(in.has_value());
+    auto ph = (*host)->add(physics, {.name = "physics", .after = {*in}});
+    auto au = (*host)->add(audio, {.name = "audio", .after = {*in}});
+    REQUIRE(ph.has_value());
+    REQUIRE(au.has_value());
+    auto re = (*host)->add(render, {.name = "render", .after = {*ph, *au}});
+    REQUIRE(re.has_value());
+
+    REQUIRE((*host)->phase_of(*in) == 0);
+    REQUIRE((*host)->phase_of(*ph) == 1);
+    REQUIRE((*host)->phase_of(*au) == 1);
+    REQUIRE((*host)->phase_of(*re) == 2);
+    REQUIRE((*host)->add(render, {.after = {service_id{9}}}).error() == core_errc::invalid_argument);
+    REQUIRE((*host)->add(render, {.interval_ns = 10}).error() == core_errc::invalid_argument);
+
+    REQUIRE((*host)->tick().error() == core_errc::invalid_state);
+    REQUIRE((*host)->init().has_value());
+    REQUIRE((*host)->add(render, {}).error() == core_errc::invalid_state);
+    REQUIRE(log.events == std::vector<std::string>{"input.init", "physics.init", "audio.init", "render.init"});
+
+    log.events.clear();
+    REQUIRE((*host)->tick().has_value());
+    REQUIRE(log.events == std::vector<std::string>{"input.tick", "physics.tick", "audio.tick", "render.tick"});
+    REQUIRE((*host)->frames() == 1);
+    REQUIRE((*host)->stats(*re).ticks == 1);
+
+    log.events.clear();
+    REQUIRE((*host)->shutdown().has_value());
+    REQUIRE(log.events == std::vector<std::string>{"render.shutdown", "audio.shutdown", "physics.shutdown", "input.shutdown"});
+    REQUIRE((*host)->tick().error() == core_errc::invalid_state);
+}
+
+TEST_CASE("Lifecycle - Parallel phases", "[lifecycle]") {
+    auto pool = make_thread_pool({.worker_count = 3});
+    REQUIRE(pool.has_value());
+    event_log log;
+    auto host = make_service_host({.executor = pool->get()});
+    REQUIRE(host.has_value());
+
+    recording_service first("first", log), last("last", log);
+    std::vector<std::unique_ptr<recording_service>> middle;
+    auto a = (*host)->add(first, {.name = "first"});
+    REQUIRE(a.has_value());
+    std::vector<service_id> ids;
+    for (int i = 0; i < 8; ++i) {
+        middle.push_back(std::make_unique<recording_service>("m" + std::to_string(i), log));
+        auto id = (*host)->add(*middle.back(), {.after = {*a}});
+        REQUIRE(id.has_value());
+        ids.push_back(*id);
+    }
+    REQUIRE((*host)->add(last, {.name = "last", .after = ids}).has_value());
+    REQUIRE((*host)->init().has_value());
+
+    for (int frame = 0; frame < 50; ++frame) {
+        log.events.clear();
+        REQUIRE((*host)->tick().has_value());
+        REQUIRE(log.events.size() == 10);
+        std::size_t first_at = log.index_of("first.tick"), last_at = log.index_of("last.tick");
+        REQUIRE(first_at == 0);
+        REQUIRE(last_at == 9);
+    }
+    for (auto id : ids) REQUIRE((*host)->stats(id).ticks == 50);
+    REQUIRE((*host)->shutdown().has_value());
+}
+
+TEST_CASE("Lifecycle - Fixed-rate and budgeted ticks", "[lifecycle]") {
+    manual_clock clock;
+    event_log log;
+
+    SECTION("Fixed-rate services keep their cadence") {
+        recording_service slow("slow", log), every("every", log);
+        auto host = make_service_host({.clock = &clock});
+        REQUIRE(host.has_value());
+        auto s = (*host)->add(slow, {.name = "slow", .interval_ns = 100});
+        auto e = (*host)->add(every, {.name = "every"});
+        REQUIRE(s.has_value());
+        REQUIRE(e.has_value());
+        REQUIRE((*host)->init().has_value());
+        for (int frame = 0; frame < 10; ++frame) {
+            REQUIRE((*host)->tick().has_value());
+            clock.now += 40;
+        }
+        // Frames at +0, +40, ... +360: due at +0, +100 (tick at +120), +200 (+200), +300 (+320)
+        REQUIRE((*host)->stats(*s).ticks == 4);
+        REQUIRE((*host)->stats(*e).ticks == 10);
+    }
+
+    SECTION("Latency, overruns and skipping past the frame budget") {
+        auto registry = make_metrics_registry();
+        REQUIRE(registry.has_value());
+        recording_service heavy("heavy", log, &clock, 500), extra("extra", log, &clock, 10);
+        auto host = make_service_host({.clock = &clock, .metrics = registry->get(), .frame_budget_ns = 400});
+        REQUIRE(host.has_value());
+        auto h = (*host)->add(heavy, {.name = "heavy", .budget_ns = 300});
+        REQUIRE(h.has_value());
+        auto x = (*host)->add(extra, {.name = "extra", .after = {*h}, .skippable = true});
+        REQUIRE(x.has_value());
+        REQUIRE((*host)->init().has_value());
+        REQUIRE((*host)->tick().has_value());
+        REQUIRE((*host)->tick().has_value());
+
+        auto stats = (*host)->stats(*h);
+        REQUIRE(stats.ticks == 2);
+        REQUIRE(stats.overruns == 2);
+        REQUIRE(stats.last_tick_ns == 500);
+        REQUIRE(stats.max_tick_ns == 500);
+        REQUIRE(stats.total_tick_ns == 1000);
+        REQUIRE((*host)->stats(*x).ticks == 0);
+        REQUIRE((*host)->stats(*x).skipped == 2);
+
+        auto snapshot = (*registry)->scrape();
+        REQUIRE(snapshot.has_value());
+        REQUIRE(snapshot->histograms.size() == 2);
+        REQUIRE(snapshot->histograms[0].name == "service.heavy.tick_ns");
+        REQUIRE(snapshot->histograms[0].count == 2);
+    }
+
+    SECTION("The frame clock is updated before every frame") {
+        cached_clock frame_clock(clock);
+        auto host = make_service_host({.clock = &clock, .frame_clock = &frame_clock});
+        REQUIRE(host.has_value());
+        REQUIRE((*host)->init().has_value());
+        clock.now = 5000;
+        REQUIRE((*host)->tick().has_value());
+        REQUIRE(frame_clock.now_fast() == 5000);
+    }
+
+    SECTION("Pacing needs a clock") {
+        REQUIRE(make_service_host({.frame_interval_ns = 1000}).error() == core_errc::invalid_argument);
+    }
+}
+
+TEST_CASE("Lifecycle - Run until stopped", "[lifecycle]") {
+    manual_clock clock;
+    std::atomic<bool> stop{false};
+    struct stopping_service final : service_base {
+        std::atomic<bool>* stop;
+        int ticks = 0;
+        void init() override {}
+        void tick() override { if (++ticks == 5) stop->store(true); }
+        void shutdown() override {}
+    } service;
+    service.stop = &stop;
+
+    auto host = make_service_host({.clock = &clock, .frame_interval_ns = 1000});
+    REQUIRE(host.has_value());
+    REQUIRE((*host)->add(service, {.name = "stopper"}).has_value());
+    REQUIRE((*host)->init().has_value());
+    REQUIRE((*host)->run(stop).has_value());
+    REQUIRE(service.ticks == 5);
+    REQUIRE((*host)->frames() == 5);
+}
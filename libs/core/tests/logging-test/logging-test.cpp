@@ -0,0 +1,265 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ion/core/logging.h>
+#include <ion/core/thread.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ion::core;
+
+namespace {
+
+// Counts how often it is formatted, to tell eager from deferred formatting
+struct counted {
+    int value;
+};
+std::atomic<int> g_formats{0};
+
+class capture_writer final : public log_writer_base {
+public:
+    void write(std::span<const log_entry> batch) override {
+        std::lock_guard lock(mutex_);
+        ++batches_;
+        for (auto const& e : batch) lines_.emplace_back(e.message);
+    }
+
+    std::vector<std::string> lines() {
+        std::lock_guard lock(mutex_);
+        return lines_;
+    }
+
+    int batches() {
+        std::lock_guard lock(mutex_);
+        return batches_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> lines_;
+    int batches_ = 0;
+};
+
+class eager_logger final : public logger_base {
+public:
+    using logger_base::log;
+    void log(log_level, std::string_view msg) override { lines.emplace_back(msg); }
+    bool is_enabled(log_level level) const override { return level >= log_level::info; }
+    std::vector<std::string> lines;
+};
+
+struct fixed_clock final : clock_base {
+    uint64_t now_ns() const override { return 42; }
+};
+
+// Holds submitted tasks until the test runs them
+class manual_executor final : public executor_base {
+public:
+    void execute(Task&& task) override { tasks_.push_back(std::move(task)); }
+
+    std::size_t run_all() {
+        std::size_t ran = 0;
+        while (!tasks_.empty()) {
+            auto task = std::move(tasks_.front());
+            tasks_.erase(tasks_.begin());
+            task();
+            ++ran;
+        }
+        return ran;
+    }
+
+private:
+    std::vector<Task> tasks_;
+};
+
+// Logs `text` from a thread of its own, which takes the next thread slot
+void log_on_new_thread(logger_base& logger, log_level level, std::string const& text) {
+    std::thread([&] { logger.log(level, std::string_view(text)); }).join();
+}
+
+} // namespace
+
+template <>
+struct std::formatter<counted> : std::formatter<int> {
+    auto format(counted c, std::format_context& ctx) const {
+        g_formats.fetch_add(1);
+        return std::formatter<int>::format(c.value, ctx);
+    }
+};
+
+TEST_CASE("Logging - logger_base", "[logging]") {
+    eager_logger logger;
+
+    SECTION("Disabled levels are not formatted") {
+        g_formats = 0;
+        logger.log(log_level::debug, "value {}", counted{1});
+        REQUIRE(g_formats == 0);
+        REQUIRE(logger.lines.empty());
+        logger.log(log_level::info, "value {}", counted{2});
+        REQUIRE(g_formats == 1);
+        REQUIRE(logger.lines == std::vector<std::string>{"value 2"});
+    }
+
+    SECTION("Captured arguments format on the default path") {
+        std::string name = "store";
+        logger.log(log_level::warning, "{} took {} us ({}%)", name, 125, 12.5);
+        logger.log(log_level::error, "{}:{}", "literal", std::string_view("view"));
+        REQUIRE(logger.lines == std::vector<std::string>{"store took 125 us (12.5%)", "literal:view"});
+    }
+}
+
+TEST_CASE("Logging - Async logger", "[logging]") {
+    capture_writer writer;
+
+    SECTION("Requires a writer") {
+        REQUIRE(make_async_logger({}).error() == core_errc::invalid_argument);
+    }
+
+    SECTION("Formats on flush, from copies of the arguments") {
+        auto logger = make_async_logger({.level = log_level::debug, .writer = &writer, .shard_count = 1});
+        REQUIRE(logger.has_value());
+
+        std::string text = "first";
+        (*logger)->log(log_level::info, "{} #{}", text, 1);
+        text = "changed";
+        (*logger)->log(log_level::trace, "hidden {}", 2);
+        (*logger)->log(log_level::debug, std::string_view("preformatted"));
+        g_formats = 0;
+        (*logger)->log(log_level::info, "custom {}", counted{3});
+        REQUIRE(g_formats == 1);   // Not capturable: formatted on the caller
+
+        REQUIRE(writer.lines().empty());
+        (*logger)->flush();
+        REQUIRE(writer.lines() == std::vector<std::string>{"first #1", "preformatted", "custom 3"});
+        REQUIRE(writer.batches() == 1);
+    }
+
+    SECTION("Level changes take effect at once") {
+        auto logger = make_async_logger({.writer = &writer, .shard_count = 1});
+        REQUIRE(logger.has_value());
+        REQUIRE_FALSE((*logger)->is_enabled(log_level::debug));
+        (*logger)->set_level(log_level::trace);
+        REQUIRE((*logger)->is_enabled(log_level::debug));
+        (*logger)->set_level(log_level::error);
+        (*logger)->log(log_level::warning, "dropped {}", 1);
+        (*logger)->flush();
+        REQUIRE(writer.lines().empty());
+    }
+
+    SECTION("A full ring drops and counts") {
+        auto logger = make_async_logger({.writer = &writer, .shard_count = 1});
+        REQUIRE(logger.has_value());
+        for (int i = 0; i < 300; ++i) (*logger)->log(log_level::info, "line {}", i);
+        REQUIRE((*logger)->dropped() == 300 - 256);
+        (*logger)->flush();
+        auto lines = writer.lines();
+        REQUIRE(lines.size() == 256);
+        REQUIRE(lines.front() == "line 0");
+        REQUIRE(lines.back() == "line 255");
+    }
+
+    SECTION("A message too long for a slot is written whole") {
+        auto logger = make_async_logger({.writer = &writer, .shard_count = 1});
+        REQUIRE(logger.has_value());
+        std::string text(2000, 'x');
+        text.back() = '!';
+        (*logger)->log(log_level::info, std::string_view(text));
+        (*logger)->log(log_level::info, "after {}", 1);
+        (*logger)->flush();
+        REQUIRE(writer.lines() == std::vector<std::string>{text, "after 1"});
+        REQUIRE((*logger)->dropped() == 0);
+    }
+
+    SECTION("Timestamps come from the clock") {
+        fixed_clock clock;
+        std::vector<uint64_t> stamps;
+        struct stamp_writer final : log_writer_base {
+            std::vector<uint64_t>* out;
+            void write(std::span<const log_entry> batch) override {
+                for (auto const& e : batch) out->push_back(e.timestamp_ns);
+            }
+        } stamps_writer;
+        stamps_writer.out = &stamps;
+        auto logger = make_async_logger({.writer = &stamps_writer, .clock = &clock, .shard_count = 1});
+        REQUIRE(logger.has_value());
+        (*logger)->log(log_level::info, "tick");
+        (*logger)->flush();
+        REQUIRE(stamps == std::vector<uint64_t>{42});
+    }
+
+    SECTION("Drains on an executor, keeping each thread's order") {
+        auto pool = make_thread_pool({.worker_count = 2});
+        REQUIRE(pool.has_value());
+        constexpr int k_threads = 4;
+        constexpr int k_lines = 2000;
+        uint64_t dropped = 0;
+        {
+            auto logger = make_async_logger({.writer = &writer, .executor = pool->get(), .drain_threshold = 16});
+            REQUIRE(logger.has_value());
+            std::vector<std::thread> threads;
+            for (int t = 0; t < k_threads; ++t) {
+                threads.emplace_back([&, t] {
+                    for (int i = 0; i < k_lines; ++i) {
+                        (*logger)->log(log_level::info, "{} {}", t, i);
+                        if (i % 64 == 0) std::this_thread::yield();
+                    }
+                });
+            }
+            for (auto& th : threads) th.join();
+            dropped = (*logger)->dropped();
+        }
+        (*pool)->wait_idle();
+
+        auto lines = writer.lines();
+        REQUIRE(lines.size() + dropped == k_threads * k_lines);
+        REQUIRE(writer.batches() > 1);
+        std::vector<int> last(k_threads, -1);
+        bool ordered = true;
+        for (auto const& line : lines) {
+            int t = 0, i = 0;
+            std::sscanf(line.c_str(), "%d %d", &t, &i);
+            ordered = ordered && i > last[t];
+            last[t] = i;
+        }
+        REQUIRE(ordered);
+    }
+
+    SECTION("A critical record logged during a drain is drained without a flush") {
+        manual_executor executor;
+
+        // On the second ring's batch, log into both rings; the first was already drained
+        struct relogging_writer final : log_writer_base {
+            capture_writer* out;
+            std::unique_ptr<async_logger_base>* logger;
+            int writes = 0;
+            void write(std::span<const log_entry> batch) override {
+                out->write(batch);
+                if (++writes == 2) {
+                    log_on_new_thread(**logger, log_level::critical, "late a");
+                    log_on_new_thread(**logger, log_level::critical, "late b");
+                }
+            }
+        } relog;
+        std::unique_ptr<async_logger_base> logger;
+        relog.out = &writer;
+        relog.logger = &logger;
+
+        auto made = make_async_logger({.writer = &relog, .executor = &executor, .shard_count = 2});
+        REQUIRE(made.has_value());
+        logger = std::move(*made);
+
+        // Consecutive threads land on different rings
+        log_on_new_thread(*logger, log_level::critical, "early a");
+        log_on_new_thread(*logger, log_level::critical, "early b");
+        REQUIRE(executor.run_all() == 1);
+
+        auto lines = writer.lines();
+        std::sort(lines.begin(), lines.end());
+        REQUIRE(lines == std::vector<std::string>{"early a", "early b", "late a", "late b"});
+    }
+}
@@ -0,0 +1,350 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ion/core/store.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ion::core;
+
+TEST_CASE("Memory Store - Lifecycle", "[storage][memory]") {
+    auto store_result = make_in_memory_store();
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+
+    SECTION("Closed store rejects transactions") {
+        REQUIRE_FALSE(store->begin_transaction().has_value());
+        REQUIRE_FALSE(store->begin_read_transaction().has_value());
+        REQUIRE_FALSE(store->close().has_value());
+    }
+
+    SECTION("Cannot open twice") {
+        REQUIRE(store->open({}).has_value());
+        auto again = store->open({});
+        REQUIRE_FALSE(again.has_value());
+        REQUIRE(again.error() == core_errc::already_exists);
+    }
+
+    SECTION("Close discards the data") {
+        REQUIRE(store->open({}).has_value());
+        {
+            auto txn = store->begin_transaction();
+            REQUIRE(txn.has_value());
+            REQUIRE((*txn)->make_int(*(*txn)->root(), "value", 1).has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+        REQUIRE(store->close().has_value());
+        REQUIRE(store->open({}).has_value());
+
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        REQUIRE_FALSE(*(*view)->has(*(*view)->root(), "value"));
+    }
+}
+
+TEST_CASE("Memory Store - Transactions", "[storage][memory]") {
+    auto store_result = make_in_memory_store();
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open({}).has_value());
+
+    {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        auto session = (*txn)->make_object(*root, "session");
+        REQUIRE(session.has_value());
+        REQUIRE((*txn)->make_string(*session, "user", "alice").has_value());
+        REQUIRE((*txn)->make_int(*session, "hits", 3).has_value());
+        REQUIRE((*txn)->make_double(*session, "ratio", 0.5).has_value());
+        REQUIRE((*txn)->make_bool(*session, "active", true).has_value());
+        auto tags = (*txn)->make_array(*session, "tags");
+        REQUIRE(tags.has_value());
+        REQUIRE((*txn)->commit().has_value());
+    }
+
+    SECTION("Committed values are visible to new transactions") {
+        auto view = store->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        REQUIRE((*view)->get<std::string>(*root, "session.user").value() == "alice");
+        REQUIRE((*view)->get<int64_t>(*root, "session.hits").value() == 3);
+        REQUIRE((*view)->get<double>(*root, "session.ratio").value() == 0.5);
+        REQUIRE((*view)->get<bool>(*root, "session.active").value());
+    }
+
+    SECTION("try_get reads return the get values with core_errc errors") {
+        auto view = store->begin_read_transaction();
+        auto session = *(*view)->child(*(*view)->root(), "session");
+        REQUIRE((*view)->try_get_int(*(*view)->child(session, "hits")).value() == 3);
+        REQUIRE((*view)->try_get_bool(*(*view)->child(session, "active")).value());
+        REQUIRE((*view)->try_get_double(*(*view)->child(session, "ratio")).value() == 0.5);
+        REQUIRE((*view)->try_get_string_view(*(*view)->child(session, "user")).value() == "alice");
+
+        auto user = *(*view)->child(session, "user");
+        auto wrong_type = (*view)->try_get_int(user);
+        REQUIRE_FALSE(wrong_type.has_value());
+        REQUIRE(wrong_type.error() == core_errc::type_mismatch);
+        REQUIRE((*view)->get_int(user).error() == make_error_code(core_errc::type_mismatch));
+        REQUIRE((*view)->try_get_bool(store_handle{}).error() == core_errc::invalid_handle);
+        static_assert(sizeof(core_errc) == 1);
+    }
+
+    SECTION("Children are enumerated in key order") {
+        auto view = store->begin_read_transaction();
+        auto session = *(*view)->child(*(*view)->root(), "session");
+        REQUIRE((*view)->size(session).value() == 5);
+
+        std::vector<std::string_view> keys;
+        auto children = (*view)->children(session);
+        REQUIRE(children.has_value());
+        for (auto const& e : *children) keys.push_back(e.key);
+        REQUIRE(keys == std::vector<std::string_view>{"active", "hits", "ratio", "tags", "user"});
+
+        auto tags = (*view)->elements(*(*view)->child(session, "tags"));
+        REQUIRE(tags.has_value());
+        REQUIRE(tags->begin() == tags->end());
+    }
+
+    SECTION("Rollback leaves the committed version alone") {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto session = (*txn)->child(*(*txn)->root(), "session");
+        REQUIRE((*txn)->remove(*session, "user").has_value());
+        (*txn)->rollback();
+
+        auto view = store->begin_read_transaction();
+        REQUIRE((*view)->get<std::string>(*(*view)->root(), "session.user").value() == "alice");
+    }
+
+    SECTION("Values follow the JSON backend's rules") {
+        auto txn = store->begin_transaction();
+        REQUIRE(txn.has_value());
+        auto root = (*txn)->root();
+        auto hits = (*txn)->navigate(*root, "session.hits");
+        REQUIRE(hits.has_value());
+        REQUIRE((*txn)->get_double(*hits).value() == 3.0);
+        REQUIRE((*txn)->set_string(*hits, "many").has_value());
+        REQUIRE((*txn)->get_string(*hits).value() == "many");
+
+        auto bad = (*txn)->make_int(*root, "not a key", 1);
+        REQUIRE_FALSE(bad.has_value());
+        REQUIRE(bad.error() == core_errc::path_syntax);
+
+        auto stale = (*txn)->get_int(store_handle{0});
+        REQUIRE_FALSE(stale.has_value());
+        REQUIRE(stale.error() == core_errc::invalid_handle);
+    }
+
+    SECTION("Long keys and values survive copy-on-write and rebuilds") {
+        std::string const long_key = "a_key_too_long_to_be_stored_inline_in_the_entry";
+        std::string const long_value(100, 'x');
+        {
+            auto txn = store->begin_transaction();
+            auto session = *(*txn)->child(*(*txn)->root(), "session");
+            for (int i = 0; i < 64; ++i) {
+                REQUIRE((*txn)->make_string(session, long_key + std::to_string(i), long_value).has_value());
+            }
+            REQUIRE((*txn)->commit().has_value());
+        }
+
+        // A view taken now must not see the next writer's changes
+        auto before = store->begin_read_transaction();
+        {
+            auto txn = store->begin_transaction();
+            auto session = *(*txn)->child(*(*txn)->root(), "session");
+            REQUIRE((*txn)->set_string(*(*txn)->child(session, long_key + "7"), "short").has_value());
+            REQUIRE((*txn)->remove(session, long_key + "8").has_value());
+            REQUIRE((*txn)->commit().has_value());
+        }
+
+        auto old_session = *(*before)->child(*(*before)->root(), "session");
+        REQUIRE((*before)->get_string(*(*before)->child(old_session, long_key + "7")).value() == long_value);
+        REQUIRE(*(*before)->has(old_session, long_key + "8"));
+
+        auto view = store->begin_read_transaction();
+        auto session = *(*view)->child(*(*view)->root(), "session");
+        REQUIRE((*view)->size(session).value() == 5 + 63);
+        REQUIRE((*view)->get_string(*(*view)->child(session, long_key + "7")).value() == "short");
+        REQUIRE((*view)->get_string(*(*view)->child(session, long_key + "63")).value() == long_value);
+        REQUIRE_FALSE(*(*view)->has(session, long_key + "8"));
+    }
+
+    SECTION("Concurrent read-modify-write conflicts") {
+        auto first = store->begin_transaction();
+        auto second = store->begin_transaction();
+        for (auto* txn : {&*first, &*second}) {
+            auto hits = (*txn)->navigate(*(*txn)->root(), "session.hits");
+            REQUIRE((*txn)->set_int(*hits, *(*txn)->get_int(*hits) + 1).has_value());
+        }
+        REQUIRE((*first)->commit().has_value());
+        auto result = (*second)->commit();
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::conflict);
+    }
+
+    SECTION("Writers on different keys from many threads") {
+        constexpr int k_writers = 4;
+        constexpr int k_commits = 50;
+        std::atomic<int> failures{0};
+        std::vector<std::thread> writers;
+        for (int w = 0; w < k_writers; ++w) {
+            writers.emplace_back([&, w] {
+                std::string key = "counter_" + std::to_string(w);
+                for (int i = 0; i < k_commits; ++i) {
+                    auto txn = store->begin_transaction();
+                    if (!txn || !(*txn)->make_int(*(*txn)->root(), key, i).has_value() || !(*txn)->commit()) {
+                        ++failures;
+                    }
+                }
+            });
+        }
+        for (auto& t : writers) t.join();
+        REQUIRE(failures.load() == 0);
+
+        auto view = store->begin_read_transaction();
+        for (int w = 0; w < k_writers; ++w) {
+            REQUIRE((*view)->get<int64_t>(*(*view)->root(), "counter_" + std::to_string(w)).value() == k_commits - 1);
+        }
+    }
+}
+
+
+namespace {
+
+struct window_size {
+    int32_t width = 0;
+    int32_t height = 0;
+};
+
+struct window_config {
+    std::string title;
+    window_size size;
+    double scale = 1.0;
+    bool vsync = true;
+    uint8_t monitor = 0;
+};
+
+struct window_label {
+    std::string_view title;
+};
+
+}  // namespace
+
+template <>
+struct ion::core::store_binding<window_size> {
+    static constexpr auto fields = std::tuple{
+        store_field{"width", &window_size::width},
+        store_field{"height", &window_size::height},
+    };
+};
+
+template <>
+struct ion::core::store_binding<window_config> {
+    static constexpr auto fields = std::tuple{
+        store_field{"title", &window_config::title},
+        store_field{"size", &window_config::size},
+        store_field{"scale", &window_config::scale},
+        store_field{"vsync", &window_config::vsync, true},
+        store_field{"monitor", &window_config::monitor, true},
+    };
+};
+
+template <>
+struct ion::core::store_binding<window_label> {
+    static constexpr auto fields = std::tuple{
+        store_field{"title", &window_label::title},
+    };
+};
+
+TEST_CASE("Memory Store - Struct binding", "[storage][memory]") {
+    auto store_result = make_in_memory_store();
+    REQUIRE(store_result.has_value());
+    auto& store = *store_result;
+    REQUIRE(store->open({}).has_value());
+
+    window_config const config{"main", {1280, 720}, 1.5, false, 2};
+    {
+        auto txn = store->begin_transaction();
+        auto window = (*txn)->make_object(*(*txn)->root(), "window");
+        REQUIRE(window.has_value());
+        REQUIRE(save(**txn, *window, config).has_value());
+        REQUIRE((*txn)->commit().has_value());
+    }
+
+    SECTION("Round trip") {
+        auto view = store->begin_read_transaction();
+        REQUIRE((*view)->get<int64_t>(*(*view)->root(), "window.size.height").value() == 720);
+        auto loaded = load<window_config>(**view, *(*view)->navigate(*(*view)->root(), "window"));
+        REQUIRE(loaded.has_value());
+        REQUIRE(loaded->title == "main");
+        REQUIRE(loaded->size.width == 1280);
+        REQUIRE(loaded->size.height == 720);
+        REQUIRE(loaded->scale == 1.5);
+        REQUIRE_FALSE(loaded->vsync);
+        REQUIRE(loaded->monitor == 2);
+    }
+
+    SECTION("String views point into the tree") {
+        auto view = store->begin_read_transaction();
+        auto window = (*view)->navigate(*(*view)->root(), "window");
+        window_config reused;
+        reused.title.reserve(64);
+        auto const* buffer = reused.title.data();
+        REQUIRE(load(**view, *window, reused).has_value());
+        REQUIRE(reused.title == "main");
+        REQUIRE(reused.title.data() == buffer);
+
+        auto label = load<window_label>(**view, *window);
+        REQUIRE(label.has_value());
+        REQUIRE(label->title == "main");
+        REQUIRE(label->title.data() == (*view)->get<std::string_view>(*window, "title").value().data());
+    }
+
+    SECTION("Save overwrites in place and keeps other keys") {
+        auto txn = store->begin_transaction();
+        auto window = (*txn)->navigate(*(*txn)->root(), "window");
+        REQUIRE((*txn)->make_string(*window, "note", "kept").has_value());
+        window_config changed = config;
+        changed.title = "renamed";
+        changed.size.width = 640;
+        REQUIRE(save(**txn, *window, changed).has_value());
+        // Nothing was replaced, so the handle is still good
+        REQUIRE((*txn)->get<std::string>(*window, "title").value() == "renamed");
+        REQUIRE((*txn)->get<std::string>(*window, "note").value() == "kept");
+        REQUIRE((*txn)->get<int64_t>(*window, "size.width").value() == 640);
+    }
+
+    SECTION("Optional fields keep their value when missing") {
+        auto txn = store->begin_transaction();
+        auto window = (*txn)->navigate(*(*txn)->root(), "window");
+        REQUIRE((*txn)->remove(*window, "vsync").has_value());
+        window = (*txn)->navigate(*(*txn)->root(), "window");
+
+        window_config reused;
+        reused.vsync = true;
+        REQUIRE(load(**txn, *window, reused).has_value());
+        REQUIRE(reused.vsync);
+        REQUIRE(reused.title == "main");
+    }
+
+    SECTION("Missing required field and bad values fail") {
+        auto txn = store->begin_transaction();
+        auto window = (*txn)->navigate(*(*txn)->root(), "window");
+        REQUIRE((*txn)->set_int(*(*txn)->navigate(*window, "monitor"), 300).has_value());
+        auto too_big = load<window_config>(**txn, *window);
+        REQUIRE_FALSE(too_big.has_value());
+        REQUIRE(too_big.error() == core_errc::index_out_of_range);
+
+        REQUIRE((*txn)->set_string(*(*txn)->navigate(*window, "monitor"), "left").has_value());
+        auto wrong_type = load<window_config>(**txn, *window);
+        REQUIRE_FALSE(wrong_type.has_value());
+        REQUIRE(wrong_type.error() == core_errc::type_mismatch);
+
+        REQUIRE((*txn)->remove(*window, "scale").has_value());
+        window = (*txn)->navigate(*(*txn)->root(), "window");
+        auto missing = load<window_config>(**txn, *window);
+        REQUIRE_FALSE(missing.has_value());
+        REQUIRE(missing.error() == core_errc::key_not_found);
+    }
+}
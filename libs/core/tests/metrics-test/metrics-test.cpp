@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ion/core/metrics.h>
+#include <thread>
+#include <vector>
+
+using namespace ion::core;
+
+TEST_CASE("Metrics - Histogram buckets", "[metrics]") {
+    for (uint64_t v = 0; v < 8; ++v) REQUIRE(histogram_bucket_of(v) == v);
+
+    // Every bucket starts where the previous one ends
+    for (std::size_t i = 1; i < k_histogram_bucket_count; ++i) {
+        uint64_t lower = histogram_bucket_lower(i);
+        REQUIRE(histogram_bucket_of(lower) == i);
+        REQUIRE(histogram_bucket_of(lower - 1) == i - 1);
+    }
+    REQUIRE(histogram_bucket_of(UINT64_MAX) == k_histogram_bucket_count - 1);
+    REQUIRE(histogram_bucket_of(1000) == histogram_bucket_of(1023));
+    REQUIRE(histogram_bucket_lower(histogram_bucket_of(1000)) == 960);
+}
+
+TEST_CASE("Metrics - Registry", "[metrics]") {
+    auto registry = make_metrics_registry({.max_counters = 4, .max_gauges = 2, .max_histograms = 2, .shard_count = 4});
+    REQUIRE(registry.has_value());
+    auto& metrics = **registry;
+
+    SECTION("Registration returns stable handles") {
+        auto a = metrics.register_counter("requests");
+        auto b = metrics.register_counter("errors");
+        REQUIRE(a.has_value());
+        REQUIRE(b.has_value());
+        REQUIRE(a->index != b->index);
+        REQUIRE(metrics.register_counter("requests")->index == a->index);
+
+        REQUIRE(metrics.register_counter("c").has_value());
+        REQUIRE(metrics.register_counter("d").has_value());
+        REQUIRE(metrics.register_counter("e").error() == core_errc::index_out_of_range);
+    }
+
+    SECTION("Counters sum over threads") {
+        auto id = metrics.register_counter("requests");
+        REQUIRE(id.has_value());
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 10000; ++i) metrics.add(*id);
+            });
+        }
+        for (auto& th : threads) th.join();
+        metrics.increment("requests", 5);
+
+        auto snapshot = metrics.scrape();
+        REQUIRE(snapshot.has_value());
+        REQUIRE(snapshot->counters.size() == 1);
+        REQUIRE(snapshot->counters[0].name == "requests");
+        REQUIRE(snapshot->counters[0].value == 80005);
+    }
+
+    SECTION("Gauges keep the last value") {
+        auto id = metrics.register_gauge("load");
+        REQUIRE(id.has_value());
+        metrics.set(*id, 0.5);
+        metrics.gauge("load", 0.75);
+        metrics.gauge("queue", 3.0);
+        auto snapshot = metrics.scrape();
+        REQUIRE(snapshot.has_value());
+        REQUIRE(snapshot->gauges.size() == 2);
+        REQUIRE(snapshot->gauges[0].value == 0.75);
+        REQUIRE(snapshot->gauges[1].name == "queue");
+    }
+
+    SECTION("Histograms count samples into buckets") {
+        auto id = metrics.register_histogram("tick_ns");
+        REQUIRE(id.has_value());
+        std::thread other([&] {
+            for (uint64_t v = 1; v <= 50; ++v) metrics.record(*id, v * 1000);
+        });
+        for (uint64_t v = 51; v <= 100; ++v) metrics.record(*id, v * 1000);
+        other.join();
+        metrics.timing("tick_ns", 0);
+
+        auto snapshot = metrics.scrape();
+        REQUIRE(snapshot.has_value());
+        auto const& h = snapshot->histograms.at(0);
+        REQUIRE(h.count == 101);
+        REQUIRE(h.sum == 5050 * 1000);
+        REQUIRE(h.buckets.size() == k_histogram_bucket_count);
+        REQUIRE(h.buckets[0] == 1);
+        REQUIRE(h.quantile(0.0) == 0);
+        // Bucket lower bounds stay within 12.5% below the exact quantile
+        uint64_t median = h.quantile(0.5);
+        REQUIRE(median <= 50000);
+        REQUIRE(median >= 50000 - 50000 / 8);
+        uint64_t top = h.quantile(1.0);
+        REQUIRE(top <= 100000);
+        REQUIRE(top >= 100000 - 100000 / 8);
+    }
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <ion/core/time.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace ion::core;
+
+namespace {
+
+struct manual_clock final : clock_base {
+    uint64_t now = 100;
+    uint64_t now_ns() const override { return now; }
+};
+
+uint64_t steady_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+TEST_CASE("Time - Fixed-point scaling", "[time]") {
+    REQUIRE(detail::mul_shift32(12345, 1ull << 32) == 12345);
+    REQUIRE(detail::mul_shift32(3, 1ull << 31) == 1);
+    // 41.666 ns per tick, the rate of a 24 MHz counter, over a day of ticks
+    uint64_t mult = static_cast<uint64_t>(1e9 / 24e6 * 4294967296.0);
+    uint64_t day = 24ull * 3600 * 24'000'000;
+    uint64_t ns = detail::mul_shift32(day, mult);
+    REQUIRE(ns > 86'399'999'000'000ull);
+    REQUIRE(ns <= 86'400'000'000'000ull);
+}
+
+TEST_CASE("Time - TSC clock", "[time]") {
+    bool use_counter = GENERATE(true, false);
+    auto clock = make_tsc_clock({.calibration_ns = 2'000'000, .use_counter = use_counter});
+    REQUIRE(clock.has_value());
+    if (!use_counter) REQUIRE((*clock)->source() == clock_source::steady);
+
+    SECTION("Follows steady_clock") {
+        uint64_t before = steady_ns();
+        uint64_t now = (*clock)->now_fast();
+        uint64_t after = steady_ns();
+        // Calibration error over the time since calibrating stays far below a millisecond
+        REQUIRE(now + 1'000'000 >= before);
+        REQUIRE(now <= after + 1'000'000);
+        REQUIRE((*clock)->now_ns() >= now);
+    }
+
+    SECTION("Spans measure elapsed time") {
+        clock_span span(**clock);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        uint64_t elapsed = span.elapsed_ns();
+        REQUIRE(elapsed >= 4'500'000);
+        REQUIRE(elapsed < 1'000'000'000);
+        REQUIRE(span.restart() >= elapsed);
+        REQUIRE(span.elapsed_ns() < elapsed);
+    }
+
+    SECTION("Readings never go backwards") {
+        bool monotonic = true;
+        uint64_t last = (*clock)->now_fast();
+        for (int i = 0; i < 100000; ++i) {
+            uint64_t now = (*clock)->now_fast();
+            monotonic = monotonic && now >= last;
+            last = now;
+        }
+        REQUIRE(monotonic);
+    }
+}
+
+TEST_CASE("Time - Cached clock", "[time]") {
+    manual_clock source;
+    cached_clock clock(source);
+    REQUIRE(clock.now_ns() == 100);
+
+    source.now = 250;
+    REQUIRE(clock.now_fast() == 100);
+    clock.update();
+    REQUIRE(clock.now_fast() == 250);
+    REQUIRE(static_cast<clock_base const&>(clock).now_ns() == 250);
+}
@@ -4,6 +4,8 @@
 #include <ion/core/store.h>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <vector>
 #include <thread>
 #include <chrono>
 
@@ -801,12 +803,125 @@ file = "/var/log/app.log"
         REQUIRE(log_level.has_value());
         REQUIRE(*log_level == "debug");
     }
+
+    SECTION("Converts to and from a binary snapshot") {
+        temp_file snapshot("test_format.bin");
+        temp.write(R"(
+title = "Test Config"
+released = 1979-05-27T07:32:00-08:00
+
+[server]
+host = "localhost"
+port = 8080
+ratio = 0.5
+enabled = true
+tags = ["a", "b"]
+)");
+
+        REQUIRE(convert_store_file(temp.path(), store_format::toml, snapshot.path(), store_format::binary).has_value());
+        {
+            auto store = make_binary_file_store(snapshot.path(), binary_store_options{});
+            REQUIRE(store.has_value());
+            REQUIRE((*store)->open(snapshot.path()).has_value());
+            auto view = (*store)->begin_read_transaction();
+            REQUIRE(view.has_value());
+            auto root = (*view)->root();
+            REQUIRE((*view)->get<std::string>(*root, "title").value() == "Test Config");
+            REQUIRE((*view)->get<int64_t>(*root, "server.port").value() == 8080);
+        }
+
+        temp.write("");
+        REQUIRE(convert_store_file(snapshot.path(), store_format::binary, temp.path(), store_format::toml).has_value());
+
+        auto store = make_toml_file_store(temp.path(), opts);
+        REQUIRE(store.has_value());
+        REQUIRE((*store)->open(temp.path()).has_value());
+        auto view = (*store)->begin_read_transaction();
+        REQUIRE(view.has_value());
+        auto root = (*view)->root();
+        REQUIRE((*view)->get<std::string>(*root, "title").value() == "Test Config");
+        REQUIRE((*view)->get<std::string>(*root, "server.host").value() == "localhost");
+        REQUIRE((*view)->get<int64_t>(*root, "server.port").value() == 8080);
+        REQUIRE((*view)->get<double>(*root, "server.ratio").value() == Catch::Approx(0.5));
+        REQUIRE((*view)->get<bool>(*root, "server.enabled").value());
+        REQUIRE((*view)->get<std::string>(*root, "server.tags[1]").value() == "b");
+        REQUIRE_THAT(temp.read(), ContainsSubstring("1979-05-27T07:32:00-08:00"));
+    }
+
+    SECTION("Dates and times survive a load, modify and save") {
+        temp.write(R"(
+name = "before"
+released = 1979-05-27T07:32:00-08:00
+birthday = 1979-05-27
+alarm = 07:32:00
+)");
+
+        for (auto name : {"first", "second"}) {
+            auto store = make_toml_file_store(temp.path(), opts);
+            REQUIRE(store.has_value());
+            REQUIRE((*store)->open(temp.path()).has_value());
+            {
+                auto txn = (*store)->begin_transaction();
+                REQUIRE(txn.has_value());
+                auto root = (*txn)->root();
+                REQUIRE(root.has_value());
+                auto handle = (*txn)->child(*root, "name");
+                REQUIRE(handle.has_value());
+                REQUIRE((*txn)->set_string(*handle, name).has_value());
+                REQUIRE((*txn)->commit().has_value());
+            }
+            REQUIRE((*store)->close().has_value());
+
+            std::string content = temp.read();
+            REQUIRE_THAT(content, ContainsSubstring(std::string("name = \"") + name + "\""));
+            REQUIRE_THAT(content, ContainsSubstring("released = 1979-05-27T07:32:00-08:00"));
+            REQUIRE_THAT(content, ContainsSubstring("birthday = 1979-05-27"));
+            REQUIRE_THAT(content, ContainsSubstring("alarm = 07:32:00"));
+        }
+    }
+
+    SECTION("A malformed stored date fails to save") {
+        temp_file snapshot("test_format.bin");
+        temp_file target("test_format_out.toml");
+        temp.write("released = 1979-05-27\n");
+        REQUIRE(convert_store_file(temp.path(), store_format::toml, snapshot.path(), store_format::binary).has_value());
+
+        // Same length, so every offset in the snapshot stays valid
+        std::string bytes;
+        {
+            std::ifstream in(snapshot.path(), std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), {});
+        }
+        auto at = bytes.find("1979-05-27");
+        REQUIRE(at != std::string::npos);
+        bytes.replace(at, 10, "not-a-date");
+        {
+            std::ofstream out(snapshot.path(), std::ios::binary | std::ios::trunc);
+            out << bytes;
+        }
+
+        auto result = convert_store_file(snapshot.path(), store_format::binary, target.path(), store_format::toml);
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::parse_error);
+        REQUIRE_FALSE(target.exists());
+    }
+
+    SECTION("Converting a null to TOML fails") {
+        temp_file source("test_format.json");
+        source.write(R"({"name": "x", "server": {"backup": null}})");
+
+        auto result = convert_store_file(source.path(), store_format::json, temp.path(), store_format::toml);
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == core_errc::type_mismatch);
+        REQUIRE_FALSE(temp.exists());
+    }
 }
 
 TEST_CASE("TOML Store - Crash Safety", "[storage][toml]") {
     temp_file temp("test_crash.toml");
     temp_file temp_backup(temp.path().string() + ".tmp");
     toml_store_options opts{};
+    opts.use_journal = false;  // Every commit rewrites the file
     
     SECTION("Atomic file replacement") {
         // Create initial file
@@ -925,4 +1040,4 @@ TEST_CASE("TOML Store - Performance", "[storage][toml][!benchmark]") {
         REQUIRE(value.has_value());
         REQUIRE(*value == "found_me");
     }
-}
\ No newline at end of file
+}